@@ -47,6 +47,7 @@
 
     BGPMain::BGPMain()
 : _exit_loop(false),
+    _update_decoder(NULL),
     _component_count(0),
     _ifmgr(NULL),
     _is_ifmgr_ready(false),
@@ -60,6 +61,16 @@
     _local_data = new LocalData;
     _peerlist = new BGPPeerList();
     _deleted_peerlist = new BGPPeerList();
+    if (UpdateDecoder::configured_threads() > 0) 
+    {
+	_update_decoder =
+	    new UpdateDecoder(UpdateDecoder::configured_threads());
+	if (!_update_decoder->running()) 
+	{
+	    delete _update_decoder;
+	    _update_decoder = NULL;
+	}
+    }
     _xrl_router = new XrlStdRouter( "bgp");
     _xrl_target = new XrlBgpTarget(_xrl_router, *this);
 
@@ -238,6 +249,10 @@ BGPMain::~BGPMain()
     debug_msg("Deleting peerlist\n");
     delete _peerlist;
 
+    debug_msg("-------------------------------------------\n");
+    debug_msg("Deleting UPDATE decoder\n");
+    delete _update_decoder;
+
     debug_msg("-------------------------------------------\n");
     debug_msg("Deleting localdata\n");
     delete _local_data;
@@ -36,6 +36,7 @@
 #include "path_attribute.hh"
 #include "peer_handler.hh"
 #include "process_watch.hh"
+#include "update_decoder.hh"
 
 #include "libfeaclient/ifmgr_xrl_mirror.hh"
 #include "policy/backend/version_filters.hh"
@@ -653,6 +654,12 @@ class BGPMain : public ServiceBase,
 	XrlStdRouter *get_router() { return _xrl_router; }
 	XrlBgpTarget *get_xrl_target() { return _xrl_target; }
 
+	/**
+	 * @return the pool of threads that decode UPDATEs, or 0 if they
+	 * are decoded on the main thread.
+	 */
+	UpdateDecoder *update_decoder() const { return _update_decoder; }
+
 	/**
 	 * Call via XrlBgpTarget when the finder reports that a process
 	 * has started.
@@ -962,6 +969,7 @@ class BGPMain : public ServiceBase,
 	bool _exit_loop;
 	BGPPeerList *_peerlist;		// List of current BGP peers.
 	BGPPeerList *_deleted_peerlist;	// List of deleted BGP peers.
+	UpdateDecoder *_update_decoder;	// UPDATE decode threads.
 
 	/**
 	 * Unicast Routing Table. SAFI = 1.
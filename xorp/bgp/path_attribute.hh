@@ -648,9 +648,9 @@ class UnknownAttribute : public PathAttribute
 };
 
 /* it ought to be possible to typedef this, but I don't know how */
-#define FPAListRef ref_ptr<FastPathAttributeList<A> >
-#define FPAList4Ref ref_ptr<FastPathAttributeList<IPv4> >
-#define FPAList6Ref ref_ptr<FastPathAttributeList<IPv6> >
+#define FPAListRef iref_ptr<FastPathAttributeList<A> >
+#define FPAList4Ref iref_ptr<FastPathAttributeList<IPv4> >
+#define FPAList6Ref iref_ptr<FastPathAttributeList<IPv6> >
 
 template<class A>
 class FastPathAttributeList;
@@ -824,7 +824,7 @@ class PAListRef
    slave to persist when this is deleted */
 
 template<class A>
-class FastPathAttributeList /*: public PathAttributeList<A>*/ 
+class FastPathAttributeList : public iref_counted
 {
 	public:
 		FastPathAttributeList(PAListRef<A>& palist);
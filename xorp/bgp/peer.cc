@@ -68,6 +68,7 @@ BGPPeer::BGPPeer(LocalData *ld, BGPPeerData *pd, SocketClient *sock,
 
 BGPPeer::~BGPPeer()
 {
+	cancel_decodes();
 	delete _SocketClient;
 	delete _peerdata;
 	list<AcceptSession *>::iterator i;
@@ -225,6 +226,35 @@ BGPPeer::get_message(BGPPacket::Status status, const uint8_t *buf,
 	 */
 	XLOG_ASSERT(0 != buf);
 
+	uint8_t type = extract_8(buf + BGPPacket::TYPE_OFFSET);
+
+	/*
+	 ** With decode threads UPDATEs are decoded off the main thread,
+	 ** and any message that arrives behind one waits for it.
+	 */
+	if (0 != _mainprocess->update_decoder() && STATEESTABLISHED == _state &&
+			(MESSAGETYPEUPDATE == type || !_decode_queue.empty())) 
+	{
+		TIMESPENT_CHECK();
+		return queue_message(buf, length, MESSAGETYPEUPDATE == type);
+	}
+
+	TIMESPENT_CHECK();
+
+	return dispatch_message(buf, length, 0);
+}
+
+/*
+ * Decode a message and dispatch it to the state machine. If the
+ * message is an UPDATE that has already been decoded it is taken from
+ * the job instead.
+ */
+	bool
+BGPPeer::dispatch_message(const uint8_t *buf, size_t length,
+		UpdateDecodeJob *job)
+{
+	TIMESPENT();
+
 	const uint8_t* marker = buf + BGPPacket::MARKER_OFFSET;
 	uint8_t type = extract_8(buf + BGPPacket::TYPE_OFFSET);
 	try 
@@ -279,24 +309,18 @@ BGPPeer::get_message(BGPPacket::Status status, const uint8_t *buf,
 					debug_msg("UPDATE Packet RECEIVED\n");
 					_in_updates++;
 					EventLoop::instance().current_time(_in_update_time);
+					if (0 != job) 
+					{
+						// Decode errors are rethrown from the job.
+						recv_update(job->packet(_mainprocess));
+						TIMESPENT_CHECK();
+						break;
+					}
 					UpdatePacket pac(buf, length, _peerdata, _mainprocess, /*do checks*/true);
 
-					PROFILE(XLOG_TRACE(main()->profile().enabled(trace_message_in),
-								"Peer %s: Receive: %s",
-								peerdata()->iptuple().str().c_str(),
-								cstring(pac)));
-
 					// All decode errors should throw a CorruptMessage.
-					debug_msg("%s", pac.str().c_str());
-
-					event_recvupdate(pac);
+					recv_update(pac);
 					TIMESPENT_CHECK();
-					if (TIMESPENT_OVERLIMIT()) 
-					{
-						XLOG_WARNING("Processing packet took longer than %u second %s",
-								XORP_UINT_CAST(TIMESPENT_LIMIT),
-								pac.str().c_str());
-					}
 					break;
 				}
 			case MESSAGETYPENOTIFICATION: 
@@ -362,6 +386,88 @@ BGPPeer::get_message(BGPPacket::Status status, const uint8_t *buf,
 	return true;
 }
 
+	void
+BGPPeer::recv_update(UpdatePacket& pac)
+{
+	TIMESPENT();
+
+	PROFILE(XLOG_TRACE(main()->profile().enabled(trace_message_in),
+				"Peer %s: Receive: %s",
+				peerdata()->iptuple().str().c_str(),
+				cstring(pac)));
+
+	debug_msg("%s", pac.str().c_str());
+
+	event_recvupdate(pac);
+	TIMESPENT_CHECK();
+	if (TIMESPENT_OVERLIMIT()) 
+	{
+		XLOG_WARNING("Processing packet took longer than %u second %s",
+				XORP_UINT_CAST(TIMESPENT_LIMIT),
+				pac.str().c_str());
+	}
+}
+
+	bool
+BGPPeer::queue_message(const uint8_t *buf, size_t length, bool decode)
+{
+	UpdateDecoder *decoder = _mainprocess->update_decoder();
+	if (_decode_peerdata.is_empty())
+		_decode_peerdata = new PeerDataSnapshot(*_peerdata);
+
+	UpdateDecodeJob *job = new UpdateDecodeJob(this, _decode_peerdata, buf,
+			length, decode);
+
+	_decode_queue.push_back(job);
+	if (decode)
+		decoder->submit(job);
+
+	/*
+	 ** Don't let a peer that sends faster than we can process its
+	 ** UPDATEs use up all the memory.
+	 */
+	if (_decode_queue.size() > MAX_DECODE_QUEUE) 
+	{
+		decoder->wait(_decode_queue.front());
+		process_decoded();
+	}
+
+	return is_connected() && still_reading();
+}
+
+	void
+BGPPeer::process_decoded()
+{
+	while (!_decode_queue.empty() && _decode_queue.front()->delivered()) 
+	{
+		UpdateDecodeJob *job = _decode_queue.front();
+		_decode_queue.pop_front();
+
+		bool more = dispatch_message(job->data(), job->length(), job);
+		delete job;
+
+		if (!more) 
+		{
+			cancel_decodes();
+			return;
+		}
+	}
+}
+
+	void
+BGPPeer::cancel_decodes()
+{
+	if (_decode_queue.empty())
+		return;
+
+	_mainprocess->update_decoder()->cancel(this);
+	while (!_decode_queue.empty()) 
+	{
+		delete _decode_queue.front();
+		_decode_queue.pop_front();
+	}
+}
+
 	PeerOutputState
 BGPPeer::send_message(const BGPPacket& p)
 {
@@ -388,25 +494,19 @@ BGPPeer::send_message(const BGPPacket& p)
 	if (packet_type == MESSAGETYPEUPDATE)
 		_out_updates++;
 
-	uint8_t *buf = new uint8_t[BGPPacket::MAXPACKETSIZE];
+	vector<uint8_t> buf(BGPPacket::MAXPACKETSIZE);
 	size_t ccnt = BGPPacket::MAXPACKETSIZE;
 
-	/*
-	 ** This buffer is dynamically allocated and should be freed.
-	 */
-	XLOG_ASSERT(p.encode(buf, ccnt, _peerdata));
-	debug_msg("Buffer for sent packet is %p\n", buf);
-
+	XLOG_ASSERT(p.encode(&buf[0], ccnt, _peerdata));
+	buf.resize(ccnt);
 
 	/*
-	 ** This write is async. So we can't free the data now,
-	 ** we will deal with it in the complete routine.
+	 ** This write is async. The writer takes over the buffer, without
+	 ** copying it, and frees it once it has been sent.
 	 */
-	bool ret = _SocketClient->send_message(buf, ccnt,
+	bool ret = _SocketClient->send_message(buf,
 			callback(this,&BGPPeer::send_message_complete));
 
-	if (ret == false)
-		delete[] buf;
 	if (ret) 
 	{
 		int size = _SocketClient->output_queue_size();
@@ -446,8 +546,8 @@ BGPPeer::send_message_complete(SocketClient::Event ev, const uint8_t *buf)
 			/*drop through to next case*/
 		case SocketClient::FLUSHING:
 			debug_msg("event: flushing\n");
-			debug_msg("Freeing Buffer for sent packet: %p\n", buf);
-			delete[] buf;
+			// The buffer belongs to the writer.
+			UNUSED(buf);
 			TIMESPENT_CHECK();
 			break;
 		case SocketClient::ERROR:
@@ -1794,6 +1894,13 @@ BGPPeer::set_state(FSMState s, bool restart, bool automatic)
 	FSMState previous_state = _state;
 	_state = s;
 
+	// The negotiated state of the peering may change with the FSM state.
+	_decode_peerdata.release();
+
+	// Messages held for decoding belong to the session that is ending.
+	if (previous_state == STATEESTABLISHED && _state != STATEESTABLISHED)
+		cancel_decodes();
+
 	if (previous_state == STATESTOPPED && _state != STATESTOPPED)
 		clear_stopped_timer();
 
@@ -2208,12 +2315,11 @@ AcceptSession::swap_sockets(const OpenPacket& p)
 #ifdef	NO_STATS
 	_peer.event_openmess(p);
 #else
-	// This buffer is dynamically allocated and needs to be freed.
+	// The message is consumed synchronously so the stack will do.
 	size_t ccnt = BGPPacket::MAXPACKETSIZE;
-	uint8_t *buf = new uint8_t[BGPPacket::MAXPACKETSIZE];
+	uint8_t buf[BGPPacket::MAXPACKETSIZE];
 	XLOG_ASSERT(p.encode(buf, ccnt, NULL));
 	_peer.get_message(BGPPacket::GOOD_MESSAGE, buf, ccnt, 0);
-	delete[] buf;
 #endif
 }
 
@@ -27,6 +27,7 @@
 #include "socket.hh"
 #include "local_data.hh"
 #include "peer_data.hh"
+#include "update_decoder.hh"
 
 enum FSMState 
 {
@@ -152,6 +153,7 @@ class BGPPeer
 		{
 			BGPPeerData *tmp = _peerdata;
 			_peerdata = pd;
+			_decode_peerdata.release();
 
 			return tmp;
 		}
@@ -223,6 +225,13 @@ class BGPPeer
 
 		bool get_message(BGPPacket::Status status, const uint8_t *buf, size_t len,
 				SocketClient *socket_client);
+
+		/**
+		 * Process the messages at the head of the queue of messages
+		 * held while UPDATEs are decoded on worker threads, that are
+		 * ready to be processed.
+		 */
+		void process_decoded();
 		PeerOutputState send_message(const BGPPacket& p);
 		void send_message_complete(SocketClient::Event, const uint8_t *buf);
 
@@ -303,6 +312,30 @@ class BGPPeer
 		list<AcceptSession *> _accept_attempt;
 		string _peername;
 
+		/*
+		 ** Messages received while UPDATEs are decoded on worker
+		 ** threads, in the order they arrived.
+		 */
+		list<UpdateDecodeJob *> _decode_queue;
+
+		/*
+		 ** The copy of the peer data shared by the queued UPDATEs,
+		 ** dropped whenever the state of the peering changes.
+		 */
+		ref_ptr<PeerDataSnapshot> _decode_peerdata;
+
+		/*
+		 ** Number of messages held before the main thread waits for
+		 ** the oldest to be decoded.
+		 */
+		static const size_t MAX_DECODE_QUEUE = 256;
+
+		bool dispatch_message(const uint8_t *buf, size_t length,
+				UpdateDecodeJob *job);
+		void recv_update(UpdatePacket& pac);
+		bool queue_message(const uint8_t *buf, size_t length, bool decode);
+		void cancel_decodes();
+
 		XorpTimer _timer_connect_retry;
 		XorpTimer _timer_hold_time;
 		XorpTimer _timer_keep_alive;
@@ -61,6 +61,36 @@ BGPPeerData::BGPPeerData(const LocalData& local_data, const Iptuple& iptuple,
 	open_negotiation();
 }
 
+BGPPeerData::BGPPeerData(const BGPPeerData& peerdata,
+		const LocalData& local_data)
+: _local_data(local_data), _iptuple(peerdata._iptuple), _as(peerdata._as),
+	_use_4byte_asnums(peerdata._use_4byte_asnums),
+	_route_reflector(peerdata._route_reflector),
+	_confederation(peerdata._confederation),
+	_prefix_limit(peerdata._prefix_limit),
+	_configured_hold_time(peerdata._configured_hold_time),
+	_delay_open_time(peerdata._delay_open_time),
+	_id(peerdata._id),
+	_hold_duration(peerdata._hold_duration),
+	_retry_duration(peerdata._retry_duration),
+	_keepalive_duration(peerdata._keepalive_duration),
+	_nexthop_ipv4(peerdata._nexthop_ipv4),
+	_nexthop_ipv6(peerdata._nexthop_ipv6),
+	_peer_type(peerdata._peer_type),
+	_recv_parameters(peerdata._recv_parameters),
+	_sent_parameters(peerdata._sent_parameters),
+	_negotiated_parameters(peerdata._negotiated_parameters),
+	_next_hop_rewrite(peerdata._next_hop_rewrite),
+	_md5_password(peerdata._md5_password)
+{
+	memcpy(_ipv4_unicast, peerdata._ipv4_unicast, sizeof(_ipv4_unicast));
+	memcpy(_ipv6_unicast, peerdata._ipv6_unicast, sizeof(_ipv6_unicast));
+	memcpy(_ipv4_multicast, peerdata._ipv4_multicast,
+			sizeof(_ipv4_multicast));
+	memcpy(_ipv6_multicast, peerdata._ipv6_multicast,
+			sizeof(_ipv6_multicast));
+}
+
 BGPPeerData::~BGPPeerData()
 {
 }
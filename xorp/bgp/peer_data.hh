@@ -92,6 +92,19 @@ class BGPPeerData
 	public:
 		BGPPeerData(const LocalData& local_data, const Iptuple& iptuple, AsNum as,
 				const IPv4& next_hop, const uint16_t holdtime);
+
+		/**
+		 * Copy the state of a peering, referring to local_data
+		 * instead of the LocalData of the original.
+		 *
+		 * A copy that doesn't share any state with the main process
+		 * can be read from another thread.
+		 *
+		 * @param peerdata the state to copy.
+		 * @param local_data the LocalData of the copy.
+		 */
+		BGPPeerData(const BGPPeerData& peerdata, const LocalData& local_data);
+
 		~BGPPeerData();
 
 		const Iptuple& iptuple() const		{ return _iptuple; }
@@ -106,8 +106,8 @@ PeerHandler::peering_came_up()
 template <>
 	bool
 PeerHandler::add<IPv4>(const UpdatePacket *p,
-		ref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
-		ref_ptr<FastPathAttributeList<IPv4> >& pa_list,
+		iref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
+		iref_ptr<FastPathAttributeList<IPv4> >& pa_list,
 		Safi safi)
 {
 	UNUSED(original_pa_list);
@@ -200,8 +200,8 @@ PeerHandler::add<IPv4>(const UpdatePacket *p,
 template <>
 	bool
 PeerHandler::add<IPv6>(const UpdatePacket *p,
-		ref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
-		ref_ptr<FastPathAttributeList<IPv6> >& pa_list,
+		iref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
+		iref_ptr<FastPathAttributeList<IPv6> >& pa_list,
 		Safi safi)
 {
 	UNUSED(original_pa_list);
@@ -263,7 +263,7 @@ PeerHandler::add<IPv6>(const UpdatePacket *p,
 template <>
 	bool
 PeerHandler::withdraw<IPv6>(const UpdatePacket *p, 
-		ref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
+		iref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
 		Safi safi)
 {
 	UNUSED(p);
@@ -297,7 +297,7 @@ PeerHandler::withdraw<IPv6>(const UpdatePacket *p,
 template <>
 	bool
 PeerHandler::withdraw<IPv4>(const UpdatePacket *p, 
-		ref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
+		iref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
 		Safi safi)
 {
 	switch(safi) 
@@ -570,7 +570,7 @@ PeerHandler::start_packet()
 
 	int
 PeerHandler::add_route(const SubnetRoute<IPv4> &rt, 
-		ref_ptr<FastPathAttributeList<IPv4> >& pa_list,
+		iref_ptr<FastPathAttributeList<IPv4> >& pa_list,
 		bool /*ibgp*/, Safi safi)
 {
 	debug_msg("PeerHandler::add_route(IPv4) %p\n", &rt);
@@ -773,7 +773,7 @@ PeerHandler::multiprotocol<IPv6>(Safi safi, BGPPeerData::Direction d) const
 
 	int
 PeerHandler::add_route(const SubnetRoute<IPv6> &rt, 
-		ref_ptr<FastPathAttributeList<IPv6> >& pa_list,
+		iref_ptr<FastPathAttributeList<IPv6> >& pa_list,
 		bool /*ibgp*/, Safi safi)
 {
 	debug_msg("PeerHandler::add_route(IPv6) %p\n", &rt);
@@ -67,8 +67,8 @@ class PeerHandler
 		 */
 		template <typename A> 
 			bool add(const UpdatePacket *p,
-					ref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
-					ref_ptr<FastPathAttributeList<A> >& pa_list,
+					iref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
+					iref_ptr<FastPathAttributeList<A> >& pa_list,
 					Safi safi);
 		/**
 		 * Given an update packet find all the WITHDRAWs with <AFI,SAFI>
@@ -81,7 +81,7 @@ class PeerHandler
 		 */
 		template <typename A> 
 			bool withdraw(const UpdatePacket *p, 
-					ref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
+					iref_ptr<FastPathAttributeList<IPv4> >& original_pa_list,
 					Safi safi);
 
 		template <typename A> bool multiprotocol(Safi safi, 
@@ -62,5 +62,29 @@ RouteQueueEntry<A>::str() const
 	return s;
 }
 
+template<class A>
+	void*
+RouteQueueEntry<A>::operator new(size_t/* size*/)
+{
+	return memory_pool().alloc();
+}
+
+template<class A>
+	void
+RouteQueueEntry<A>::operator delete(void* ptr)
+{
+	memory_pool().free(ptr);
+}
+
+template<class A>
+	MemoryPool<RouteQueueEntry<A> >&
+RouteQueueEntry<A>::memory_pool()
+{
+	// Never destroyed, queued routes may still be referenced during shutdown.
+	static MemoryPool<RouteQueueEntry<A> >* mp
+		= new MemoryPool<RouteQueueEntry<A> >("RouteQueueEntry");
+	return *mp;
+}
+
 template class RouteQueueEntry<IPv4>;
 template class RouteQueueEntry<IPv6>;
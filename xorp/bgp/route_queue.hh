@@ -64,6 +64,9 @@ class RouteQueueEntry
 		{
 		}
 
+		void* operator new(size_t size);
+		void operator delete(void* ptr);
+
 		const SubnetRoute<A>* route() const		
 		{ 
 			return _route_ref.route();	
@@ -92,6 +95,8 @@ class RouteQueueEntry
 
 		string str() const;
 	private:
+		static MemoryPool<RouteQueueEntry<A> >& memory_pool();
+
 		RouteQueueOp _op;
 
 		SubnetRouteConstRef<A> _route_ref;
@@ -88,12 +88,14 @@ ReaderIxTuple<A>::is_consistent() const
 
 	template <class A>
 RouteTableReader<A>::RouteTableReader(const list <RibInTable<A>*>& ribins,
-		const IPNet<A>& /*prefix*/)
+		const IPNet<A>& prefix)
 {
+	// Only visit the subtree covered by the requested prefix, so that
+	// the caller is not handed routes it would discard anyway.
 	typename list <RibInTable<A>*>::const_iterator i;
 	for(i = ribins.begin(); i != ribins.end(); i++) 
 	{
-		trie_iterator ti = (*i)->trie().begin();
+		trie_iterator ti = (*i)->trie().search_subtree(prefix);
 		if (ti != (*i)->trie().end()) 
 		{
 			IPv4 peer_id = (*i)->peer_handler()->id();
@@ -265,100 +265,86 @@ SocketClient::flush_transmit_queue()
 		_async_writer->flush_buffers();
 }
 
-	void
-SocketClient::async_read_start(size_t cnt, size_t offset)
-{
-	debug_msg("start reading %s\n", get_remote_host());
-
-	XLOG_ASSERT(_async_reader);
-
-	_async_reader->
-		add_buffer_with_offset(_read_buf, 
-				cnt,
-				offset,
-				callback(this,
-					&SocketClient::async_read_message));
-	_async_reader->start();
-}
-
 /*
  * Handler for reading incoming data on a BGP connection.
  *
- * When a packet first comes in, we read the default amount of data,
- * which is BGPPacket::MINPACKETSIZE (i.e. the minimum size of a BGP message).
- * This callback is then invoked a first time, and it can check the
- * actual message length. If more bytes are needed, we call again
- * async_read_start with the desired length (instructing it to skip
- * whatever we already read).
- * Once the packet is complete, we invoke the packet decoder with dispatch()
+ * The reader accumulates data in a single buffer and calls us once at
+ * least trigger bytes are available. Every complete message in the
+ * buffer is handed to the packet decoder directly from the buffer with
+ * dispatch(), there is no copy and no per message allocation. If a
+ * partial message remains the trigger is raised to the length of that
+ * message, so that we are only called again once it is complete.
  */
 	void
-SocketClient::async_read_message(AsyncFileWriter::Event ev,
-		const uint8_t *buf,	// the base of the buffer
-		const size_t buf_bytes,	// desired message size
-		const size_t offset)	// where we got so far (next free byte)
+SocketClient::async_read_message(BufferedAsyncReader* reader,
+		BufferedAsyncReader::Event ev,
+		uint8_t *buf,		// head of the unprocessed data
+		size_t buf_bytes)	// bytes of unprocessed data
 {
-	debug_msg("async_read_message %d %u %u %s\n", ev,
-			XORP_UINT_CAST(buf_bytes), XORP_UINT_CAST(offset),
-			get_remote_host());
+	debug_msg("async_read_message %d %u %s\n", ev,
+			XORP_UINT_CAST(buf_bytes), get_remote_host());
 
-	XLOG_ASSERT(_async_reader);
+	XLOG_ASSERT(_async_reader == reader);
 
 	switch (ev) 
 	{
-		case AsyncFileReader::DATA:
-			XLOG_ASSERT(offset <= buf_bytes);
-			if (offset == buf_bytes) {		// message complete so far
+		case BufferedAsyncReader::DATA:
+			while (buf_bytes >= BGPPacket::COMMON_HEADER_LEN) 
+			{
 				size_t fh_length = extract_16(buf + BGPPacket::LENGTH_OFFSET);
 
 				if (fh_length < BGPPacket::MINPACKETSIZE
-						|| fh_length > sizeof(_read_buf)) 
+						|| fh_length > BGPPacket::MAXPACKETSIZE) 
 				{
 					XLOG_ERROR("Illegal length value %u",
 							XORP_UINT_CAST(fh_length));
 					if (!_callback->dispatch(BGPPacket::ILLEGAL_MESSAGE_LENGTH,
-								buf, buf_bytes, this))
+								buf, BGPPacket::COMMON_HEADER_LEN, this))
+						return;
+					/*
+					 ** There is no way to find the next message in
+					 ** the stream, throw away whatever we have.
+					 */
+					if (_async_reader != reader)
 						return;
+					reader->dispose(buf_bytes);
+					buf_bytes = 0;
+					break;
 				}
+
 				/*
-				 * Keep reading until we have the whole message.
+				 * Wait until we have the whole message.
 				 */
-				if (buf_bytes == fh_length) 
+				if (buf_bytes < fh_length) 
 				{
-					if (_callback->dispatch(BGPPacket::GOOD_MESSAGE,
-								buf, buf_bytes, this))
-						async_read_start();		// ready for next message
-				} else {				// read rest of the message
-					async_read_start(fh_length, buf_bytes);
+					reader->set_trigger_bytes(fh_length);
+					return;
 				}
-			}
-			/*
-			 ** At this point if we have a valid _async_reader then it should
-			 ** have buffers into which we expect data.
-			 */
-			if (_async_reader && 0 == _async_reader->buffers_remaining())
-				XLOG_WARNING("No outstanding reads %s socket %p async_reader %p",
-						is_connected() ? "connected" : "not connected",
-						this, _async_reader);
-
-			XLOG_ASSERT(!_async_reader ||
-					(_async_reader &&
-					 _async_reader->buffers_remaining() > 0));
-			break;
 
-		case AsyncFileReader::WOULDBLOCK:
-		case AsyncFileReader::FLUSHING:
-			/*
-			 * We are not using a dynamic buffer so don't worry.
-			 */
+				if (!_callback->dispatch(BGPPacket::GOOD_MESSAGE,
+							buf, fh_length, this))
+					return;
+
+				/*
+				 ** The callback may have stopped the reader, in
+				 ** which case the buffer has gone with it.
+				 */
+				if (_async_reader != reader)
+					return;
+
+				reader->dispose(fh_length);
+				buf += fh_length;
+				buf_bytes -= fh_length;
+			}
+			reader->set_trigger_bytes(BGPPacket::COMMON_HEADER_LEN);
 			break;
 
-		case AsyncFileReader::OS_ERROR:
-			debug_msg("Read failed: %d\n", _async_reader->error());
+		case BufferedAsyncReader::OS_ERROR:
+			debug_msg("Read failed: %d\n", reader->error());
 			_callback->dispatch(BGPPacket::CONNECTION_CLOSED, 0, 0, this);
 			break;
 
-		case AsyncFileReader::END_OF_FILE:
+		case BufferedAsyncReader::END_OF_FILE:
 			debug_msg("End of file\n");
 			_callback->dispatch(BGPPacket::CONNECTION_CLOSED, 0, 0, this);
 			break;
@@ -425,6 +411,31 @@ SocketClient::send_message(const uint8_t* buf,
 	return true;
 }
 
+	bool
+SocketClient::send_message(vector<uint8_t>& data,
+		SendCompleteCallback cb)
+{
+	debug_msg("peer %s bytes = %u\n", get_remote_host(),
+			XORP_UINT_CAST(data.size()));
+
+	if(!is_connected()) 
+	{
+		XLOG_WARNING("sending message to %s, not connected!!!",
+				get_remote_addr().c_str());
+		return false;
+	}
+
+	XLOG_ASSERT(_async_writer);
+
+	_async_writer->add_data_swap(data,
+			callback(this,
+				&SocketClient::send_message_complete,
+				cb));
+	_async_writer->start();
+
+	return true;
+}
+
 bool 
 SocketClient::output_queue_busy() const 
 {
@@ -597,7 +608,7 @@ SocketClient::async_add(XorpFd sock)
 		XLOG_FATAL("Failed to go non-blocking");
 
 	XLOG_ASSERT(0 == _async_writer);
-	_async_writer = new AsyncFileWriter(sock);
+	_async_writer = new AsyncFileWriter(sock, WRITE_COALESCE);
 
 	XLOG_ASSERT(0 == _async_reader);
 	//
@@ -606,10 +617,12 @@ SocketClient::async_add(XorpFd sock)
 	// Also, the priority is lower than the tasks' background priority
 	// to avoid being overloaded by high volume data from the peers.
 	//
-	_async_reader = new AsyncFileReader( sock,
+	_async_reader = new BufferedAsyncReader(sock, READ_BUFFER_BYTES,
+			callback(this,
+				&SocketClient::async_read_message),
 			XorpTask::PRIORITY_BACKGROUND);
-
-	async_read_start();
+	_async_reader->set_trigger_bytes(BGPPacket::COMMON_HEADER_LEN);
+	_async_reader->start();
 }
 
 	void 
@@ -631,7 +644,6 @@ SocketClient::async_remove_reader()
 	if (_async_reader) 
 	{
 		_async_reader->stop();
-		_async_reader->flush_buffers();
 		delete _async_reader;
 		_async_reader = 0;
 	}
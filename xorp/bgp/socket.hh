@@ -30,6 +30,7 @@
 #include "libxorp/xorpfd.hh"
 #include "libxorp/eventloop.hh"
 #include "libxorp/asyncio.hh"
+#include "libxorp/buffered_asyncio.hh"
 #include "libxorp/callback.hh"
 
 #ifdef HAVE_NETDB_H
@@ -223,6 +224,21 @@ class SocketClient : public Socket
 				size_t cnt, 
 				SendCompleteCallback cb);
 
+		/**
+		 * Asynchronously Send a message, taking over its data.
+		 *
+		 * The data is held by the writer, so the callback must not
+		 * free the pointer it is passed.
+		 *
+		 * @param data the message, which is empty on return if the
+		 * message is accepted.
+		 * @param cb notification of success or failure.
+		 *
+		 * @return true if the message is accepted.
+		 */
+		bool send_message(vector<uint8_t>& data,
+				SendCompleteCallback cb);
+
 		/**
 		 * Flow control signal. 
 		 *
@@ -269,22 +285,32 @@ class SocketClient : public Socket
 				const size_t offset,
 				SendCompleteCallback cb);
 
-		void async_read_start(size_t cnt = BGPPacket::COMMON_HEADER_LEN,
-				size_t ofset = 0);
-		void async_read_message(AsyncFileWriter::Event ev,
-				const uint8_t *buf,
-				const size_t buf_bytes,
-				const size_t offset);
+		void async_read_message(BufferedAsyncReader* reader,
+				BufferedAsyncReader::Event ev,
+				uint8_t *buf,
+				size_t buf_bytes);
+
+		/*
+		 ** Size of the receive buffer, enough to hold several
+		 ** maximum sized messages so that a single read() can
+		 ** pick up a burst of UPDATEs.
+		 */
+		static const size_t READ_BUFFER_BYTES =
+			16 * BGPPacket::MAXPACKETSIZE;
+
+		/*
+		 ** Number of queued messages that may be sent with a
+		 ** single writev().
+		 */
+		static const uint32_t WRITE_COALESCE = 64;
 
 		MessageCallback _callback;
 		AsyncFileWriter *_async_writer;
-		AsyncFileReader *_async_reader;
+		BufferedAsyncReader *_async_reader;
 
 		bool _disconnecting;
 		bool _connecting;
 		bool _md5sig;
-
-		uint8_t _read_buf[BGPPacket::MAXPACKETSIZE]; // Maximum allowed BGP message
 };
 
 class SocketServer : public Socket 
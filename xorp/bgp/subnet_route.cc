@@ -23,6 +23,7 @@
 #include "bgp_module.h"
 #include "libxorp/xlog.h"
 #include "subnet_route.hh"
+#include "bgp_trie.hh"
 
 RouteMetaData::RouteMetaData(const RouteMetaData& metadata)
 {
@@ -261,5 +262,30 @@ SubnetRoute<A>::set_policyfilter(uint32_t i, const RefPf& f) const
     _metadata.set_policyfilter(i, f);
 }
 
+template<class A>
+    void*
+SubnetRoute<A>::operator new(size_t size)
+{
+    XLOG_ASSERT(size <= sizeof(ChainedSubnetRoute<A>));
+    return memory_pool().alloc();
+}
+
+template<class A>
+    void
+SubnetRoute<A>::operator delete(void* ptr)
+{
+    memory_pool().free(ptr);
+}
+
+template<class A>
+    MemoryPool<ChainedSubnetRoute<A> >&
+SubnetRoute<A>::memory_pool()
+{
+    // Never destroyed, routes may still be referenced during shutdown.
+    static MemoryPool<ChainedSubnetRoute<A> >* mp
+	= new MemoryPool<ChainedSubnetRoute<A> >("SubnetRoute");
+    return *mp;
+}
+
 template class SubnetRoute<IPv4>;
 template class SubnetRoute<IPv6>;
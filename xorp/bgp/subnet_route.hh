@@ -28,6 +28,7 @@
 #include "libxorp/xorp.h"
 #include "libxorp/ipv4net.hh"
 #include "libxorp/ipv6net.hh"
+#include "libxorp/memory_pool.hh"
 
 #include "policy/backend/policytags.hh"
 #include "policy/backend/policy_filter.hh"
@@ -55,6 +56,8 @@
 template<class A>
 class SubnetRouteRef;
 template<class A>
+class ChainedSubnetRoute;
+template<class A>
 class SubnetRouteConstRef;
 
 class RouteMetaData 
@@ -638,6 +641,14 @@ class SubnetRoute
 	return _metadata.aggr_prefix_len();
     }
 
+    /**
+     * SubnetRoutes and ChainedSubnetRoutes share one slab pool, with
+     * chunks large enough for a ChainedSubnetRoute.  This is safe even
+     * though unref() deletes through a SubnetRoute pointer.
+     */
+    void* operator new(size_t size);
+    void operator delete(void* ptr);
+
     protected:
     /**
      * @short protected SubnetRoute destructor.
@@ -659,6 +670,8 @@ class SubnetRoute
     // Copyable, but not assignable.
     const SubnetRoute<A>& operator=(const SubnetRoute<A>&);
 
+    static MemoryPool<ChainedSubnetRoute<A> >& memory_pool();
+
     /**
      * _net is the subnet (address and prefix) for this route.
      */
@@ -24,6 +24,10 @@
 // ----------------------------------------------------------------------------
 // Specialized PrintRoutes implementation
 
+// Extract address family specific values from the batched route lists.
+template <typename A> static IPNet<A> atom_net(const XrlAtom& atom);
+template <typename A> static A atom_addr(const XrlAtom& atom);
+
 template <>
 	void
 PrintRoutes<IPv4>::get_route_list_start(IPNet<IPv4> net, bool unicast,
@@ -38,10 +42,24 @@ template <>
 	void
 PrintRoutes<IPv4>::get_route_list_next()
 {
-	send_get_v4_route_list_next("bgp",	_token,
+	send_get_v4_route_list_next_batch("bgp", _token, routes_wanted(),
 			callback(this, &PrintRoutes::get_route_list_next_done));
 }
 
+template <>
+	IPNet<IPv4>
+atom_net<IPv4>(const XrlAtom& atom)
+{
+	return atom.ipv4net();
+}
+
+template <>
+	IPv4
+atom_addr<IPv4>(const XrlAtom& atom)
+{
+	return atom.ipv4();
+}
+
 // ----------------------------------------------------------------------------
 // Common PrintRoutes implementation
 
@@ -136,11 +154,19 @@ PrintRoutes<A>::get_route_list_start_done(const XrlError& e,
 	}
 
 	_token = *token;
-	for (uint32_t i = 0; i < MAX_REQUESTS; i++) 
-	{
-		_active_requests++;
-		get_route_list_next();
-	}
+	_active_requests++;
+	get_route_list_next();
+}
+
+template <typename A>
+	uint32_t
+PrintRoutes<A>::routes_wanted() const
+{
+	// Don't ask for routes beyond the output limit.
+	if (_lines > 0
+			&& static_cast<uint32_t>(_lines) - _count < MAX_ROUTES_PER_REQUEST)
+		return static_cast<uint32_t>(_lines) - _count;
+	return MAX_ROUTES_PER_REQUEST;
 }
 
 // See RFC 1657 (BGP MIB) for full definitions of return values.
@@ -148,37 +174,85 @@ PrintRoutes<A>::get_route_list_start_done(const XrlError& e,
 template <typename A>
 	void
 PrintRoutes<A>::get_route_list_next_done(const XrlError& e,
-		const IPv4* peer_id,
-		const IPNet<A>* net,
-		const uint32_t *best_and_origin,
-		const vector<uint8_t>* aspath,
-		const A* nexthop,
-		const int32_t* med,
-		const int32_t* localpref,
-		const int32_t* atomic_agg,
-		const vector<uint8_t>* aggregator,
-		const int32_t* calc_localpref,
-		const vector<uint8_t>* attr_unknown,
-		const bool* valid,
-		const bool* /*unicast*/,
-		const bool* /*multicast*/)
+		const XrlAtomList* peer_id,
+		const XrlAtomList* net,
+		const XrlAtomList* best_and_origin,
+		const XrlAtomList* aspath,
+		const XrlAtomList* nexthop,
+		const XrlAtomList* med,
+		const XrlAtomList* localpref,
+		const XrlAtomList* atomic_agg,
+		const XrlAtomList* aggregator,
+		const XrlAtomList* /*unicast*/,
+		const XrlAtomList* /*multicast*/,
+		const bool* done)
 {
-	UNUSED(calc_localpref);
-	UNUSED(attr_unknown);
-	UNUSED(aspath);
+	if (e != XrlError::OKAY()) 
+	{
+		_active_requests--;
+		_done = true;
+		return;
+	}
 
-	if (e != XrlError::OKAY() || false == *valid) 
+	XrlAtomList::const_iterator peer_id_iter = peer_id->begin();
+	XrlAtomList::const_iterator net_iter = net->begin();
+	XrlAtomList::const_iterator best_and_origin_iter = best_and_origin->begin();
+	XrlAtomList::const_iterator aspath_iter = aspath->begin();
+	XrlAtomList::const_iterator nexthop_iter = nexthop->begin();
+	XrlAtomList::const_iterator med_iter = med->begin();
+	XrlAtomList::const_iterator localpref_iter = localpref->begin();
+	XrlAtomList::const_iterator atomic_agg_iter = atomic_agg->begin();
+	XrlAtomList::const_iterator aggregator_iter = aggregator->begin();
+
+	for (size_t i = 0; i < net->size(); i++) 
+	{
+		print_route(peer_id_iter->ipv4(),
+				atom_net<A>(*net_iter),
+				best_and_origin_iter->uint32(),
+				aspath_iter->binary(),
+				atom_addr<A>(*nexthop_iter),
+				med_iter->int32(),
+				localpref_iter->int32(),
+				atomic_agg_iter->int32(),
+				aggregator_iter->binary());
+		_count++;
+		++peer_id_iter;
+		++net_iter;
+		++best_and_origin_iter;
+		++aspath_iter;
+		++nexthop_iter;
+		++med_iter;
+		++localpref_iter;
+		++atomic_agg_iter;
+		++aggregator_iter;
+	}
+
+	if (*done || _lines == static_cast<int>(_count)) 
 	{
 		_active_requests--;
 		_done = true;
 		return;
 	}
-	_count++;
 
-	uint8_t best = (*best_and_origin)>>16;
-	uint8_t origin = (*best_and_origin)&255;
+	get_route_list_next();
+}
+
+template <typename A>
+	void
+PrintRoutes<A>::print_route(const IPv4& peer_id,
+		const IPNet<A>& net,
+		uint32_t best_and_origin,
+		const vector<uint8_t>& aspath,
+		const A& nexthop,
+		int32_t med,
+		int32_t localpref,
+		int32_t atomic_agg,
+		const vector<uint8_t>& aggregator)
+{
+	uint8_t best = best_and_origin>>16;
+	uint8_t origin = best_and_origin&255;
 
-	ASPath asp((const uint8_t*)(&((*aspath)[0])), aspath->size());
+	ASPath asp((const uint8_t*)(&aspath[0]), aspath.size());
 
 	switch(_verbose) 
 	{
@@ -199,9 +273,9 @@ PrintRoutes<A>::get_route_list_next_done(const XrlError& e,
 					printf("?");
 			}
 
-			printf(" %-20s  %-25s  %-12s  %s ", net->str().c_str(),
-					nexthop->str().c_str(),
-					peer_id->str().c_str(),
+			printf(" %-20s  %-25s  %-12s  %s ", net.str().c_str(),
+					nexthop.str().c_str(),
+					peer_id.str().c_str(),
 					asp.short_str().c_str());
 
 			switch (origin) 
@@ -221,8 +295,8 @@ PrintRoutes<A>::get_route_list_next_done(const XrlError& e,
 			}
 			break;
 		case DETAIL:
-			printf("%s\n", cstring(*net));
-			printf("\tFrom peer: %s\n", cstring(*peer_id));
+			printf("%s\n", cstring(net));
+			printf("\tFrom peer: %s\n", cstring(peer_id));
 			printf("\tRoute: ");
 			switch (best) 
 			{
@@ -254,25 +328,23 @@ PrintRoutes<A>::get_route_list_next_done(const XrlError& e,
 			}
 
 			printf("\tAS Path: %s\n", asp.short_str().c_str());
-			printf("\tNexthop: %s\n", cstring(*nexthop));
-			if (INVALID != *med)
-				printf("\tMultiple Exit Discriminator: %d\n", *med);
-			if (INVALID != *localpref)
-				printf("\tLocal Preference: %d\n", *localpref);
-			if (2 == *atomic_agg)
+			printf("\tNexthop: %s\n", cstring(nexthop));
+			if (INVALID != med)
+				printf("\tMultiple Exit Discriminator: %d\n", med);
+			if (INVALID != localpref)
+				printf("\tLocal Preference: %d\n", localpref);
+			if (2 == atomic_agg)
 				printf("\tAtomic Aggregate: Less Specific Route Selected\n");
-			if (!aggregator->empty()) 
+			if (!aggregator.empty()) 
 			{
-				XLOG_ASSERT(6 == aggregator->size());
-				A agg(&((*aggregator)[0]));
-				AsNum asnum(&((*aggregator)[4]));
+				XLOG_ASSERT(6 == aggregator.size());
+				A agg(&aggregator[0]);
+				AsNum asnum(&aggregator[4]);
 
 				printf("\tAggregator: %s %s\n", cstring(agg), cstring(asnum));
 			}
 			break;
 	}
-
-	get_route_list_next();
 }
 
 template <typename A>
@@ -303,9 +375,23 @@ template <>
 	void
 PrintRoutes<IPv6>::get_route_list_next()
 {
-	send_get_v6_route_list_next("bgp", _token,
+	send_get_v6_route_list_next_batch("bgp", _token, routes_wanted(),
 			callback(this, &PrintRoutes::get_route_list_next_done));
 }
 
+template <>
+	IPNet<IPv6>
+atom_net<IPv6>(const XrlAtom& atom)
+{
+	return atom.ipv6net();
+}
+
+template <>
+	IPv6
+atom_addr<IPv6>(const XrlAtom& atom)
+{
+	return atom.ipv6();
+}
+
 template class PrintRoutes<IPv6>;
 
@@ -40,7 +40,7 @@ template <typename A>
 class PrintRoutes : public XrlBgpV0p3Client 
 {
 	public:
-		static const uint32_t MAX_REQUESTS = 100;
+		static const uint32_t MAX_ROUTES_PER_REQUEST = 500;
 		static const int32_t INVALID = -1;
 		enum detail_t {SUMMARY, NORMAL, DETAIL};
 		PrintRoutes(detail_t verbose, int interval, IPNet<A> net, bool unicast,
@@ -50,21 +50,29 @@ class PrintRoutes : public XrlBgpV0p3Client
 				const uint32_t* token);
 		void get_route_list_next();
 		void get_route_list_next_done(const XrlError& 	 e,
-				const IPv4* 		 peer_id,
-				const IPNet<A>* 	 net,
-				const uint32_t 	 *best_and_origin,
-				const vector<uint8_t>* aspath,
-				const A* 		 nexthop,
-				const int32_t* 	 med,
-				const int32_t* 	 localpref,
-				const int32_t* 	 atomic_agg,
-				const vector<uint8_t>* aggregator,
-				const int32_t* 	 calc_localpref,
-				const vector<uint8_t>* attr_unknown,
-				const bool* 		 valid,
-				const bool* 		 unicast,
-				const bool* 		 multicast);
+				const XrlAtomList*	 peer_id,
+				const XrlAtomList*	 net,
+				const XrlAtomList*	 best_and_origin,
+				const XrlAtomList*	 aspath,
+				const XrlAtomList*	 nexthop,
+				const XrlAtomList*	 med,
+				const XrlAtomList*	 localpref,
+				const XrlAtomList*	 atomic_agg,
+				const XrlAtomList*	 aggregator,
+				const XrlAtomList*	 unicast,
+				const XrlAtomList*	 multicast,
+				const bool* 		 done);
 	private:
+		void print_route(const IPv4& peer_id,
+				const IPNet<A>& net,
+				uint32_t best_and_origin,
+				const vector<uint8_t>& aspath,
+				const A& nexthop,
+				int32_t med,
+				int32_t localpref,
+				int32_t atomic_agg,
+				const vector<uint8_t>& aggregator);
+		uint32_t routes_wanted() const;
 		void timer_expired();
 
 		XrlStdRouter 	_xrl_rtr;
@@ -0,0 +1,480 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+
+// Copyright (c) 2001-2009 XORP, Inc.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "bgp_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/debug.h"
+#include "libxorp/xlog.h"
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#include "bgp.hh"
+#include "packet.hh"
+#include "update_decoder.hh"
+
+// ----------------------------------------------------------------------------
+// PeerDataSnapshot
+
+PeerDataSnapshot::PeerDataSnapshot(const BGPPeerData& peerdata)
+	: _peerdata(0)
+{
+	_local_data.set_use_4byte_asnums(peerdata.we_use_4byte_asnums());
+	_peerdata = new BGPPeerData(peerdata, _local_data);
+}
+
+PeerDataSnapshot::~PeerDataSnapshot()
+{
+	delete _peerdata;
+}
+
+// ----------------------------------------------------------------------------
+// UpdateDecodeJob
+
+UpdateDecodeJob::UpdateDecodeJob(BGPPeer* peer,
+		const ref_ptr<PeerDataSnapshot>& snapshot,
+		const uint8_t* buf, size_t length, bool decode)
+	: _peer(peer), _snapshot(snapshot), _peerdata(snapshot->peerdata()),
+	_buf(buf, buf + length), _state(decode ? QUEUED : DELIVERED),
+	_packet(0), _error(NONE), _error_code(0), _error_subcode(0)
+{
+}
+
+UpdateDecodeJob::~UpdateDecodeJob()
+{
+	delete _packet;
+}
+
+	void
+UpdateDecodeJob::decode()
+{
+	/*
+	 ** The nexthop checks need the interface state of the main
+	 ** process, they are made later by check_nexthops().
+	 */
+	try
+	{
+		_packet = new UpdatePacket(&_buf[0], _buf.size(), _peerdata, 0,
+				/*do checks*/true);
+		_packet->pa_list()->canonicalize();
+	} catch(CorruptMessage& c)
+	{
+		_error = CORRUPT;
+		_why = c.why();
+		_error_code = c.error();
+		_error_subcode = c.subcode();
+		_error_data.assign(c.data(), c.data() + c.len());
+	} catch(UnusableMessage& um)
+	{
+		_error = UNUSABLE;
+		_why = um.why();
+	} catch(XorpException& e)
+	{
+		/*
+		 ** On the main thread this would have escaped to the event
+		 ** loop, here it would take the whole process down. Treat
+		 ** the message as malformed instead.
+		 */
+		_error = CORRUPT;
+		_why = e.str();
+		_error_code = UPDATEMSGERR;
+		_error_subcode = MALATTRLIST;
+	}
+}
+
+	UpdatePacket&
+UpdateDecodeJob::packet(BGPMain* mainprocess)
+	throw(CorruptMessage, UnusableMessage)
+{
+	XLOG_ASSERT(DELIVERED == _state);
+
+	switch (_error)
+	{
+		case NONE:
+			break;
+		case CORRUPT:
+			check_corrupt_nexthops(mainprocess);
+			xorp_throw(CorruptMessage, _why, _error_code, _error_subcode,
+					_error_data.empty() ? 0 : &_error_data[0],
+					_error_data.size());
+			break;
+		case UNUSABLE:
+			xorp_throw(UnusableMessage, _why);
+			break;
+	}
+
+	XLOG_ASSERT(0 != _packet);
+	check_nexthops(mainprocess);
+
+	return *_packet;
+}
+
+	void
+UpdateDecodeJob::check_nexthops(BGPMain* mainprocess)
+	throw(UnusableMessage)
+{
+	FastPathAttributeList<IPv4>& pa_list = *_packet->pa_list();
+
+	// The same checks as FastPathAttributeList::load_raw_data().
+	PathAttribute* pa = pa_list.find_attribute_by_type(MP_REACH_NLRI);
+	if (pa != 0)
+	{
+		MPReachNLRIAttribute<IPv4>* mp4 =
+			dynamic_cast<MPReachNLRIAttribute<IPv4>*>(pa);
+		if (mp4 && mainprocess->interface_address4(mp4->nexthop()))
+		{
+			XLOG_ERROR("Nexthop in update belongs to this router:\n %s",
+					cstring(pa_list));
+			xorp_throw(UnusableMessage, "Nexthop belongs to this router");
+		}
+
+		MPReachNLRIAttribute<IPv6>* mp6 =
+			dynamic_cast<MPReachNLRIAttribute<IPv6>*>(pa);
+		if (mp6 && mainprocess->interface_address6(mp6->nexthop()))
+		{
+			XLOG_ERROR("Nexthop in update belongs to this router:\n %s",
+					cstring(pa_list));
+			xorp_throw(UnusableMessage, "Nexthop6 belongs to this router");
+		}
+	}
+
+	NextHopAttribute<IPv4>* nh = pa_list.nexthop_att();
+	if (nh != 0 && mainprocess->interface_address4(nh->nexthop()))
+	{
+		XLOG_ERROR("Nexthop in update belongs to this router:\n %s",
+				cstring(nh->nexthop()));
+		xorp_throw(UnusableMessage, "Nexthop belongs to this router");
+	}
+}
+
+/*
+** Our own nexthop in a multiprotocol attribute makes the message
+** unusable, and that is checked before the mandatory attributes. So a
+** message that the worker found corrupt is decoded again, with the
+** interface state, to find whether it is unusable instead.
+*/
+	void
+UpdateDecodeJob::check_corrupt_nexthops(BGPMain* mainprocess)
+	throw(UnusableMessage)
+{
+	try
+	{
+		UpdatePacket pac(&_buf[0], _buf.size(), _peerdata, mainprocess,
+				/*do checks*/true);
+	} catch(UnusableMessage&)
+	{
+		throw;
+	} catch(XorpException&)
+	{
+		// The error found by the worker is raised instead.
+	}
+}
+
+// ----------------------------------------------------------------------------
+// UpdateDecoder
+
+	size_t
+UpdateDecoder::configured_threads()
+{
+#ifdef HAVE_PTHREAD_H
+	const char* threads = getenv("XORP_BGP_DECODE_THREADS");
+	if (threads == NULL)
+		return 0;
+
+	int n = atoi(threads);
+	if (n <= 0)
+		return 0;
+
+	return n;
+#else
+	return 0;
+#endif
+}
+
+#ifdef HAVE_PTHREAD_H
+
+UpdateDecoder::UpdateDecoder(size_t threads)
+	: _stopping(false)
+{
+	int fds[2];
+
+	pthread_mutex_init(&_mutex, NULL);
+	pthread_cond_init(&_work_cond, NULL);
+	pthread_cond_init(&_done_cond, NULL);
+
+	if (pipe(fds) < 0)
+	{
+		XLOG_ERROR("Cannot create pipe, UPDATEs are decoded inline: %s",
+				strerror(errno));
+		return;
+	}
+	for (int i = 0; i < 2; i++)
+	{
+		fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+		fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+	}
+	_notify_read = XorpFd(fds[0]);
+	_notify_write = XorpFd(fds[1]);
+
+	EventLoop::instance().add_ioevent_cb(_notify_read, IOT_READ,
+			callback(this, &UpdateDecoder::notify_event));
+
+	for (size_t i = 0; i < threads; i++)
+	{
+		pthread_t thread;
+		int error = pthread_create(&thread, NULL,
+				&UpdateDecoder::worker_main, this);
+		if (error != 0)
+		{
+			XLOG_ERROR("Cannot create UPDATE decode thread: %s",
+					strerror(error));
+			break;
+		}
+		_threads.push_back(thread);
+	}
+
+	XLOG_INFO("Decoding UPDATEs on %u threads",
+			XORP_UINT_CAST(_threads.size()));
+}
+
+UpdateDecoder::~UpdateDecoder()
+{
+	pthread_mutex_lock(&_mutex);
+	_stopping = true;
+	pthread_cond_broadcast(&_work_cond);
+	pthread_mutex_unlock(&_mutex);
+
+	for (size_t i = 0; i < _threads.size(); i++)
+		pthread_join(_threads[i], NULL);
+
+	// Any jobs left belong to the peers, which delete them.
+	_work.clear();
+	_done.clear();
+
+	if (_notify_read.is_valid())
+	{
+		EventLoop::instance().remove_ioevent_cb(_notify_read, IOT_READ);
+		close(_notify_read);
+		close(_notify_write);
+	}
+
+	pthread_cond_destroy(&_done_cond);
+	pthread_cond_destroy(&_work_cond);
+	pthread_mutex_destroy(&_mutex);
+}
+
+	bool
+UpdateDecoder::running() const
+{
+	return !_threads.empty();
+}
+
+	void
+UpdateDecoder::submit(UpdateDecodeJob* job)
+{
+	XLOG_ASSERT(running());
+	XLOG_ASSERT(UpdateDecodeJob::QUEUED == job->_state);
+
+	pthread_mutex_lock(&_mutex);
+	_work.push_back(job);
+	pthread_cond_signal(&_work_cond);
+	pthread_mutex_unlock(&_mutex);
+}
+
+	void
+UpdateDecoder::wait(UpdateDecodeJob* job)
+{
+	if (job->delivered())
+		return;
+
+	pthread_mutex_lock(&_mutex);
+	while (UpdateDecodeJob::DONE != job->_state)
+		pthread_cond_wait(&_done_cond, &_mutex);
+	_done.remove(job);
+	job->_state = UpdateDecodeJob::DELIVERED;
+	pthread_mutex_unlock(&_mutex);
+}
+
+	void
+UpdateDecoder::cancel(BGPPeer* peer)
+{
+	list<UpdateDecodeJob*>::iterator i;
+
+	pthread_mutex_lock(&_mutex);
+	for (i = _work.begin(); i != _work.end();)
+	{
+		if ((*i)->_peer == peer)
+			i = _work.erase(i);
+		else
+			++i;
+	}
+
+	for (;;)
+	{
+		for (i = _running.begin(); i != _running.end(); ++i)
+			if ((*i)->_peer == peer)
+				break;
+		if (i == _running.end())
+			break;
+		pthread_cond_wait(&_done_cond, &_mutex);
+	}
+
+	for (i = _done.begin(); i != _done.end();)
+	{
+		if ((*i)->_peer == peer)
+			i = _done.erase(i);
+		else
+			++i;
+	}
+	pthread_mutex_unlock(&_mutex);
+}
+
+	void*
+UpdateDecoder::worker_main(void* arg)
+{
+	UpdateDecoder* decoder = reinterpret_cast<UpdateDecoder*>(arg);
+
+	decoder->worker();
+
+	return NULL;
+}
+
+	void
+UpdateDecoder::worker()
+{
+	pthread_mutex_lock(&_mutex);
+	while (!_stopping)
+	{
+		if (_work.empty())
+		{
+			pthread_cond_wait(&_work_cond, &_mutex);
+			continue;
+		}
+
+		UpdateDecodeJob* job = _work.front();
+		_work.pop_front();
+		_running.push_back(job);
+		job->_state = UpdateDecodeJob::RUNNING;
+		pthread_mutex_unlock(&_mutex);
+
+		job->decode();
+
+		pthread_mutex_lock(&_mutex);
+		_running.remove(job);
+		job->_state = UpdateDecodeJob::DONE;
+		bool wake = _done.empty();
+		_done.push_back(job);
+		pthread_cond_broadcast(&_done_cond);
+		pthread_mutex_unlock(&_mutex);
+
+		// The main thread drains _done until it is empty, so it only
+		// needs to be told when the first job arrives.
+		if (wake)
+			notify();
+
+		pthread_mutex_lock(&_mutex);
+	}
+	pthread_mutex_unlock(&_mutex);
+}
+
+	void
+UpdateDecoder::notify()
+{
+	uint8_t wake = 0;
+
+	if (write(_notify_write, &wake, sizeof(wake)) < 0 && errno != EAGAIN)
+		XLOG_ERROR("Cannot wake the main thread: %s", strerror(errno));
+}
+
+	void
+UpdateDecoder::notify_event(XorpFd fd, IoEventType type)
+{
+	uint8_t buf[64];
+
+	XLOG_ASSERT(fd == _notify_read);
+	XLOG_ASSERT(IOT_READ == type);
+
+	while (read(_notify_read, buf, sizeof(buf)) > 0)
+		;
+
+	/*
+	 ** Jobs are taken off _done one at a time, processing a job may
+	 ** cancel the jobs of any peer.
+	 */
+	for (size_t n = 0; n < MAX_DELIVERED; n++)
+	{
+		pthread_mutex_lock(&_mutex);
+		if (_done.empty())
+		{
+			pthread_mutex_unlock(&_mutex);
+			return;
+		}
+		UpdateDecodeJob* job = _done.front();
+		_done.pop_front();
+		job->_state = UpdateDecodeJob::DELIVERED;
+		pthread_mutex_unlock(&_mutex);
+
+		job->_peer->process_decoded();
+	}
+
+	// Let other work run, and come back for the rest.
+	notify();
+}
+
+#else // ! HAVE_PTHREAD_H
+
+UpdateDecoder::UpdateDecoder(size_t threads)
+	: _stopping(false)
+{
+	UNUSED(threads);
+}
+
+UpdateDecoder::~UpdateDecoder()
+{
+}
+
+	bool
+UpdateDecoder::running() const
+{
+	return false;
+}
+
+	void
+UpdateDecoder::submit(UpdateDecodeJob* job)
+{
+	UNUSED(job);
+	XLOG_UNREACHABLE();
+}
+
+	void
+UpdateDecoder::wait(UpdateDecodeJob* job)
+{
+	UNUSED(job);
+	XLOG_UNREACHABLE();
+}
+
+	void
+UpdateDecoder::cancel(BGPPeer* peer)
+{
+	UNUSED(peer);
+}
+
+#endif // HAVE_PTHREAD_H
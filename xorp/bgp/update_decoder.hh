@@ -0,0 +1,219 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+
+// Copyright (c) 2001-2009 XORP, Inc.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __BGP_UPDATE_DECODER_HH__
+#define __BGP_UPDATE_DECODER_HH__
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+#include "libxorp/eventloop.hh"
+#include "libxorp/ref_ptr.hh"
+
+#include "exceptions.hh"
+#include "local_data.hh"
+
+class BGPMain;
+class BGPPeer;
+class BGPPeerData;
+class UpdatePacket;
+
+/**
+ * @short A copy of the state of a peering that worker threads can read.
+ *
+ * The copy has a private LocalData that holds only the 4-byte AS
+ * setting. It is never changed once made: a peer makes a new copy when
+ * its state changes, and the jobs already queued keep the old one.
+ */
+class PeerDataSnapshot : public NONCOPYABLE
+{
+	public:
+		PeerDataSnapshot(const BGPPeerData& peerdata);
+		~PeerDataSnapshot();
+
+		const BGPPeerData* peerdata() const	{ return _peerdata; }
+
+	private:
+		LocalData		_local_data;
+		const BGPPeerData*	_peerdata;
+};
+
+/**
+ * @short A message received from a peer, held while earlier UPDATEs
+ * from the same peer are decoded.
+ *
+ * An UPDATE job is decoded on a worker thread, any other message is
+ * only held so that it is processed in the order it arrived.
+ */
+class UpdateDecodeJob : public NONCOPYABLE
+{
+	public:
+		UpdateDecodeJob(BGPPeer* peer,
+				const ref_ptr<PeerDataSnapshot>& snapshot,
+				const uint8_t* buf, size_t length, bool decode);
+		~UpdateDecodeJob();
+
+		const uint8_t* data() const		{ return &_buf[0]; }
+		size_t length() const			{ return _buf.size(); }
+
+		/**
+		 * @return true once the job can be processed by the peer.
+		 */
+		bool delivered() const			{ return _state == DELIVERED; }
+
+		/**
+		 * Get the decoded UPDATE, on the main thread.
+		 *
+		 * The checks that need the state of the main process, such as
+		 * whether the nexthop is one of our addresses, are made here.
+		 *
+		 * @param mainprocess the main process.
+		 * @return the decoded packet.
+		 * @throw the exception raised when the message was decoded.
+		 */
+		UpdatePacket& packet(BGPMain* mainprocess)
+			throw(CorruptMessage, UnusableMessage);
+
+	private:
+		friend class UpdateDecoder;
+
+		enum State
+		{
+			QUEUED,		// Waiting for a worker.
+			RUNNING,	// Being decoded by a worker.
+			DONE,		// Decoded, waiting for the main thread.
+			DELIVERED	// Handed to the peer.
+		};
+
+		enum Error
+		{
+			NONE,
+			CORRUPT,
+			UNUSABLE
+		};
+
+		/**
+		 * Decode the UPDATE and canonicalise its attributes, on a
+		 * worker thread.
+		 */
+		void decode();
+
+		void check_nexthops(BGPMain* mainprocess)
+			throw(UnusableMessage);
+
+		void check_corrupt_nexthops(BGPMain* mainprocess)
+			throw(UnusableMessage);
+
+		BGPPeer*		_peer;
+
+		// The peer state when the job was queued, the worker can't
+		// read the state of the peer itself.
+		ref_ptr<PeerDataSnapshot> _snapshot;
+		const BGPPeerData*	_peerdata;
+		vector<uint8_t>		_buf;
+		State			_state;
+		UpdatePacket*		_packet;
+
+		// A decode error, rethrown on the main thread.
+		Error			_error;
+		string			_why;
+		int			_error_code;
+		int			_error_subcode;
+		vector<uint8_t>		_error_data;
+};
+
+/**
+ * @short A pool of threads that decode UPDATE messages.
+ *
+ * Decoding an UPDATE, validating it and canonicalising its path
+ * attributes do not touch any state shared between peers, so they are
+ * done off the main thread. Everything else, including interning the
+ * attributes, stays on the main thread.
+ *
+ * Jobs may finish out of order, a peer only processes the head of its
+ * queue of jobs so that its messages are handled in arrival order.
+ * Finished jobs are handed back from the event loop by calling
+ * BGPPeer::process_decoded().
+ */
+class UpdateDecoder : public NONCOPYABLE
+{
+	public:
+		/**
+		 * @param threads the number of worker threads.
+		 */
+		UpdateDecoder(size_t threads);
+		~UpdateDecoder();
+
+		/**
+		 * @return the number of worker threads set in the environment
+		 * variable XORP_BGP_DECODE_THREADS, zero if decoding on worker
+		 * threads is disabled or not supported.
+		 */
+		static size_t configured_threads();
+
+		/**
+		 * @return true if the worker threads are running.
+		 */
+		bool running() const;
+
+		/**
+		 * Queue a job for decoding.
+		 */
+		void submit(UpdateDecodeJob* job);
+
+		/**
+		 * Wait until a job has been decoded, and mark it delivered.
+		 */
+		void wait(UpdateDecodeJob* job);
+
+		/**
+		 * Take all the jobs of a peer away from the workers. On
+		 * return no worker refers to the peer and its jobs may be
+		 * deleted.
+		 */
+		void cancel(BGPPeer* peer);
+
+	private:
+		static void* worker_main(void* arg);
+		void worker();
+		void notify_event(XorpFd fd, IoEventType type);
+		void notify();
+
+		/*
+		 ** Number of decoded jobs handed back in one call from the
+		 ** event loop.
+		 */
+		static const size_t MAX_DELIVERED = 64;
+
+		list<UpdateDecodeJob*>	_work;		// Waiting for a worker.
+		list<UpdateDecodeJob*>	_running;	// Being decoded.
+		list<UpdateDecodeJob*>	_done;		// Waiting for the main thread.
+		bool			_stopping;
+		XorpFd			_notify_read;
+		XorpFd			_notify_write;
+#ifdef HAVE_PTHREAD_H
+		pthread_mutex_t		_mutex;
+		pthread_cond_t		_work_cond;	// _work is not empty.
+		pthread_cond_t		_done_cond;	// A job has been decoded.
+		vector<pthread_t>	_threads;
+#endif
+};
+
+#endif // __BGP_UPDATE_DECODER_HH__
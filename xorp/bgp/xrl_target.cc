@@ -1168,6 +1168,77 @@ XrlBgpTarget::bgp_0_3_register_rib(
     return XrlCmdError::OKAY();
 }
 
+/**
+ * The largest number of routes returned by a single
+ * get_route_list_next_batch call, irrespective of what was asked for.
+ */
+static const uint32_t MAX_ROUTE_LIST_BATCH = 1000;
+
+template <typename A>
+static void
+get_route_list_batch(BGPMain& bgp,
+	// Input values,
+	uint32_t token,
+	uint32_t max_routes,
+	// Output values,
+	XrlAtomList& peer_id_list,
+	XrlAtomList& net_list,
+	XrlAtomList& best_and_origin_list,
+	XrlAtomList& aspath_list,
+	XrlAtomList& nexthop_list,
+	XrlAtomList& med_list,
+	XrlAtomList& localpref_list,
+	XrlAtomList& atomic_agg_list,
+	XrlAtomList& aggregator_list,
+	XrlAtomList& unicast_list,
+	XrlAtomList& multicast_list,
+	bool& done)
+{
+    if (max_routes > MAX_ROUTE_LIST_BATCH)
+	max_routes = MAX_ROUTE_LIST_BATCH;
+
+    done = false;
+
+    for (uint32_t count = 0; count < max_routes; count++) 
+    {
+	IPv4 peer_id;
+	IPNet<A> net;
+	uint32_t origin;
+	vector<uint8_t> aspath;
+	A nexthop;
+	int32_t med, localpref, atomic_agg, calc_localpref;
+	vector<uint8_t> aggregator, attr_unknown;
+	bool best = false;
+	bool unicast = false, multicast = false;
+
+	if (!bgp.get_route_list_next<A>(token, peer_id, net, origin, aspath,
+		    nexthop, med, localpref, atomic_agg,
+		    aggregator, calc_localpref,
+		    attr_unknown, best, unicast,
+		    multicast)) 
+	{
+	    done = true;
+	    break;
+	}
+
+	//same trivial encoding as get_route_list_next
+	uint32_t best_and_origin = ((best ? 2 : 1) << 16) | origin;
+
+	peer_id_list.append(XrlAtom(peer_id));
+	net_list.append(XrlAtom(net));
+	best_and_origin_list.append(XrlAtom(best_and_origin));
+	aspath_list.append(XrlAtom(aspath));
+	nexthop_list.append(XrlAtom(nexthop));
+	med_list.append(XrlAtom(med));
+	localpref_list.append(XrlAtom(localpref));
+	atomic_agg_list.append(XrlAtom(atomic_agg));
+	aggregator_list.append(XrlAtom(aggregator));
+	// A batch may run from the unicast into the multicast routes.
+	unicast_list.append(XrlAtom(unicast));
+	multicast_list.append(XrlAtom(multicast));
+    }
+}
+
 XrlCmdError
 XrlBgpTarget::bgp_0_3_get_v4_route_list_start(
 	// Input values,
@@ -1235,6 +1306,36 @@ XrlBgpTarget::bgp_0_3_get_v4_route_list_next(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlBgpTarget::bgp_0_3_get_v4_route_list_next_batch(
+	// Input values,
+	const uint32_t&	token,
+	const uint32_t&	max_routes,
+	// Output values,
+	XrlAtomList&	peer_id,
+	XrlAtomList&	net,
+	XrlAtomList&	best_and_origin,
+	XrlAtomList&	aspath,
+	XrlAtomList&	nexthop,
+	XrlAtomList&	med,
+	XrlAtomList&	localpref,
+	XrlAtomList&	atomic_agg,
+	XrlAtomList&	aggregator,
+	XrlAtomList&	unicast,
+	XrlAtomList&	multicast,
+	bool&	done)
+{
+    debug_msg("token %u max_routes %u\n",
+	    XORP_UINT_CAST(token), XORP_UINT_CAST(max_routes));
+
+    get_route_list_batch<IPv4>(_bgp, token, max_routes,
+	    peer_id, net, best_and_origin, aspath, nexthop,
+	    med, localpref, atomic_agg, aggregator,
+	    unicast, multicast, done);
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError XrlBgpTarget::rib_client_0_1_route_info_changed4(
 	// Input values, 
 	const IPv4& addr,
@@ -1666,6 +1767,36 @@ XrlBgpTarget::bgp_0_3_get_v6_route_list_next(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlBgpTarget::bgp_0_3_get_v6_route_list_next_batch(
+	// Input values,
+	const uint32_t&	token,
+	const uint32_t&	max_routes,
+	// Output values,
+	XrlAtomList&	peer_id,
+	XrlAtomList&	net,
+	XrlAtomList&	best_and_origin,
+	XrlAtomList&	aspath,
+	XrlAtomList&	nexthop,
+	XrlAtomList&	med,
+	XrlAtomList&	localpref,
+	XrlAtomList&	atomic_agg,
+	XrlAtomList&	aggregator,
+	XrlAtomList&	unicast,
+	XrlAtomList&	multicast,
+	bool&	done)
+{
+    debug_msg("token %u max_routes %u\n",
+	    XORP_UINT_CAST(token), XORP_UINT_CAST(max_routes));
+
+    get_route_list_batch<IPv6>(_bgp, token, max_routes,
+	    peer_id, net, best_and_origin, aspath, nexthop,
+	    med, localpref, atomic_agg, aggregator,
+	    unicast, multicast, done);
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError XrlBgpTarget::rib_client_0_1_route_info_changed6(
 	// Input values, 
 	const IPv6&	addr, 
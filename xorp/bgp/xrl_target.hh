@@ -383,6 +383,24 @@ class XrlBgpTarget :  XrlBgpTargetBase
 				bool& unicast,
 				bool& multicast);
 
+		XrlCmdError bgp_0_3_get_v4_route_list_next_batch(
+				// Input values,
+				const uint32_t&	token,
+				const uint32_t&	max_routes,
+				// Output values,
+				XrlAtomList&	peer_id,
+				XrlAtomList&	net,
+				XrlAtomList&	best_and_origin,
+				XrlAtomList&	aspath,
+				XrlAtomList&	nexthop,
+				XrlAtomList&	med,
+				XrlAtomList&	localpref,
+				XrlAtomList&	atomic_agg,
+				XrlAtomList&	aggregator,
+				XrlAtomList&	unicast,
+				XrlAtomList&	multicast,
+				bool&	done);
+
 		XrlCmdError rib_client_0_1_route_info_changed4(
 				// Input values,
 				const IPv4&	addr,
@@ -502,6 +520,24 @@ class XrlBgpTarget :  XrlBgpTargetBase
 				bool& unicast,
 				bool& multicast);
 
+		XrlCmdError bgp_0_3_get_v6_route_list_next_batch(
+				// Input values,
+				const uint32_t&	token,
+				const uint32_t&	max_routes,
+				// Output values,
+				XrlAtomList&	peer_id,
+				XrlAtomList&	net,
+				XrlAtomList&	best_and_origin,
+				XrlAtomList&	aspath,
+				XrlAtomList&	nexthop,
+				XrlAtomList&	med,
+				XrlAtomList&	localpref,
+				XrlAtomList&	atomic_agg,
+				XrlAtomList&	aggregator,
+				XrlAtomList&	unicast,
+				XrlAtomList&	multicast,
+				bool&	done);
+
 		XrlCmdError rib_client_0_1_route_info_changed6(
 				// Input values,
 				const IPv6&	addr,
@@ -81,6 +81,24 @@ const string FirewallSetNetfilter::_netfilter_chain_input = "INPUT";
 const string FirewallSetNetfilter::_netfilter_chain_forward = "FORWARD";
 const string FirewallSetNetfilter::_netfilter_chain_output = "OUTPUT";
 
+//
+// The maximum size of an encoded entry: the entry, the TCP or UDP port
+// match, and the target.
+//
+// XXX: the target size is aligned with XT_ALIGN(), which may be larger
+// than _ALIGN().
+//
+static const size_t ENTRY_MAX_SIZE4 =
+    _ALIGN(sizeof(struct ipt_entry))
+    + _ALIGN(sizeof(struct ipt_entry_match))
+    + _ALIGN(sizeof(struct ipt_tcp)) + _ALIGN(sizeof(struct ipt_udp))
+    + XT_ALIGN(sizeof(struct ipt_standard_target));
+static const size_t ENTRY_MAX_SIZE6 =
+    _ALIGN(sizeof(struct ip6t_entry))
+    + _ALIGN(sizeof(struct ip6t_entry_match))
+    + _ALIGN(sizeof(struct ip6t_tcp)) + _ALIGN(sizeof(struct ip6t_udp))
+    + XT_ALIGN(sizeof(struct ip6t_standard_target));
+
 //
 // Local IPv4 structures
 //
@@ -146,6 +164,8 @@ struct local_ipv6_iptcb_chain_error
 : FirewallSet(fea_data_plane_manager),
     _s4(-1),
     _s6(-1),
+    _is_modified4(false),
+    _is_modified6(false),
     _num_entries(0),
     _head_offset(0),
     _foot_offset(0)
@@ -261,8 +281,6 @@ FirewallSetNetfilter::update_entries(
 	string& error_msg)
 {
     list<FirewallEntry>::const_iterator iter;
-    bool has_ipv4 = false;
-    bool has_ipv6 = false;
 
     //
     // The entries to add
@@ -272,10 +290,6 @@ FirewallSetNetfilter::update_entries(
 	    ++iter) 
     {
 	const FirewallEntry& firewall_entry = *iter;
-	if (firewall_entry.is_ipv4())
-	    has_ipv4 = true;
-	if (firewall_entry.is_ipv6())
-	    has_ipv6 = true;
 	if (add_entry(firewall_entry, error_msg) != XORP_OK)
 	    return (XORP_ERROR);
     }
@@ -288,10 +302,6 @@ FirewallSetNetfilter::update_entries(
 	    ++iter) 
     {
 	const FirewallEntry& firewall_entry = *iter;
-	if (firewall_entry.is_ipv4())
-	    has_ipv4 = true;
-	if (firewall_entry.is_ipv6())
-	    has_ipv6 = true;
 	if (replace_entry(firewall_entry, error_msg) != XORP_OK)
 	    return (XORP_ERROR);
     }
@@ -304,23 +314,22 @@ FirewallSetNetfilter::update_entries(
 	    ++iter) 
     {
 	const FirewallEntry& firewall_entry = *iter;
-	if (firewall_entry.is_ipv4())
-	    has_ipv4 = true;
-	if (firewall_entry.is_ipv6())
-	    has_ipv6 = true;
 	if (delete_entry(firewall_entry, error_msg) != XORP_OK)
 	    return (XORP_ERROR);
     }
 
     //
-    // Push the entries
+    // Push the entries.
     //
-    if (has_ipv4) 
+    // XXX: NETFILTER can only replace the whole table, hence the
+    // table is pushed only if any of its entries was modified.
+    //
+    if (_is_modified4) 
     {
 	if (push_entries4(error_msg) != XORP_OK)
 	    return (XORP_ERROR);
     }
-    if (has_ipv6) 
+    if (_is_modified6) 
     {
 	if (push_entries6(error_msg) != XORP_OK)
 	    return (XORP_ERROR);
@@ -334,10 +343,31 @@ FirewallSetNetfilter::set_table4(const list<FirewallEntry>& firewall_entry_list,
 	string& error_msg)
 {
     list<FirewallEntry> empty_list;
+    list<FirewallEntry> deleted_entries;
+    list<FirewallEntry>::const_iterator iter;
+    FirewallTrie::const_iterator trie_iter;
+    set<uint32_t> rule_numbers;
 
-    _firewall_entries4.clear();
+    //
+    // Delete only the entries that are not in the new table. The other
+    // entries are replaced, and an entry that is not modified doesn't
+    // modify the table.
+    //
+    for (iter = firewall_entry_list.begin();
+	    iter != firewall_entry_list.end();
+	    ++iter) 
+    {
+	rule_numbers.insert(iter->rule_number());
+    }
+    for (trie_iter = _firewall_entries4.begin();
+	    trie_iter != _firewall_entries4.end();
+	    ++trie_iter) 
+    {
+	if (rule_numbers.find(trie_iter->first) == rule_numbers.end())
+	    deleted_entries.push_back(trie_iter->second);
+    }
 
-    return (update_entries(firewall_entry_list, empty_list, empty_list,
+    return (update_entries(firewall_entry_list, empty_list, deleted_entries,
 		error_msg));
 }
 
@@ -346,10 +376,31 @@ FirewallSetNetfilter::set_table6(const list<FirewallEntry>& firewall_entry_list,
 	string& error_msg)
 {
     list<FirewallEntry> empty_list;
+    list<FirewallEntry> deleted_entries;
+    list<FirewallEntry>::const_iterator iter;
+    FirewallTrie::const_iterator trie_iter;
+    set<uint32_t> rule_numbers;
 
-    _firewall_entries6.clear();
+    //
+    // Delete only the entries that are not in the new table. The other
+    // entries are replaced, and an entry that is not modified doesn't
+    // modify the table.
+    //
+    for (iter = firewall_entry_list.begin();
+	    iter != firewall_entry_list.end();
+	    ++iter) 
+    {
+	rule_numbers.insert(iter->rule_number());
+    }
+    for (trie_iter = _firewall_entries6.begin();
+	    trie_iter != _firewall_entries6.end();
+	    ++trie_iter) 
+    {
+	if (rule_numbers.find(trie_iter->first) == rule_numbers.end())
+	    deleted_entries.push_back(trie_iter->second);
+    }
 
-    return (update_entries(firewall_entry_list, empty_list, empty_list,
+    return (update_entries(firewall_entry_list, empty_list, deleted_entries,
 		error_msg));
 }
 
@@ -357,6 +408,8 @@ FirewallSetNetfilter::set_table6(const list<FirewallEntry>& firewall_entry_list,
 FirewallSetNetfilter::delete_all_entries4(string& error_msg)
 {
     _firewall_entries4.clear();
+    _encoded_entries4.clear();
+    _is_modified4 = true;
 
     return (push_entries4(error_msg));
 }
@@ -365,6 +418,8 @@ FirewallSetNetfilter::delete_all_entries4(string& error_msg)
 FirewallSetNetfilter::delete_all_entries6(string& error_msg)
 {
     _firewall_entries6.clear();
+    _encoded_entries6.clear();
+    _is_modified6 = true;
 
     return (push_entries6(error_msg));
 }
@@ -375,14 +430,43 @@ FirewallSetNetfilter::add_entry(const FirewallEntry& firewall_entry,
 {
     FirewallTrie::iterator iter;
     FirewallTrie* ftp = NULL;
+    EncodedEntryTrie::iterator encoded_iter;
+    EncodedEntryTrie* etp = NULL;
+    bool* is_modified = NULL;
     uint32_t key = firewall_entry.rule_number();  // XXX: the map key
+    vector<uint8_t> encoded_entry;
+    size_t encoded_size = 0;
 
-    UNUSED(error_msg);
-
-    if (firewall_entry.is_ipv4())
+    //
+    // Encode the entry
+    //
+    if (firewall_entry.is_ipv4()) 
+    {
 	ftp = &_firewall_entries4;
-    else
+	etp = &_encoded_entries4;
+	is_modified = &_is_modified4;
+	encoded_entry.resize(ENTRY_MAX_SIZE4, 0);
+	if (encode_entry4(firewall_entry, encoded_entry, encoded_size,
+		    error_msg)
+		!= XORP_OK) 
+	{
+	    return (XORP_ERROR);
+	}
+    } else 
+    {
 	ftp = &_firewall_entries6;
+	etp = &_encoded_entries6;
+	is_modified = &_is_modified6;
+	encoded_entry.resize(ENTRY_MAX_SIZE6, 0);
+	if (encode_entry6(firewall_entry, encoded_entry, encoded_size,
+		    error_msg)
+		!= XORP_OK) 
+	{
+	    return (XORP_ERROR);
+	}
+    }
+    XLOG_ASSERT(encoded_size <= encoded_entry.size());
+    encoded_entry.resize(encoded_size);
 
     //
     // XXX: If the entry already exists, then just update it.
@@ -398,6 +482,17 @@ FirewallSetNetfilter::add_entry(const FirewallEntry& firewall_entry,
 	fe_tmp = firewall_entry;
     }
 
+    encoded_iter = etp->find(key);
+    if (encoded_iter == etp->end()) 
+    {
+	etp->insert(make_pair(key, encoded_entry));
+	*is_modified = true;
+    } else if (encoded_iter->second != encoded_entry) 
+    {
+	encoded_iter->second.swap(encoded_entry);
+	*is_modified = true;
+    }
+
     return (XORP_OK);
 }
 
@@ -418,12 +513,21 @@ FirewallSetNetfilter::delete_entry(const FirewallEntry& firewall_entry,
 {
     FirewallTrie::iterator iter;
     FirewallTrie* ftp = NULL;
+    EncodedEntryTrie* etp = NULL;
+    bool* is_modified = NULL;
     uint32_t key = firewall_entry.rule_number();  // XXX: the map key
 
-    if (firewall_entry.is_ipv4())
+    if (firewall_entry.is_ipv4()) 
+    {
 	ftp = &_firewall_entries4;
-    else
+	etp = &_encoded_entries4;
+	is_modified = &_is_modified4;
+    } else 
+    {
 	ftp = &_firewall_entries6;
+	etp = &_encoded_entries6;
+	is_modified = &_is_modified6;
+    }
 
     // Find the entry
     iter = ftp->find(key);
@@ -433,6 +537,8 @@ FirewallSetNetfilter::delete_entry(const FirewallEntry& firewall_entry,
 	return (XORP_ERROR);
     }
     ftp->erase(iter);
+    etp->erase(key);
+    *is_modified = true;
 
     return (XORP_OK);
 }
@@ -440,6 +546,7 @@ FirewallSetNetfilter::delete_entry(const FirewallEntry& firewall_entry,
     int
 FirewallSetNetfilter::push_entries4(string& error_msg)
 {
+    EncodedEntryTrie::const_iterator iter;
     vector<uint8_t> buffer;
     size_t size;
     size_t next_data_index = 0;
@@ -449,10 +556,13 @@ FirewallSetNetfilter::push_entries4(string& error_msg)
     //
     // Calculate the required buffer space and allocate the buffer
     //
-    size = _ALIGN(sizeof(struct ipt_entry))
-	+ _ALIGN(sizeof(struct ipt_entry_match))
-	+ _ALIGN(sizeof(struct ipt_standard_target));
-    size *= _firewall_entries4.size();
+    size = 0;
+    for (iter = _encoded_entries4.begin();
+	    iter != _encoded_entries4.end();
+	    ++iter) 
+    {
+	size += iter->second.size();
+    }
     size += _ALIGN(sizeof(struct ipt_replace));
     size += 3 * _ALIGN(sizeof(struct local_ipv4_iptcb_chain_start));
     size += 3 * _ALIGN(sizeof(struct local_ipv4_iptcb_chain_foot));
@@ -569,12 +679,15 @@ FirewallSetNetfilter::push_entries4(string& error_msg)
 	return (XORP_ERROR);
     }
 
+    _is_modified4 = false;
+
     return (XORP_OK);
 }
 
     int
 FirewallSetNetfilter::push_entries6(string& error_msg)
 {
+    EncodedEntryTrie::const_iterator iter;
     vector<uint8_t> buffer;
     size_t size;
     size_t next_data_index = 0;
@@ -584,10 +697,13 @@ FirewallSetNetfilter::push_entries6(string& error_msg)
     //
     // Calculate the required buffer space and allocate the buffer
     //
-    size = _ALIGN(sizeof(struct ip6t_entry))
-	+ _ALIGN(sizeof(struct ip6t_entry_match))
-	+ _ALIGN(sizeof(struct ip6t_standard_target));
-    size *= _firewall_entries6.size();
+    size = 0;
+    for (iter = _encoded_entries6.begin();
+	    iter != _encoded_entries6.end();
+	    ++iter) 
+    {
+	size += iter->second.size();
+    }
     size += _ALIGN(sizeof(struct ip6t_replace));
     size += 3 * _ALIGN(sizeof(struct local_ipv6_iptcb_chain_start));
     size += 3 * _ALIGN(sizeof(struct local_ipv6_iptcb_chain_foot));
@@ -707,6 +823,8 @@ FirewallSetNetfilter::push_entries6(string& error_msg)
 	return (XORP_ERROR);
     }
 
+    _is_modified6 = false;
+
     return (XORP_OK);
 }
 
@@ -718,6 +836,8 @@ FirewallSetNetfilter::encode_chain4(const string& chain_name,
 {
     uint8_t* ptr;
 
+    UNUSED(error_msg);
+
     //
     // Add the chain header for user-defined chains
     //
@@ -749,22 +869,22 @@ FirewallSetNetfilter::encode_chain4(const string& chain_name,
     }
 
     //
-    // Encode all entries one-by-one if the FORWARD chain
+    // Copy all encoded entries if the FORWARD chain
     //
     if (chain_name == _netfilter_chain_forward) 
     {
-	FirewallTrie::const_iterator iter;
-	for (iter = _firewall_entries4.begin();
-		iter != _firewall_entries4.end();
+	EncodedEntryTrie::const_iterator iter;
+	for (iter = _encoded_entries4.begin();
+		iter != _encoded_entries4.end();
 		++iter) 
 	{
-	    const FirewallEntry& firewall_entry = iter->second;
-	    if (encode_entry4(firewall_entry, buffer, next_data_index,
-			error_msg)
-		    != XORP_OK) 
-	    {
-		return (XORP_ERROR);
-	    }
+	    const vector<uint8_t>& encoded_entry = iter->second;
+	    XLOG_ASSERT(next_data_index + encoded_entry.size()
+		    <= buffer.size());
+	    memcpy(&buffer[next_data_index], &encoded_entry[0],
+		    encoded_entry.size());
+	    next_data_index += encoded_entry.size();
+	    _num_entries++;
 	}
     }
 
@@ -805,6 +925,8 @@ FirewallSetNetfilter::encode_chain6(const string& chain_name,
 {
     uint8_t* ptr;
 
+    UNUSED(error_msg);
+
     //
     // Add the chain header for user-defined chains
     //
@@ -836,22 +958,22 @@ FirewallSetNetfilter::encode_chain6(const string& chain_name,
     }
 
     //
-    // Encode all entries one-by-one if the FORWARD chain
+    // Copy all encoded entries if the FORWARD chain
     //
     if (chain_name == _netfilter_chain_forward) 
     {
-	FirewallTrie::const_iterator iter;
-	for (iter = _firewall_entries6.begin();
-		iter != _firewall_entries6.end();
+	EncodedEntryTrie::const_iterator iter;
+	for (iter = _encoded_entries6.begin();
+		iter != _encoded_entries6.end();
 		++iter) 
 	{
-	    const FirewallEntry& firewall_entry = iter->second;
-	    if (encode_entry6(firewall_entry, buffer, next_data_index,
-			error_msg)
-		    != XORP_OK) 
-	    {
-		return (XORP_ERROR);
-	    }
+	    const vector<uint8_t>& encoded_entry = iter->second;
+	    XLOG_ASSERT(next_data_index + encoded_entry.size()
+		    <= buffer.size());
+	    memcpy(&buffer[next_data_index], &encoded_entry[0],
+		    encoded_entry.size());
+	    next_data_index += encoded_entry.size();
+	    _num_entries++;
 	}
     }
 
@@ -1021,7 +1143,6 @@ FirewallSetNetfilter::encode_entry4(const FirewallEntry& firewall_entry,
     }
     ipt->next_offset = ipt->target_offset + ist->target.u.user.target_size;
 
-    _num_entries++;
     next_data_index += ipt->next_offset;
 
     return (XORP_OK);
@@ -1163,7 +1284,6 @@ FirewallSetNetfilter::encode_entry6(const FirewallEntry& firewall_entry,
     }
     ipt->next_offset = ipt->target_offset + ist->target.u.user.target_size;
 
-    _num_entries++;
     next_data_index += ipt->next_offset;
 
     return (XORP_OK);
@@ -32,6 +32,8 @@ class FirewallSetNetfilter : public FirewallSet
 	public:
 		// Firewall entries trie indexed by rule number
 		typedef map<uint32_t, FirewallEntry> FirewallTrie;
+		// Encoded firewall entries trie indexed by rule number
+		typedef map<uint32_t, vector<uint8_t> > EncodedEntryTrie;
 
 		/**
 		 * Constructor.
@@ -65,6 +67,9 @@ class FirewallSetNetfilter : public FirewallSet
 		/**
 		 * Update the firewall entries by pushing them into the underlying system.
 		 *
+		 * NETFILTER can only replace the whole table, hence a table is
+		 * pushed only if the update modified any of its entries.
+		 *
 		 * @param added_entries the entries to add.
 		 * @param replaced_entries the entries to replace.
 		 * @param deleted_entries the deleted entries.
@@ -79,6 +84,9 @@ class FirewallSetNetfilter : public FirewallSet
 		/**
 		 * Set the IPv4 firewall table.
 		 *
+		 * Only the entries that differ from the current table are
+		 * updated.
+		 *
 		 * @param firewall_entry_list the list with all entries to install into
 		 * the IPv4 firewall table.
 		 * @param error_msg the error message (if error).
@@ -98,6 +106,9 @@ class FirewallSetNetfilter : public FirewallSet
 		/**
 		 * Set the IPv6 firewall table.
 		 *
+		 * Only the entries that differ from the current table are
+		 * updated.
+		 *
 		 * @param firewall_entry_list the list with all entries to install into
 		 * the IPv6 firewall table.
 		 * @param error_msg the error message (if error).
@@ -118,6 +129,11 @@ class FirewallSetNetfilter : public FirewallSet
 		/**
 		 * Add a single firewall entry.
 		 *
+		 * The entry is encoded when it is added, and the encoded entry
+		 * is kept until the entry is deleted. If the entry already
+		 * exists and its encoding is not modified, the table is not
+		 * marked as modified.
+		 *
 		 * @param firewall_entry the entry to add.
 		 * @param error_msg the error message (if error).
 		 * @return XORP_OK on success, otherwise XORP_ERROR.
@@ -148,6 +164,9 @@ class FirewallSetNetfilter : public FirewallSet
 		/**
 		 * Encode a single IPv4 firewall chain.
 		 *
+		 * The entries of the FORWARD chain are copied from the
+		 * encoded entries.
+		 *
 		 * @param chain_name the name of the chain to encode.
 		 * @param buffer the buffer to store the encoded chain.
 		 * @param next_data_index the return-by-reference index into the buffer
@@ -163,6 +182,9 @@ class FirewallSetNetfilter : public FirewallSet
 		/**
 		 * Encode a single IPv6 firewall chain.
 		 *
+		 * The entries of the FORWARD chain are copied from the
+		 * encoded entries.
+		 *
 		 * @param chain_name the name of the chain to encode.
 		 * @param buffer the buffer to store the encoded chain.
 		 * @param next_data_index the return-by-reference index into the buffer
@@ -228,6 +250,14 @@ class FirewallSetNetfilter : public FirewallSet
 		FirewallTrie	_firewall_entries4;
 		FirewallTrie	_firewall_entries6;
 
+		// The locally saved firewall entries, encoded
+		EncodedEntryTrie _encoded_entries4;
+		EncodedEntryTrie _encoded_entries6;
+
+		// Whether the entries were modified since they were last pushed
+		bool		_is_modified4;
+		bool		_is_modified6;
+
 		// Misc. local state
 		size_t		_num_entries;
 		size_t		_head_offset;
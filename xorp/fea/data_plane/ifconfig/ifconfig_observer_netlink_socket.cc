@@ -121,6 +121,93 @@ IfConfigObserverNetlinkSocket::stop(string& error_msg)
 
 	void
 IfConfigObserverNetlinkSocket::receive_data(vector<uint8_t>& buffer)
+{
+	bool modified = false;
+	int nl_errno = 0;
+	set<uint32_t> if_indexes;
+	set<string> ifnames;
+	set<string>::const_iterator iter;
+	IfTree& system_config = ifconfig().system_config();
+
+	//
+	// Process only the interfaces the data is about. If they cannot be
+	// found, process the whole tree.
+	//
+	if (! get_if_indexes(buffer, if_indexes)) 
+	{
+		receive_data_all(buffer);
+		return;
+	}
+
+	//
+	// Pre-processing cleanup of the interfaces the data is about.
+	// The state of the other interfaces is not used below.
+	//
+	add_ifnames(system_config, if_indexes, ifnames);
+	for (iter = ifnames.begin(); iter != ifnames.end(); ++iter)
+		system_config.finalize_interface_state(*iter);
+
+	if (IfConfigGetNetlinkSocket::parse_buffer_netlink_socket(
+				ifconfig(), system_config, buffer, modified, nl_errno)
+			!= XORP_OK) 
+	{
+		return;
+	}
+
+	// The data may be about new interfaces
+	add_ifnames(system_config, if_indexes, ifnames);
+
+	//
+	// Get the VLAN vif info of those interfaces only
+	//
+	IfConfigVlanGet* ifconfig_vlan_get;
+	ifconfig_vlan_get = fea_data_plane_manager().ifconfig_vlan_get();
+	if (ifconfig_vlan_get != NULL) 
+	{
+		for (iter = ifnames.begin(); iter != ifnames.end(); ++iter) 
+		{
+			if (ifconfig_vlan_get->pull_config_one(system_config, *iter,
+						modified)
+					!= XORP_OK) 
+			{
+				XLOG_ERROR("Unknown error while pulling VLAN information "
+						"for interface %s",
+						iter->c_str());
+			}
+		}
+	}
+
+	if (modified && ifnames.empty()) 
+	{
+		//
+		// XXX: the modified interfaces could not be found, so propagate
+		// the changes of all interfaces.
+		//
+		IfTree& merged_config = ifconfig().merged_config();
+		merged_config.align_with_observed_changes(system_config,
+				ifconfig().user_config());
+		ifconfig().report_updates(merged_config);
+		merged_config.finalize_state();
+	} else if (modified) 
+	{
+		//
+		// Propagate the changes of those interfaces from the system config
+		// to the merged config
+		//
+		IfTree& merged_config = ifconfig().merged_config();
+		merged_config.align_with_observed_changes(system_config,
+				ifconfig().user_config(), ifnames);
+		ifconfig().report_updates(merged_config, ifnames);
+		for (iter = ifnames.begin(); iter != ifnames.end(); ++iter) 
+		{
+			merged_config.finalize_interface_state(*iter);
+			system_config.finalize_interface_state(*iter);
+		}
+	}
+}
+
+	void
+IfConfigObserverNetlinkSocket::receive_data_all(vector<uint8_t>& buffer)
 {
 	bool modified = false;
 	int nl_errno = 0;
@@ -163,6 +250,80 @@ IfConfigObserverNetlinkSocket::receive_data(vector<uint8_t>& buffer)
 	}
 }
 
+	bool
+IfConfigObserverNetlinkSocket::get_if_indexes(const vector<uint8_t>& buffer,
+		set<uint32_t>& if_indexes) const
+{
+	size_t buffer_bytes = buffer.size();
+	const struct nlmsghdr* nlh;
+
+	if (buffer.empty())
+		return (false);
+
+	for (nlh = reinterpret_cast<const struct nlmsghdr*>(&buffer[0]);
+			NLMSG_OK(nlh, buffer_bytes);
+			nlh = NLMSG_NEXT(nlh, buffer_bytes)) 
+	{
+		const void* nlmsg_data = NLMSG_DATA(nlh);
+
+		switch (nlh->nlmsg_type) 
+		{
+			case RTM_NEWLINK:
+			case RTM_DELLINK:
+				{
+					const struct ifinfomsg* ifinfomsg;
+
+					if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(*ifinfomsg)))
+						return (false);
+					ifinfomsg = reinterpret_cast<const struct ifinfomsg*>(nlmsg_data);
+					if (ifinfomsg->ifi_index <= 0)
+						return (false);
+					if_indexes.insert(ifinfomsg->ifi_index);
+				}
+				break;
+
+			case RTM_NEWADDR:
+			case RTM_DELADDR:
+				{
+					const struct ifaddrmsg* ifaddrmsg;
+
+					if (nlh->nlmsg_len < NLMSG_LENGTH(sizeof(*ifaddrmsg)))
+						return (false);
+					ifaddrmsg = reinterpret_cast<const struct ifaddrmsg*>(nlmsg_data);
+					if (ifaddrmsg->ifa_index == 0)
+						return (false);
+					if_indexes.insert(ifaddrmsg->ifa_index);
+				}
+				break;
+
+			default:
+				// XXX: the other messages don't modify the interfaces
+				break;
+		}
+	}
+
+	return (true);
+}
+
+	void
+IfConfigObserverNetlinkSocket::add_ifnames(const IfTree& iftree,
+		const set<uint32_t>& if_indexes,
+		set<string>& ifnames) const
+{
+	set<uint32_t>::const_iterator iter;
+
+	for (iter = if_indexes.begin(); iter != if_indexes.end(); ++iter) 
+	{
+		const IfTreeInterface* ifp = iftree.find_interface(*iter);
+		if (ifp != NULL)
+			ifnames.insert(ifp->ifname());
+
+		const IfTreeVif* vifp = iftree.find_vif(*iter);
+		if (vifp != NULL)
+			ifnames.insert(vifp->ifname());
+	}
+}
+
 	void
 IfConfigObserverNetlinkSocket::netlink_socket_data(vector<uint8_t>& buffer)
 {
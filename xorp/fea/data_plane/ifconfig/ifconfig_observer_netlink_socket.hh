@@ -73,6 +73,38 @@ class IfConfigObserverNetlinkSocket : public IfConfigObserver,
 		void netlink_socket_data(vector<uint8_t>& buffer);
 
 	private:
+		/**
+		 * Receive data from the underlying system, and process the
+		 * whole interface tree.
+		 *
+		 * @param buffer the buffer with the received data.
+		 */
+		void receive_data_all(vector<uint8_t>& buffer);
+
+		/**
+		 * Get the indexes of the interfaces the received data is about.
+		 *
+		 * @param buffer the buffer with the received data.
+		 * @param if_indexes the set to add the interface indexes to.
+		 * @return true on success, or false if some of the data could not
+		 * be attributed to an interface.
+		 */
+		bool get_if_indexes(const vector<uint8_t>& buffer,
+				set<uint32_t>& if_indexes) const;
+
+		/**
+		 * Add the names of the interfaces with the given indexes.
+		 *
+		 * The interface with the index, and the interface with the vif
+		 * with the index (e.g., the parent of a VLAN) are added.
+		 *
+		 * @param iftree the interface tree to look up the indexes in.
+		 * @param if_indexes the interface indexes.
+		 * @param ifnames the set to add the interface names to.
+		 */
+		void add_ifnames(const IfTree& iftree,
+				const set<uint32_t>& if_indexes,
+				set<string>& ifnames) const;
 };
 
 #endif
@@ -196,102 +196,137 @@ IfConfigVlanGetLinux::read_config(IfTree& iftree, bool& modified)
 			ifp->set_probed_vlan(false);
 		}
 
-		// If we've already probed this device for vlan-ness, then
-		// no need to probe again I think.
-		if (ifp->probed_vlan()) 
-		{
-			continue;
-		}
+		probe_vlan(ifp, modified);
+	}
+
+	return XORP_OK;
+}
+
+	int
+IfConfigVlanGetLinux::pull_config_one(IfTree& iftree, const string& ifname,
+		bool& modified)
+{
+	if (_is_dummy)
+		return XORP_OK;
+
+	if (! _is_running) 
+	{
+		XLOG_ERROR("Cannot read VLAN interface intormation: "
+				"the IfConfigVlanGetLinux plugin is not running");
+		return (XORP_ERROR);
+	}
+	XLOG_ASSERT(_s4 >= 0);
 
-		/** we'll have probed it when we return. */
-		ifp->set_probed_vlan(true);
+	IfTreeInterface* ifp = iftree.find_interface(ifname);
+	if ((ifp == NULL) || ifp->is_marked(IfTreeItem::DELETED))
+		return (XORP_OK);
 
-		uint16_t vlan_id = 0xFFFF;
-		string parent_ifname;
+	//
+	// XXX: always reprobe the interface, because a change observed on it
+	// may be a change of its VLAN state.
+	//
+	ifp->set_probed_vlan(false);
+	probe_vlan(ifp, modified);
+
+	return (XORP_OK);
+}
+
+//
+// Test whether an interface is a VLAN, and if yes, set its VLAN state.
+//
+	void
+IfConfigVlanGetLinux::probe_vlan(IfTreeInterface* ifp, bool& modified)
+{
+	// If we've already probed this device for vlan-ness, then
+	// no need to probe again I think.
+	if (ifp->probed_vlan())
+		return;
+
+	/** we'll have probed it when we return. */
+	ifp->set_probed_vlan(true);
+
+	uint16_t vlan_id = 0xFFFF;
+	string parent_ifname;
 
 #ifdef HAVE_VLAN_BSD
-		struct ifreq ifreq;
-		struct vlanreq vlanreq;
-
-		// Test whether a VLAN interface
-		memset(&ifreq, 0, sizeof(ifreq));
-		memset(&vlanreq, 0, sizeof(vlanreq));
-		strncpy(ifreq.ifr_name, ifp->ifname().c_str(),
-				sizeof(ifreq.ifr_name) - 1);
-		ifreq.ifr_data = reinterpret_cast<caddr_t>(&vlanreq);
-		if (ioctl(_s4, SIOCGETVLAN, (caddr_t)&ifreq) < 0)
-			continue;		// XXX: Most likely not a VLAN interface
-
-		// Get the VLAN information
-		vlan_id = vlanreq.vlr_tag;
-		parent_ifname = vlanreq.vlr_parent;
-
-		if (parent_ifname.empty())
-			continue;
+	struct ifreq ifreq;
+	struct vlanreq vlanreq;
+
+	// Test whether a VLAN interface
+	memset(&ifreq, 0, sizeof(ifreq));
+	memset(&vlanreq, 0, sizeof(vlanreq));
+	strncpy(ifreq.ifr_name, ifp->ifname().c_str(),
+			sizeof(ifreq.ifr_name) - 1);
+	ifreq.ifr_data = reinterpret_cast<caddr_t>(&vlanreq);
+	if (ioctl(_s4, SIOCGETVLAN, (caddr_t)&ifreq) < 0)
+		return;		// XXX: Most likely not a VLAN interface
+
+	// Get the VLAN information
+	vlan_id = vlanreq.vlr_tag;
+	parent_ifname = vlanreq.vlr_parent;
+
+	if (parent_ifname.empty())
+		return;
 
 #elif defined(HAVE_VLAN_LINUX)
-		struct vlan_ioctl_args vlanreq;
-
-		// Test whether a VLAN interface
-		memset(&vlanreq, 0, sizeof(vlanreq));
-		strncpy(vlanreq.device1, ifp->ifname().c_str(),
-				sizeof(vlanreq.device1) - 1);
-		vlanreq.cmd = GET_VLAN_REALDEV_NAME_CMD;
-		if (ioctl(_s4, SIOCGIFVLAN, &vlanreq) < 0) 
-		{
-			continue; // not a vlan
-		}
+	struct vlan_ioctl_args vlanreq;
+
+	// Test whether a VLAN interface
+	memset(&vlanreq, 0, sizeof(vlanreq));
+	strncpy(vlanreq.device1, ifp->ifname().c_str(),
+			sizeof(vlanreq.device1) - 1);
+	vlanreq.cmd = GET_VLAN_REALDEV_NAME_CMD;
+	if (ioctl(_s4, SIOCGIFVLAN, &vlanreq) < 0) 
+	{
+		return; // not a vlan
+	}
 
-		// Get the parent device
-		parent_ifname = vlanreq.u.device2;
-		if (parent_ifname.empty()) 
-		{
-			// BUG
-			XLOG_ERROR("Could not find parent ifname for iface: %s\n", ifp->ifname().c_str());
-			continue;
-		}
+	// Get the parent device
+	parent_ifname = vlanreq.u.device2;
+	if (parent_ifname.empty()) 
+	{
+		// BUG
+		XLOG_ERROR("Could not find parent ifname for iface: %s\n", ifp->ifname().c_str());
+		return;
+	}
 
-		// Get the VLAN ID
-		memset(&vlanreq, 0, sizeof(vlanreq));
-		strncpy(vlanreq.device1, ifp->ifname().c_str(),
-				sizeof(vlanreq.device1) - 1);
-		vlanreq.cmd = GET_VLAN_VID_CMD;
-		if (ioctl(_s4, SIOCGIFVLAN, &vlanreq) < 0) 
-		{
-			error_msg = c_format("Cannot get the VLAN ID for interface %s: %s",
-					ifp->ifname().c_str(), strerror(errno));
-			XLOG_ERROR("%s", error_msg.c_str());
-			continue;
-		}
-		vlan_id = vlanreq.u.VID;
+	// Get the VLAN ID
+	memset(&vlanreq, 0, sizeof(vlanreq));
+	strncpy(vlanreq.device1, ifp->ifname().c_str(),
+			sizeof(vlanreq.device1) - 1);
+	vlanreq.cmd = GET_VLAN_VID_CMD;
+	if (ioctl(_s4, SIOCGIFVLAN, &vlanreq) < 0) 
+	{
+		XLOG_ERROR("Cannot get the VLAN ID for interface %s: %s",
+				ifp->ifname().c_str(), strerror(errno));
+		return;
+	}
+	vlan_id = vlanreq.u.VID;
 #endif
 
-		IfTreeVif* vifp = ifp->find_vif(ifp->ifname());
-		if (vifp == NULL) 
-		{
-			ifp->add_vif(ifp->ifname());
-			modified = true;
-		}
-
-		if (ifp->parent_ifname() != parent_ifname) 
-		{
-			modified = true;
-			ifp->set_parent_ifname(parent_ifname);
-		}
-		// TODO:  Use a #define or similar for 'VLAN'
-		string vl("VLAN");
-		if (ifp->iface_type() != vl) 
-		{
-			modified = true;
-			ifp->set_iface_type(vl);
-		}
-		string vid = c_format("%hu", vlan_id);
-		if (ifp->vid() != vid) 
-		{
-			modified = true;
-			ifp->set_vid(vid);
-		}
+	IfTreeVif* vifp = ifp->find_vif(ifp->ifname());
+	if (vifp == NULL) 
+	{
+		ifp->add_vif(ifp->ifname());
+		modified = true;
 	}
 
-	return XORP_OK;
+	if (ifp->parent_ifname() != parent_ifname) 
+	{
+		modified = true;
+		ifp->set_parent_ifname(parent_ifname);
+	}
+	// TODO:  Use a #define or similar for 'VLAN'
+	string vl("VLAN");
+	if (ifp->iface_type() != vl) 
+	{
+		modified = true;
+		ifp->set_iface_type(vl);
+	}
+	string vid = c_format("%hu", vlan_id);
+	if (ifp->vid() != vid) 
+	{
+		modified = true;
+		ifp->set_vid(vid);
+	}
 }
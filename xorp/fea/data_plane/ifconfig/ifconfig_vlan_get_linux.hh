@@ -67,8 +67,21 @@ class IfConfigVlanGetLinux : public IfConfigVlanGet
 		 */
 		virtual int pull_config(IfTree& iftree, bool& modified);
 
+		/**
+		 * Pull the VLAN information about a single network interface
+		 * from the underlying system.
+		 *
+		 * @param iftree the IfTree storage to store the pulled information.
+		 * @param ifname the name of the interface.
+		 * @param modified set to true if the interface was modified.
+		 * @return XORP_OK on success, otherwise XORP_ERROR.
+		 */
+		virtual int pull_config_one(IfTree& iftree, const string& ifname,
+				bool& modified);
+
 	private:
 		int read_config(IfTree& iftree, bool& modified);
+		void probe_vlan(IfTreeInterface* ifp, bool& modified);
 		bool _is_dummy;
 		int _s4;
 };
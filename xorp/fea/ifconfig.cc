@@ -958,6 +958,38 @@ IfConfig::report_updates_completed()
 	_ifconfig_update_replicator.updates_completed();
 }
 
+	bool
+IfConfig::report_interface_updates(const IfTreeInterface& fi)
+{
+	bool updated = false;
+
+	updated |= report_update(fi);
+
+	IfTreeInterface::VifMap::const_iterator vi;
+	for (vi = fi.vifs().begin(); vi != fi.vifs().end(); ++vi) 
+	{
+
+		const IfTreeVif& vif = *(vi->second);
+		updated |= report_update(fi, vif);
+
+		for (IfTreeVif::IPv4Map::const_iterator ai = vif.ipv4addrs().begin();
+				ai != vif.ipv4addrs().end(); ai++) 
+		{
+			const IfTreeAddr4& addr = *(ai->second);
+			updated |= report_update(fi, vif, addr);
+		}
+
+		for (IfTreeVif::IPv6Map::const_iterator ai = vif.ipv6addrs().begin();
+				ai != vif.ipv6addrs().end(); ai++) 
+		{
+			const IfTreeAddr6& addr = *(ai->second);
+			updated |= report_update(fi, vif, addr);
+		}
+	}
+
+	return (updated);
+}
+
 	void
 IfConfig::report_updates(IfTree& iftree)
 {
@@ -969,32 +1001,29 @@ IfConfig::report_updates(IfTree& iftree)
 	for (IfTree::IfMap::const_iterator ii = iftree.interfaces().begin();
 			ii != iftree.interfaces().end(); ++ii) 
 	{
+		updated |= report_interface_updates(*(ii->second));
+	}
+	if (updated) 
+	{
+		// Complete the update
+		report_updates_completed();
+	}
+}
 
-		const IfTreeInterface& interface = *(ii->second);
-		updated |= report_update(interface);
-
-		IfTreeInterface::VifMap::const_iterator vi;
-		for (vi = interface.vifs().begin();
-				vi != interface.vifs().end(); ++vi) 
-		{
-
-			const IfTreeVif& vif = *(vi->second);
-			updated |= report_update(interface, vif);
-
-			for (IfTreeVif::IPv4Map::const_iterator ai = vif.ipv4addrs().begin();
-					ai != vif.ipv4addrs().end(); ai++) 
-			{
-				const IfTreeAddr4& addr = *(ai->second);
-				updated |= report_update(interface, vif, addr);
-			}
+	void
+IfConfig::report_updates(IfTree& iftree, const set<string>& ifnames)
+{
+	bool updated = false;
 
-			for (IfTreeVif::IPv6Map::const_iterator ai = vif.ipv6addrs().begin();
-					ai != vif.ipv6addrs().end(); ai++) 
-			{
-				const IfTreeAddr6& addr = *(ai->second);
-				updated |= report_update(interface, vif, addr);
-			}
-		}
+	//
+	// Walk only the given interfaces looking for changes to report
+	//
+	for (set<string>::const_iterator iter = ifnames.begin();
+			iter != ifnames.end(); ++iter) 
+	{
+		const IfTreeInterface* ifp = iftree.find_interface(*iter);
+		if (ifp != NULL)
+			updated |= report_interface_updates(*ifp);
 	}
 	if (updated) 
 	{
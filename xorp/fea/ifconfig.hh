@@ -425,6 +425,15 @@ class IfConfig
 				const IfTreeVif&		fv,
 				const IfTreeAddr6&	fa);
 
+		/**
+		 * Check IfTreeInterface and every item within it, and report
+		 * updates to IfConfigUpdateReporter.
+		 *
+		 * @param fi the @ref IfTreeInterface interface instance to check.
+		 * @return true if there were updates to report, otherwise false.
+		 */
+		bool report_interface_updates(const IfTreeInterface& fi);
+
 		/**
 		 * Report that updates were completed to IfConfigUpdateReporter.
 		 */
@@ -438,6 +447,15 @@ class IfConfig
 		 */
 		void report_updates(IfTree& iftree);
 
+		/**
+		 * Check every item within some of the interfaces in IfTree and
+		 * report updates to IfConfigUpdateReporter.
+		 *
+		 * @param iftree the interface tree instance to check.
+		 * @param ifnames the names of the interfaces to check.
+		 */
+		void report_updates(IfTree& iftree, const set<string>& ifnames);
+
 	private:
 		/**
 		 * Restore the interface configuration.
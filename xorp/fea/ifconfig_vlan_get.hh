@@ -94,6 +94,25 @@ class IfConfigVlanGet
 		 */
 		virtual int pull_config(IfTree& iftree, bool& modified) = 0;
 
+		/**
+		 * Pull the VLAN information about a single network interface
+		 * from the underlying system.
+		 *
+		 * The default implementation pulls the information about all
+		 * interfaces.
+		 *
+		 * @param iftree the IfTree storage to store the pulled information.
+		 * @param ifname the name of the interface.
+		 * @param modified Will be set to true if the interface was modified.
+		 * @return XORP_OK on success, otherwise XORP_ERROR.
+		 */
+		virtual int pull_config_one(IfTree& iftree, const string& ifname,
+				bool& modified) 
+		{
+			UNUSED(ifname);
+			return (pull_config(iftree, modified));
+		}
+
 	protected:
 		// Misc other state
 		bool	_is_running;
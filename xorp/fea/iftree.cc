@@ -735,6 +735,34 @@ IfTree::finalize_state()
 	set_state(NO_CHANGE);
 }
 
+/**
+ * Delete an interface if it is labelled as ready for deletion, otherwise
+ * call finalize_state() on it.
+ *
+ * Unlike @ref finalize_state(), the state of the tree itself and of the
+ * other interfaces is not modified.
+ *
+ * @param ifname the name of the interface.
+ */
+	void
+IfTree::finalize_interface_state(const string& ifname)
+{
+	IfMap::iterator ii = _interfaces.find(ifname);
+	if (ii == _interfaces.end())
+		return;
+
+	IfTreeInterface* ifp = ii->second;
+	if (ifp->is_marked(DELETED)) 
+	{
+		sendEvent(IFTREE_ERASE_IFACE, ifp);
+		_interfaces.erase(ii);
+		XLOG_WARNING("Deleting interface: %s from tree: %s\n", ifp->ifname().c_str(), name.c_str());
+		delete ifp;
+		return;
+	}
+	ifp->finalize_state();
+}
+
 string
 IfTree::str() const
 {
@@ -1075,258 +1103,294 @@ IfTree::align_with_observed_changes(const IfTree& other,
 	for (oi = other.interfaces().begin();
 			oi != other.interfaces().end(); ++oi) 
 	{
-		const IfTreeInterface* other_ifp = oi->second;
-		const string& ifname = other_ifp->ifname();
-		IfTreeInterface* this_ifp = find_interface(ifname);
-		const IfTreeInterface* user_ifp = user_config.find_interface(ifname);
+		align_interface_with_observed_changes(oi->second, user_config);
+	}
+
+	return (*this);
+}
 
+/**
+ * Align system-user merged configuration with the observed changes
+ * in some of the interfaces in the system configuration.
+ *
+ * The alignment is same as @ref align_with_observed_changes(), but only
+ * the interfaces with the given names are aligned.
+ *
+ * @param other the configuration tree to align state with.
+ * @param user_config the user configuration tree to reference during
+ * the alignment.
+ * @param ifnames the names of the interfaces to align.
+ * @return modified configuration structure.
+ */
+	IfTree&
+IfTree::align_with_observed_changes(const IfTree& other,
+		const IfTree& user_config,
+		const set<string>& ifnames)
+{
+	set<string>::const_iterator iter;
+
+	for (iter = ifnames.begin(); iter != ifnames.end(); ++iter) 
+	{
+		const IfTreeInterface* other_ifp = other.find_interface(*iter);
+		if (other_ifp != NULL)
+			align_interface_with_observed_changes(other_ifp, user_config);
+	}
+
+	return (*this);
+}
+
+	void
+IfTree::align_interface_with_observed_changes(const IfTreeInterface* other_ifp,
+		const IfTree& user_config)
+{
+	const string& ifname = other_ifp->ifname();
+	IfTreeInterface* this_ifp = find_interface(ifname);
+	const IfTreeInterface* user_ifp = user_config.find_interface(ifname);
+
+	//
+	// Ignore interfaces that are not in the local or user config tree
+	//
+	if (this_ifp == NULL) 
+	{
+		if (user_ifp == NULL)
+			return;
+		// Create the interface
+		add_interface(ifname);
+		this_ifp = find_interface(ifname);
+		XLOG_ASSERT(this_ifp != NULL);
+		this_ifp->copy_state(*user_ifp, true);
+		this_ifp->copy_state(*other_ifp, false);
+		this_ifp->mark(CREATED);
+	}
+
+	//
+	// Ignore "soft" interfaces
+	//
+	if (this_ifp->is_soft())
+		return;
+
+	//
+	// Special processing for "default_system_config" interfaces
+	//
+	if (this_ifp->default_system_config()) 
+	{
+		update_interface(*other_ifp);
+		return;
+	}
+
+	//
+	// Test for "DELETED" entries
+	//
+	if (other_ifp->is_marked(DELETED)) 
+	{
+		this_ifp->set_enabled(false);
+		return;
+	}
+
+	//
+	// Test for "CREATED" or "CHANGED" entries
+	//
+	if (other_ifp->is_marked(CREATED) || other_ifp->is_marked(CHANGED)) 
+	{
+		bool enabled = false;
+		if ((user_ifp != NULL) && user_ifp->enabled())
+			enabled = true;
 		//
-		// Ignore interfaces that are not in the local or user config tree
+		// Copy state from the other entry
 		//
-		if (this_ifp == NULL) 
+		if (! this_ifp->is_same_state(*other_ifp)) 
 		{
-			if (user_ifp == NULL)
-				continue;
-			// Create the interface
-			add_interface(ifname);
-			this_ifp = find_interface(ifname);
-			XLOG_ASSERT(this_ifp != NULL);
-			this_ifp->copy_state(*user_ifp, true);
 			this_ifp->copy_state(*other_ifp, false);
-			this_ifp->mark(CREATED);
+			if (! enabled)
+				this_ifp->set_enabled(enabled);
+			this_ifp->mark(CHANGED);	// XXX: no-op if it was CREATED
 		}
+	}
 
-		//
-		// Ignore "soft" interfaces
-		//
-		if (this_ifp->is_soft())
-			continue;
+	//
+	// Align the vif state
+	//
+	IfTreeInterface::VifMap::const_iterator ov;
+	for (ov = other_ifp->vifs().begin();
+			ov != other_ifp->vifs().end();
+			++ov) 
+	{
+		const IfTreeVif* other_vifp = ov->second;
+		const string& vifname = other_vifp->vifname();
+		IfTreeVif* this_vifp = this_ifp->find_vif(vifname);
+		const IfTreeVif* user_vifp = NULL;
+
+		if (user_ifp != NULL)
+			user_vifp = user_ifp->find_vif(vifname);
 
 		//
-		// Special processing for "default_system_config" interfaces
+		// Ignore entries that are not in the local or user config tree
 		//
-		if (this_ifp->default_system_config()) 
+		if (this_vifp == NULL) 
 		{
-			update_interface(*other_ifp);
-			continue;
+			if (user_vifp == NULL)
+				continue;
+			// Create the vif
+			this_ifp->add_vif(vifname);
+			this_vifp = this_ifp->find_vif(vifname);
+			XLOG_ASSERT(this_vifp != NULL);
+			this_vifp->copy_state(*other_vifp);
+			this_vifp->mark(CREATED);
 		}
 
 		//
 		// Test for "DELETED" entries
 		//
-		if (other_ifp->is_marked(DELETED)) 
+		if (other_vifp->is_marked(DELETED)) 
 		{
-			this_ifp->set_enabled(false);
+			this_vifp->set_enabled(false);
 			continue;
 		}
 
 		//
 		// Test for "CREATED" or "CHANGED" entries
 		//
-		if (other_ifp->is_marked(CREATED) || other_ifp->is_marked(CHANGED)) 
+		if (other_vifp->is_marked(CREATED)
+				|| other_vifp->is_marked(CHANGED)) 
 		{
 			bool enabled = false;
-			if ((user_ifp != NULL) && user_ifp->enabled())
+			if ((user_vifp != NULL) && user_vifp->enabled())
 				enabled = true;
 			//
 			// Copy state from the other entry
 			//
-			if (! this_ifp->is_same_state(*other_ifp)) 
+			if (! this_vifp->is_same_state(*other_vifp)) 
 			{
-				this_ifp->copy_state(*other_ifp, false);
+				this_vifp->copy_state(*other_vifp);
 				if (! enabled)
-					this_ifp->set_enabled(enabled);
-				this_ifp->mark(CHANGED);	// XXX: no-op if it was CREATED
+					this_vifp->set_enabled(enabled);
+				this_vifp->mark(CHANGED);	// XXX: no-op if it was CREATED
 			}
 		}
 
 		//
-		// Align the vif state
+		// Align the IPv4 address state
 		//
-		IfTreeInterface::VifMap::const_iterator ov;
-		for (ov = other_ifp->vifs().begin();
-				ov != other_ifp->vifs().end();
-				++ov) 
+		IfTreeVif::IPv4Map::const_iterator oa4;
+		for (oa4 = other_vifp->ipv4addrs().begin();
+				oa4 != other_vifp->ipv4addrs().end();
+				++oa4) 
 		{
-			const IfTreeVif* other_vifp = ov->second;
-			const string& vifname = other_vifp->vifname();
-			IfTreeVif* this_vifp = this_ifp->find_vif(vifname);
-			const IfTreeVif* user_vifp = NULL;
+			const IfTreeAddr4* other_ap = oa4->second;
+			const IPv4& addr = other_ap->addr();
+			IfTreeAddr4* this_ap = this_vifp->find_addr(addr);
+			const IfTreeAddr4* user_ap = NULL;
 
-			if (user_ifp != NULL)
-				user_vifp = user_ifp->find_vif(vifname);
+			if (user_vifp != NULL)
+				user_ap = user_vifp->find_addr(addr);
 
 			//
 			// Ignore entries that are not in the local or user config tree
 			//
-			if (this_vifp == NULL) 
+			if (this_ap == NULL) 
 			{
-				if (user_vifp == NULL)
+				if (user_ap == NULL)
 					continue;
-				// Create the vif
-				this_ifp->add_vif(vifname);
-				this_vifp = this_ifp->find_vif(vifname);
-				XLOG_ASSERT(this_vifp != NULL);
-				this_vifp->copy_state(*other_vifp);
-				this_vifp->mark(CREATED);
+				// Create the address
+				this_vifp->add_addr(addr);
+				this_ap = this_vifp->find_addr(addr);
+				XLOG_ASSERT(this_ap != NULL);
+				this_ap->copy_state(*other_ap);
+				this_ap->mark(CREATED);
 			}
 
 			//
 			// Test for "DELETED" entries
 			//
-			if (other_vifp->is_marked(DELETED)) 
+			if (other_ap->is_marked(DELETED)) 
 			{
-				this_vifp->set_enabled(false);
+				this_ap->set_enabled(false);
 				continue;
 			}
 
 			//
 			// Test for "CREATED" or "CHANGED" entries
 			//
-			if (other_vifp->is_marked(CREATED)
-					|| other_vifp->is_marked(CHANGED)) 
+			if (other_ap->is_marked(CREATED)
+					|| other_ap->is_marked(CHANGED)) 
 			{
 				bool enabled = false;
-				if ((user_vifp != NULL) && user_vifp->enabled())
+				if ((user_ap != NULL) && user_ap->enabled())
 					enabled = true;
 				//
 				// Copy state from the other entry
 				//
-				if (! this_vifp->is_same_state(*other_vifp)) 
+				if (! this_ap->is_same_state(*other_ap)) 
 				{
-					this_vifp->copy_state(*other_vifp);
+					this_ap->copy_state(*other_ap);
 					if (! enabled)
-						this_vifp->set_enabled(enabled);
-					this_vifp->mark(CHANGED);	// XXX: no-op if it was CREATED
+						this_ap->set_enabled(enabled);
+					this_ap->mark(CHANGED);	// XXX: no-op if it was CREATED
 				}
 			}
+		}
+
+		//
+		// Align the IPv6 address state
+		//
+		IfTreeVif::IPv6Map::const_iterator oa6;
+		for (oa6 = other_vifp->ipv6addrs().begin();
+				oa6 != other_vifp->ipv6addrs().end();
+				++oa6) 
+		{
+			const IfTreeAddr6* other_ap = oa6->second;
+			const IPv6& addr = other_ap->addr();
+			IfTreeAddr6* this_ap = this_vifp->find_addr(addr);
+			const IfTreeAddr6* user_ap = NULL;
+
+			if (user_vifp != NULL)
+				user_ap = user_vifp->find_addr(addr);
 
 			//
-			// Align the IPv4 address state
+			// Ignore entries that are not in the local or user config tree
 			//
-			IfTreeVif::IPv4Map::const_iterator oa4;
-			for (oa4 = other_vifp->ipv4addrs().begin();
-					oa4 != other_vifp->ipv4addrs().end();
-					++oa4) 
+			if (this_ap == NULL) 
 			{
-				const IfTreeAddr4* other_ap = oa4->second;
-				const IPv4& addr = other_ap->addr();
-				IfTreeAddr4* this_ap = this_vifp->find_addr(addr);
-				const IfTreeAddr4* user_ap = NULL;
-
-				if (user_vifp != NULL)
-					user_ap = user_vifp->find_addr(addr);
-
-				//
-				// Ignore entries that are not in the local or user config tree
-				//
-				if (this_ap == NULL) 
-				{
-					if (user_ap == NULL)
-						continue;
-					// Create the address
-					this_vifp->add_addr(addr);
-					this_ap = this_vifp->find_addr(addr);
-					XLOG_ASSERT(this_ap != NULL);
-					this_ap->copy_state(*other_ap);
-					this_ap->mark(CREATED);
-				}
-
-				//
-				// Test for "DELETED" entries
-				//
-				if (other_ap->is_marked(DELETED)) 
-				{
-					this_ap->set_enabled(false);
+				if (user_ap == NULL)
 					continue;
-				}
-
-				//
-				// Test for "CREATED" or "CHANGED" entries
-				//
-				if (other_ap->is_marked(CREATED)
-						|| other_ap->is_marked(CHANGED)) 
-				{
-					bool enabled = false;
-					if ((user_ap != NULL) && user_ap->enabled())
-						enabled = true;
-					//
-					// Copy state from the other entry
-					//
-					if (! this_ap->is_same_state(*other_ap)) 
-					{
-						this_ap->copy_state(*other_ap);
-						if (! enabled)
-							this_ap->set_enabled(enabled);
-						this_ap->mark(CHANGED);	// XXX: no-op if it was CREATED
-					}
-				}
+				// Create the address
+				this_vifp->add_addr(addr);
+				this_ap = this_vifp->find_addr(addr);
+				XLOG_ASSERT(this_ap != NULL);
+				this_ap->copy_state(*other_ap);
+				this_ap->mark(CREATED);
 			}
 
 			//
-			// Align the IPv6 address state
+			// Test for "DELETED" entries
 			//
-			IfTreeVif::IPv6Map::const_iterator oa6;
-			for (oa6 = other_vifp->ipv6addrs().begin();
-					oa6 != other_vifp->ipv6addrs().end();
-					++oa6) 
+			if (other_ap->is_marked(DELETED)) 
 			{
-				const IfTreeAddr6* other_ap = oa6->second;
-				const IPv6& addr = other_ap->addr();
-				IfTreeAddr6* this_ap = this_vifp->find_addr(addr);
-				const IfTreeAddr6* user_ap = NULL;
-
-				if (user_vifp != NULL)
-					user_ap = user_vifp->find_addr(addr);
-
-				//
-				// Ignore entries that are not in the local or user config tree
-				//
-				if (this_ap == NULL) 
-				{
-					if (user_ap == NULL)
-						continue;
-					// Create the address
-					this_vifp->add_addr(addr);
-					this_ap = this_vifp->find_addr(addr);
-					XLOG_ASSERT(this_ap != NULL);
-					this_ap->copy_state(*other_ap);
-					this_ap->mark(CREATED);
-				}
-
-				//
-				// Test for "DELETED" entries
-				//
-				if (other_ap->is_marked(DELETED)) 
-				{
-					this_ap->set_enabled(false);
-					continue;
-				}
+				this_ap->set_enabled(false);
+				continue;
+			}
 
+			//
+			// Test for "CREATED" or "CHANGED" entries
+			//
+			if (other_ap->is_marked(CREATED)
+					|| other_ap->is_marked(CHANGED)) 
+			{
+				bool enabled = false;
+				if ((user_ap != NULL) && user_ap->enabled())
+					enabled = true;
 				//
-				// Test for "CREATED" or "CHANGED" entries
+				// Copy state from the other entry
 				//
-				if (other_ap->is_marked(CREATED)
-						|| other_ap->is_marked(CHANGED)) 
+				if (! this_ap->is_same_state(*other_ap)) 
 				{
-					bool enabled = false;
-					if ((user_ap != NULL) && user_ap->enabled())
-						enabled = true;
-					//
-					// Copy state from the other entry
-					//
-					if (! this_ap->is_same_state(*other_ap)) 
-					{
-						if (! enabled)
-							this_ap->set_enabled(enabled);
-						this_ap->mark(CHANGED);	// XXX: no-op if it was CREATED
-					}
+					if (! enabled)
+						this_ap->set_enabled(enabled);
+					this_ap->mark(CHANGED);	// XXX: no-op if it was CREATED
 				}
 			}
 		}
 	}
-
-	return (*this);
 }
 
 /**
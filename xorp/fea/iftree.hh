@@ -491,6 +491,25 @@ class IfTree : public IfTreeItem
 	IfTree& align_with_observed_changes(const IfTree& other,
 		const IfTree& user_config);
 
+	/**
+	 * Align system-user merged configuration with the observed changes
+	 * in some of the interfaces in the system configuration.
+	 *
+	 * The alignment is same as @ref align_with_observed_changes(), but
+	 * only the interfaces with the given names are aligned. It is used
+	 * when it is known which interfaces were modified by the observed
+	 * changes.
+	 *
+	 * @param other the configuration tree to align state with.
+	 * @param user_config the user configuration tree to reference during
+	 * the alignment.
+	 * @param ifnames the names of the interfaces to align.
+	 * @return modified configuration structure.
+	 */
+	IfTree& align_with_observed_changes(const IfTree& other,
+		const IfTree& user_config,
+		const set<string>& ifnames);
+
 	/**
 	 * Align system-user merged configuration with the user configuration
 	 * changes.
@@ -558,6 +577,17 @@ class IfTree : public IfTreeItem
 	 */
 	void finalize_state();
 
+	/**
+	 * Delete an interface if it is labelled as ready for deletion,
+	 * otherwise call finalize_state() on it.
+	 *
+	 * Unlike @ref finalize_state(), the state of the tree itself and of
+	 * the other interfaces is not modified.
+	 *
+	 * @param ifname the name of the interface.
+	 */
+	void finalize_interface_state(const string& ifname);
+
 	/**
 	 * @return string representation of IfTree.
 	 */
@@ -581,6 +611,9 @@ class IfTree : public IfTreeItem
 	void sendEvent(IfTreeIfaceEventE e, IfTreeInterface* ifp);
 
     private:
+	void align_interface_with_observed_changes(
+		const IfTreeInterface* other_ifp, const IfTree& user_config);
+
 	string name; // identifier for this tree
 	IfMap	_interfaces;
 	IfIndexMap	_ifindex_map;		// Map of pif_index to interface
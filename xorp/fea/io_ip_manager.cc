@@ -852,6 +852,11 @@ IoIpManager::~IoIpManager()
 {
 	erase_filters(_comm_table4, _filters4, _filters4.begin(), _filters4.end());
 	erase_filters(_comm_table6, _filters6, _filters6.begin(), _filters6.end());
+
+	while (! _rings4.empty())
+		erase_ring(AF_INET, _rings4.begin()->first);
+	while (! _rings6.empty())
+		erase_ring(AF_INET6, _rings6.begin()->first);
 }
 
 	IoIpManager::CommTable&
@@ -878,15 +883,128 @@ IoIpManager::filters_by_family(int family)
 	return (_filters4);
 }
 
+	IoIpManager::RingTable&
+IoIpManager::rings_by_family(int family)
+{
+	if (family == IPv4::af())
+		return (_rings4);
+	if (family == IPv6::af())
+		return (_rings6);
+
+	XLOG_FATAL("Invalid address family: %d", family);
+	return (_rings4);
+}
+
 	void
 IoIpManager::recv_event(const string&			receiver_name,
 		const struct IPvXHeaderInfo&	header,
 		const vector<uint8_t>&		payload)
 {
+	int family = header.src_address.af();
+	RingTable& rings = rings_by_family(family);
+	RingTable::iterator ri = rings.find(receiver_name);
+
+	if (ri != rings.end()) 
+	{
+		RawPacketRing* ring = ri->second;
+
+		if (ring->send(header.if_name, header.vif_name,
+					header.src_address, header.dst_address,
+					header.ip_protocol, header.ip_ttl, header.ip_tos,
+					header.ip_router_alert, header.ip_internet_control,
+					header.ext_headers_type, header.ext_headers_payload,
+					payload))
+			return;
+
+		//
+		// XXX: The ring is full, or the receiver has gone away. Use
+		// the receiver instead, which will notice if it has gone.
+		//
+		if (ring->is_broken()) 
+		{
+			XLOG_WARNING("Shared memory ring %s for %s failed",
+					ring->name().c_str(), receiver_name.c_str());
+			erase_ring(family, receiver_name);
+		}
+	}
+
 	if (_io_ip_manager_receiver != NULL)
 		_io_ip_manager_receiver->recv_event(receiver_name, header, payload);
 }
 
+	int
+IoIpManager::register_receiver_ring(int		family,
+		const string&	receiver_name,
+		const string&	ring_name,
+		string&		error_msg)
+{
+	if (ring_name.empty() || ring_name.find('/') != string::npos) 
+	{
+		error_msg = c_format("Invalid ring name: %s", ring_name.c_str());
+		return (XORP_ERROR);
+	}
+
+	RawPacketRing* ring = new RawPacketRing(ring_name);
+	if (ring->attach(error_msg) != XORP_OK) 
+	{
+		delete ring;
+		return (XORP_ERROR);
+	}
+
+	if (_fea_node.fea_io().add_instance_watch(receiver_name, this, error_msg)
+			!= XORP_OK) 
+	{
+		delete ring;
+		return (XORP_ERROR);
+	}
+
+	erase_ring(family, receiver_name);
+	rings_by_family(family)[receiver_name] = ring;
+
+	return (XORP_OK);
+}
+
+	int
+IoIpManager::unregister_receiver_ring(int		family,
+		const string&	receiver_name,
+		string&		error_msg)
+{
+	RingTable& rings = rings_by_family(family);
+
+	if (rings.find(receiver_name) == rings.end()) 
+	{
+		error_msg = c_format("No ring for receiver %s",
+				receiver_name.c_str());
+		return (XORP_ERROR);
+	}
+
+	erase_ring(family, receiver_name);
+
+	// Deregister interest in watching the receiver
+	if (! has_filter_by_receiver_name(receiver_name)
+			&& ! has_ring_by_receiver_name(receiver_name)) 
+	{
+		string dummy_error_msg;
+		_fea_node.fea_io().delete_instance_watch(receiver_name, this,
+				dummy_error_msg);
+	}
+
+	return (XORP_OK);
+}
+
+	void
+IoIpManager::erase_ring(int family, const string& receiver_name)
+{
+	RingTable& rings = rings_by_family(family);
+	RingTable::iterator ri = rings.find(receiver_name);
+
+	if (ri == rings.end())
+		return;
+
+	delete ri->second;
+	rings.erase(ri);
+}
+
 	void
 IoIpManager::erase_filters_by_receiver_name(int family,
 		const string& receiver_name)
@@ -911,6 +1029,17 @@ IoIpManager::has_filter_by_receiver_name(const string& receiver_name) const
 	return (false);
 }
 
+bool
+IoIpManager::has_ring_by_receiver_name(const string& receiver_name) const
+{
+	if (_rings4.find(receiver_name) != _rings4.end())
+		return (true);
+	if (_rings6.find(receiver_name) != _rings6.end())
+		return (true);
+
+	return (false);
+}
+
 	void
 IoIpManager::erase_filters(CommTable& comm_table, FilterBag& filters,
 		const FilterBag::iterator& begin,
@@ -1140,7 +1269,8 @@ IoIpManager::unregister_receiver(int		family,
 			}
 
 			// Deregister interest in watching the receiver
-			if (! has_filter_by_receiver_name(receiver_name)) 
+			if (! has_filter_by_receiver_name(receiver_name)
+					&& ! has_ring_by_receiver_name(receiver_name)) 
 			{
 				string dummy_error_msg;
 				_fea_node.fea_io().delete_instance_watch(receiver_name, this,
@@ -1511,4 +1641,6 @@ IoIpManager::instance_death(const string& instance_name)
 
 	erase_filters_by_receiver_name(AF_INET, instance_name);
 	erase_filters_by_receiver_name(AF_INET6, instance_name);
+	erase_ring(AF_INET, instance_name);
+	erase_ring(AF_INET6, instance_name);
 }
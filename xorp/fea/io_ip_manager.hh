@@ -26,6 +26,8 @@
 #include "libxorp/ipvx.hh"
 #include "libxorp/xorpfd.hh"
 
+#include "libproto/raw_packet_ring.hh"
+
 #include "fea_io.hh"
 #include "io_ip.hh"
 
@@ -606,6 +608,37 @@ class IoIpManager : public IoIpManagerReceiver,
 				uint8_t		ip_protocol,
 				string&		error_msg);
 
+		/**
+		 * Deliver the packets for a receiver through a shared memory
+		 * ring created by the receiver. Packets that do not fit on
+		 * the ring are still delivered through the
+		 * @ref IoIpManagerReceiver.
+		 *
+		 * @param family the address family (AF_INET or AF_INET6 for
+		 * IPv4 and IPv6 respectively).
+		 * @param receiver_name the name of the receiver.
+		 * @param ring_name the name of the ring.
+		 * @param error_msg the error message (if error).
+		 * @return XORP_OK on success, otherwise XORP_ERROR.
+		 */
+		int register_receiver_ring(int		family,
+				const string&	receiver_name,
+				const string&	ring_name,
+				string&		error_msg);
+
+		/**
+		 * Stop using the shared memory ring of a receiver.
+		 *
+		 * @param family the address family (AF_INET or AF_INET6 for
+		 * IPv4 and IPv6 respectively).
+		 * @param receiver_name the name of the receiver.
+		 * @param error_msg the error message (if error).
+		 * @return XORP_OK on success, otherwise XORP_ERROR.
+		 */
+		int unregister_receiver_ring(int		family,
+				const string&	receiver_name,
+				string&		error_msg);
+
 		/**
 		 * Join an IP multicast group.
 		 *
@@ -763,6 +796,7 @@ class IoIpManager : public IoIpManagerReceiver,
 	private:
 		typedef map<uint8_t, IoIpComm*> CommTable;
 		typedef multimap<string, IoIpComm::InputFilter*> FilterBag;
+		typedef map<string, RawPacketRing*> RingTable;
 
 		/**
 		 * Get the CommTable for an address family.
@@ -780,6 +814,22 @@ class IoIpManager : public IoIpManagerReceiver,
 		 */
 		FilterBag& filters_by_family(int family);
 
+		/**
+		 * Get the RingTable for an address family.
+		 *
+		 * @param family the address family.
+		 * @return a reference to the RingTable for the address family.
+		 */
+		RingTable& rings_by_family(int family);
+
+		/**
+		 * Close and forget the ring of a receiver, if it has one.
+		 *
+		 * @param family the address family.
+		 * @param receiver_name the name of the receiver.
+		 */
+		void erase_ring(int family, const string& receiver_name);
+
 		/**
 		 * Erase filters for a given receiver name.
 		 *
@@ -798,6 +848,15 @@ class IoIpManager : public IoIpManagerReceiver,
 		 */
 		bool has_filter_by_receiver_name(const string& receiver_name) const;
 
+		/**
+		 * Test whether there is a ring for a given receiver name.
+		 *
+		 * @param receiver_name the name of the receiver.
+		 * @return true if there is a ring for the given receiver name,
+		 * otherwise false.
+		 */
+		bool has_ring_by_receiver_name(const string& receiver_name) const;
+
 		/**
 		 * Erase filters for a given CommTable and FilterBag.
 		 *
@@ -823,6 +882,10 @@ class IoIpManager : public IoIpManagerReceiver,
 		FilterBag		_filters4;
 		FilterBag		_filters6;
 
+		// Shared memory rings keyed by receiver name.
+		RingTable		_rings4;
+		RingTable		_rings6;
+
 		IoIpManagerReceiver* _io_ip_manager_receiver;
 
 		list<FeaDataPlaneManager*> _fea_data_plane_managers;
@@ -806,7 +806,26 @@ XrlFeaTarget::fea_fib_0_1_add_fib_client4(
 {
     return _xrl_fib_client_manager.add_fib_client4(client_target_name,
 	    send_updates,
-	    send_resolves);
+	    send_resolves,
+	    false);
+}
+
+/**
+ *  Add a FIB client that receives the route changes in batches.
+ *
+ *  @param target_name the target name of the FIB client to add.
+ */
+XrlCmdError
+XrlFeaTarget::fea_fib_0_1_add_batch_fib_client4(
+	// Input values,
+	const string&	client_target_name,
+	const bool&		send_updates,
+	const bool&		send_resolves)
+{
+    return _xrl_fib_client_manager.add_fib_client4(client_target_name,
+	    send_updates,
+	    send_resolves,
+	    true);
 }
 
 
@@ -833,7 +852,21 @@ XrlFeaTarget::fea_fib_0_1_add_fib_client6(
 {
     return _xrl_fib_client_manager.add_fib_client6(client_target_name,
 	    send_updates,
-	    send_resolves);
+	    send_resolves,
+	    false);
+}
+
+XrlCmdError
+XrlFeaTarget::fea_fib_0_1_add_batch_fib_client6(
+	// Input values,
+	const string&	client_target_name,
+	const bool&		send_updates,
+	const bool&		send_resolves)
+{
+    return _xrl_fib_client_manager.add_fib_client6(client_target_name,
+	    send_updates,
+	    send_resolves,
+	    true);
 }
 
 XrlCmdError
@@ -3928,6 +3961,44 @@ XrlFeaTarget::raw_packet4_0_1_unregister_receiver(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlFeaTarget::raw_packet4_0_1_register_receiver_ring(
+	// Input values,
+	const string&	xrl_target_instance_name,
+	const string&	ring_name)
+{
+    string error_msg;
+
+    if (_io_ip_manager.register_receiver_ring(IPv4::af(),
+		xrl_target_instance_name,
+		ring_name,
+		error_msg)
+	    != XORP_OK) 
+    {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
+XrlCmdError
+XrlFeaTarget::raw_packet4_0_1_unregister_receiver_ring(
+	// Input values,
+	const string&	xrl_target_instance_name)
+{
+    string error_msg;
+
+    if (_io_ip_manager.unregister_receiver_ring(IPv4::af(),
+		xrl_target_instance_name,
+		error_msg)
+	    != XORP_OK) 
+    {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlFeaTarget::raw_packet4_0_1_join_multicast_group(
 	// Input values,
@@ -4082,6 +4153,44 @@ XrlFeaTarget::raw_packet6_0_1_unregister_receiver(
     return XrlCmdError::OKAY();
 }
 
+XrlCmdError
+XrlFeaTarget::raw_packet6_0_1_register_receiver_ring(
+	// Input values,
+	const string&	xrl_target_instance_name,
+	const string&	ring_name)
+{
+    string error_msg;
+
+    if (_io_ip_manager.register_receiver_ring(IPv6::af(),
+		xrl_target_instance_name,
+		ring_name,
+		error_msg)
+	    != XORP_OK) 
+    {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
+XrlCmdError
+XrlFeaTarget::raw_packet6_0_1_unregister_receiver_ring(
+	// Input values,
+	const string&	xrl_target_instance_name)
+{
+    string error_msg;
+
+    if (_io_ip_manager.unregister_receiver_ring(IPv6::af(),
+		xrl_target_instance_name,
+		error_msg)
+	    != XORP_OK) 
+    {
+	return XrlCmdError::COMMAND_FAILED(error_msg);
+    }
+
+    return XrlCmdError::OKAY();
+}
+
 XrlCmdError
 XrlFeaTarget::raw_packet6_0_1_join_multicast_group(
 	// Input values,
@@ -349,6 +349,19 @@ class XrlFeaTarget : public XrlFeaTargetBase
 		// Input values,
 		const string&	client_target_name);
 
+	/**
+	 *  Add a FIB client that receives the route changes in batches.
+	 *
+	 *  @param client_target_name the target name of the FIB client to add.
+	 *  @param send_updates whether updates should be sent.
+	 *  @param send_resolves whether resolve requests should be sent.
+	 */
+	XrlCmdError fea_fib_0_1_add_batch_fib_client4(
+		// Input values,
+		const string&	client_target_name,
+		const bool&	send_updates,
+		const bool&	send_resolves);
+
 
 	XrlCmdError fea_fib_0_1_add_fib_client6(
 		// Input values,
@@ -360,6 +373,12 @@ class XrlFeaTarget : public XrlFeaTargetBase
 		// Input values,
 		const string&	client_target_name);
 
+	XrlCmdError fea_fib_0_1_add_batch_fib_client6(
+		// Input values,
+		const string&	client_target_name,
+		const bool&	send_updates,
+		const bool&	send_resolves);
+
 #ifndef XORP_DISABLE_FIREWALL
 	//
 	// FEA firewall interface
@@ -1805,6 +1824,33 @@ class XrlFeaTarget : public XrlFeaTargetBase
 		const string&	vif_name,
 		const uint32_t&	ip_protocol);
 
+	/**
+	 *  Deliver the IPv4 packets for a receiver through a shared memory
+	 *  ring created by the receiver, instead of with the
+	 *  raw_packet4_client/0.1 recv XRL. Packets that cannot be placed
+	 *  on the ring are still delivered with the XRL. The ring only carries
+	 *  packets for filters that have been set up with register_receiver.
+	 *
+	 *  @param xrl_target_instance_name the receiver's XRL target instance
+	 *  name.
+	 *
+	 *  @param ring_name the name of the ring.
+	 */
+	XrlCmdError raw_packet4_0_1_register_receiver_ring(
+		// Input values,
+		const string&	xrl_target_instance_name,
+		const string&	ring_name);
+
+	/**
+	 *  Stop using the shared memory ring of a receiver.
+	 *
+	 *  @param xrl_target_instance_name the receiver's XRL target instance
+	 *  name.
+	 */
+	XrlCmdError raw_packet4_0_1_unregister_receiver_ring(
+		// Input values,
+		const string&	xrl_target_instance_name);
+
 	/**
 	 *  Join an IPv4 multicast group.
 	 *
@@ -1959,6 +2005,33 @@ class XrlFeaTarget : public XrlFeaTargetBase
 		const string&	vif_name,
 		const uint32_t&	ip_protocol);
 
+	/**
+	 *  Deliver the IPv6 packets for a receiver through a shared memory
+	 *  ring created by the receiver, instead of with the
+	 *  raw_packet6_client/0.1 recv XRL. Packets that cannot be placed
+	 *  on the ring are still delivered with the XRL. The ring only carries
+	 *  packets for filters that have been set up with register_receiver.
+	 *
+	 *  @param xrl_target_instance_name the receiver's XRL target instance
+	 *  name.
+	 *
+	 *  @param ring_name the name of the ring.
+	 */
+	XrlCmdError raw_packet6_0_1_register_receiver_ring(
+		// Input values,
+		const string&	xrl_target_instance_name,
+		const string&	ring_name);
+
+	/**
+	 *  Stop using the shared memory ring of a receiver.
+	 *
+	 *  @param xrl_target_instance_name the receiver's XRL target instance
+	 *  name.
+	 */
+	XrlCmdError raw_packet6_0_1_unregister_receiver_ring(
+		// Input values,
+		const string&	xrl_target_instance_name);
+
 	/**
 	 *  Join an IPv6 multicast group.
 	 *
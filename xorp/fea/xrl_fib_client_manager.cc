@@ -51,7 +51,8 @@ XrlFibClientManager::process_fib_changes(const list<Fte4>& fte_list)
 	XrlCmdError
 XrlFibClientManager::add_fib_client4(const string& client_target_name,
 		const bool send_updates,
-		const bool send_resolves)
+		const bool send_resolves,
+		const bool send_batches)
 {
 	// Test if we have this client already
 	if (_fib_clients4.find(client_target_name) != _fib_clients4.end()) 
@@ -76,7 +77,10 @@ XrlFibClientManager::add_fib_client4(const string& client_target_name,
 		static const string error_msg("Cannot get the IPv4 FIB");
 		return XrlCmdError::COMMAND_FAILED(error_msg);
 	}
-	fib_client.activate(fte_list);
+	if (send_batches)
+		fib_client.activate_snapshot(fte_list, ++_generation);
+	else
+		fib_client.activate(fte_list);
 
 	return XrlCmdError::OKAY();
 }
@@ -166,6 +170,55 @@ XrlFibClientManager::send_fib_client_resolve_route(const string& target_name,
 		return XORP_ERROR;
 }
 
+	int
+XrlFibClientManager::send_fib_client_route_batch(const string& target_name,
+		uint32_t generation, bool snapshot,
+		bool end_of_snapshot,
+		const list<Fte4>& fte_list)
+{
+	XrlAtomList network, nexthop, ifname, vifname, metric, admin_distance;
+	XrlAtomList protocol_origin, xorp_route, deleted;
+	bool success;
+
+	list<Fte4>::const_iterator iter;
+	for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) 
+	{
+		const Fte4& fte = *iter;
+		network.append(XrlAtom(fte.net()));
+		nexthop.append(XrlAtom(fte.nexthop()));
+		ifname.append(XrlAtom(fte.ifname()));
+		vifname.append(XrlAtom(fte.vifname()));
+		metric.append(XrlAtom(fte.metric()));
+		admin_distance.append(XrlAtom(fte.admin_distance()));
+		protocol_origin.append(XrlAtom(string("NOT_SUPPORTED")));
+		xorp_route.append(XrlAtom(fte.xorp_route()));
+		deleted.append(XrlAtom(fte.is_deleted()));
+	}
+
+	success = _xrl_fea_fib_client.send_apply_route_batch4(
+			target_name.c_str(),
+			generation,
+			snapshot,
+			end_of_snapshot,
+			network,
+			nexthop,
+			ifname,
+			vifname,
+			metric,
+			admin_distance,
+			protocol_origin,
+			xorp_route,
+			deleted,
+			callback(this,
+				&XrlFibClientManager::send_fib_client_route_batch4_cb,
+				target_name));
+
+	if (success)
+		return XORP_OK;
+	else
+		return XORP_ERROR;
+}
+
 	void
 XrlFibClientManager::send_fib_client_add_route4_cb(const XrlError& xrl_error,
 		string target_name)
@@ -219,11 +272,31 @@ XrlFibClientManager::send_fib_client_resolve_route4_cb(
 	fib_client.send_fib_client_route_change_cb(xrl_error);
 }
 
+	void
+XrlFibClientManager::send_fib_client_route_batch4_cb(
+		const XrlError& xrl_error,
+		string target_name)
+{
+	map<string, FibClient4>::iterator iter;
+
+	iter = _fib_clients4.find(target_name);
+	if (iter == _fib_clients4.end()) 
+	{
+		// The client has probably gone. Silently ignore.
+		return;
+	}
+
+	FibClient4& fib_client = iter->second;
+	fib_client.send_fib_client_route_change_cb(xrl_error);
+}
+
 template<class F>
 	void
 XrlFibClientManager::FibClient<F>::activate(const list<F>& fte_list)
 {
-	bool queue_was_empty = _inform_fib_client_queue.empty();
+	// XXX: the last batch of a snapshot may have no routes
+	bool queue_was_empty = (_inform_fib_client_queue.empty()
+			&& (! _is_snapshot_pending));
 
 	if (fte_list.empty())
 		return;
@@ -241,6 +314,31 @@ XrlFibClientManager::FibClient<F>::activate(const list<F>& fte_list)
 		send_fib_client_route_change();
 }
 
+/**
+ * Activate a client that receives the route changes in batches.
+ *
+ * The FIB is sent first as a snapshot, even if it is empty, so that
+ * the client can delete the routes it holds from an earlier snapshot.
+ *
+ * @param fte_list the Fte entries of the FIB.
+ * @param generation the generation number of the snapshot.
+ */
+template<class F>
+	void
+XrlFibClientManager::FibClient<F>::activate_snapshot(const list<F>& fte_list,
+		uint32_t generation)
+{
+	XLOG_ASSERT(_inform_fib_client_queue.empty());
+
+	_is_batched = true;
+	_generation = generation;
+	_is_snapshot_pending = true;
+	_snapshot_n = fte_list.size();
+	_inform_fib_client_queue = fte_list;
+
+	send_fib_client_route_change();
+}
+
 template<class F>
 	void
 XrlFibClientManager::FibClient<F>::send_fib_client_route_change()
@@ -251,10 +349,17 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change()
 	{
 		bool ignore_fte = true;
 
+		if (_is_batched) 
+		{
+			success = send_fib_client_route_batch();
+			break;
+		}
+
 		if (_inform_fib_client_queue.empty())
 			return;		// No more route changes to send
 
 		F& fte = _inform_fib_client_queue.front();
+		_sent_n = 1;
 
 		//
 		// If FIB route misses and resolution requests were requested to be
@@ -318,7 +423,7 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change_cb(
 	// If success, then send the next route change
 	if (xrl_error == XrlError::OKAY()) 
 	{
-		_inform_fib_client_queue.pop_front();
+		pop_sent_route_changes();
 		send_fib_client_route_change();
 		return;
 	}
@@ -331,7 +436,7 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change_cb(
 	{
 		XLOG_ERROR("Error sending route change to %s: %s",
 				_target_name.c_str(), xrl_error.str().c_str());
-		_inform_fib_client_queue.pop_front();
+		pop_sent_route_changes();
 		send_fib_client_route_change();
 		return;
 	}
@@ -348,6 +453,97 @@ XrlFibClientManager::FibClient<F>::send_fib_client_route_change_cb(
 			callback(this, &XrlFibClientManager::FibClient<F>::send_fib_client_route_change));
 }
 
+/**
+ * Send the next batch of route changes to a batched client.
+ *
+ * A batch holds only snapshot entries or only later changes, and no
+ * more than MAX_ROUTE_BATCH routes. A resolve request is sent on
+ * its own.
+ *
+ * @return XORP_OK if an XRL was sent or there is nothing to send,
+ * otherwise XORP_ERROR.
+ */
+template<class F>
+	int
+XrlFibClientManager::FibClient<F>::send_fib_client_route_batch()
+{
+	do 
+	{
+		list<F> batch;
+		size_t limit = _inform_fib_client_queue.size();
+		bool is_snapshot = _is_snapshot_pending;
+
+		if (is_snapshot)
+			limit = _snapshot_n;
+
+		_sent_n = 0;
+		typename list<F>::iterator iter = _inform_fib_client_queue.begin();
+		for ( ; (_sent_n < limit) && (batch.size() < MAX_ROUTE_BATCH);
+				++iter) 
+		{
+			F& fte = *iter;
+			if (fte.is_unresolved()) 
+			{
+				if (_send_resolves && batch.empty() && (_sent_n == 0)) 
+				{
+					_sent_n = 1;
+					return (_xfcm->send_fib_client_resolve_route(_target_name,
+								fte));
+				}
+				if (_send_resolves)
+					break;		// Sent on its own
+			} else if (_send_updates) 
+			{
+				batch.push_back(fte);
+			}
+			_sent_n++;
+		}
+
+		bool is_end_of_snapshot = is_snapshot && (_sent_n == _snapshot_n);
+
+		if (batch.empty() && ! is_end_of_snapshot) 
+		{
+			//
+			// The entries are not needed hence silently drop them and
+			// process the next ones.
+			//
+			if (_sent_n == 0)
+				return (XORP_OK);	// No more route changes to send
+			pop_sent_route_changes();
+			continue;
+		}
+
+		return (_xfcm->send_fib_client_route_batch(_target_name,
+					_generation,
+					is_snapshot,
+					is_end_of_snapshot,
+					batch));
+	} while (true);
+}
+
+/**
+ * Remove the entries that have been sent from the queue.
+ */
+template<class F>
+	void
+XrlFibClientManager::FibClient<F>::pop_sent_route_changes()
+{
+	XLOG_ASSERT(_sent_n <= _inform_fib_client_queue.size());
+
+	for ( ; _sent_n > 0; _sent_n--) 
+	{
+		_inform_fib_client_queue.pop_front();
+		if (_is_snapshot_pending && (_snapshot_n > 0))
+			_snapshot_n--;
+	}
+	//
+	// XXX: the snapshot is over only after its last batch is sent,
+	// which for an empty snapshot is a batch with no routes.
+	//
+	if (_is_snapshot_pending && (_snapshot_n == 0))
+		_is_snapshot_pending = false;
+}
+
 template class XrlFibClientManager::FibClient<Fte4>;
 
 
@@ -374,7 +570,8 @@ XrlFibClientManager::process_fib_changes(const list<Fte6>& fte_list)
 	XrlCmdError
 XrlFibClientManager::add_fib_client6(const string& client_target_name,
 		const bool send_updates,
-		const bool send_resolves)
+		const bool send_resolves,
+		const bool send_batches)
 {
 	// Test if we have this client already
 	if (_fib_clients6.find(client_target_name) != _fib_clients6.end()) 
@@ -399,7 +596,10 @@ XrlFibClientManager::add_fib_client6(const string& client_target_name,
 		string error_msg = "Cannot get the IPv6 FIB";
 		return XrlCmdError::COMMAND_FAILED(error_msg);
 	}
-	fib_client.activate(fte_list);
+	if (send_batches)
+		fib_client.activate_snapshot(fte_list, ++_generation);
+	else
+		fib_client.activate(fte_list);
 
 	return XrlCmdError::OKAY();
 }
@@ -492,6 +692,56 @@ XrlFibClientManager::send_fib_client_resolve_route(const string& target_name,
 }
 
 
+	int
+XrlFibClientManager::send_fib_client_route_batch(const string& target_name,
+		uint32_t generation, bool snapshot,
+		bool end_of_snapshot,
+		const list<Fte6>& fte_list)
+{
+	XrlAtomList network, nexthop, ifname, vifname, metric, admin_distance;
+	XrlAtomList protocol_origin, xorp_route, deleted;
+	bool success;
+
+	list<Fte6>::const_iterator iter;
+	for (iter = fte_list.begin(); iter != fte_list.end(); ++iter) 
+	{
+		const Fte6& fte = *iter;
+		network.append(XrlAtom(fte.net()));
+		nexthop.append(XrlAtom(fte.nexthop()));
+		ifname.append(XrlAtom(fte.ifname()));
+		vifname.append(XrlAtom(fte.vifname()));
+		metric.append(XrlAtom(fte.metric()));
+		admin_distance.append(XrlAtom(fte.admin_distance()));
+		protocol_origin.append(XrlAtom(string("NOT_SUPPORTED")));
+		xorp_route.append(XrlAtom(fte.xorp_route()));
+		deleted.append(XrlAtom(fte.is_deleted()));
+	}
+
+	success = _xrl_fea_fib_client.send_apply_route_batch6(
+			target_name.c_str(),
+			generation,
+			snapshot,
+			end_of_snapshot,
+			network,
+			nexthop,
+			ifname,
+			vifname,
+			metric,
+			admin_distance,
+			protocol_origin,
+			xorp_route,
+			deleted,
+			callback(this,
+				&XrlFibClientManager::send_fib_client_route_batch6_cb,
+				target_name));
+
+	if (success)
+		return XORP_OK;
+	else
+		return XORP_ERROR;
+}
+
+
 	void
 XrlFibClientManager::send_fib_client_add_route6_cb(const XrlError& xrl_error,
 		string target_name)
@@ -547,5 +797,24 @@ XrlFibClientManager::send_fib_client_resolve_route6_cb(
 	fib_client.send_fib_client_route_change_cb(xrl_error);
 }
 
+
+	void
+XrlFibClientManager::send_fib_client_route_batch6_cb(
+		const XrlError& xrl_error,
+		string target_name)
+{
+	map<string, FibClient6>::iterator iter;
+
+	iter = _fib_clients6.find(target_name);
+	if (iter == _fib_clients6.end()) 
+	{
+		// The client has probably gone. Silently ignore.
+		return;
+	}
+
+	FibClient6& fib_client = iter->second;
+	fib_client.send_fib_client_route_change_cb(xrl_error);
+}
+
 template class XrlFibClientManager::FibClient<Fte6>;
 
@@ -43,6 +43,7 @@ class XrlFibClientManager : public FibTableObserverBase
 		XrlFibClientManager(FibConfig&	fibconfig,
 				XrlRouter&	xrl_router)
 			: _fibconfig(fibconfig),
+			_generation(0),
 			_xrl_fea_fib_client(&xrl_router) 
 	{
 		_fibconfig.add_fib_table_observer(this);
@@ -68,11 +69,14 @@ class XrlFibClientManager : public FibTableObserverBase
 		 * @param client_target_name the target name of the client to add.
 		 * @param send_updates whether updates should be sent.
 		 * @param send_resolves whether resolve requests should be sent.
+		 * @param send_batches whether the FIB snapshot and the updates
+		 * should be sent in batches.
 		 * @return the XRL command error.
 		 */
 		XrlCmdError add_fib_client4(const string& client_target_name,
 				const bool send_updates,
-				const bool send_resolves);
+				const bool send_resolves,
+				const bool send_batches);
 
 		/**
 		 * Delete an IPv4 FIB client.
@@ -115,6 +119,24 @@ class XrlFibClientManager : public FibTableObserverBase
 		int send_fib_client_resolve_route(const string& target_name,
 				const Fte4& fte);
 
+		/**
+		 * Send an XRL to a FIB client to add or delete a batch of IPv4
+		 * routes.
+		 *
+		 * @param target_name the target name of the FIB client.
+		 * @param generation the generation number of the client snapshot.
+		 * @param snapshot true if the batch is part of the snapshot.
+		 * @param end_of_snapshot true if the batch is the last one of
+		 * the snapshot.
+		 * @param fte_list the Fte entries with the routes to add or delete.
+		 * @return XORP_OK on success, otherwise XORP_ERROR.
+		 * @see Fte4.
+		 */
+		int send_fib_client_route_batch(const string& target_name,
+				uint32_t generation, bool snapshot,
+				bool end_of_snapshot,
+				const list<Fte4>& fte_list);
+
 
 
 		/**
@@ -132,11 +154,14 @@ class XrlFibClientManager : public FibTableObserverBase
 		 * @param client_target_name the target name of the client to add.
 		 * @param send_updates whether updates should be sent.
 		 * @param send_resolves whether resolve requests should be sent.
+		 * @param send_batches whether the FIB snapshot and the updates
+		 * should be sent in batches.
 		 * @return the XRL command error.
 		 */
 		XrlCmdError add_fib_client6(const string& client_target_name,
 				const bool send_updates,
-				const bool send_resolves);
+				const bool send_resolves,
+				const bool send_batches);
 
 		/**
 		 * Delete an IPv6 FIB client.
@@ -180,6 +205,24 @@ class XrlFibClientManager : public FibTableObserverBase
 		int send_fib_client_resolve_route(const string& target_name,
 				const Fte6& fte);
 
+		/**
+		 * Send an XRL to a FIB client to add or delete a batch of IPv6
+		 * routes.
+		 *
+		 * @param target_name the target name of the FIB client.
+		 * @param generation the generation number of the client snapshot.
+		 * @param snapshot true if the batch is part of the snapshot.
+		 * @param end_of_snapshot true if the batch is the last one of
+		 * the snapshot.
+		 * @param fte_list the Fte entries with the routes to add or delete.
+		 * @return XORP_OK on success, otherwise XORP_ERROR.
+		 * @see Fte6.
+		 */
+		int send_fib_client_route_batch(const string& target_name,
+				uint32_t generation, bool snapshot,
+				bool end_of_snapshot,
+				const list<Fte6>& fte_list);
+
 
 	protected:
 		FibConfig&		_fibconfig;
@@ -198,6 +241,16 @@ class XrlFibClientManager : public FibTableObserverBase
 				string target_name);
 		void send_fib_client_resolve_route6_cb(const XrlError& xrl_error,
 				string target_name);
+		void send_fib_client_route_batch4_cb(const XrlError& xrl_error,
+				string target_name);
+		void send_fib_client_route_batch6_cb(const XrlError& xrl_error,
+				string target_name);
+
+		/**
+		 * The maximum number of routes sent to a FIB client in a
+		 * single batch.
+		 */
+		static const size_t MAX_ROUTE_BATCH = 1000;
 
 		/**
 		 * A template class for storing FIB client information.
@@ -207,10 +260,16 @@ class XrlFibClientManager : public FibTableObserverBase
 			{
 				public:
 					FibClient(const string& target_name, XrlFibClientManager& xfcm)
-						: _target_name(target_name), _xfcm(&xfcm),
-						_send_updates(false), _send_resolves(false) {}
-
-					FibClient() { _xfcm = NULL; }
+						: _sent_n(0), _target_name(target_name), _xfcm(&xfcm),
+						_send_updates(false), _send_resolves(false),
+						_is_batched(false), _generation(0),
+						_is_snapshot_pending(false), _snapshot_n(0) {}
+
+					FibClient()
+						: _sent_n(0), _xfcm(NULL),
+						_send_updates(false), _send_resolves(false),
+						_is_batched(false), _generation(0),
+						_is_snapshot_pending(false), _snapshot_n(0) {}
 					FibClient& operator=(const FibClient& rhs) 
 					{
 						if (this != &rhs) 
@@ -218,13 +277,20 @@ class XrlFibClientManager : public FibTableObserverBase
 							_inform_fib_client_queue = rhs._inform_fib_client_queue;
 							_inform_fib_client_queue_timer = rhs._inform_fib_client_queue_timer;
 							_target_name = rhs._target_name;
+							_sent_n = rhs._sent_n;
 							_send_updates = rhs._send_updates;
 							_send_resolves = rhs._send_resolves;
+							_is_batched = rhs._is_batched;
+							_generation = rhs._generation;
+							_is_snapshot_pending = rhs._is_snapshot_pending;
+							_snapshot_n = rhs._snapshot_n;
 						}
 						return *this;
 					}
 
 					void	activate(const list<F>& fte_list);
+					void	activate_snapshot(const list<F>& fte_list,
+							uint32_t generation);
 					void	send_fib_client_route_change_cb(const XrlError& xrl_error);
 
 					bool get_send_updates() const { return _send_updates; }
@@ -234,15 +300,28 @@ class XrlFibClientManager : public FibTableObserverBase
 
 				private:
 					void	send_fib_client_route_change();
+					int	send_fib_client_route_batch();
+					void	pop_sent_route_changes();
 
 					list<F>			_inform_fib_client_queue;
 					XorpTimer		_inform_fib_client_queue_timer;
+					size_t			_sent_n;	// Queue entries being sent
 
 					string			_target_name;	// Target name of the client
 					XrlFibClientManager*	_xfcm;
 
 					bool			_send_updates;	// Event filters
 					bool			_send_resolves;
+
+					//
+					// A batched client is sent a snapshot of the FIB followed
+					// by batches of the FIB changes. The first _snapshot_n
+					// entries in the queue are the rest of the snapshot.
+					//
+					bool			_is_batched;
+					uint32_t		_generation;	// Snapshot generation
+					bool			_is_snapshot_pending;
+					size_t			_snapshot_n;
 			};
 
 		typedef FibClient<Fte4>	FibClient4;
@@ -251,6 +330,8 @@ class XrlFibClientManager : public FibTableObserverBase
 		typedef FibClient<Fte6>	FibClient6;
 		map<string, FibClient6>	_fib_clients6;
 
+		uint32_t		_generation;	// Last snapshot generation
+
 		XrlFeaFibClientV0p1Client	_xrl_fea_fib_client;
 };
 
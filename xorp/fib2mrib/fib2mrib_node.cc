@@ -38,6 +38,8 @@ Fib2mribNode::Fib2mribNode()
 	: ServiceBase("Fib2mrib"),
 	_protocol_name("fib2mrib"),	// TODO: must be known by RIB
 	_is_enabled(true),		// XXX: enabled by default
+	_fib_generation4(0),
+	_fib_generation6(0),
 	_startup_requests_n(0),
 	_shutdown_requests_n(0),
 	_is_log_trace(true)		// XXX: default to print trace logs
@@ -830,6 +832,16 @@ Fib2mribNode::replace_route(const Fib2mribRoute& fib2mrib_route,
 		return XORP_ERROR;
 	}
 
+	//
+	// If the route hasn't changed, then there is nothing to tell the RIB.
+	// E.g., most of the routes in a new FEA snapshot are unchanged.
+	//
+	if (route_to_replace_ptr->is_same_fib_entry(updated_route)) 
+	{
+		route_to_replace_ptr->set_fib_generation(updated_route.fib_generation());
+		return XORP_OK;
+	}
+
 	//
 	// Route found. Overwrite its value.
 	//
@@ -980,6 +992,110 @@ Fib2mribNode::delete_route(const Fib2mribRoute& fib2mrib_route,
 	return XORP_OK;
 }
 
+/**
+ * Apply a batch of route changes received from the FEA.
+ *
+ * @param family the address family of the routes (AF_INET or AF_INET6).
+ * @param generation the generation number of the snapshot.
+ * @param is_snapshot true if the batch is part of the snapshot.
+ * @param is_end_of_snapshot true if the batch is the last one of
+ * the snapshot.
+ * @param routes the routes to add (or replace) or delete.
+ * @param error_msg the error message (if error).
+ * @return XORP_OK on success, otherwise XORP_ERROR if any of the
+ * route changes failed.
+ */
+	int
+Fib2mribNode::apply_route_batch(int family, uint32_t generation,
+		bool is_snapshot, bool is_end_of_snapshot,
+		list<Fib2mribRoute>& routes, string& error_msg)
+{
+	uint32_t& last_generation = (family == AF_INET)?
+		_fib_generation4 : _fib_generation6;
+	size_t failed_n = 0;
+	string route_error_msg;
+
+	if (generation != last_generation) 
+	{
+		if (! is_snapshot) 
+		{
+			// XXX: a late batch from an earlier snapshot
+			return XORP_OK;
+		}
+		// The first batch of a new snapshot
+		last_generation = generation;
+	}
+
+	list<Fib2mribRoute>::iterator iter;
+	for (iter = routes.begin(); iter != routes.end(); ++iter) 
+	{
+		Fib2mribRoute& fib2mrib_route = *iter;
+		int ret_value;
+
+		fib2mrib_route.set_fib_generation(generation);
+		if (fib2mrib_route.is_delete_route())
+			ret_value = delete_route(fib2mrib_route, route_error_msg);
+		else
+			ret_value = add_route(fib2mrib_route, route_error_msg);
+		if (ret_value != XORP_OK)
+			failed_n++;
+	}
+
+	if (is_end_of_snapshot)
+		delete_stale_routes(family, generation);
+
+	if (failed_n > 0) 
+	{
+		error_msg = c_format("%u of %u route changes failed, the last "
+				"one with error: %s",
+				XORP_UINT_CAST(failed_n),
+				XORP_UINT_CAST(routes.size()),
+				route_error_msg.c_str());
+		return XORP_ERROR;
+	}
+
+	return XORP_OK;
+}
+
+/**
+ * Delete the routes that were not received in a FEA snapshot.
+ *
+ * @param family the address family of the snapshot.
+ * @param generation the generation number of the snapshot.
+ */
+	void
+Fib2mribNode::delete_stale_routes(int family, uint32_t generation)
+{
+	multimap<IPvXNet, Fib2mribRoute>::iterator route_iter;
+	list<Fib2mribRoute> stale_routes;
+	list<Fib2mribRoute>::iterator iter;
+
+	for (route_iter = _fib2mrib_routes.begin();
+			route_iter != _fib2mrib_routes.end();
+			++route_iter) 
+	{
+		Fib2mribRoute& fib2mrib_route = route_iter->second;
+		if (fib2mrib_route.network().af() != family)
+			continue;
+		if (fib2mrib_route.fib_generation() == generation)
+			continue;
+		stale_routes.push_back(fib2mrib_route);
+	}
+
+	for (iter = stale_routes.begin(); iter != stale_routes.end(); ++iter) 
+	{
+		Fib2mribRoute& fib2mrib_route = *iter;
+		string error_msg;
+
+		fib2mrib_route.set_delete_route();
+		if (delete_route(fib2mrib_route, error_msg) != XORP_OK) 
+		{
+			XLOG_ERROR("Cannot delete route that is not in the FEA "
+					"snapshot: %s", error_msg.c_str());
+		}
+	}
+}
+
 /**
  * Check whether the route entry is valid.
  * 
@@ -71,7 +71,8 @@ class Fib2mribRoute
 			_metric(metric), _admin_distance(admin_distance),
 			_protocol_origin(protocol_origin), _xorp_route(xorp_route),
 			_route_type(IDLE_ROUTE), _is_ignored(false),
-			_is_filtered(false), _is_accepted_by_nexthop(false) {}
+			_is_filtered(false), _is_accepted_by_nexthop(false),
+			_fib_generation(0) {}
 
 		/**
 		 * Constructor for a given IPv6 route.
@@ -98,7 +99,8 @@ class Fib2mribRoute
 			_metric(metric), _admin_distance(admin_distance),
 			_protocol_origin(protocol_origin), _xorp_route(xorp_route),
 			_route_type(IDLE_ROUTE), _is_ignored(false),
-			_is_filtered(false), _is_accepted_by_nexthop(false) {}
+			_is_filtered(false), _is_accepted_by_nexthop(false),
+			_fib_generation(0) {}
 
 
 		/**
@@ -119,6 +121,26 @@ class Fib2mribRoute
 					&& (_policytags == other._policytags));
 		}
 
+		/**
+		 * Test whether the route has the same information as received
+		 * from the FEA as another route.
+		 *
+		 * @param other the route to compare against.
+		 * @return true if the network, the next-hop router, the interface,
+		 * the metric, the distance and the origin of the routes are same.
+		 */
+		bool is_same_fib_entry(const Fib2mribRoute& other) const 
+		{
+			return ((_network == other.network())
+					&& (_nexthop == other.nexthop())
+					&& (_ifname == other.ifname())
+					&& (_vifname == other.vifname())
+					&& (_metric == other.metric())
+					&& (_admin_distance == other.admin_distance())
+					&& (_protocol_origin == other.protocol_origin())
+					&& (_xorp_route == other.xorp_route()));
+		}
+
 		/**
 		 * Test if this is an IPv4 route.
 		 * 
@@ -322,6 +344,23 @@ class Fib2mribRoute
 		 */
 		void set_accepted_by_nexthop(bool v) { _is_accepted_by_nexthop = v; }
 
+		/**
+		 * Get the generation number of the FEA snapshot the route was
+		 * last received in.
+		 *
+		 * @return the snapshot generation number, or zero if the route
+		 * was not received in a batch.
+		 */
+		uint32_t fib_generation() const { return _fib_generation; }
+
+		/**
+		 * Set the generation number of the FEA snapshot the route was
+		 * received in.
+		 *
+		 * @param v the snapshot generation number.
+		 */
+		void set_fib_generation(uint32_t v) { _fib_generation = v; }
+
 		/**
 		 * Test whether the route is accepted for transmission to the RIB.
 		 *
@@ -345,6 +384,7 @@ class Fib2mribRoute
 		bool	_is_filtered;	// True if rejected by a policy filter
 		bool	_is_accepted_by_nexthop; // True if the route is accepted based on its next-hop information
 		PolicyTags	_policytags;
+		uint32_t	_fib_generation; // The FEA snapshot it was received in
 };
 
 
@@ -550,6 +590,30 @@ class Fib2mribNode : public IfMgrHintObserver,
 		int delete_route6(const IPv6Net& network, const string& ifname,
 				const string& vifname, string& error_msg);
 
+		/**
+		 * Apply a batch of route changes received from the FEA.
+		 *
+		 * The FEA sends a snapshot of the FIB in one or more batches,
+		 * followed by batches of the FIB changes with the same
+		 * generation number. At the end of a snapshot, the routes that
+		 * were not in the snapshot are deleted. The batches with the
+		 * generation number of an earlier snapshot are ignored.
+		 *
+		 * @param family the address family of the routes (AF_INET or
+		 * AF_INET6).
+		 * @param generation the generation number of the snapshot.
+		 * @param is_snapshot true if the batch is part of the snapshot.
+		 * @param is_end_of_snapshot true if the batch is the last one of
+		 * the snapshot.
+		 * @param routes the routes to add (or replace) or delete.
+		 * @param error_msg the error message (if error).
+		 * @return XORP_OK on success, otherwise XORP_ERROR if any of the
+		 * route changes failed. The other changes are applied regardless.
+		 */
+		int apply_route_batch(int family, uint32_t generation,
+				bool is_snapshot, bool is_end_of_snapshot,
+				list<Fib2mribRoute>& routes, string& error_msg);
+
 		//
 		// Debug-related methods
 		//
@@ -711,6 +775,14 @@ class Fib2mribNode : public IfMgrHintObserver,
 		 */
 		int delete_route(const Fib2mribRoute& fib2mrib_route, string& error_msg);
 
+		/**
+		 * Delete the routes that were not received in a FEA snapshot.
+		 *
+		 * @param family the address family of the snapshot.
+		 * @param generation the generation number of the snapshot.
+		 */
+		void delete_stale_routes(int family, uint32_t generation);
+
 		/**
 		 * Prepare a copy of a route for transmission to the RIB.
 		 *
@@ -812,6 +884,12 @@ class Fib2mribNode : public IfMgrHintObserver,
 		//
 		multimap<IPvXNet, Fib2mribRoute>	_fib2mrib_routes;
 
+		//
+		// The generation numbers of the last FEA snapshots
+		//
+		uint32_t	_fib_generation4;
+		uint32_t	_fib_generation6;
+
 		//
 		// Status-related state
 		//
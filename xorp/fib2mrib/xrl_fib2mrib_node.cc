@@ -32,6 +32,107 @@
 
 const TimeVal XrlFib2mribNode::RETRY_TIMEVAL = TimeVal(1, 0);
 
+static void
+get_atom_value(const XrlAtom& atom, IPv4Net& v)	{ v = atom.ipv4net(); }
+static void
+get_atom_value(const XrlAtom& atom, IPv4& v)	{ v = atom.ipv4(); }
+static void
+get_atom_value(const XrlAtom& atom, IPv6Net& v)	{ v = atom.ipv6net(); }
+static void
+get_atom_value(const XrlAtom& atom, IPv6& v)	{ v = atom.ipv6(); }
+
+/**
+ * Get the routes of a batch received from the FEA.
+ *
+ * The lists are walked with iterators, because retrieving each atom
+ * by its index takes time proportional to the index.
+ *
+ * @param routes the list to append the routes to.
+ * @param error_msg the error message (if error).
+ * @return XORP_OK on success, otherwise XORP_ERROR.
+ */
+template <class A>
+static int
+get_route_batch(const XrlAtomList& network,
+		const XrlAtomList& nexthop,
+		const XrlAtomList& ifname,
+		const XrlAtomList& vifname,
+		const XrlAtomList& metric,
+		const XrlAtomList& admin_distance,
+		const XrlAtomList& protocol_origin,
+		const XrlAtomList& xorp_route,
+		const XrlAtomList& deleted,
+		list<Fib2mribRoute>& routes,
+		string& error_msg)
+{
+	size_t routes_n = network.size();
+
+	if ((nexthop.size() != routes_n)
+			|| (ifname.size() != routes_n)
+			|| (vifname.size() != routes_n)
+			|| (metric.size() != routes_n)
+			|| (admin_distance.size() != routes_n)
+			|| (protocol_origin.size() != routes_n)
+			|| (xorp_route.size() != routes_n)
+			|| (deleted.size() != routes_n)) 
+	{
+		error_msg = c_format("Route batch lists have different sizes");
+		return XORP_ERROR;
+	}
+
+	XrlAtomList::const_iterator network_iter = network.begin();
+	XrlAtomList::const_iterator nexthop_iter = nexthop.begin();
+	XrlAtomList::const_iterator ifname_iter = ifname.begin();
+	XrlAtomList::const_iterator vifname_iter = vifname.begin();
+	XrlAtomList::const_iterator metric_iter = metric.begin();
+	XrlAtomList::const_iterator admin_distance_iter = admin_distance.begin();
+	XrlAtomList::const_iterator protocol_origin_iter = protocol_origin.begin();
+	XrlAtomList::const_iterator xorp_route_iter = xorp_route.begin();
+	XrlAtomList::const_iterator deleted_iter = deleted.begin();
+
+	try 
+	{
+		for (size_t i = 0; i < routes_n; i++) 
+		{
+			IPNet<A> route_network;
+			A route_nexthop;
+
+			get_atom_value(*network_iter++, route_network);
+			get_atom_value(*nexthop_iter++, route_nexthop);
+			if ((deleted_iter++)->boolean()) 
+			{
+				Fib2mribRoute fib2mrib_route(route_network, A::ZERO(),
+						ifname_iter->text(), vifname_iter->text(),
+						0, 0, "", false);
+				fib2mrib_route.set_delete_route();
+				routes.push_back(fib2mrib_route);
+			} else 
+			{
+				Fib2mribRoute fib2mrib_route(route_network, route_nexthop,
+						ifname_iter->text(), vifname_iter->text(),
+						metric_iter->uint32(),
+						admin_distance_iter->uint32(),
+						protocol_origin_iter->text(),
+						xorp_route_iter->boolean());
+				fib2mrib_route.set_add_route();
+				routes.push_back(fib2mrib_route);
+			}
+			++ifname_iter;
+			++vifname_iter;
+			++metric_iter;
+			++admin_distance_iter;
+			++protocol_origin_iter;
+			++xorp_route_iter;
+		}
+	} catch (const XorpException& e) 
+	{
+		error_msg = c_format("Invalid route batch: %s", e.str().c_str());
+		return XORP_ERROR;
+	}
+
+	return XORP_OK;
+}
+
 XrlFib2mribNode::XrlFib2mribNode( const string&	class_name,
 		const string&	finder_hostname,
 		uint16_t	finder_port,
@@ -49,6 +150,7 @@ XrlFib2mribNode::XrlFib2mribNode( const string&	class_name,
 	_rib_target(rib_target),
 	_ifmgr( fea_target.c_str(), xrl_router().finder_address(),
 			xrl_router().finder_port()),
+	_inform_rib_batch_size(0),
 	_xrl_finder_client(&xrl_router()),
 	_is_finder_alive(false),
 	_is_fea_alive(false),
@@ -626,7 +728,7 @@ XrlFib2mribNode::send_fea_add_fib_client()
 
 	if (_fea_have_ipv4 && ! _is_fea_fib_client4_registered) 
 	{
-		success = _xrl_fea_fib_client.send_add_fib_client4(
+		success = _xrl_fea_fib_client.send_add_batch_fib_client4(
 				_fea_target.c_str(),
 				xrl_router().class_name(),
 				true,		/* send_updates */
@@ -641,7 +743,7 @@ XrlFib2mribNode::send_fea_add_fib_client()
 
 	if (_fea_have_ipv6 && ! _is_fea_fib_client6_registered) 
 	{
-		success = _xrl_fea_fib_client.send_add_fib_client6(
+		success = _xrl_fea_fib_client.send_add_batch_fib_client6(
 				_fea_target.c_str(),
 				xrl_router().class_name(),
 				true,		/* send_updates */
@@ -1491,6 +1593,81 @@ XrlFib2mribNode::fea_fib_client_0_1_resolve_route4(
 	return XrlCmdError::OKAY();
 }
 
+/**
+ *  Notification of a batch of route changes.
+ *
+ *  @param generation the generation number of the snapshot.
+ *
+ *  @param snapshot true if the batch is part of the snapshot.
+ *
+ *  @param end_of_snapshot true if the batch is the last one of the
+ *  snapshot.
+ *
+ *  @param network the network address prefixes of the routes.
+ *
+ *  @param nexthop the addresses of the next-hop routers (ignored for the
+ *  routes to delete).
+ *
+ *  @param ifname the names of the physical interfaces.
+ *
+ *  @param vifname the names of the virtual interfaces.
+ *
+ *  @param metric the routing metrics.
+ *
+ *  @param admin_distance the administratively defined distances.
+ *
+ *  @param protocol_origin the names of the protocols that originated the
+ *  routes.
+ *
+ *  @param xorp_route true for the routes installed by XORP.
+ *
+ *  @param deleted true for the routes to delete, false for the routes to
+ *  add or replace.
+ */
+XrlCmdError
+XrlFib2mribNode::fea_fib_client_0_1_apply_route_batch4(
+		// Input values,
+		const uint32_t&	generation,
+		const bool&	snapshot,
+		const bool&	end_of_snapshot,
+		const XrlAtomList&	network,
+		const XrlAtomList&	nexthop,
+		const XrlAtomList&	ifname,
+		const XrlAtomList&	vifname,
+		const XrlAtomList&	metric,
+		const XrlAtomList&	admin_distance,
+		const XrlAtomList&	protocol_origin,
+		const XrlAtomList&	xorp_route,
+		const XrlAtomList&	deleted)
+{
+	list<Fib2mribRoute> routes;
+	string error_msg;
+
+	debug_msg("fea_fib_client_0_1_apply_route_batch4(): "
+			"generation = %u snapshot = %s end_of_snapshot = %s "
+			"routes = %u\n",
+			XORP_UINT_CAST(generation),
+			bool_c_str(snapshot),
+			bool_c_str(end_of_snapshot),
+			XORP_UINT_CAST(network.size()));
+
+	if (get_route_batch<IPv4>(network, nexthop, ifname, vifname, metric,
+				admin_distance, protocol_origin, xorp_route,
+				deleted, routes, error_msg) != XORP_OK) 
+	{
+		return XrlCmdError::BAD_ARGS(error_msg);
+	}
+
+	if (Fib2mribNode::apply_route_batch(AF_INET, generation, snapshot,
+				end_of_snapshot, routes,
+				error_msg) != XORP_OK) 
+	{
+		return XrlCmdError::COMMAND_FAILED(error_msg);
+	}
+
+	return XrlCmdError::OKAY();
+}
+
 /**
  *  Enable/disable/start/stop Fib2mrib.
  *
@@ -1599,198 +1776,107 @@ XrlFib2mribNode::send_rib_route_change()
 	} while (true);
 
 	Fib2mribRoute& fib2mrib_route = _inform_rib_queue.front();
+	bool is_ipv4 = fib2mrib_route.is_ipv4();
 
 	//
 	// Check whether we have already registered with the RIB
 	//
-	if (fib2mrib_route.is_ipv4() && (! _is_rib_igp_table4_registered)) 
+	if (is_ipv4 && (! _is_rib_igp_table4_registered)) 
 	{
 		success = false;
 		goto start_timer_label;
 	}
 
-	if (fib2mrib_route.is_ipv6() && (! _is_rib_igp_table6_registered)) 
+	if ((! is_ipv4) && (! _is_rib_igp_table6_registered)) 
 	{
 		success = false;
 		goto start_timer_label;
 	}
 
 	//
-	// Send the appropriate XRL
+	// Send the route changes at the front of the queue that are for
+	// the same address family as a single batch.
 	//
-	if (fib2mrib_route.is_add_route()) 
 	{
-		if (fib2mrib_route.is_ipv4()) 
-		{
-			if (fib2mrib_route.is_interface_route()) 
-			{
-				success = _xrl_rib_client.send_add_interface_route4(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv4net(),
-						fib2mrib_route.nexthop().get_ipv4(),
-						fib2mrib_route.ifname(),
-						fib2mrib_route.vifname(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
-			} else 
-			{
-				success = _xrl_rib_client.send_add_route4(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv4net(),
-						fib2mrib_route.nexthop().get_ipv4(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
-			}
-		}
-
-		if (fib2mrib_route.is_ipv6()) 
+		XrlAtomList op, network, nexthop, ifname, vifname, metric;
+		XrlAtomList policytag_count, policytags;
+		list<Fib2mribRoute>::iterator iter;
+
+		_inform_rib_batch_size = 0;
+		for (iter = _inform_rib_queue.begin();
+				iter != _inform_rib_queue.end();
+				++iter) 
 		{
-			if (fib2mrib_route.is_interface_route()) 
+			Fib2mribRoute& tmp_fib2mrib_route = *iter;
+
+			if ((tmp_fib2mrib_route.is_ipv4() != is_ipv4)
+					|| (op.size() == MAX_RIB_BATCH))
+				break;
+			_inform_rib_batch_size++;
+			if (tmp_fib2mrib_route.is_ignored())
+				continue;
+
+			op.append(XrlAtom(string(
+							(tmp_fib2mrib_route.is_add_route())? "add"
+							: (tmp_fib2mrib_route.is_replace_route())? "replace"
+							: "delete")));
+			if (is_ipv4) 
 			{
-				success = _xrl_rib_client.send_add_interface_route6(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv6net(),
-						fib2mrib_route.nexthop().get_ipv6(),
-						fib2mrib_route.ifname(),
-						fib2mrib_route.vifname(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
+				network.append(XrlAtom(
+							tmp_fib2mrib_route.network().get_ipv4net()));
+				nexthop.append(XrlAtom(
+							tmp_fib2mrib_route.nexthop().get_ipv4()));
 			} else 
 			{
-				success = _xrl_rib_client.send_add_route6(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv6net(),
-						fib2mrib_route.nexthop().get_ipv6(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
+				network.append(XrlAtom(
+							tmp_fib2mrib_route.network().get_ipv6net()));
+				nexthop.append(XrlAtom(
+							tmp_fib2mrib_route.nexthop().get_ipv6()));
 			}
-		}
-	}
-
-	if (fib2mrib_route.is_replace_route()) 
-	{
-		if (fib2mrib_route.is_ipv4()) 
-		{
-			if (fib2mrib_route.is_interface_route()) 
+			if (tmp_fib2mrib_route.is_interface_route()) 
 			{
-				success = _xrl_rib_client.send_replace_interface_route4(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv4net(),
-						fib2mrib_route.nexthop().get_ipv4(),
-						fib2mrib_route.ifname(),
-						fib2mrib_route.vifname(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
+				ifname.append(XrlAtom(tmp_fib2mrib_route.ifname()));
+				vifname.append(XrlAtom(tmp_fib2mrib_route.vifname()));
 			} else 
 			{
-				success = _xrl_rib_client.send_replace_route4(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv4net(),
-						fib2mrib_route.nexthop().get_ipv4(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
+				ifname.append(XrlAtom(string("")));
+				vifname.append(XrlAtom(string("")));
 			}
-		}
+			metric.append(XrlAtom(tmp_fib2mrib_route.metric()));
 
-		if (fib2mrib_route.is_ipv6()) 
-		{
-			if (fib2mrib_route.is_interface_route()) 
-			{
-				success = _xrl_rib_client.send_replace_interface_route6(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv6net(),
-						fib2mrib_route.nexthop().get_ipv6(),
-						fib2mrib_route.ifname(),
-						fib2mrib_route.vifname(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
-			} else 
+			XrlAtomList tags = tmp_fib2mrib_route.policytags().xrl_atomlist();
+			policytag_count.append(XrlAtom(static_cast<uint32_t>(tags.size())));
+			for (XrlAtomList::const_iterator tag_iter = tags.begin();
+					tag_iter != tags.end();
+					++tag_iter) 
 			{
-				success = _xrl_rib_client.send_replace_route6(
-						_rib_target.c_str(),
-						Fib2mribNode::protocol_name(),
-						false,			/* unicast */
-						true,			/* multicast */
-						fib2mrib_route.network().get_ipv6net(),
-						fib2mrib_route.nexthop().get_ipv6(),
-						fib2mrib_route.metric(),
-						fib2mrib_route.policytags().xrl_atomlist(),
-						callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-				if (success)
-					return;
+				policytags.append(*tag_iter);
 			}
 		}
-	}
 
-	if (fib2mrib_route.is_delete_route()) 
-	{
-		if (fib2mrib_route.is_ipv4()) 
+		if (is_ipv4) 
 		{
-			success = _xrl_rib_client.send_delete_route4(
+			success = _xrl_rib_client.send_apply_route_batch4(
 					_rib_target.c_str(),
 					Fib2mribNode::protocol_name(),
 					false,			/* unicast */
 					true,			/* multicast */
-					fib2mrib_route.network().get_ipv4net(),
+					op, network, nexthop, ifname, vifname, metric,
+					policytag_count, policytags,
 					callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-			if (success)
-				return;
-		}
-
-		if (fib2mrib_route.is_ipv6()) 
+		} else 
 		{
-			success = _xrl_rib_client.send_delete_route6(
+			success = _xrl_rib_client.send_apply_route_batch6(
 					_rib_target.c_str(),
 					Fib2mribNode::protocol_name(),
 					false,			/* unicast */
 					true,			/* multicast */
-					fib2mrib_route.network().get_ipv6net(),
+					op, network, nexthop, ifname, vifname, metric,
+					policytag_count, policytags,
 					callback(this, &XrlFib2mribNode::send_rib_route_change_cb));
-			if (success)
-				return;
 		}
+		if (success)
+			return;
 	}
 
 	if (! success) 
@@ -1798,12 +1884,9 @@ XrlFib2mribNode::send_rib_route_change()
 		//
 		// If an error, then start a timer to try again.
 		//
-		XLOG_ERROR("Failed to %s route for %s with the RIB. "
+		XLOG_ERROR("Failed to send %u route changes to the RIB. "
 				"Will try again.",
-				(fib2mrib_route.is_add_route())? "add"
-				: (fib2mrib_route.is_replace_route())? "replace"
-				: "delete",
-				fib2mrib_route.network().str().c_str());
+				XORP_UINT_CAST(_inform_rib_batch_size));
 start_timer_label:
 		_inform_rib_queue_timer = EventLoop::instance().new_oneoff_after(
 				RETRY_TIMEVAL,
@@ -1811,6 +1894,17 @@ start_timer_label:
 	}
 }
 
+/**
+ * Remove the route changes of the batch last sent to the RIB from the
+ * queue.
+ */
+	void
+XrlFib2mribNode::pop_rib_route_change_batch()
+{
+	for ( ; _inform_rib_batch_size > 0; _inform_rib_batch_size--)
+		_inform_rib_queue.pop_front();
+}
+
 	void
 XrlFib2mribNode::send_rib_route_change_cb(const XrlError& xrl_error)
 {
@@ -1820,7 +1914,7 @@ XrlFib2mribNode::send_rib_route_change_cb(const XrlError& xrl_error)
 			//
 			// If success, then send the next route change
 			//
-			_inform_rib_queue.pop_front();
+			pop_rib_route_change_batch();
 			send_rib_route_change();
 			break;
 
@@ -1829,12 +1923,9 @@ XrlFib2mribNode::send_rib_route_change_cb(const XrlError& xrl_error)
 			// If a command failed because the other side rejected it,
 			// then print an error and send the next one.
 			//
-			XLOG_ERROR("Cannot %s a routing entry with the RIB: %s",
-					(_inform_rib_queue.front().is_add_route())? "add"
-					: (_inform_rib_queue.front().is_replace_route())? "replace"
-					: "delete",
+			XLOG_ERROR("Cannot apply route changes with the RIB: %s",
 					xrl_error.str().c_str());
-			_inform_rib_queue.pop_front();
+			pop_rib_route_change_batch();
 			send_rib_route_change();
 			break;
 
@@ -1847,12 +1938,9 @@ XrlFib2mribNode::send_rib_route_change_cb(const XrlError& xrl_error)
 			// Probably we caught it here because of event reordering.
 			// In some cases we print an error. In other cases our job is done.
 			//
-			XLOG_ERROR("Cannot %s a routing entry with the RIB: %s",
-					(_inform_rib_queue.front().is_add_route())? "add"
-					: (_inform_rib_queue.front().is_replace_route())? "replace"
-					: "delete",
+			XLOG_ERROR("Cannot apply route changes with the RIB: %s",
 					xrl_error.str().c_str());
-			_inform_rib_queue.pop_front();
+			pop_rib_route_change_batch();
 			send_rib_route_change();
 			break;
 
@@ -1875,11 +1963,8 @@ XrlFib2mribNode::send_rib_route_change_cb(const XrlError& xrl_error)
 			//
 			if (! _inform_rib_queue_timer.scheduled()) 
 			{
-				XLOG_ERROR("Failed to %s a routing entry with the RIB: %s. "
+				XLOG_ERROR("Failed to apply route changes with the RIB: %s. "
 						"Will try again.",
-						(_inform_rib_queue.front().is_add_route())? "add"
-						: (_inform_rib_queue.front().is_replace_route())? "replace"
-						: "delete",
 						xrl_error.str().c_str());
 				_inform_rib_queue_timer = EventLoop::instance().new_oneoff_after(
 						RETRY_TIMEVAL,
@@ -2040,6 +2125,81 @@ XrlFib2mribNode::fea_fib_client_0_1_resolve_route6(
 	return XrlCmdError::OKAY();
 }
 
+/**
+ *  Notification of a batch of route changes.
+ *
+ *  @param generation the generation number of the snapshot.
+ *
+ *  @param snapshot true if the batch is part of the snapshot.
+ *
+ *  @param end_of_snapshot true if the batch is the last one of the
+ *  snapshot.
+ *
+ *  @param network the network address prefixes of the routes.
+ *
+ *  @param nexthop the addresses of the next-hop routers (ignored for the
+ *  routes to delete).
+ *
+ *  @param ifname the names of the physical interfaces.
+ *
+ *  @param vifname the names of the virtual interfaces.
+ *
+ *  @param metric the routing metrics.
+ *
+ *  @param admin_distance the administratively defined distances.
+ *
+ *  @param protocol_origin the names of the protocols that originated the
+ *  routes.
+ *
+ *  @param xorp_route true for the routes installed by XORP.
+ *
+ *  @param deleted true for the routes to delete, false for the routes to
+ *  add or replace.
+ */
+XrlCmdError
+XrlFib2mribNode::fea_fib_client_0_1_apply_route_batch6(
+		// Input values,
+		const uint32_t&	generation,
+		const bool&	snapshot,
+		const bool&	end_of_snapshot,
+		const XrlAtomList&	network,
+		const XrlAtomList&	nexthop,
+		const XrlAtomList&	ifname,
+		const XrlAtomList&	vifname,
+		const XrlAtomList&	metric,
+		const XrlAtomList&	admin_distance,
+		const XrlAtomList&	protocol_origin,
+		const XrlAtomList&	xorp_route,
+		const XrlAtomList&	deleted)
+{
+	list<Fib2mribRoute> routes;
+	string error_msg;
+
+	debug_msg("fea_fib_client_0_1_apply_route_batch6(): "
+			"generation = %u snapshot = %s end_of_snapshot = %s "
+			"routes = %u\n",
+			XORP_UINT_CAST(generation),
+			bool_c_str(snapshot),
+			bool_c_str(end_of_snapshot),
+			XORP_UINT_CAST(network.size()));
+
+	if (get_route_batch<IPv6>(network, nexthop, ifname, vifname, metric,
+				admin_distance, protocol_origin, xorp_route,
+				deleted, routes, error_msg) != XORP_OK) 
+	{
+		return XrlCmdError::BAD_ARGS(error_msg);
+	}
+
+	if (Fib2mribNode::apply_route_batch(AF_INET6, generation, snapshot,
+				end_of_snapshot, routes,
+				error_msg) != XORP_OK) 
+	{
+		return XrlCmdError::COMMAND_FAILED(error_msg);
+	}
+
+	return XrlCmdError::OKAY();
+}
+
 	void
 XrlFib2mribNode::fea_fti_client_send_have_ipv6_cb(const XrlError& xrl_error,
 		const bool* result)
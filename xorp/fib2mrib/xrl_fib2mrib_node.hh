@@ -233,6 +233,52 @@ class XrlFib2mribNode : public Fib2mribNode,
 				// Input values,
 				const IPv4Net&	network);
 
+		/**
+		 *  Notification of a batch of route changes.
+		 *
+		 *  @param generation the generation number of the snapshot.
+		 *
+		 *  @param snapshot true if the batch is part of the snapshot.
+		 *
+		 *  @param end_of_snapshot true if the batch is the last one of the
+		 *  snapshot.
+		 *
+		 *  @param network the network address prefixes of the routes.
+		 *
+		 *  @param nexthop the addresses of the next-hop routers (ignored for
+		 *  the routes to delete).
+		 *
+		 *  @param ifname the names of the physical interfaces.
+		 *
+		 *  @param vifname the names of the virtual interfaces.
+		 *
+		 *  @param metric the routing metrics.
+		 *
+		 *  @param admin_distance the administratively defined distances.
+		 *
+		 *  @param protocol_origin the names of the protocols that originated
+		 *  the routes.
+		 *
+		 *  @param xorp_route true for the routes installed by XORP.
+		 *
+		 *  @param deleted true for the routes to delete, false for the routes
+		 *  to add or replace.
+		 */
+		XrlCmdError fea_fib_client_0_1_apply_route_batch4(
+				// Input values,
+				const uint32_t&	generation,
+				const bool&	snapshot,
+				const bool&	end_of_snapshot,
+				const XrlAtomList&	network,
+				const XrlAtomList&	nexthop,
+				const XrlAtomList&	ifname,
+				const XrlAtomList&	vifname,
+				const XrlAtomList&	metric,
+				const XrlAtomList&	admin_distance,
+				const XrlAtomList&	protocol_origin,
+				const XrlAtomList&	xorp_route,
+				const XrlAtomList&	deleted);
+
 		/**
 		 *  Enable/disable/start/stop Fib2mrib.
 		 *
@@ -314,6 +360,21 @@ class XrlFib2mribNode : public Fib2mribNode,
 				// Input values,
 				const IPv6Net&	network);
 
+		XrlCmdError fea_fib_client_0_1_apply_route_batch6(
+				// Input values,
+				const uint32_t&	generation,
+				const bool&	snapshot,
+				const bool&	end_of_snapshot,
+				const XrlAtomList&	network,
+				const XrlAtomList&	nexthop,
+				const XrlAtomList&	ifname,
+				const XrlAtomList&	vifname,
+				const XrlAtomList&	metric,
+				const XrlAtomList&	admin_distance,
+				const XrlAtomList&	protocol_origin,
+				const XrlAtomList&	xorp_route,
+				const XrlAtomList&	deleted);
+
 
 	private:
 		const ServiceBase* ifmgr_mirror_service_base() const 
@@ -380,6 +441,7 @@ class XrlFib2mribNode : public Fib2mribNode,
 
 		void send_rib_route_change();
 		void send_rib_route_change_cb(const XrlError& xrl_error);
+		void pop_rib_route_change_batch();
 
 		XrlFtiV0p2Client	_xrl_fea_fti_client;
 		XrlFeaFibV0p1Client	_xrl_fea_fib_client;
@@ -391,10 +453,17 @@ class XrlFib2mribNode : public Fib2mribNode,
 		IfMgrXrlMirror	_ifmgr;
 		list<Fib2mribRoute>	_inform_rib_queue;
 		XorpTimer		_inform_rib_queue_timer;
+		size_t			_inform_rib_batch_size;	// Queued changes sent
 		XrlFinderEventNotifierV0p1Client	_xrl_finder_client;
 
 		static const TimeVal RETRY_TIMEVAL;
 
+		/**
+		 * The maximum number of route changes sent to the RIB in a
+		 * single batch.
+		 */
+		static const size_t MAX_RIB_BATCH = 1000;
+
 		bool		_is_finder_alive;
 
 		bool		_is_fea_alive;
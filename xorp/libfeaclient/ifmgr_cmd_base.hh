@@ -70,6 +70,18 @@ class IfMgrCommandBase
 	 * Render command as string.
 	 */
 	virtual string str() const = 0;
+
+	/**
+	 * Get the key of the state the command sets.
+	 *
+	 * A command that is still queued for forwarding is superseded by
+	 * a later command with the same key, e.g., an interface's MTU
+	 * is superseded by a later MTU of the same interface.
+	 *
+	 * @return the key of the state, or an empty string if the command
+	 * is never superseded.
+	 */
+	virtual string supersede_key() const;
 };
 
 #endif // __LIBFEACLIENT_IFMGR_CMD_BASE_HH__
@@ -85,10 +85,34 @@ IfMgrCommandDispatcher::execute()
 // ----------------------------------------------------------------------------
 // IfMgrCommandFifoQueue
 
+IfMgrCommandFifoQueue::IfMgrCommandFifoQueue()
+    : _fifo_size(0), _superseded_n(0)
+{
+}
+
     void
 IfMgrCommandFifoQueue::push(const Cmd& c)
 {
-    _fifo.push_back(c);
+    string key = c->supersede_key();
+
+    if (key.empty()) 
+    {
+	// The queued commands can't be superseded past this command
+	_latest.clear();
+	_fifo.push_back(c);
+	_fifo_size++;
+	return;
+    }
+
+    map<string, CmdList::iterator>::iterator iter = _latest.find(key);
+    if (iter != _latest.end()) 
+    {
+	_fifo.erase(iter->second);
+	_fifo_size--;
+	_superseded_n++;
+    }
+    _latest[key] = _fifo.insert(_fifo.end(), c);
+    _fifo_size++;
 }
 
 bool
@@ -112,7 +136,16 @@ IfMgrCommandFifoQueue::front() const
     void
 IfMgrCommandFifoQueue::pop_front()
 {
+    string key = _fifo.front()->supersede_key();
+
+    if (! key.empty()) 
+    {
+	map<string, CmdList::iterator>::iterator iter = _latest.find(key);
+	if ((iter != _latest.end()) && (iter->second == _fifo.begin()))
+	    _latest.erase(iter);
+    }
     _fifo.pop_front();
+    _fifo_size--;
 }
 
 
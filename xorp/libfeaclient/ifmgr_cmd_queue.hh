@@ -210,6 +210,14 @@ class IfMgrCommandQueueBase : public IfMgrCommandSinkBase
 
 /**
  * @short FIFO Queue for command objects.
+ *
+ * A command pushed into the queue supersedes a queued command with the
+ * same key (see @ref IfMgrCommandBase::supersede_key), which is
+ * removed from the queue. E.g., if an interface flaps while the queue
+ * is not drained, only its latest state is queued. A command that
+ * is never superseded (e.g., adding or removing an interface) is a
+ * barrier: the commands queued before it are not superseded by the
+ * commands pushed after it.
  */
 class IfMgrCommandFifoQueue : public IfMgrCommandQueueBase 
 {
@@ -217,14 +225,32 @@ class IfMgrCommandFifoQueue : public IfMgrCommandQueueBase
 	typedef IfMgrCommandQueueBase::Cmd Cmd;
 
     public:
+	IfMgrCommandFifoQueue();
+
 	void 	push(const Cmd& cmd);
 	bool	empty() const;
 	Cmd&	front();
 	const Cmd&	front() const;
 	void	pop_front();
 
+	/**
+	 * @return the number of commands in the queue.
+	 */
+	size_t	size() const		{ return _fifo_size; }
+
+	/**
+	 * @return the number of commands that were superseded.
+	 */
+	size_t	superseded_n() const	{ return _superseded_n; }
+
     protected:
-	list<Cmd> _fifo;
+	typedef list<Cmd> CmdList;
+
+	CmdList	_fifo;
+	size_t	_fifo_size;
+	// The commands that may be superseded, by key
+	map<string, CmdList::iterator> _latest;
+	size_t	_superseded_n;
 };
 
 /**
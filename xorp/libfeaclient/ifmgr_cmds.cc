@@ -21,6 +21,8 @@
 
 
 
+#include <typeinfo>
+
 #include "libxorp/c_format.hh"
 #include "ifmgr_atoms.hh"
 #include "ifmgr_cmds.hh"
@@ -113,6 +115,12 @@ IfMgrCommandBase::~IfMgrCommandBase()
 {
 }
 
+string
+IfMgrCommandBase::supersede_key() const
+{
+    return string();
+}
+
 
 // ----------------------------------------------------------------------------
 //
@@ -120,6 +128,24 @@ IfMgrCommandBase::~IfMgrCommandBase()
 //
 // ----------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+// IfMgrIfCommandBase
+
+//
+// The key is the type of the command followed by the names of the
+// object it relates to. The names can't contain '\0', hence it is used
+// as the separator.
+//
+string
+IfMgrIfCommandBase::supersede_key() const
+{
+    string key(typeid(*this).name());
+
+    key += '\0';
+    key += ifname();
+    return key;
+}
+
 // ----------------------------------------------------------------------------
 // IfMgrIfCommandAdd
 
@@ -563,6 +589,17 @@ IfMgrIfSetString::str() const
 	+ ", " + _str + c_format(" %i", _tp) + vif_str_end();
 }
 
+string
+IfMgrIfSetString::supersede_key() const
+{
+    string key(IfMgrIfCommandBase::supersede_key());
+
+    // The string type is part of the state the command sets
+    key += '\0';
+    key += c_format("%i", _tp);
+    return key;
+}
+
 
 // ----------------------------------------------------------------------------
 //
@@ -571,6 +608,19 @@ IfMgrIfSetString::str() const
 // ----------------------------------------------------------------------------
 
 
+// ----------------------------------------------------------------------------
+// IfMgrVifCommandBase
+
+string
+IfMgrVifCommandBase::supersede_key() const
+{
+    string key(IfMgrIfCommandBase::supersede_key());
+
+    key += '\0';
+    key += vifname();
+    return key;
+}
+
 // ----------------------------------------------------------------------------
 // IfMgrVifAdd
 
@@ -906,6 +956,22 @@ IfMgrVifSetVifIndex::str() const
 //
 // ----------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+// IfMgrIPv4CommandBase
+
+string
+IfMgrIPv4CommandBase::supersede_key() const
+{
+    string key(IfMgrVifCommandBase::supersede_key());
+
+    key += '\0';
+    key += addr().str();
+    return key;
+}
+
+// ----------------------------------------------------------------------------
+// IfMgrIPv4Add
+
 bool
 IfMgrIPv4Add::execute(IfMgrIfTree& tree) const
 {
@@ -1172,6 +1238,22 @@ IfMgrIPv4SetEndpoint::str() const
 //
 // ----------------------------------------------------------------------------
 
+// ----------------------------------------------------------------------------
+// IfMgrIPv6CommandBase
+
+string
+IfMgrIPv6CommandBase::supersede_key() const
+{
+    string key(IfMgrVifCommandBase::supersede_key());
+
+    key += '\0';
+    key += addr().str();
+    return key;
+}
+
+// ----------------------------------------------------------------------------
+// IfMgrIPv6Add
+
 bool
 IfMgrIPv6Add::execute(IfMgrIfTree& tree) const
 {
@@ -1452,3 +1534,13 @@ IfMgrHintUpdatesMade::str() const
 {
     return "IfMgrHintUpdatesMade";
 }
+
+//
+// XXX: a hint that updates were made is superseded by a later hint,
+// because the later hint follows the same updates.
+//
+string
+IfMgrHintUpdatesMade::supersede_key() const
+{
+    return str();
+}
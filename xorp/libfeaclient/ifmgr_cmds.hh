@@ -39,6 +39,8 @@ class IfMgrIfCommandBase : public IfMgrCommandBase
 		 */
 		const string& ifname() const		{ return _ifname; }
 
+		string supersede_key() const;
+
 	protected:
 		string	_ifname;
 };
@@ -60,6 +62,8 @@ class IfMgrIfAdd : public IfMgrIfCommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -79,6 +83,8 @@ class IfMgrIfRemove : public IfMgrIfCommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -323,6 +329,8 @@ class IfMgrVifCommandBase : public IfMgrIfCommandBase
 		 */
 		const string& vifname() const		{ return _vifname; }
 
+		string supersede_key() const;
+
 	protected:
 		string	_vifname;
 };
@@ -349,6 +357,8 @@ class IfMgrIfSetString : public IfMgrIfCommandBase
 
 		string str() const;
 
+		string supersede_key() const;
+
 	protected:
 		string _str;
 		IfStringTypeE _tp;
@@ -401,6 +411,8 @@ class IfMgrVifAdd : public IfMgrVifCommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -420,6 +432,8 @@ class IfMgrVifRemove : public IfMgrVifCommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -657,6 +671,8 @@ class IfMgrIPv4CommandBase : public IfMgrVifCommandBase
 		 */
 		const IPv4& addr() const 			{ return _addr; }
 
+		string supersede_key() const;
+
 	protected:
 		IPv4	_addr;
 };
@@ -680,6 +696,8 @@ class IfMgrIPv4Add : public IfMgrIPv4CommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -701,6 +719,8 @@ class IfMgrIPv4Remove : public IfMgrIPv4CommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -894,6 +914,8 @@ class IfMgrIPv6CommandBase : public IfMgrVifCommandBase
 		 */
 		const IPv6& addr() const 			{ return _addr; }
 
+		string supersede_key() const;
+
 	protected:
 		IPv6	_addr;
 };
@@ -917,6 +939,8 @@ class IfMgrIPv6Add : public IfMgrIPv6CommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -938,6 +962,8 @@ class IfMgrIPv6Remove : public IfMgrIPv6CommandBase
 				const IfMgrXrlSendCB&	xscb) const;
 
 		string str() const;
+
+		string supersede_key() const	{ return string(); }
 };
 
 /**
@@ -1121,6 +1147,8 @@ class IfMgrHintUpdatesMade : public IfMgrHintCommandBase
 				const string&		xrl_target,
 				const IfMgrXrlSendCB&	xscb) const;
 		string str() const;
+
+		string supersede_key() const;
 };
 
 #endif // __LIBFEACLIENT_IFMGR_CMDS_HH__
@@ -310,6 +310,10 @@ class IfMgrXrlMirrorTarget : protected XrlFeaIfmgrMirrorTargetBase
 
 	XrlCmdError fea_ifmgr_mirror_0_1_hint_updates_made();
 
+	XrlCmdError fea_ifmgr_mirror_0_1_apply_batch(
+		// Input values,
+		const XrlAtomList&	commands);
+
     protected:
 	// Not implemented
 	IfMgrXrlMirrorTarget();
@@ -984,6 +988,53 @@ IfMgrXrlMirrorTarget::fea_ifmgr_mirror_0_1_hint_updates_made()
     return XrlCmdError::OKAY();
 }
 
+    static void
+apply_batch_cb(const XrlCmdError& e, const XrlArgs* /* a */, XrlError* err)
+{
+    *err = e;
+}
+
+    XrlCmdError
+IfMgrXrlMirrorTarget::fea_ifmgr_mirror_0_1_apply_batch(
+	const XrlAtomList& commands)
+{
+    static const string apply_batch_command =
+	"fea_ifmgr_mirror/0.1/apply_batch";
+    XrlAtomList::const_iterator iter;
+
+    //
+    // Each command is dispatched to the handler of its own Xrl, as if
+    // it was received on its own. The handlers don't defer their
+    // response, hence the result of each command is known before the
+    // next command is dispatched.
+    //
+    for (iter = commands.begin(); iter != commands.end(); ++iter) 
+    {
+	XrlError err = XrlError::OKAY();
+	try 
+	{
+	    Xrl xrl(iter->text().c_str());
+	    const XrlCmdEntry* ce = NULL;
+	    if (xrl.command() != apply_batch_command)
+		ce = _rtr.get_handler(xrl.command());
+	    if (ce == NULL) 
+	    {
+		return XrlCmdError::BAD_ARGS(c_format("Bad batch command: %s",
+			    xrl.command().c_str()));
+	    }
+	    ce->dispatch(xrl.args(), callback(&apply_batch_cb, &err));
+	} catch (const XorpException& e) 
+	{
+	    return XrlCmdError::BAD_ARGS(e.str());
+	}
+	if (err == XrlError::BAD_ARGS())
+	    return XrlCmdError::BAD_ARGS(err.note());
+	if (err != XrlError::OKAY())
+	    return XrlCmdError::COMMAND_FAILED(DISPATCH_FAILED);
+    }
+    return XrlCmdError::OKAY();
+}
+
 
 // ----------------------------------------------------------------------------
 // IfMgrXrlMirrorRouter
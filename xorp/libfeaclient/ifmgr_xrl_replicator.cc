@@ -29,29 +29,64 @@
 
 #include "libxipc/xrl_router.hh"
 
+#include "xrl/interfaces/fea_ifmgr_mirror_xif.hh"
+
 #include "ifmgr_xrl_replicator.hh"
 
 
+/**
+ * @short An XrlSender that stores the Xrls instead of sending them.
+ *
+ * The commands are forwarded to it to get the textual form of their
+ * Xrls, which are then sent in a single apply_batch Xrl.
+ */
+class IfMgrXrlBatchSender : public XrlSender 
+{
+    public:
+	IfMgrXrlBatchSender(XrlAtomList& xrls) : _xrls(xrls) {}
+
+	bool send(const Xrl& xrl, const XrlSender::Callback& /* scb */) {
+	    _xrls.append(XrlAtom(xrl.str()));
+	    return true;
+	}
+
+	bool pending() const { return false; }
+
+    private:
+	XrlAtomList&	_xrls;
+};
+
+
 IfMgrXrlReplicator::IfMgrXrlReplicator(XrlSender&	sender,
 	const string&	xrl_target_name)
-: _s(sender), _tgt(xrl_target_name), _pending(false)
+: _s(sender), _tgt(xrl_target_name), _pending(false), _batch_n(0)
 {
 }
 
     void
 IfMgrXrlReplicator::push(const Cmd& cmd)
 {
-    if (_queue.empty()) 
-    {
-	XLOG_ASSERT(_pending == false);
-	_queue.push(cmd);
+    bool was_empty = is_empty_queue();
+    size_t superseded_n = _queue.superseded_n();
+
+    _queue.push(cmd);
+
+    //
+    // XXX: a command that supersedes a queued command takes the place
+    // of that command in the manager's queue, so that the commands
+    // queued are always as many as the manager's queue entries.
+    // Hence no target receives a command later than the order it was
+    // registered in.
+    //
+    if (_queue.superseded_n() == superseded_n)
 	push_manager_queue();
+
+    //
+    // XXX: if a dispatch is in progress or commands are queued already,
+    // the queue is cranked after the dispatch in progress completes.
+    //
+    if (was_empty)
 	crank_manager();
-    } else 
-    {
-	_queue.push(cmd);
-	push_manager_queue();
-    }
 }
 
     void
@@ -63,10 +98,47 @@ IfMgrXrlReplicator::crank_replicator()
     if (_queue.empty())
 	return;
 
+    size_t batch_n = min(_queue.size(), manager_batch_limit());
+    if (batch_n == 0)
+	return;
+
     _pending = true;
+    _batch_n = batch_n;
+
+    //
+    // The commands are removed from the queue when they are dispatched,
+    // so the commands that are queued meanwhile can't supersede them.
+    //
+    if (batch_n == 1) 
+    {
+	Cmd c = _queue.front();
+	_queue.pop_front();
+	if (c->forward(_s, _tgt, callback(this, &IfMgrXrlReplicator::xrl_cb))
+		== false) 
+	{
+	    // XXX todo
+	    XLOG_FATAL("Send failed.");
+	}
+	return;
+    }
 
-    Cmd c = _queue.front();
-    if (c->forward(_s, _tgt, callback(this, &IfMgrXrlReplicator::xrl_cb))
+    XrlAtomList commands;
+    IfMgrXrlBatchSender batch_sender(commands);
+    for (size_t i = 0; i < batch_n; i++) 
+    {
+	Cmd c = _queue.front();
+	_queue.pop_front();
+	if (c->forward(batch_sender, _tgt,
+		    callback(this, &IfMgrXrlReplicator::xrl_cb))
+		== false) 
+	{
+	    XLOG_FATAL("Cannot encode command %s", c->str().c_str());
+	}
+    }
+
+    XrlFeaIfmgrMirrorV0p1Client client(&_s);
+    if (client.send_apply_batch(_tgt.c_str(), commands,
+		callback(this, &IfMgrXrlReplicator::xrl_cb))
 	    == false) 
     {
 	// XXX todo
@@ -77,11 +149,9 @@ IfMgrXrlReplicator::crank_replicator()
     void
 IfMgrXrlReplicator::xrl_cb(const XrlError& err)
 {
-    XLOG_ASSERT(_queue.empty() == false);
+    XLOG_ASSERT(_pending == true);
 
     _pending = false;
-    Cmd c = _queue.front();
-    _queue.pop_front();
 
     if (err == XrlError::OKAY()) 
     {
@@ -120,6 +190,16 @@ IfMgrXrlReplicator::crank_manager_cb()
     crank_replicator();
 }
 
+//
+// XXX: note that this method may be overwritten by
+// IfMgrManagedXrlReplicator::manager_batch_limit()
+//
+    size_t
+IfMgrXrlReplicator::manager_batch_limit() const
+{
+    return MAX_COMMAND_BATCH;
+}
+
 //
 // XXX: note that this method may be overwritten by
 // IfMgrManagedXrlReplicator::push_manager_queue()
@@ -157,7 +237,13 @@ IfMgrManagedXrlReplicator::crank_manager()
     void
 IfMgrManagedXrlReplicator::crank_manager_cb()
 {
-    _mgr.crank_replicators_queue_cb();
+    _mgr.crank_replicators_queue_cb(_batch_n);
+}
+
+    size_t
+IfMgrManagedXrlReplicator::manager_batch_limit() const
+{
+    return _mgr.replicators_queue_run(this, MAX_COMMAND_BATCH);
 }
 
 
@@ -278,15 +364,36 @@ IfMgrXrlReplicationManager::crank_replicators_queue()
 }
 
     void
-IfMgrXrlReplicationManager::crank_replicators_queue_cb()
+IfMgrXrlReplicationManager::crank_replicators_queue_cb(size_t commands_n)
 {
-    XLOG_ASSERT(_replicators_queue.empty() == false);
+    //
+    // XXX: the commands dispatched were the commands of the entries at
+    // the head of the queue.
+    //
+    XLOG_ASSERT(_replicators_queue.size() >= commands_n);
 
-    _replicators_queue.pop_front();
+    for (size_t i = 0; i < commands_n; i++)
+	_replicators_queue.pop_front();
 
     crank_replicators_queue();
 }
 
+    size_t
+IfMgrXrlReplicationManager::replicators_queue_run(
+    const IfMgrManagedXrlReplicator* r, size_t max_n) const
+{
+    size_t n = 0;
+
+    Outputs::const_iterator ci;
+    for (ci = _replicators_queue.begin(); ci != _replicators_queue.end(); ++ci) 
+    {
+	if ((*ci != r) || (n == max_n))
+	    break;
+	n++;
+    }
+    return n;
+}
+
     void
 IfMgrXrlReplicationManager::push_manager_queue(IfMgrManagedXrlReplicator* r)
 {
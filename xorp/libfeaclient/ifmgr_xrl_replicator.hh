@@ -39,11 +39,15 @@
  * The IfMgrXrlReplicator contains an @ref IfMgrCommandFifoQueue and
  * adds commands to it when @ref IfMgrXrlReplicator::push is called.
  * Invoking push also cranks the queue if an Xrl dispatch is not in
- * progress.  Cranking causes the Xrl at the head of the queue to be
- * dispatched.
+ * progress.  Cranking causes the commands at the head of the queue
+ * (up to @ref IfMgrXrlReplicator::MAX_COMMAND_BATCH of them, or fewer
+ * if @ref IfMgrXrlReplicator::manager_batch_limit says so) to be
+ * dispatched in a single fea_ifmgr_mirror/0.1/apply_batch Xrl, or as
+ * their own Xrl if there is only one command.  The queue coalesces
+ * the commands that are superseded while they wait for dispatching.
  *
- * On the successful dispatch of an Xrl, the next command ready for
- * dispatching as an Xrl is taken from the queue and dispatched if
+ * On the successful dispatch of an Xrl, the next commands ready for
+ * dispatching are taken from the queue and dispatched if
  * available.  If no command is available, processing stops.  If an
  * Xrl dispatch fails, the overrideable method @ref
  * IfMgrXrlReplicator::xrl_error_event is called.  After an error, the
@@ -79,11 +83,20 @@ class IfMgrXrlReplicator :
 	const string& xrl_target_name() const	{ return _tgt; }
 
 	/**
-	 * Test whether the queue with the commands is empty.
+	 * Test whether the queue with the commands is empty, and no
+	 * commands are being dispatched.
 	 *
-	 * @return trie if the queue with the commans is empty, otherwise false.
+	 * @return true if the queue with the commands is empty and no
+	 * commands are being dispatched, otherwise false.
 	 */
-	bool is_empty_queue() const { return (_queue.empty() == true); }
+	bool is_empty_queue() const {
+	    return ((_queue.empty() == true) && (_pending == false));
+	}
+
+	/**
+	 * The maximum number of commands dispatched in a single Xrl.
+	 */
+	static const size_t MAX_COMMAND_BATCH = 1000;
 
     protected:
 	/**
@@ -101,6 +114,12 @@ class IfMgrXrlReplicator :
 	 */
 	virtual void push_manager_queue();
 
+	/**
+	 * Method invoked to get the maximum number of commands that may be
+	 * dispatched in the next Xrl.
+	 */
+	virtual size_t manager_batch_limit() const;
+
 	/**
 	 * Method invoked when an Xrl dispatch fails.
 	 */
@@ -131,6 +150,7 @@ class IfMgrXrlReplicator :
 
 	IfMgrCommandFifoQueue _queue;
 	bool		  _pending;
+	size_t		  _batch_n;	// Commands in the Xrl being dispatched
 };
 
 
@@ -169,6 +189,13 @@ class IfMgrManagedXrlReplicator :
 	 */
 	void push_manager_queue();
 
+	/**
+	 * Method invoked to get the maximum number of commands that may be
+	 * dispatched in the next Xrl.  These are the commands of the
+	 * entries for this replicator at the head of the manager's queue.
+	 */
+	size_t manager_batch_limit() const;
+
 	void xrl_error_event(const XrlError& e);
 
     private:
@@ -222,8 +249,21 @@ class IfMgrXrlReplicationManager : public IfMgrCommandSinkBase
 
 	/**
 	 * Method invoked when the previous Xrl dispatch has completed.
+	 *
+	 * @param commands_n the number of commands that were dispatched.
+	 */
+	void crank_replicators_queue_cb(size_t commands_n);
+
+	/**
+	 * Get the number of consecutive entries for a replicator at the
+	 * head of the manager's queue.
+	 *
+	 * @param r the replicator.
+	 * @param max_n the maximum number of entries to count.
+	 * @return the number of entries.
 	 */
-	void crank_replicators_queue_cb();
+	size_t replicators_queue_run(const IfMgrManagedXrlReplicator* r,
+				     size_t max_n) const;
 
 	/**
 	 * Method invoked when a command should be added to the manager's queue.
@@ -36,7 +36,87 @@
 
 
 /*
- * inet_checksum extracted from:
+ * Sum the data as 16 bit words in host order.
+ *
+ * The Internet checksum does not depend on byte order (RFC 1071,
+ * Section 2(B)), so the words are summed as they lie in memory and no
+ * byte swapping is needed.  The data is loaded 32 bits at a time into
+ * independent 64 bit accumulators (RFC 1071, Section 2(C)), which
+ * removes the dependency between successive additions and lets the
+ * compiler vectorise the main loop.  No carries can be lost before
+ * 2^32 words have been summed.
+ */
+static uint64_t
+inet_checksum_sum(const uint8_t *addr, size_t len)
+{
+    const uint8_t *w = addr;
+    size_t nleft = len;
+    uint64_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    uint32_t w32[4];
+    uint16_t w16;
+
+    while (nleft >= sizeof(w32)) 
+    {
+	memcpy(w32, w, sizeof(w32));
+	sum0 += w32[0];
+	sum1 += w32[1];
+	sum2 += w32[2];
+	sum3 += w32[3];
+	w += sizeof(w32);
+	nleft -= sizeof(w32);
+    }
+
+    while (nleft >= sizeof(w32[0])) 
+    {
+	memcpy(w32, w, sizeof(w32[0]));
+	sum0 += w32[0];
+	w += sizeof(w32[0]);
+	nleft -= sizeof(w32[0]);
+    }
+
+    if (nleft >= sizeof(w16)) 
+    {
+	memcpy(&w16, w, sizeof(w16));
+	sum1 += w16;
+	w += sizeof(w16);
+	nleft -= sizeof(w16);
+    }
+
+    /* mop up an odd byte, if necessary */
+    if (nleft == 1) 
+    {
+	/*
+	 * XXX: If the number of bytes is odd, we assume a padding
+	 * with a zero byte.
+	 */
+	w16 = 0;
+	memcpy(&w16, w, 1);
+	sum2 += w16;
+    }
+
+    /* The accumulators can not overflow when added together. */
+    sum0 = (sum0 >> 32) + (sum0 & 0xffffffffU);
+    sum1 = (sum1 >> 32) + (sum1 & 0xffffffffU);
+    sum2 = (sum2 >> 32) + (sum2 & 0xffffffffU);
+    sum3 = (sum3 >> 32) + (sum3 & 0xffffffffU);
+
+    return (sum0 + sum1 + sum2 + sum3);
+}
+
+/*
+ * Fold a sum into 16 bits, adding back the carry outs.
+ */
+static uint16_t
+inet_checksum_fold(uint64_t sum)
+{
+    while (sum >> 16)
+	sum = (sum >> 16) + (sum & 0xffff);
+
+    return ((uint16_t)sum);
+}
+
+/*
+ * inet_checksum based on in_cksum extracted from:
  *			P I N G . C
  *
  * Author -
@@ -56,48 +136,11 @@
     uint16_t
 inet_checksum(const uint8_t *addr, size_t len)
 {
-    register size_t nleft = len;
-    register const uint8_t *w = addr;
-    uint16_t answer = 0;
-    register uint32_t sum = 0;
-
-    /*
-     *  Our algorithm is simple, using a 32 bit accumulator (sum),
-     *  we add sequential 16 bit words to it, and at the end, fold
-     *  back all the carry bits from the top 16 bits into the lower
-     *  16 bits.
-     */
-    while (nleft > 1)  
-    {
-	sum += ((w[0] << 8) | w[1]);
-	w += 2;
-	nleft -= 2;
-    }
-
-    /* mop up an odd byte, if necessary */
-    if (nleft == 1) 
-    {
-	/*
-	 * XXX: If the number of bytes is odd, we assume a padding
-	 * with a zero byte, hence we just "<< 8" the remaining
-	 * odd byte.
-	 */
-	sum += (w[0] << 8);
-    }
-
     /*
-     * add back carry outs from top 16 bits to low 16 bits
+     * XXX: The words were summed in host order, so the result is
+     * already in network order.
      */
-    sum = (sum >> 16) + (sum & 0xffff);	/* add hi 16 to low 16 */
-    sum += (sum >> 16);			/* add carry */
-    answer = ~sum;				/* truncate to 16 bits */
-
-    /*
-     * XXX: We need to swap the bytes, because we implicitly performed
-     * network-to-host order swapping when we accessed the data.
-     */
-    answer = htons(answer);			/* swap the bytes */
-    return (answer);
+    return ((uint16_t)~inet_checksum_fold(inet_checksum_sum(addr, len)));
 }
 
 /*
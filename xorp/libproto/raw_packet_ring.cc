@@ -0,0 +1,249 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+// 
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+#include "libproto_module.h"
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+
+#include "raw_packet_ring.hh"
+
+//
+// A record is the fixed part below, followed by the addresses, the
+// interface and vif names each preceded by a 16-bit length, the
+// extension headers each as an 8-bit type and a 16-bit length, and
+// then the payload. Both ends are on the same host, so everything is
+// in host order.
+//
+struct RawPacketRecord
+{
+    uint8_t	_family;
+    uint8_t	_ip_protocol;
+    uint8_t	_flags;
+    uint8_t	_ext_headers;
+    int32_t	_ip_ttl;
+    int32_t	_ip_tos;
+};
+
+enum {
+    RAW_PACKET_ROUTER_ALERT	= 0x1,
+    RAW_PACKET_INTERNET_CONTROL	= 0x2
+};
+
+static inline void
+put_bytes(vector<uint8_t>& buf, const void* p, size_t len)
+{
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+    buf.insert(buf.end(), b, b + len);
+}
+
+static inline void
+put_16(vector<uint8_t>& buf, size_t v)
+{
+    uint16_t v16 = v;
+    put_bytes(buf, &v16, sizeof(v16));
+}
+
+static inline bool
+get_bytes(const uint8_t*& p, const uint8_t* end, void* to, size_t len)
+{
+    if (static_cast<size_t>(end - p) < len)
+	return false;
+    memcpy(to, p, len);
+    p += len;
+    return true;
+}
+
+static inline bool
+get_16(const uint8_t*& p, const uint8_t* end, size_t& v)
+{
+    uint16_t v16;
+    if (!get_bytes(p, end, &v16, sizeof(v16)))
+	return false;
+    v = v16;
+    return true;
+}
+
+    bool
+RawPacketRing::send(const string& if_name, const string& vif_name,
+	const IPvX& src_address, const IPvX& dst_address,
+	uint8_t ip_protocol, int32_t ip_ttl, int32_t ip_tos,
+	bool ip_router_alert, bool ip_internet_control,
+	const vector<uint8_t>& ext_headers_type,
+	const vector<vector<uint8_t> >& ext_headers_payload,
+	const vector<uint8_t>& payload)
+{
+    if (!is_open())
+	return false;
+
+    XLOG_ASSERT(ext_headers_type.size() == ext_headers_payload.size());
+    if (ext_headers_type.size() > 0xff || if_name.size() > 0xffff
+	    || vif_name.size() > 0xffff)
+	return false;
+
+    RawPacketRecord rec;
+    rec._family = src_address.is_ipv4() ? 4 : 6;
+    rec._ip_protocol = ip_protocol;
+    rec._flags = (ip_router_alert ? RAW_PACKET_ROUTER_ALERT : 0)
+	| (ip_internet_control ? RAW_PACKET_INTERNET_CONTROL : 0);
+    rec._ext_headers = ext_headers_type.size();
+    rec._ip_ttl = ip_ttl;
+    rec._ip_tos = ip_tos;
+
+    vector<uint8_t> head;
+    head.reserve(sizeof(rec) + 2 * IPvX::addr_bytelen(AF_INET6)
+	    + if_name.size() + vif_name.size() + 4);
+
+    uint8_t addr[sizeof(struct in6_addr)];
+    put_bytes(head, &rec, sizeof(rec));
+    put_bytes(head, addr, src_address.copy_out(addr));
+    put_bytes(head, addr, dst_address.copy_out(addr));
+    put_16(head, if_name.size());
+    put_bytes(head, if_name.data(), if_name.size());
+    put_16(head, vif_name.size());
+    put_bytes(head, vif_name.data(), vif_name.size());
+    for (size_t i = 0; i < ext_headers_type.size(); i++) 
+    {
+	const vector<uint8_t>& ext = ext_headers_payload[i];
+	if (ext.size() > 0xffff)
+	    return false;
+	head.push_back(ext_headers_type[i]);
+	put_16(head, ext.size());
+	if (!ext.empty())
+	    put_bytes(head, &ext[0], ext.size());
+    }
+
+    return write(&head[0], head.size(),
+	    payload.empty() ? NULL : &payload[0], payload.size());
+}
+
+//
+// Decode a record, return false if it is malformed.
+//
+static bool
+get_record(const uint8_t* p, const uint8_t* end,
+	string& if_name, string& vif_name,
+	IPvX& src_address, IPvX& dst_address,
+	uint8_t& ip_protocol, int32_t& ip_ttl, int32_t& ip_tos,
+	bool& ip_router_alert, bool& ip_internet_control,
+	vector<uint8_t>& ext_headers_type,
+	vector<vector<uint8_t> >& ext_headers_payload,
+	vector<uint8_t>& payload)
+{
+    RawPacketRecord rec;
+    uint8_t addr[sizeof(struct in6_addr)];
+    int family;
+    size_t n;
+
+    if (!get_bytes(p, end, &rec, sizeof(rec)))
+	return false;
+
+    switch (rec._family) 
+    {
+	case 4:
+	    family = AF_INET;
+	    break;
+	case 6:
+	    family = AF_INET6;
+	    break;
+	default:
+	    return false;
+    }
+
+    if (!get_bytes(p, end, addr, IPvX::addr_bytelen(family)))
+	return false;
+    src_address.copy_in(family, addr);
+    if (!get_bytes(p, end, addr, IPvX::addr_bytelen(family)))
+	return false;
+    dst_address.copy_in(family, addr);
+
+    if (!get_16(p, end, n) || static_cast<size_t>(end - p) < n)
+	return false;
+    if_name.assign(reinterpret_cast<const char*>(p), n);
+    p += n;
+    if (!get_16(p, end, n) || static_cast<size_t>(end - p) < n)
+	return false;
+    vif_name.assign(reinterpret_cast<const char*>(p), n);
+    p += n;
+
+    ext_headers_type.clear();
+    ext_headers_payload.clear();
+    for (size_t i = 0; i < rec._ext_headers; i++) 
+    {
+	uint8_t type;
+	if (!get_bytes(p, end, &type, sizeof(type))
+		|| !get_16(p, end, n)
+		|| static_cast<size_t>(end - p) < n)
+	    return false;
+	ext_headers_type.push_back(type);
+	ext_headers_payload.push_back(vector<uint8_t>(p, p + n));
+	p += n;
+    }
+
+    ip_protocol = rec._ip_protocol;
+    ip_ttl = rec._ip_ttl;
+    ip_tos = rec._ip_tos;
+    ip_router_alert = rec._flags & RAW_PACKET_ROUTER_ALERT;
+    ip_internet_control = rec._flags & RAW_PACKET_INTERNET_CONTROL;
+    payload.assign(p, end);
+
+    return true;
+}
+
+    bool
+RawPacketRing::recv(string& if_name, string& vif_name,
+	IPvX& src_address, IPvX& dst_address,
+	uint8_t& ip_protocol, int32_t& ip_ttl, int32_t& ip_tos,
+	bool& ip_router_alert, bool& ip_internet_control,
+	vector<uint8_t>& ext_headers_type,
+	vector<vector<uint8_t> >& ext_headers_payload,
+	vector<uint8_t>& payload)
+{
+    for (;;) 
+    {
+	size_t len;
+	const uint8_t* p = front(len);
+	if (p == NULL)
+	    return false;
+
+	bool good = get_record(p, p + len, if_name, vif_name,
+		src_address, dst_address, ip_protocol, ip_ttl, ip_tos,
+		ip_router_alert, ip_internet_control,
+		ext_headers_type, ext_headers_payload, payload);
+	pop();
+
+	if (good)
+	    return true;
+
+	XLOG_WARNING("Bad packet on ring %s", name().c_str());
+    }
+}
+
+    string
+RawPacketRing::unique_name(int family)
+{
+    static uint32_t instance = 0;
+
+    return c_format("xorp-rawpkt%u-%u-%u",
+	    family == AF_INET ? 4 : 6,
+	    XORP_UINT_CAST(getpid()),
+	    XORP_UINT_CAST(instance++));
+}
@@ -0,0 +1,86 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+// 
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+#ifndef __LIBPROTO_RAW_PACKET_RING_HH__
+#define __LIBPROTO_RAW_PACKET_RING_HH__
+
+#include "libxorp/xorp.h"
+#include "libxorp/ipvx.hh"
+#include "libxorp/shm_ring.hh"
+
+/**
+ * @short Shared memory ring carrying received raw IP packets from the
+ * FEA to a protocol.
+ *
+ * A record holds the same information as the raw_packet4_client/0.1
+ * and raw_packet6_client/0.1 recv XRLs.  The protocol creates the
+ * ring and registers it with the FEA, which then places packets on the
+ * ring instead of sending XRLs.  Packets that do not fit on the ring
+ * are still sent as XRLs, so the protocol must accept both.
+ */
+class RawPacketRing : public ShmRing
+{
+    public:
+	/**
+	 * Default size of the ring.
+	 */
+	static const size_t DEFAULT_BYTES = 1024 * 1024;
+
+	RawPacketRing(const string& name) : ShmRing(name) {}
+
+	/**
+	 * Append a packet.
+	 *
+	 * @return true if the packet was added, false if there was no room
+	 * or the ring is not usable.
+	 */
+	bool send(const string& if_name, const string& vif_name,
+		const IPvX& src_address, const IPvX& dst_address,
+		uint8_t ip_protocol, int32_t ip_ttl, int32_t ip_tos,
+		bool ip_router_alert, bool ip_internet_control,
+		const vector<uint8_t>& ext_headers_type,
+		const vector<vector<uint8_t> >& ext_headers_payload,
+		const vector<uint8_t>& payload);
+
+	/**
+	 * Remove the oldest packet.
+	 *
+	 * @return true if a packet was removed, false if the ring is
+	 * empty or not usable.
+	 */
+	bool recv(string& if_name, string& vif_name,
+		IPvX& src_address, IPvX& dst_address,
+		uint8_t& ip_protocol, int32_t& ip_ttl, int32_t& ip_tos,
+		bool& ip_router_alert, bool& ip_internet_control,
+		vector<uint8_t>& ext_headers_type,
+		vector<vector<uint8_t> >& ext_headers_payload,
+		vector<uint8_t>& payload);
+
+	/**
+	 * @return a name for a ring that is unique on this host.
+	 *
+	 * @param family the address family of the packets.
+	 */
+	static string unique_name(int family);
+};
+
+#endif // __LIBPROTO_RAW_PACKET_RING_HH__
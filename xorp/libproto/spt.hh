@@ -185,13 +185,13 @@ class Spt
 };
 
 template <typename A>
-class Node 
+class Node : public iref_counted
 {
     public:
 	typedef map <A, Edge<A> > adjacency; // Only one edge allowed
 	// between nodes.
 
-	typedef ref_ptr<Node<A> > NodeRef;
+	typedef iref_ptr<Node<A> > NodeRef;
 
 	Node(A a, bool trace = false);
 
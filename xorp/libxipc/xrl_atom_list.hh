@@ -54,6 +54,8 @@ class XrlAtomList
     };
 
     public:
+	typedef list<XrlAtom>::const_iterator const_iterator;
+
 	XrlAtomList();
 
 	/**
@@ -90,6 +92,21 @@ class XrlAtomList
 	 */
 	size_t size() const;
 
+	/**
+	 * Get an iterator to the first XrlAtom in the list.
+	 *
+	 * Walking the list with an iterator takes linear time, whereas
+	 * retrieving each XrlAtom with get() takes quadratic time.
+	 *
+	 * @return an iterator to the first XrlAtom in the list.
+	 */
+	const_iterator begin() const	{ return _list.begin(); }
+
+	/**
+	 * @return an iterator past the last XrlAtom in the list.
+	 */
+	const_iterator end() const	{ return _list.end(); }
+
 	/**
 	 * Test equality of with another XrlAtomList.
 	 *
@@ -30,6 +30,7 @@
 
 
 #include "xrl_pf_factory.hh"
+#include "xrl_pf_inproc.hh"
 #include "xrl_pf_stcp.hh"
 #include "xrl_pf_unix.hh"
 
@@ -47,6 +48,15 @@ XrlPFSenderFactory::create_sender(const string& name,
     ref_ptr<XrlPFSender> rv;
     try 
     {
+	if (strcmp(XrlPFInProcSender::protocol_name(), protocol) == 0) 
+	{
+	    // Fails quietly when the target is in another process, the
+	    // caller moves on to the next protocol family.
+	    if (XrlPFInProcListener::find(address) == NULL)
+		return rv;
+	    rv = new XrlPFInProcSender(name,  address);
+	    return rv;
+	}
 	if (strcmp(XrlPFSTCPSender::protocol_name(), protocol) == 0) 
 	{
 	    rv = new XrlPFSTCPSender(name,  address);
@@ -0,0 +1,254 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+// 
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "xrl_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/debug.h"
+#include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#include "xrl_error.hh"
+#include "xrl_dispatcher.hh"
+#include "xrl_pf_inproc.hh"
+
+const char* XrlPFInProcListener::_protocol = "inproc";
+
+// ----------------------------------------------------------------------------
+// Listener table, one entry per in-process listener.
+
+typedef map<string, XrlPFInProcListener*> InProcListeners;
+
+    static InProcListeners&
+listeners()
+{
+    static InProcListeners l;
+    return l;
+}
+
+// A random value read once per process.  It distinguishes this process
+// from one with the same process id on another host, or a later one on
+// this host.  The global xorp_random() state is left alone, since some
+// processes seed it themselves.
+    static uint32_t
+process_nonce()
+{
+    uint32_t nonce = 0;
+    bool done = false;
+
+    int fd = open("/dev/urandom", O_RDONLY, 0);
+    if (fd >= 0) 
+    {
+	if (read(fd, &nonce, sizeof(nonce)) == (ssize_t)sizeof(nonce))
+	    done = true;
+	close(fd);
+    }
+
+    if (! done) 
+    {
+	TimeVal now;
+	TimerList::system_gettimeofday(&now);
+	nonce = (static_cast<uint32_t>(getpid()) << 16)
+	    ^ static_cast<uint32_t>(now.sec())
+	    ^ static_cast<uint32_t>(now.usec())
+	    ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&nonce));
+    }
+    return nonce;
+}
+
+    static string
+next_address()
+{
+    static uint32_t nonce = process_nonce();
+    static uint32_t instance = 0;
+
+    return c_format("%u.%u.%u", XORP_UINT_CAST(getpid()),
+	    XORP_UINT_CAST(nonce), XORP_UINT_CAST(++instance));
+}
+
+// Senders that have not been destroyed, by id.  A response may arrive
+// after its sender has gone, and so after the object its callback
+// refers to has gone.
+    static set<uint32_t>&
+live_senders()
+{
+    static set<uint32_t> s;
+    return s;
+}
+
+// ----------------------------------------------------------------------------
+// XrlPFInProcListener
+
+XrlPFInProcListener::XrlPFInProcListener(XrlDispatcher* d)
+    : XrlPFListener(d), _address(next_address()), _responses_pending(0)
+{
+    listeners()[_address] = this;
+}
+
+XrlPFInProcListener::~XrlPFInProcListener()
+{
+    listeners().erase(_address);
+}
+
+    XrlPFInProcListener*
+XrlPFInProcListener::find(const string& address)
+{
+    InProcListeners::const_iterator i = listeners().find(address);
+    if (i == listeners().end())
+	return NULL;
+
+    return i->second;
+}
+
+    void
+XrlPFInProcListener::dispatch(const Xrl& xrl, uint32_t sender_id,
+	const XrlPFSender::SendCallback& cb)
+{
+    XLOG_ASSERT(_dispatcher != NULL);
+
+    _responses_pending++;
+    _dispatcher->dispatch_xrl(xrl.command(), xrl.args(),
+	    callback(&XrlPFInProcListener::dispatch_cb, _address, sender_id,
+		cb));
+}
+
+    void
+XrlPFInProcListener::dispatch_cb(const XrlError& e, const XrlArgs* reply,
+	string address, uint32_t sender_id, XrlPFSender::SendCallback cb)
+{
+    // The listener may have gone away while an asynchronous handler
+    // was running.
+    XrlPFInProcListener* l = find(address);
+    if (l != NULL) 
+    {
+	XLOG_ASSERT(l->_responses_pending != 0);
+	l->_responses_pending--;
+    }
+
+    if (!XrlPFInProcSender::exists(sender_id))
+	return;
+
+    if (reply == NULL) 
+    {
+	cb->dispatch(e, NULL);
+	return;
+    }
+
+    XrlArgs args(*reply);
+    cb->dispatch(e, &args);
+}
+
+    string
+XrlPFInProcListener::toString() const
+{
+    ostringstream oss;
+    oss << "InProc listener: " << _address << " responses pending: "
+	<< _responses_pending;
+    return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// XrlPFInProcSender
+
+XrlPFInProcSender::XrlPFInProcSender(const string& name, const char* address)
+    : XrlPFSender(name, address)
+{
+    static uint32_t next_id = 0;
+
+    if (XrlPFInProcListener::find(_address) == NULL)
+	xorp_throw(XrlPFConstructorError,
+		c_format("No in-process listener %s", address));
+
+    _id = ++next_id;
+    live_senders().insert(_id);
+}
+
+XrlPFInProcSender::~XrlPFInProcSender()
+{
+    _dispatch_task.unschedule();
+    live_senders().erase(_id);
+}
+
+    bool
+XrlPFInProcSender::exists(uint32_t id)
+{
+    return live_senders().find(id) != live_senders().end();
+}
+
+    const char*
+XrlPFInProcSender::protocol_name()
+{
+    return XrlPFInProcListener::_protocol;
+}
+
+    bool
+XrlPFInProcSender::alive() const
+{
+    return XrlPFInProcListener::find(_address) != NULL;
+}
+
+    bool
+XrlPFInProcSender::send(const Xrl&			xrl,
+	bool				direct_call,
+	const XrlPFSender::SendCallback& cb)
+{
+    if (!alive()) 
+    {
+	if (direct_call)
+	    return false;
+
+	cb->dispatch(XrlError::SEND_FAILED(), NULL);
+	return true;
+    }
+
+    _requests.push_back(Request(xrl, cb));
+
+    if (!_dispatch_task.scheduled())
+	_dispatch_task = EventLoop::instance().new_task(
+		callback(this, &XrlPFInProcSender::dispatch_requests));
+
+    return true;
+}
+
+    bool
+XrlPFInProcSender::dispatch_requests()
+{
+    for (size_t n = 0; n < MAX_XRLS_DISPATCHED && !_requests.empty(); n++) 
+    {
+	// Unlink the request first, the handler may send more XRLs.
+	Request r = _requests.front();
+	_requests.pop_front();
+
+	XrlPFInProcListener* l = XrlPFInProcListener::find(_address);
+	if (l == NULL) 
+	{
+	    r._cb->dispatch(XrlError::SEND_FAILED(), NULL);
+	    continue;
+	}
+	l->dispatch(r._xrl, _id, r._cb);
+    }
+
+    return !_requests.empty();
+}
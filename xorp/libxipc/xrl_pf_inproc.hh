@@ -0,0 +1,130 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+// 
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __LIBXIPC_XRL_PF_INPROC_HH__
+#define __LIBXIPC_XRL_PF_INPROC_HH__
+
+#include "libxorp/task.hh"
+
+#include "xrl.hh"
+#include "xrl_pf.hh"
+
+/**
+ * @short In-process XRL listener.
+ *
+ * Makes the handlers of a dispatcher reachable from other XRL routers
+ * in the same process.  The address includes the process id and a
+ * random value read from /dev/urandom once per process, so that it
+ * does not resolve in any other process.
+ */
+class XrlPFInProcListener : public XrlPFListener 
+{
+    public:
+	XrlPFInProcListener(XrlDispatcher* d = 0);
+	~XrlPFInProcListener();
+
+	const char* address() const		{ return _address.c_str(); }
+	const char* protocol() const		{ return _protocol; }
+
+	bool response_pending() const		{ return _responses_pending != 0; }
+
+	string toString() const;
+
+	/**
+	 * Find the listener with the given address in this process.
+	 *
+	 * @return the listener, or NULL if there is none.
+	 */
+	static XrlPFInProcListener* find(const string& address);
+
+	/**
+	 * Dispatch an XRL to the dispatcher of the listener, without
+	 * packing it.  The response is passed on to the callback when the
+	 * handler responds, unless the sender has gone away by then.
+	 *
+	 * @param sender_id the XrlPFInProcSender::id() of the sender.
+	 */
+	void dispatch(const Xrl& xrl, uint32_t sender_id,
+		const XrlPFSender::SendCallback& cb);
+
+	static const char* _protocol;
+
+    private:
+	static void dispatch_cb(const XrlError& e, const XrlArgs* reply,
+		string address, uint32_t sender_id,
+		XrlPFSender::SendCallback cb);
+
+	string	_address;
+	size_t	_responses_pending;	// Dispatched but not responded.
+};
+
+/**
+ * @short In-process XRL sender.
+ *
+ * Queues XRLs for a listener in the same process and dispatches them
+ * from a task, so that the response is never delivered from within
+ * send().  Construction fails if the listener is not in this process,
+ * and the next protocol family for the target is then tried.
+ */
+class XrlPFInProcSender : public XrlPFSender 
+{
+    public:
+	XrlPFInProcSender(const string& name, const char* address);
+	~XrlPFInProcSender();
+
+	bool send(const Xrl&			xrl,
+		bool			direct_call,
+		const SendCallback&	cb);
+
+	bool sends_pending() const		{ return !_requests.empty(); }
+
+	const char* protocol() const		{ return protocol_name(); }
+	static const char* protocol_name();
+
+	bool alive() const;
+
+	uint32_t id() const			{ return _id; }
+
+	/**
+	 * @return true if the sender with the given id still exists.
+	 */
+	static bool exists(uint32_t id);
+
+    private:
+	bool dispatch_requests();
+
+	struct Request 
+	{
+	    Request(const Xrl& xrl, const SendCallback& cb)
+		: _xrl(xrl), _cb(cb) {}
+
+	    Xrl		_xrl;
+	    SendCallback	_cb;
+	};
+
+	uint32_t	_id;
+	list<Request>	_requests;
+	XorpTask	_dispatch_task;
+
+	static const size_t MAX_XRLS_DISPATCHED = 100;
+};
+
+#endif // __LIBXIPC_XRL_PF_INPROC_HH__
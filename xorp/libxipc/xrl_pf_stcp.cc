@@ -64,7 +64,7 @@ static const size_t 	MAX_ACTIVE_REQUESTS  	    = 100;
 static const uint32_t   MAX_XRLS_DISPATCHED	    = 100;
 
 // The maximum number of buffers the AsyncFileWriters should coalesce.
-static const uint32_t   MAX_WRITES		    = 16;
+static const uint32_t   MAX_WRITES		    = 64;
 
 #define xassert(x) // An expensive - assert(x)
 
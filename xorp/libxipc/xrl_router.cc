@@ -31,6 +31,7 @@
 #include "xrl_router.hh"
 #include "xrl_pf.hh"
 #include "xrl_pf_factory.hh"
+#include "xrl_pf_inproc.hh"
 
 #include "finder_client.hh"
 #include "finder_client_xrl_target.hh"
@@ -266,6 +267,15 @@ XrlRouter::pending() const
     return false;
 }
 
+    bool
+XrlRouter::is_resolved(const Xrl& xrl) const
+{
+    if ((_fc == NULL) || xrl.to_finder())
+	return false;
+
+    return (_dsl.empty() && (_fc->query_cache(xrl.string_no_args()) != NULL));
+}
+
     bool
 XrlRouter::add_listener(XrlPFListener* l)
 {
@@ -408,9 +418,12 @@ XrlRouter::lookup_sender(const Xrl& xrl, FinderDBEntry* dbe)
 	if (s.get() != 0)
 	    break;
 
-	XLOG_ERROR("Could not create XrlPFSender for protocol = \"%s\" "
-		"address = \"%s\" ",
-		x.protocol().c_str(), x.target().c_str());
+	// In-process addresses of targets in other processes are expected
+	// to fail.
+	if (x.protocol() != XrlPFInProcSender::protocol_name())
+	    XLOG_ERROR("Could not create XrlPFSender for protocol = \"%s\" "
+		    "address = \"%s\" ",
+		    x.protocol().c_str(), x.target().c_str());
 
 	dbe->pop_front();
     }
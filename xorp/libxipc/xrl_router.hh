@@ -121,6 +121,19 @@ class XrlRouter :
 	 */
 	bool pending() const;
 
+	/**
+	 * Test whether an XRL would be sent without waiting for the Finder.
+	 *
+	 * An XRL that is not resolved in the Finder cache is sent after the
+	 * Finder replies, hence it may be overtaken by the XRLs sent after
+	 * it.
+	 *
+	 * @param xrl XRL to be tested.
+	 * @return true if the XRL is resolved in the Finder cache and no
+	 * earlier XRL is waiting for the Finder, otherwise false.
+	 */
+	bool is_resolved(const Xrl& xrl) const;
+
 	/**
 	 * Add an XRL method handler.
 	 *
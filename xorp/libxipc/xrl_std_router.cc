@@ -23,6 +23,7 @@
 
 #include "xrl_module.h"
 #include "xrl_std_router.hh"
+#include "xrl_pf_inproc.hh"
 #include "xrl_pf_stcp.hh"
 #include "xrl_pf_unix.hh"
 #include "libxorp/xlog.h"
@@ -41,7 +42,18 @@ string XrlStdRouter::toString() const
 {
     ostringstream oss;
     oss << XrlRouter::toString();
-    oss << "\n_unix: ";
+    oss << "\n_inproc: ";
+
+    if (_inproc) 
+    {
+	oss << _inproc->toString() << endl;
+    }
+    else 
+    {
+	oss << "NULL\n";
+    }
+
+    oss << "_unix: ";
 
     if (_unix) 
     {
@@ -149,7 +161,7 @@ XrlStdRouter::XrlStdRouter( const char*	class_name,
     void
 XrlStdRouter::construct(bool unix_socket)
 {
-    _unix = _l = NULL;
+    _inproc = _unix = _l = NULL;
 
     // We need to check the environment otherwise
     // we get the compiled-in default.
@@ -159,6 +171,11 @@ XrlStdRouter::construct(bool unix_socket)
     if (pf[0] != 'x')
 	unix_socket = false;
 
+    // The in-process listener is added first, so that targets in the
+    // same process are reached without going through the kernel.
+    _inproc = new XrlPFInProcListener(this);
+    add_listener(_inproc);
+
     if (unix_socket)
 	create_unix_listener();
 
@@ -178,5 +195,8 @@ XrlStdRouter::~XrlStdRouter()
     if (_unix)
 	destroy_listener(_unix);
 
+    if (_inproc)
+	destroy_listener(_inproc);
+
     destroy_listener(_l);
 }
@@ -72,6 +72,7 @@ class XrlStdRouter : public XrlRouter
 	void	   create_unix_listener();
 	XrlPFListener* create_listener();
 
+	XrlPFListener* _inproc;
 	XrlPFListener* _unix;
 	XrlPFListener* _l;
 };
@@ -298,19 +298,44 @@ string AsyncFileReader::toString() const
 // AsyncFileWriter write method and entry hook
 
 #ifndef MAX_IOVEC
-#define MAX_IOVEC 16
+#define MAX_IOVEC 64
 #endif
 
+#if defined(IOV_MAX) && (IOV_MAX < MAX_IOVEC)
+#undef MAX_IOVEC
+#define MAX_IOVEC IOV_MAX
+#endif
+
+//
+// Limit on the bytes handed to a single write when the size of the
+// socket send buffer can't be found, e.g. the file descriptor is a pipe.
+//
+static const size_t DEFAULT_COALESCE_BYTES = 65536;
+
 AsyncFileWriter::AsyncFileWriter( XorpFd fd, uint32_t coalesce,
 	int priority)
-: AsyncFileOperator( fd, priority)
+: AsyncFileOperator( fd, priority),
+    _write_calls(0), _bytes_written(0)
 {
-    static const uint32_t max_coalesce = 16;
     _coalesce = (coalesce > MAX_IOVEC) ? MAX_IOVEC : coalesce;
-    if (_coalesce > max_coalesce) 
+    if (_coalesce == 0)
+	_coalesce = 1;
+
+    //
+    // There is no point in handing the kernel more data in one go than
+    // the socket can buffer, the rest would just have to be resent.
+    //
+    _coalesce_bytes = DEFAULT_COALESCE_BYTES;
+#ifdef SO_SNDBUF
+    int sndbuf = 0;
+    socklen_t sndbuf_len = sizeof(sndbuf);
+    if (getsockopt(_fd.getSocket(), SOL_SOCKET, SO_SNDBUF,
+		reinterpret_cast<char*>(&sndbuf), &sndbuf_len) == 0
+	    && sndbuf > 0) 
     {
-	_coalesce = max_coalesce;
+	_coalesce_bytes = sndbuf;
     }
+#endif
     _iov = new iovec[_coalesce];
     _dtoken = new int;
 }
@@ -436,11 +461,44 @@ AsyncFileWriter::add_data_sendto(const vector<uint8_t>&	data,
     }
 }
 
+    void
+AsyncFileWriter::add_data_swap(vector<uint8_t>&	data,
+	const Callback&		cb)
+{
+    assert(data.size() != 0);
+    size_t data_bytes = data.size();
+    UNUSED(data_bytes);		// XXX: only used by the trace
+    _buffers.push_back(new BufferInfo(&data, cb));
+#ifdef EDGE_TRIGGERED_WRITES
+    if (_running && !_deferred_io_task.scheduled()) 
+    {
+	_deferred_io_task = EventLoop::instance().new_oneoff_task(
+		callback(this, &AsyncFileWriter::write, _fd, IOT_WRITE));
+	XLOG_ASSERT(_deferred_io_task.scheduled());
+    }
+#endif // EDGE_TRIGGERED_WRITES
+    if (aio_trace.on()) 
+    {
+	XLOG_INFO("afw: %p  add_data-swap sz: %i  buffers: %i\n",
+		this, (int)(data_bytes), (int)(_buffers.size()));
+    }
+}
+
+    size_t
+AsyncFileWriter::bytes_per_write() const
+{
+    if (_write_calls == 0)
+	return 0;
+
+    return static_cast<size_t>(_bytes_written / _write_calls);
+}
 
 string AsyncFileWriter::toString() const 
 {
     ostringstream oss;
-    oss << AsyncFileOperator::toString() << " buffers: " << _buffers.size() << endl;
+    oss << AsyncFileOperator::toString() << " buffers: " << _buffers.size()
+	<< " writes: " << _write_calls << " bytes: " << _bytes_written
+	<< " bytes/write: " << bytes_per_write() << endl;
     return oss.str();
 }
 
@@ -518,7 +576,7 @@ AsyncFileWriter::write(XorpFd fd, IoEventType type)
 	    dst_port = bi->dst_port();
 	    break;
 	}
-	if (iov_cnt == _coalesce)
+	if (iov_cnt == _coalesce || total_bytes >= _coalesce_bytes)
 	    break;
 	++i;
     }
@@ -596,6 +654,12 @@ AsyncFileWriter::write(XorpFd fd, IoEventType type)
 	errno = 0;
     }
 
+    if (done > 0) 
+    {
+	_write_calls++;
+	_bytes_written += done;
+    }
+
     if (aio_trace.on()) 
     {
 	XLOG_INFO("afw: %p Wrote %d of %u bytes, last-err: %i\n",
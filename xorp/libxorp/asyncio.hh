@@ -255,7 +255,8 @@ class AsyncFileWriter :
 	/**
 	 * @param fd a file descriptor marked as non-blocking to write to.
 	 * @param coalesce the number of buffers to coalesce for each write()
-	 *        system call.
+	 *        system call.  A single write() is also limited to about
+	 *        the size of the socket send buffer.
 	 */
 	AsyncFileWriter( XorpFd fd, uint32_t coalesce = 1,
 		int priority = XorpTask::PRIORITY_DEFAULT);
@@ -318,6 +319,18 @@ class AsyncFileWriter :
 	void add_data(const vector<uint8_t>&	data,
 		const Callback&		cb);
 
+	/**
+	 * Add additional data for writing from, without copying it.
+	 *
+	 * The contents of data are swapped into storage held by the
+	 * AsyncFileWriter, so on return data is empty.
+	 *
+	 * @param data the data to write.
+	 * @param cb Callback object to invoke when I/O is performed.
+	 */
+	void add_data_swap(vector<uint8_t>&	data,
+		const Callback&		cb);
+
 	/**
 	 * Add additional data for writing from by using sendto(2).
 	 *
@@ -358,6 +371,21 @@ class AsyncFileWriter :
 	 */
 	void flush_buffers();
 
+	/**
+	 * @return the number of write system calls made.
+	 */
+	uint64_t write_calls() const { return _write_calls; }
+
+	/**
+	 * @return the number of bytes written.
+	 */
+	uint64_t bytes_written() const { return _bytes_written; }
+
+	/**
+	 * @return the average number of bytes written per system call.
+	 */
+	size_t bytes_per_write() const;
+
 	virtual string toString() const;
 
     private:
@@ -387,6 +415,14 @@ class AsyncFileWriter :
 		: _data(data), _buffer(&_data[0]), _buffer_bytes(_data.size()),
 		_offset(0), _dst_addr(dst_addr), _dst_port(dst_port),
 		_cb(cb), _is_sendto(true) {}
+	    BufferInfo(vector<uint8_t>* data, const Callback& cb)
+		: _buffer(0), _buffer_bytes(0), _offset(0), _dst_port(0),
+		_cb(cb), _is_sendto(false)
+	    {
+		_data.swap(*data);
+		_buffer = &_data[0];
+		_buffer_bytes = _data.size();
+	    }
 
 	    void dispatch_callback(AsyncFileOperator::Event e) 
 	    {
@@ -404,7 +440,7 @@ class AsyncFileWriter :
 	private:
 	    BufferInfo();			// Not directly constructible
 
-	    const vector<uint8_t>	_data;		// Local copy of the data
+	    vector<uint8_t>		_data;		// Local copy of the data
 	    const uint8_t*		_buffer;
 	    size_t			_buffer_bytes;
 	    size_t			_offset;
@@ -418,6 +454,9 @@ class AsyncFileWriter :
 	void complete_transfer(ssize_t done);
 
 	uint32_t		_coalesce;
+	size_t		_coalesce_bytes;	// Byte limit for each write
+	uint64_t		_write_calls;
+	uint64_t		_bytes_written;
 	struct iovec* 	_iov;
 	ref_ptr<int>	_dtoken;
 	list<BufferInfo *> 	_buffers;
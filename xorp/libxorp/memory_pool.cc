@@ -0,0 +1,58 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2012 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+#include "libxorp_module.h"
+#include "libxorp/xorp.h"
+
+#ifdef HOST_OS_WINDOWS
+#include <malloc.h>
+#endif
+
+#include <new>
+
+#include "memory_pool.hh"
+
+
+void*
+MemoryPoolBase::slab_alloc(size_t bytes)
+{
+    void* slab;
+#ifdef HOST_OS_WINDOWS
+    slab = _aligned_malloc(bytes, bytes);
+    if (slab == NULL)
+	throw std::bad_alloc();
+#else
+    if (posix_memalign(&slab, bytes, bytes) != 0)
+	throw std::bad_alloc();
+#endif
+    return slab;
+}
+
+void
+MemoryPoolBase::slab_free(void* slab)
+{
+#ifdef HOST_OS_WINDOWS
+    _aligned_free(slab);
+#else
+    ::free(slab);
+#endif
+}
@@ -23,11 +23,58 @@
 
 #include "xorp.h"
 
+/**
+ * @short Type independent part of a MemoryPool.
+ *
+ * Holds the name of a pool and allocates its slabs.
+ */
+class MemoryPoolBase : public NONCOPYABLE
+{
+    public:
+	MemoryPoolBase(const char* name) : _name(name), _slab_bytes(0) {}
+	virtual ~MemoryPoolBase() {}
+
+	/**
+	 * @return the name of the pool.
+	 */
+	const char* name() const { return _name; }
+
+    protected:
+	/**
+	 * Allocate a slab aligned on its own size, so that the slab
+	 * an object belongs to can be found by masking its address.
+	 *
+	 * @param bytes the size of the slab, must be a power of two.
+	 */
+	static void* slab_alloc(size_t bytes);
+	static void slab_free(void* slab);
+
+	const char*	_name;
+	size_t		_slab_bytes;	// size of each slab
+};
+
+/**
+ * @short Slab allocator for objects of a single type.
+ *
+ * Objects are carved from large contiguous slabs, so that objects
+ * allocated together are close together in memory.  Each slab keeps its
+ * own free list; a slab that becomes completely free is returned to the
+ * system, except for one which is held in reserve to avoid thrashing
+ * when the pool size oscillates around a slab boundary.
+ *
+ * A class adopts the pool by defining its own operator new and operator
+ * delete in terms of alloc() and free().  The pool hands out chunks of
+ * sizeof(T) bytes regardless of the size requested, so a derived class
+ * that is larger than T must not use its base class' pool.
+ *
+ * EXPANSION_SIZE is the minimum number of objects per slab; the slab is
+ * rounded up to a power of two and filled with as many objects as fit.
+ */
 template <class T, size_t EXPANSION_SIZE = 100>
-class MemoryPool : public NONCOPYABLE 
+class MemoryPool : public MemoryPoolBase
 {
     public:
-	MemoryPool();
+	MemoryPool(const char* name = "MemoryPool");
 	~MemoryPool();
 
 	//Allocate element of type T from free list
@@ -35,30 +82,76 @@ class MemoryPool : public NONCOPYABLE
 
 	// Return element to the free list
 	void free(void* doomed);
+
     private:
-	// next element on the free list
-	MemoryPool<T, EXPANSION_SIZE>* _next;
+	struct Chunk
+	{
+	    Chunk*	_next;
+	};
+
+	struct Slab
+	{
+	    Slab*	_prev;		// partial list linkage
+	    Slab*	_next;
+	    Chunk*	_free;		// chunks returned to this slab
+	    size_t	_in_use;	// chunks handed out from this slab
+	    size_t	_carved;	// chunks ever handed out from this slab
+	    bool	_listed;	// on the partial list
+	};
+
+	static const size_t ALIGNMENT = 8;
+	static const size_t MAX_EMPTY_SLABS = 1;
+
+	static size_t round_up(size_t n, size_t a) { return (n + a - 1) & ~(a - 1); }
 
-	// Add free elements to the list
-	void expand_free_list();
+	Slab* slab_of(void* p) const
+	{
+	    return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(p)
+		    & ~(static_cast<uintptr_t>(_slab_bytes) - 1));
+	}
 
-	size_t _size;
+	char* chunk_at(Slab* s, size_t i) const
+	{
+	    return reinterpret_cast<char*>(s) + _header_size + i * _chunk_size;
+	}
+
+	void link(Slab* s);
+	void unlink(Slab* s);
+	Slab* new_slab();
+	void delete_slab(Slab* s);
+
+	Slab*	_partial;	// slabs with at least one free chunk
+	size_t	_empty_slabs;	// slabs on the partial list with no live chunks
+	size_t	_chunk_size;
+	size_t	_header_size;
+	size_t	_per_slab;
 };
 
 template <class T, size_t EXPANSION_SIZE>
-MemoryPool<T, EXPANSION_SIZE>::MemoryPool() :
-    _size((sizeof(T) > sizeof(MemoryPool<T, EXPANSION_SIZE>)) ? sizeof(T) :sizeof(MemoryPool<T, EXPANSION_SIZE>))
+MemoryPool<T, EXPANSION_SIZE>::MemoryPool(const char* name)
+    : MemoryPoolBase(name), _partial(NULL), _empty_slabs(0)
 {
-    expand_free_list();
+    _chunk_size = round_up(sizeof(T) > sizeof(Chunk) ? sizeof(T)
+	    : sizeof(Chunk), ALIGNMENT);
+    _header_size = round_up(sizeof(Slab), 2 * ALIGNMENT);
+
+    _slab_bytes = 1;
+    while (_slab_bytes < _header_size + EXPANSION_SIZE * _chunk_size)
+	_slab_bytes <<= 1;
+    _per_slab = (_slab_bytes - _header_size) / _chunk_size;
 }
 
     template <class T, size_t EXPANSION_SIZE>
 MemoryPool<T, EXPANSION_SIZE>::~MemoryPool()
 {
-    for (MemoryPool<T, EXPANSION_SIZE> *nextPtr = _next; nextPtr != NULL; nextPtr = _next) 
+    // Slabs that still hold live objects are deliberately leaked, they
+    // may be referenced by objects destroyed after the pool.
+    while (_partial != NULL)
     {
-	_next = _next->_next;
-	delete [] reinterpret_cast<char* >(nextPtr);
+	Slab* s = _partial;
+	unlink(s);
+	if (s->_in_use == 0)
+	    delete_slab(s);
     }
 }
 
@@ -66,38 +159,105 @@ template <class T, size_t EXPANSION_SIZE>
     inline void*
 MemoryPool<T, EXPANSION_SIZE>::alloc()
 {
-    if (!_next)
-	expand_free_list();
+    if (_partial == NULL)
+	link(new_slab());
 
-    MemoryPool<T, EXPANSION_SIZE>* head = _next;
-    _next = head->_next;
-    return head;
+    Slab* s = _partial;
+    void* p;
+    if (s->_free != NULL)
+    {
+	p = s->_free;
+	s->_free = s->_free->_next;
+    } else
+    {
+	// Carve lazily, so that a new slab is not touched all at once.
+	p = chunk_at(s, s->_carved++);
+    }
+
+    if (s->_in_use++ == 0)
+	_empty_slabs--;
+
+    if (s->_free == NULL && s->_carved == _per_slab)
+	unlink(s);
+
+    return p;
 }
 
 template <class T, size_t EXPANSION_SIZE>
     inline void
 MemoryPool<T, EXPANSION_SIZE>::free(void* doomed)
 {
-    MemoryPool<T, EXPANSION_SIZE>* head = reinterpret_cast<MemoryPool<T, EXPANSION_SIZE>* >(doomed);
+    if (doomed == NULL)
+	return;
+
+    Slab* s = slab_of(doomed);
+    Chunk* c = reinterpret_cast<Chunk*>(doomed);
+
+    c->_next = s->_free;
+    s->_free = c;
+
+    if (!s->_listed)
+	link(s);
+
+    if (--s->_in_use == 0 && ++_empty_slabs > MAX_EMPTY_SLABS)
+    {
+	unlink(s);
+	delete_slab(s);
+    }
+}
+
+template <class T, size_t EXPANSION_SIZE>
+    void
+MemoryPool<T, EXPANSION_SIZE>::link(Slab* s)
+{
+    s->_prev = NULL;
+    s->_next = _partial;
+    if (_partial != NULL)
+	_partial->_prev = s;
+    _partial = s;
+    s->_listed = true;
+}
+
+template <class T, size_t EXPANSION_SIZE>
+    void
+MemoryPool<T, EXPANSION_SIZE>::unlink(Slab* s)
+{
+    if (s->_prev != NULL)
+	s->_prev->_next = s->_next;
+    else
+	_partial = s->_next;
+    if (s->_next != NULL)
+	s->_next->_prev = s->_prev;
+    s->_prev = s->_next = NULL;
+    s->_listed = false;
+}
+
+template <class T, size_t EXPANSION_SIZE>
+    typename MemoryPool<T, EXPANSION_SIZE>::Slab*
+MemoryPool<T, EXPANSION_SIZE>::new_slab()
+{
+    Slab* s = reinterpret_cast<Slab*>(slab_alloc(_slab_bytes));
+
+    s->_prev = s->_next = NULL;
+    s->_free = NULL;
+    s->_in_use = 0;
+    s->_carved = 0;
+    s->_listed = false;
 
-    head->_next = _next;
-    _next = head;
+    _empty_slabs++;
+
+    return s;
 }
 
 template <class T, size_t EXPANSION_SIZE>
-    inline void
-MemoryPool<T, EXPANSION_SIZE>::expand_free_list()
+    void
+MemoryPool<T, EXPANSION_SIZE>::delete_slab(Slab* s)
 {
-    // We must allocate object large enough to contain the next pointer
-    MemoryPool<T, EXPANSION_SIZE>* runner = reinterpret_cast<MemoryPool<T, EXPANSION_SIZE>* >(new char[_size]);
+    assert(s->_in_use == 0);
 
-    _next = runner;
-    for (size_t i = 0; i < EXPANSION_SIZE; ++i) 
-    {
-	runner->_next = reinterpret_cast<MemoryPool<T, EXPANSION_SIZE>* >(new char[_size]);
-	runner = runner->_next;
-    }
-    runner->_next = NULL;
+    _empty_slabs--;
+
+    slab_free(s);
 }
 
 #endif /* MEMORY_POOL_HH_ */
@@ -89,8 +89,10 @@ inline
 	MemoryPool<IPPeerNextHop<A> >&
 IPPeerNextHop<A>::memory_pool()
 {
-	static MemoryPool<IPPeerNextHop<A> > mp;
-	return mp;
+	// Never destroyed, nexthops may still be referenced during shutdown.
+	static MemoryPool<IPPeerNextHop<A> >* mp
+		= new MemoryPool<IPPeerNextHop<A> >("IPPeerNextHop");
+	return *mp;
 }
 
 	template<class A>
@@ -124,8 +126,10 @@ inline
 	MemoryPool<IPExternalNextHop<A> >&
 IPExternalNextHop<A>::memory_pool()
 {
-	static MemoryPool<IPExternalNextHop<A> > mp;
-	return mp;
+	// Never destroyed, nexthops may still be referenced during shutdown.
+	static MemoryPool<IPExternalNextHop<A> >* mp
+		= new MemoryPool<IPExternalNextHop<A> >("IPExternalNextHop");
+	return *mp;
 }
 
 	template <class A>
@@ -276,6 +276,197 @@ class ref_ptr
 	mutable int32_t _M_index;	// index in ref_counter_pool
 };
 
+/**
+ * @short Base class for objects that carry their own reference count.
+ *
+ * An object deriving from iref_counted stores its reference count
+ * inline, so an @ref iref_ptr to it needs no slot in a counter pool
+ * and copying the pointer only touches the object itself.  The count
+ * is not copied when the object is copied.
+ */
+class iref_counted
+{
+    public:
+	iref_counted() : _iref_count(0) {}
+	iref_counted(const iref_counted&) : _iref_count(0) {}
+	iref_counted& operator=(const iref_counted&) { return *this; }
+
+	/**
+	 * @return the number of iref_ptr instances referring to this object.
+	 */
+	int32_t iref_count() const { return _iref_count; }
+
+    protected:
+	~iref_counted() {}
+
+    private:
+	template <class _Tp> friend class iref_ptr;
+
+	int32_t iref_incr() const { return ++_iref_count; }
+	int32_t iref_decr() const
+	{
+	    int32_t c = --_iref_count;
+	    assert(c >= 0);
+	    return c;
+	}
+
+	mutable int32_t _iref_count;
+};
+
+/**
+ * @short Intrusive Reference Counted Pointer Class.
+ *
+ * The iref_ptr class has the same interface and semantics as ref_ptr,
+ * but keeps the reference count in the object, which must derive from
+ * @ref iref_counted.  It is intended for heavily copied types where the
+ * ref_counter_pool lookup on every copy and destruction is a
+ * measurable cost.
+ *
+ * Unlike ref_ptr, constructing two iref_ptr's from the same raw pointer
+ * is safe: both share the count stored in the object.
+ */
+template <class _Tp>
+class iref_ptr 
+{
+    public:
+	/**
+	 * Construct a reference pointer for object.
+	 *
+	 * @param p pointer to object to be reference counted.  p must be
+	 * allocated using operator new as it will be destructed using delete
+	 * when the reference count reaches zero.
+	 */
+	iref_ptr(_Tp* __p = 0)
+	    : _M_ptr(__p)
+	{
+	    if (_M_ptr)
+		counted()->iref_incr();
+	}
+
+	/**
+	 * Copy Constructor
+	 *
+	 * Constructs a reference pointer for object.  Raises reference count
+	 * associated with object by 1.
+	 */
+	iref_ptr(const iref_ptr& __r)
+	    : _M_ptr(0)
+	{
+	    ref(&__r);
+	}
+
+	/**
+	 * Assignment Operator
+	 *
+	 * Assigns reference pointer to new object.
+	 */
+	iref_ptr& operator=(const iref_ptr& __r) 
+	{
+	    if (&__r != this) 
+	    {
+		unref();
+		ref(&__r);
+	    }
+	    return *this;
+	}
+
+	/**
+	 * Destruct reference pointer instance and lower reference count on
+	 * object being tracked.  The object being tracked will be deleted if
+	 * the reference count falls to zero because of the destruction of the
+	 * reference pointer.
+	 */
+	~iref_ptr() 
+	{
+	    unref();
+	}
+
+	/**
+	 * Dereference reference counted object.
+	 * @return reference to object.
+	 */
+	_Tp& operator*() const { return *_M_ptr; }
+
+	/**
+	 * Dereference pointer to reference counted object.
+	 * @return pointer to object.
+	 */
+	_Tp* operator->() const { return _M_ptr; }
+
+	/**
+	 * Dereference pointer to reference counted object.
+	 * @return pointer to object.
+	 */
+	_Tp* get() const { return _M_ptr; }
+
+	/**
+	 * Equality Operator
+	 * @return true if reference pointers refer to same object.
+	 */
+	bool operator==(const iref_ptr& rp) const { return _M_ptr == rp._M_ptr; }
+
+	/**
+	 * Check if reference pointer refers to an object or whether it has
+	 * been assigned a null object.
+	 * @return true if reference pointer refers to a null object.
+	 */
+	bool is_empty() const { return _M_ptr == 0; }
+
+	/**
+	 * @return true if reference pointer represents only reference to object.
+	 */
+	bool is_only() const 
+	{
+	    return _M_ptr && counted()->iref_count() == 1;
+	}
+
+	/**
+	 * @param n minimum count.
+	 * @return true if there are at least n references to object.
+	 */
+	bool at_least(int32_t n) const 
+	{
+	    return _M_ptr && counted()->iref_count() >= n;
+	}
+
+	/**
+	 * Release reference on object.  The reference pointers underlying
+	 * object is set to null, and the former object is destructed if
+	 * necessary.
+	 */
+	void release() const { unref(); }
+	/* mimic functionality of boost weak_ptr, same as release()
+	*/
+	void reset() const { unref(); }
+
+    private:
+	const iref_counted* counted() const { return _M_ptr; }
+
+	/**
+	 * Add reference.
+	 */
+	void ref(const iref_ptr* __r) const 
+	{
+	    _M_ptr = __r->_M_ptr;
+	    if (_M_ptr) 
+		counted()->iref_incr();
+	}
+
+	/**
+	 * Remove reference.
+	 */
+	void unref() const 
+	{
+	    if (_M_ptr && counted()->iref_decr() == 0) 
+	    {
+		delete _M_ptr;
+	    }
+	    _M_ptr = 0;
+	}
+
+	mutable _Tp*    _M_ptr;
+};
+
 /**
  * @short class for maintaining the storage of counters used by cref_ptr.
  *
@@ -31,6 +31,7 @@
 #include "xlog.h"
 #include "debug.h"
 #include "minitraits.hh"
+#include "memory_pool.hh"
 #include "stack"
 
 
@@ -339,7 +340,21 @@ class RefTrieNode
 	    return n->_k.top_addr();
 	}
 
+	/**
+	 * Nodes are allocated from a slab pool shared by all tries with
+	 * the same key and payload types.
+	 */
+	void* operator new(size_t/* size*/)	{ return memory_pool().alloc(); }
+	void operator delete(void* ptr)		{ memory_pool().free(ptr); }
+
     private:
+	static MemoryPool<RefTrieNode>& memory_pool()
+	{
+	    // Never destroyed, tries held in statics are torn down later.
+	    static MemoryPool<RefTrieNode>* mp = new MemoryPool<RefTrieNode>("RefTrieNode");
+	    return *mp;
+	}
+
 	/* delete_payload is a separate method to allow specialization */
 	void delete_payload(Payload* p) 
 	{
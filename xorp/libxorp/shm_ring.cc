@@ -0,0 +1,442 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "libxorp_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/debug.h"
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include "shm_ring.hh"
+
+#if defined(HAVE_SYS_MMAN_H) && defined(HAVE_SHM_OPEN) && defined(HAVE_MKFIFO)
+#define HAVE_SHM_RING
+#endif
+
+#ifndef O_NOFOLLOW
+#define O_NOFOLLOW 0
+#endif
+
+//
+// The segment starts with this header, the records follow it. The
+// producer only writes _head and the consumer only writes _tail, the
+// two are kept on separate cache lines. Both are byte counts that
+// only ever increase, the offset in the ring is the count modulo the
+// size of the ring.
+//
+struct ShmRing::Header
+{
+    uint32_t		_magic;
+    uint32_t		_size;
+    uint8_t		_pad0[56];
+    volatile uint64_t	_head;		// Bytes written by the producer.
+    uint8_t		_pad1[56];
+    volatile uint64_t	_tail;		// Bytes read by the consumer.
+    volatile uint32_t	_sleeping;	// Consumer is waiting on the pipe.
+    uint8_t		_pad2[52];
+};
+
+//
+// Each record is a 32-bit length followed by the record, padded to
+// a multiple of ALIGN bytes. A record that does not fit before the end
+// of the ring is preceded by a WRAP marker and placed at the start.
+//
+static const uint32_t MAGIC = 0x58534852;	// "XSHR"
+static const uint32_t WRAP = 0xffffffff;
+static const size_t ALIGN = 8;
+static const size_t MIN_SIZE = 4096;
+
+static inline size_t
+record_bytes(size_t len)
+{
+    return (sizeof(uint32_t) + len + ALIGN - 1) & ~(ALIGN - 1);
+}
+
+ShmRing::ShmRing(const string& name)
+    : _name(name), _header(NULL), _mapped(0), _size(0), _front_bytes(0),
+      _producer(false), _broken(false)
+{
+}
+
+ShmRing::~ShmRing()
+{
+    close();
+}
+
+    string
+ShmRing::shm_name() const
+{
+    return "/" + _name;
+}
+
+    string
+ShmRing::fifo_name() const
+{
+    return "/tmp/" + _name + ".fifo";
+}
+
+    uint8_t*
+ShmRing::data() const
+{
+    return reinterpret_cast<uint8_t*>(_header) + sizeof(Header);
+}
+
+    size_t
+ShmRing::max_record() const
+{
+    // A record must fit even if it is preceded by a WRAP marker that
+    // uses up the rest of the ring.
+    return _size / 2 - sizeof(uint32_t);
+}
+
+    int
+ShmRing::map(int fd, size_t bytes, string& error_msg)
+{
+#ifdef HAVE_SHM_RING
+    void* p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) 
+    {
+	error_msg = c_format("Cannot map shared memory %s: %s",
+			     shm_name().c_str(), strerror(errno));
+	return (XORP_ERROR);
+    }
+    _header = reinterpret_cast<Header*>(p);
+    _mapped = bytes;
+
+    return (XORP_OK);
+#else
+    UNUSED(fd);
+    UNUSED(bytes);
+    error_msg = "Shared memory rings are not supported";
+    return (XORP_ERROR);
+#endif
+}
+
+    int
+ShmRing::create(size_t bytes, string& error_msg)
+{
+#ifdef HAVE_SHM_RING
+    XLOG_ASSERT(_header == NULL);
+
+    _size = MIN_SIZE;
+    while (_size < bytes)
+	_size <<= 1;
+
+    int fd = shm_open(shm_name().c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) 
+    {
+	error_msg = c_format("Cannot create shared memory %s: %s",
+			     shm_name().c_str(), strerror(errno));
+	return (XORP_ERROR);
+    }
+    if (ftruncate(fd, sizeof(Header) + _size) < 0) 
+    {
+	error_msg = c_format("Cannot size shared memory %s: %s",
+			     shm_name().c_str(), strerror(errno));
+	::close(fd);
+	shm_unlink(shm_name().c_str());
+	return (XORP_ERROR);
+    }
+    int ret = map(fd, sizeof(Header) + _size, error_msg);
+    ::close(fd);
+    if (ret != XORP_OK) 
+    {
+	shm_unlink(shm_name().c_str());
+	return (XORP_ERROR);
+    }
+
+    memset(_header, 0, sizeof(Header));
+    _header->_size = _size;
+    _header->_magic = MAGIC;
+    // The consumer starts out waiting on the pipe for the first record.
+    _header->_sleeping = 1;
+
+    //
+    // XXX: The pipe is opened for writing as well as reading, so that
+    // it does not report end of file whenever the producer closes it.
+    //
+    if (mkfifo(fifo_name().c_str(), 0600) < 0
+	    || (fd = open(fifo_name().c_str(),
+			O_RDWR | O_NONBLOCK | O_NOFOLLOW)) < 0) 
+    {
+	error_msg = c_format("Cannot create pipe %s: %s",
+			     fifo_name().c_str(), strerror(errno));
+	unlink();
+	close();
+	return (XORP_ERROR);
+    }
+    _notify_fd = XorpFd(fd);
+    _producer = false;
+    _broken = false;
+
+    return (XORP_OK);
+#else
+    UNUSED(bytes);
+    error_msg = "Shared memory rings are not supported";
+    return (XORP_ERROR);
+#endif
+}
+
+    int
+ShmRing::attach(string& error_msg)
+{
+#ifdef HAVE_SHM_RING
+    XLOG_ASSERT(_header == NULL);
+
+    int fd = shm_open(shm_name().c_str(), O_RDWR, 0);
+    if (fd < 0) 
+    {
+	error_msg = c_format("Cannot open shared memory %s: %s",
+			     shm_name().c_str(), strerror(errno));
+	return (XORP_ERROR);
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0
+	    || static_cast<size_t>(st.st_size) < sizeof(Header) + MIN_SIZE) 
+    {
+	error_msg = c_format("Shared memory %s is too small",
+			     shm_name().c_str());
+	::close(fd);
+	return (XORP_ERROR);
+    }
+    int ret = map(fd, st.st_size, error_msg);
+    ::close(fd);
+    if (ret != XORP_OK)
+	return (XORP_ERROR);
+
+    _size = _mapped - sizeof(Header);
+    if (_header->_magic != MAGIC || _header->_size != _size
+	    || (_size & (_size - 1)) != 0) 
+    {
+	error_msg = c_format("Shared memory %s is not a ring",
+			     shm_name().c_str());
+	close();
+	return (XORP_ERROR);
+    }
+
+    fd = open(fifo_name().c_str(), O_WRONLY | O_NONBLOCK | O_NOFOLLOW);
+    if (fd < 0) 
+    {
+	error_msg = c_format("Cannot open pipe %s: %s",
+			     fifo_name().c_str(), strerror(errno));
+	close();
+	return (XORP_ERROR);
+    }
+    _notify_fd = XorpFd(fd);
+    _producer = true;
+    _broken = false;
+
+    return (XORP_OK);
+#else
+    error_msg = "Shared memory rings are not supported";
+    return (XORP_ERROR);
+#endif
+}
+
+    void
+ShmRing::unlink()
+{
+#ifdef HAVE_SHM_RING
+    shm_unlink(shm_name().c_str());
+    ::unlink(fifo_name().c_str());
+#endif
+}
+
+    void
+ShmRing::close()
+{
+#ifdef HAVE_SHM_RING
+    if (_header != NULL)
+	munmap(_header, _mapped);
+#endif
+    _header = NULL;
+    _mapped = 0;
+    _size = 0;
+    _front_bytes = 0;
+
+    if (_notify_fd.is_valid()) 
+    {
+	::close(_notify_fd);
+	_notify_fd.clear();
+    }
+}
+
+    bool
+ShmRing::write(const uint8_t* head, size_t head_len,
+	       const uint8_t* data_ptr, size_t data_len)
+{
+    if (!is_open() || !_producer)
+	return false;
+
+    size_t len = head_len + data_len;
+    if (len > max_record())
+	return false;
+
+    uint64_t head_count = _header->_head;
+    uint64_t tail_count = _header->_tail;
+    if (head_count - tail_count > _size) 
+    {
+	XLOG_WARNING("Shared memory ring %s is corrupt", _name.c_str());
+	_broken = true;
+	return false;
+    }
+
+    size_t need = record_bytes(len);
+    size_t pos = head_count & (_size - 1);
+    size_t to_end = _size - pos;
+    size_t total = need > to_end ? to_end + need : need;
+    if (total > _size - (head_count - tail_count))
+	return false;
+
+    if (need > to_end) 
+    {
+	memcpy(data() + pos, &WRAP, sizeof(WRAP));
+	head_count += to_end;
+	pos = 0;
+    }
+
+    uint32_t rec_len = len;
+    uint8_t* p = data() + pos;
+    memcpy(p, &rec_len, sizeof(rec_len));
+    memcpy(p + sizeof(rec_len), head, head_len);
+    memcpy(p + sizeof(rec_len) + head_len, data_ptr, data_len);
+
+    // Publish the record, then see if the consumer needs waking.
+    __sync_synchronize();
+    _header->_head = head_count + need;
+    __sync_synchronize();
+
+    if (_header->_sleeping) 
+    {
+	_header->_sleeping = 0;
+	wake();
+
+	// The consumer has gone away.
+	if (_broken)
+	    return false;
+    }
+
+    return true;
+}
+
+    const uint8_t*
+ShmRing::front(size_t& len)
+{
+    if (!is_open() || _producer)
+	return NULL;
+
+    uint64_t tail_count = _header->_tail;
+    uint64_t head_count = _header->_head;
+    __sync_synchronize();
+
+    for (;;) 
+    {
+	if (head_count == tail_count)
+	    return NULL;
+	if (head_count - tail_count > _size)
+	    break;
+
+	size_t pos = tail_count & (_size - 1);
+	uint32_t rec_len;
+	memcpy(&rec_len, data() + pos, sizeof(rec_len));
+
+	if (rec_len == WRAP) 
+	{
+	    tail_count += _size - pos;
+	    __sync_synchronize();
+	    _header->_tail = tail_count;
+	    continue;
+	}
+
+	if (rec_len > max_record()
+		|| record_bytes(rec_len) > head_count - tail_count
+		|| record_bytes(rec_len) > _size - pos)
+	    break;
+
+	len = rec_len;
+	_front_bytes = record_bytes(rec_len);
+	return data() + pos + sizeof(rec_len);
+    }
+
+    XLOG_WARNING("Shared memory ring %s is corrupt", _name.c_str());
+    _broken = true;
+
+    return NULL;
+}
+
+    void
+ShmRing::pop()
+{
+    XLOG_ASSERT(_front_bytes != 0);
+
+    // Finish with the record before handing the space back.
+    __sync_synchronize();
+    _header->_tail = _header->_tail + _front_bytes;
+    _front_bytes = 0;
+}
+
+    bool
+ShmRing::sleep()
+{
+    if (!is_open())
+	return true;
+
+    _header->_sleeping = 1;
+    __sync_synchronize();
+    if (_header->_head != _header->_tail) 
+    {
+	_header->_sleeping = 0;
+	return false;
+    }
+
+    return true;
+}
+
+    void
+ShmRing::clear_notify()
+{
+    uint8_t buf[64];
+
+    if (!_notify_fd.is_valid())
+	return;
+
+    while (::read(_notify_fd, buf, sizeof(buf)) > 0)
+	;
+}
+
+    void
+ShmRing::wake()
+{
+    uint8_t wake = 0;
+
+    if (!_notify_fd.is_valid())
+	return;
+
+    if (::write(_notify_fd, &wake, sizeof(wake)) < 0 && errno == EPIPE)
+	_broken = true;
+}
@@ -0,0 +1,183 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __LIBXORP_SHM_RING_HH__
+#define __LIBXORP_SHM_RING_HH__
+
+#include "libxorp/xorp.h"
+#include "libxorp/xorpfd.hh"
+
+/**
+ * @short Single producer, single consumer ring of records in shared
+ * memory.
+ *
+ * The ring allows two processes on the same host to pass records to
+ * each other without a system call per record.  The consumer creates
+ * the ring, which consists of a shared memory segment and a named pipe
+ * used to wake the consumer, and tells the producer its name by some
+ * other means.  Once the producer has attached the consumer may
+ * unlink the names, the ring then lives until both sides close it.
+ *
+ * The producer only writes to the pipe when the consumer has said it
+ * is about to sleep, so a busy consumer is not woken for every record.
+ * The consumer should add notify_fd() to its event loop and on
+ * readability call clear_notify(), then consume records with front()
+ * and pop() until the ring is empty, and then call sleep().  If sleep()
+ * returns false more records arrived and they should be consumed
+ * before sleeping again.
+ *
+ * Neither side trusts the other: a corrupt ring is reported as broken
+ * and should be closed, after which the caller should fall back to
+ * some other means of communication.
+ */
+class ShmRing : public NONCOPYABLE
+{
+    public:
+	/**
+	 * @param name the name of the ring, a file name without any
+	 * slashes.
+	 */
+	ShmRing(const string& name);
+	~ShmRing();
+
+	/**
+	 * @return the name of the ring.
+	 */
+	const string& name() const { return _name; }
+
+	/**
+	 * Create the ring, as the consumer.
+	 *
+	 * @param bytes the number of bytes of records the ring holds,
+	 * rounded up to a power of two.
+	 * @param error_msg the error message (if error).
+	 * @return XORP_OK on success, otherwise XORP_ERROR.
+	 */
+	int create(size_t bytes, string& error_msg);
+
+	/**
+	 * Attach to a ring created by the consumer, as the producer.
+	 *
+	 * @param error_msg the error message (if error).
+	 * @return XORP_OK on success, otherwise XORP_ERROR.
+	 */
+	int attach(string& error_msg);
+
+	/**
+	 * Remove the names of the ring. The ring is still usable by any
+	 * side that has created or attached to it.
+	 */
+	void unlink();
+
+	/**
+	 * Unmap the ring and close the pipe.
+	 */
+	void close();
+
+	/**
+	 * @return true if the ring has been created or attached and is not
+	 * broken.
+	 */
+	bool is_open() const { return _header != NULL && !_broken; }
+
+	/**
+	 * @return true if the other side has corrupted the ring, or the
+	 * consumer has gone away.
+	 */
+	bool is_broken() const { return _broken; }
+
+	/**
+	 * Append a record made up of two pieces, and wake the consumer if
+	 * it is sleeping.
+	 *
+	 * @param head the first piece.
+	 * @param head_len the length of the first piece.
+	 * @param data the second piece.
+	 * @param data_len the length of the second piece.
+	 * @return true if the record was added, false if there was no room
+	 * or the ring is not usable.
+	 */
+	bool write(const uint8_t* head, size_t head_len,
+		const uint8_t* data, size_t data_len);
+
+	/**
+	 * Get the oldest record, without removing it.
+	 *
+	 * @param len the length of the record.
+	 * @return the record, or NULL if the ring is empty or not usable.
+	 */
+	const uint8_t* front(size_t& len);
+
+	/**
+	 * Remove the oldest record.
+	 */
+	void pop();
+
+	/**
+	 * Tell the producer that the consumer is going to wait on
+	 * notify_fd().
+	 *
+	 * @return false if records arrived in the meantime, in which case
+	 * the consumer should not wait.
+	 */
+	bool sleep();
+
+	/**
+	 * @return the file descriptor that becomes readable when the
+	 * consumer should look at the ring.
+	 */
+	XorpFd notify_fd() const { return _notify_fd; }
+
+	/**
+	 * Read any pending wake ups from notify_fd().
+	 */
+	void clear_notify();
+
+	/**
+	 * Make notify_fd() readable. A consumer that stops before the ring
+	 * is empty, to let other work run, uses this to be called again.
+	 */
+	void wake();
+
+	/**
+	 * The largest record that can be written to a ring of this size.
+	 */
+	size_t max_record() const;
+
+    private:
+	struct Header;
+
+	string shm_name() const;
+	string fifo_name() const;
+	int map(int fd, size_t bytes, string& error_msg);
+	uint8_t* data() const;
+
+	string		_name;
+	Header*		_header;	// Start of the mapped segment.
+	size_t		_mapped;	// Bytes mapped.
+	size_t		_size;		// Bytes of records, a power of two.
+	size_t		_front_bytes;	// Ring bytes used by the front record.
+	XorpFd		_notify_fd;	// Named pipe.
+	bool		_producer;
+	bool		_broken;
+};
+
+#endif // __LIBXORP_SHM_RING_HH__
@@ -0,0 +1,224 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "libxorp_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
+
+#include "timer_buckets.hh"
+
+// ----------------------------------------------------------------------------
+// BucketTimer
+
+BucketTimer::BucketTimer(const XorpCallback0<void>::RefPtr& cb)
+    : _timer_buckets(NULL), _scheduled_in(NULL), _cb(cb)
+{
+}
+
+BucketTimer::BucketTimer(TimerBuckets& timer_buckets,
+			 const XorpCallback0<void>::RefPtr& cb)
+    : _timer_buckets(&timer_buckets), _scheduled_in(NULL), _cb(cb)
+{
+}
+
+BucketTimer::~BucketTimer()
+{
+    unschedule();
+}
+
+void
+BucketTimer::schedule_after(const TimeVal& delay)
+{
+    XLOG_ASSERT(_timer_buckets != NULL);
+
+    _timer_buckets->schedule_after(*this, delay);
+}
+
+void
+BucketTimer::unschedule()
+{
+    if (_scheduled_in != NULL)
+	_scheduled_in->unschedule(*this);
+}
+
+bool
+BucketTimer::time_remaining(TimeVal& remain) const
+{
+    if (_scheduled_in == NULL)
+    {
+	remain = TimeVal::ZERO();
+	return false;
+    }
+
+    TimeVal now;
+    EventLoop::instance().current_time(now);
+    if (_expiry > now)
+	remain = _expiry - now;
+    else
+	remain = TimeVal::ZERO();
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// TimerBuckets
+
+TimerBuckets::TimerBuckets(uint32_t bucket_ms)
+    : _bucket_ms(bucket_ms), _timers(0), _timer_ops(0),
+      _event_loop_timer_ops(0)
+{
+    XLOG_ASSERT(_bucket_ms > 0);
+}
+
+TimerBuckets::~TimerBuckets()
+{
+    BucketMap::iterator bi;
+    for (bi = _buckets.begin(); bi != _buckets.end(); ++bi)
+    {
+	Bucket::iterator ti;
+	for (ti = bi->second.begin(); ti != bi->second.end(); ++ti)
+	    (*ti)->_scheduled_in = NULL;
+    }
+    _buckets.clear();
+    _timers = 0;
+}
+
+TimeVal
+TimerBuckets::bucket_time(const TimeVal& when) const
+{
+    // Round up, so that a timer never expires early.
+    int64_t ms = when.to_ms();
+    ms = ((ms + _bucket_ms - 1) / _bucket_ms) * _bucket_ms;
+    return TimeVal(ms / 1000, (ms % 1000) * 1000);
+}
+
+void
+TimerBuckets::schedule_at(BucketTimer& timer, const TimeVal& when)
+{
+    if (timer._scheduled_in != NULL)
+	timer._scheduled_in->remove(timer);
+
+    add(timer, when);
+}
+
+void
+TimerBuckets::schedule_after(BucketTimer& timer, const TimeVal& delay)
+{
+    TimeVal when;
+    EventLoop::instance().current_time(when);
+    when += delay;
+    schedule_at(timer, when);
+}
+
+void
+TimerBuckets::unschedule(BucketTimer& timer)
+{
+    if (timer._scheduled_in != this)
+	return;
+
+    // The event loop timer is left alone, an empty bucket is dropped
+    // when it falls due.
+    remove(timer);
+}
+
+void
+TimerBuckets::add(BucketTimer& timer, const TimeVal& when)
+{
+    TimeVal bucket = bucket_time(when);
+    bool first = _buckets.empty() || bucket < _buckets.begin()->first;
+
+    Bucket& b = _buckets[bucket];
+    timer._bucket_iter = b.insert(b.end(), &timer);
+    timer._bucket = bucket;
+    timer._expiry = when;
+    timer._scheduled_in = this;
+    _timers++;
+    _timer_ops++;
+
+    if (first)
+	reschedule_event_loop_timer();
+}
+
+void
+TimerBuckets::remove(BucketTimer& timer)
+{
+    XLOG_ASSERT(timer._scheduled_in == this);
+
+    BucketMap::iterator bi = _buckets.find(timer._bucket);
+    XLOG_ASSERT(bi != _buckets.end());
+    bi->second.erase(timer._bucket_iter);
+    // XXX: the first bucket is removed when it falls due
+    if (bi->second.empty() && bi != _buckets.begin())
+	_buckets.erase(bi);
+
+    timer._scheduled_in = NULL;
+    _timers--;
+    _timer_ops++;
+}
+
+void
+TimerBuckets::reschedule_event_loop_timer()
+{
+    if (_buckets.empty())
+    {
+	_event_loop_timer.unschedule();
+	return;
+    }
+
+    const TimeVal& when = _buckets.begin()->first;
+    if (_event_loop_timer.scheduled() && _event_loop_timer.expiry() == when)
+	return;
+
+    _event_loop_timer = EventLoop::instance().new_oneoff_at(when,
+	    callback(this, &TimerBuckets::event_loop_timer_timeout));
+    _event_loop_timer_ops++;
+}
+
+void
+TimerBuckets::event_loop_timer_timeout()
+{
+    TimeVal now;
+    EventLoop::instance().current_time(now);
+
+    //
+    // The timers are taken one at a time, since a callback may
+    // reschedule or delete any timer, including others in the same
+    // bucket.
+    //
+    while (_buckets.empty() == false && _buckets.begin()->first <= now)
+    {
+	Bucket& b = _buckets.begin()->second;
+	if (b.empty())
+	{
+	    _buckets.erase(_buckets.begin());
+	    continue;
+	}
+
+	BucketTimer* timer = b.front();
+	// XXX: keep a reference, the callback may delete the timer
+	XorpCallback0<void>::RefPtr cb = timer->_cb;
+	remove(*timer);
+	cb->dispatch();
+    }
+
+    reschedule_event_loop_timer();
+}
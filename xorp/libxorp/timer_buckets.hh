@@ -0,0 +1,206 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License, Version
+// 2.1, June 1999 as published by the Free Software Foundation.
+// Redistribution and/or modification of this program under the terms of
+// any other version of the GNU Lesser General Public License is not
+// permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU Lesser General Public License, Version 2.1, a copy of
+// which can be found in the XORP LICENSE.lgpl file.
+//
+// XORP, Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __LIBXORP_TIMER_BUCKETS_HH__
+#define __LIBXORP_TIMER_BUCKETS_HH__
+
+#include "xorp.h"
+#include "callback.hh"
+#include "timer.hh"
+#include "timeval.hh"
+
+class TimerBuckets;
+
+/**
+ * @short A one-off timer kept in time buckets.
+ *
+ * The timer is used like a one-off XorpTimer, but it doesn't have an
+ * event loop timer of its own: it is kept in a @ref TimerBuckets.
+ */
+class BucketTimer :
+    public NONCOPYABLE
+{
+    public:
+	/**
+	 * Constructor for a timer that is scheduled with
+	 * TimerBuckets::schedule_at() or TimerBuckets::schedule_after().
+	 *
+	 * @param cb the callback to invoke when the timer expires.
+	 */
+	BucketTimer(const XorpCallback0<void>::RefPtr& cb);
+
+	/**
+	 * Constructor for a timer that is scheduled with schedule_after().
+	 *
+	 * @param timer_buckets the buckets the timer is kept in.
+	 * @param cb the callback to invoke when the timer expires.
+	 */
+	BucketTimer(TimerBuckets& timer_buckets,
+		    const XorpCallback0<void>::RefPtr& cb);
+
+	/**
+	 * Destructor.  The timer is unscheduled.
+	 */
+	~BucketTimer();
+
+	/**
+	 * Schedule the timer in the buckets given to the constructor, or
+	 * reschedule it if it is scheduled already.
+	 *
+	 * @param delay the timeout interval of the timer.
+	 */
+	void schedule_after(const TimeVal& delay);
+
+	/**
+	 * Unschedule the timer.
+	 */
+	void unschedule();
+
+	/**
+	 * @return true if the timer is scheduled.
+	 */
+	bool scheduled() const		{ return _scheduled_in != NULL; }
+
+	/**
+	 * @return the buckets the timer is scheduled in, or NULL if it is
+	 * not scheduled.
+	 */
+	TimerBuckets* scheduled_in() const	{ return _scheduled_in; }
+
+	/**
+	 * @return the time the timer expires, valid while it is scheduled.
+	 */
+	const TimeVal& expiry() const	{ return _expiry; }
+
+	/**
+	 * Get the time remaining until the timer expires.
+	 *
+	 * @param remain the time remaining, or zero if the timer is not
+	 * scheduled.
+	 * @return true if the timer is scheduled, otherwise false.
+	 */
+	bool time_remaining(TimeVal& remain) const;
+
+    private:
+	friend class TimerBuckets;
+
+	TimerBuckets*	_timer_buckets;	// The buckets for schedule_after()
+	TimerBuckets*	_scheduled_in;	// The buckets the timer is in
+	XorpCallback0<void>::RefPtr _cb;	// The expiry callback
+	TimeVal		_expiry;	// The time the timer expires
+	TimeVal		_bucket;	// The bucket the timer is in
+	list<BucketTimer*>::iterator _bucket_iter;	// Position in bucket
+};
+
+/**
+ * @short A set of one-off timers, kept in time buckets.
+ *
+ * The timers that expire within the same bucket interval, typically
+ * those refreshed by the same received message, are in one bucket, and
+ * all buckets share a single event loop timer.  Rescheduling a timer
+ * moves it between buckets without touching the event loop, and a
+ * bucket is processed in one go when it falls due.
+ *
+ * A timer expires up to one bucket interval after its expiry time, but
+ * never before it.  A timer is in at most one TimerBuckets at a time,
+ * scheduling it in one removes it from any other.
+ */
+class TimerBuckets :
+    public NONCOPYABLE
+{
+    public:
+	/**
+	 * Constructor.
+	 *
+	 * @param bucket_ms the interval covered by each bucket, in
+	 * milliseconds.
+	 */
+	TimerBuckets(uint32_t bucket_ms);
+
+	/**
+	 * Destructor.  The timers that are still scheduled are left
+	 * unscheduled.
+	 */
+	~TimerBuckets();
+
+	/**
+	 * Schedule a timer to expire at a time, or reschedule it.
+	 *
+	 * @param timer the timer.
+	 * @param when the time the timer should expire.
+	 */
+	void schedule_at(BucketTimer& timer, const TimeVal& when);
+
+	/**
+	 * Schedule a timer to expire after a delay, or reschedule it.
+	 *
+	 * @param timer the timer.
+	 * @param delay the timeout interval of the timer.
+	 */
+	void schedule_after(BucketTimer& timer, const TimeVal& delay);
+
+	/**
+	 * Unschedule a timer, if it is scheduled in these buckets.
+	 *
+	 * @param timer the timer.
+	 */
+	void unschedule(BucketTimer& timer);
+
+	/**
+	 * @return the number of scheduled timers.
+	 */
+	size_t timers() const			{ return _timers; }
+
+	/**
+	 * @return the number of buckets in use.
+	 */
+	size_t buckets() const			{ return _buckets.size(); }
+
+	/**
+	 * @return the number of times a timer was scheduled or
+	 * unscheduled.
+	 */
+	uint64_t timer_ops() const		{ return _timer_ops; }
+
+	/**
+	 * @return the number of times the event loop timer was scheduled.
+	 */
+	uint64_t event_loop_timer_ops() const	{ return _event_loop_timer_ops; }
+
+    private:
+	typedef list<BucketTimer*>		Bucket;
+	typedef map<TimeVal, Bucket>		BucketMap;
+
+	TimeVal bucket_time(const TimeVal& when) const;
+	void add(BucketTimer& timer, const TimeVal& when);
+	void remove(BucketTimer& timer);
+	void reschedule_event_loop_timer();
+	void event_loop_timer_timeout();
+
+	uint32_t	_bucket_ms;
+	BucketMap	_buckets;		// Timers by end of bucket
+	XorpTimer	_event_loop_timer;	// Expires at the end of first bucket
+	size_t		_timers;
+	uint64_t	_timer_ops;
+	uint64_t	_event_loop_timer_ops;
+};
+
+#endif // __LIBXORP_TIMER_BUCKETS_HH__
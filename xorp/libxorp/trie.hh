@@ -32,6 +32,7 @@
 #include "xlog.h"
 #include "debug.h"
 #include "minitraits.hh"
+#include "memory_pool.hh"
 
 #include <stack>
 
@@ -285,7 +286,21 @@ class TrieNode
 	    return n->_k.top_addr();
 	}
 
+	/**
+	 * Nodes are allocated from a slab pool shared by all tries with
+	 * the same key and payload types.
+	 */
+	void* operator new(size_t/* size*/)	{ return memory_pool().alloc(); }
+	void operator delete(void* ptr)		{ memory_pool().free(ptr); }
+
     private:
+	static MemoryPool<TrieNode>& memory_pool()
+	{
+	    // Never destroyed, tries held in statics are torn down later.
+	    static MemoryPool<TrieNode>* mp = new MemoryPool<TrieNode>("TrieNode");
+	    return *mp;
+	}
+
 	/* delete_payload is a separate method to allow specialization */
 	void delete_payload(Payload* p) 
 	{
@@ -37,6 +37,9 @@
 #ifdef HAVE_SYSLOG_H
 #include <syslog.h>
 #endif
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 
 #include "xlog.h"
 
@@ -406,17 +409,56 @@ xlog_level_set_verbose(xlog_level_t log_level, xlog_verbose_t verbose_level)
     xlog_verbose_level[log_level] = verbose_level;
 }
 
+/*
+ * Most processes are single threaded, but BGP may decode messages on
+ * worker threads which can log. The lock is recursive in case an
+ * output function logs.
+ */
+#ifdef HAVE_PTHREAD_H
+static pthread_mutex_t	xlog_mutex;
+static pthread_once_t	xlog_mutex_once = PTHREAD_ONCE_INIT;
+
+    static void
+xlog_mutex_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&xlog_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+    static void
+xlog_lock(void)
+{
+    pthread_once(&xlog_mutex_once, xlog_mutex_init);
+    pthread_mutex_lock(&xlog_mutex);
+}
+
+    static void
+xlog_unlock(void)
+{
+    pthread_mutex_unlock(&xlog_mutex);
+}
+#else
+#define xlog_lock()
+#define xlog_unlock()
+#endif
+
     void
 _xlog_with_level(int log_level, const char *module_name, int line, const char *file,
 	const char *function, const char *fmt, ...)
 {
     va_list ap;
-    static char where_buf[8000]; // we are single threaded, global buffer is good enough.
+    static char where_buf[8000]; // global buffer, guarded by xlog_lock().
+    xlog_lock();
     snprintf(where_buf, sizeof(where_buf), "%s:%d %s",
 	    file, line, (function) ? function : "(unknown_func)");
     va_start(ap, fmt);
     xlog_record_va(log_level, module_name, where_buf, fmt, ap);
     va_end(ap);
+    xlog_unlock();
 }
 
 
@@ -51,6 +51,12 @@ Mld6igmpGroupRecord::Mld6igmpGroupRecord(Mld6igmpVif& mld6igmp_vif,
 	_do_forward_sources(*this),
 	_dont_forward_sources(*this),
 	_last_reported_host(IPvX::ZERO(family())),
+	_igmpv1_host_present_timer(mld6igmp_vif.timer_buckets(),
+			callback(this, &Mld6igmpGroupRecord::older_version_host_present_timer_timeout)),
+	_igmpv2_mldv1_host_present_timer(mld6igmp_vif.timer_buckets(),
+			callback(this, &Mld6igmpGroupRecord::older_version_host_present_timer_timeout)),
+	_group_timer(mld6igmp_vif.timer_buckets(),
+			callback(this, &Mld6igmpGroupRecord::group_timer_timeout)),
 	_query_retransmission_count(0)
 {
 
@@ -243,9 +249,7 @@ Mld6igmpGroupRecord::process_mode_is_exclude(const set<IPvX>& sources,
 
 		_dont_forward_sources.cancel_source_timer();		// (B - A) = 0
 		a_minus_b.delete_payload_and_clear();			// Delete (A-B)
-		_group_timer = EventLoop::instance().new_oneoff_after(
-				gmi,
-				callback(this, &Mld6igmpGroupRecord::group_timer_timeout));
+		_group_timer.schedule_after(gmi);
 
 		calculate_forwarding_changes(old_is_include_mode,
 				old_do_forward_sources,
@@ -285,9 +289,7 @@ Mld6igmpGroupRecord::process_mode_is_exclude(const set<IPvX>& sources,
 		a_minus_x_minus_y.set_source_timer(gmi);	// (A - X - Y) = GMI
 		x_minus_a.delete_payload_and_clear();		// Delete (X - A)
 		y_minus_a.delete_payload_and_clear();		// Delete (Y - A)
-		_group_timer = EventLoop::instance().new_oneoff_after(
-				gmi,
-				callback(this, &Mld6igmpGroupRecord::group_timer_timeout));
+		_group_timer.schedule_after(gmi);
 
 		calculate_forwarding_changes(old_is_include_mode,
 				old_do_forward_sources,
@@ -430,9 +432,7 @@ Mld6igmpGroupRecord::process_change_to_exclude_mode(const set<IPvX>& sources,
 
 		_dont_forward_sources.cancel_source_timer();		// (B - A) = 0
 		a_minus_b.delete_payload_and_clear();			// Delete (A-B)
-		_group_timer = EventLoop::instance().new_oneoff_after(
-				gmi,
-				callback(this, &Mld6igmpGroupRecord::group_timer_timeout));
+		_group_timer.schedule_after(gmi);
 
 		// Send Q(G, A * B) with _do_forward_sources
 		_mld6igmp_vif.mld6igmp_group_source_query_send(
@@ -481,9 +481,7 @@ Mld6igmpGroupRecord::process_change_to_exclude_mode(const set<IPvX>& sources,
 		a_minus_x_minus_y.set_source_timer(gt);	// (A - X - Y) = Group Timer
 		x_minus_a.delete_payload_and_clear();		// Delete (X - A)
 		y_minus_a.delete_payload_and_clear();		// Delete (Y - A)
-		_group_timer = EventLoop::instance().new_oneoff_after(
-				gmi,
-				callback(this, &Mld6igmpGroupRecord::group_timer_timeout));
+		_group_timer.schedule_after(gmi);
 
 		// Send Q(G, A - Y) with _do_forward_sources
 		_mld6igmp_vif.mld6igmp_group_source_query_send(
@@ -673,9 +671,7 @@ Mld6igmpGroupRecord::lower_group_timer(const TimeVal& timeval)
 	_group_timer.time_remaining(timeval_remaining);
 	if (timeval < timeval_remaining) 
 	{
-		_group_timer = EventLoop::instance().new_oneoff_after(
-				timeval,
-				callback(this, &Mld6igmpGroupRecord::group_timer_timeout));
+		_group_timer.schedule_after(timeval);
 	}
 }
 
@@ -723,7 +719,7 @@ Mld6igmpGroupRecord::source_expired(Mld6igmpSourceRecord* source_record)
 		if (_do_forward_sources.empty()) 
 		{
 			XLOG_ASSERT(_dont_forward_sources.empty());
-			mld6igmp_vif().group_records().erase(group());
+			mld6igmp_vif().group_records().erase_group_record(this);
 			delete this;
 		}
 		return;
@@ -811,7 +807,7 @@ Mld6igmpGroupRecord::group_timer_timeout()
 		// No sources with running source timers.
 		// Delete the group record and return immediately.
 		//
-		mld6igmp_vif().group_records().erase(group());
+		mld6igmp_vif().group_records().erase_group_record(this);
 		delete this;
 		return;
 	}
@@ -1044,14 +1040,10 @@ Mld6igmpGroupRecord::received_older_membership_report(int message_version)
 					//
 					timeval = _mld6igmp_vif.group_membership_interval();
 				}
-				_igmpv1_host_present_timer = EventLoop::instance().new_oneoff_after(
-						timeval,
-						callback(this, &Mld6igmpGroupRecord::older_version_host_present_timer_timeout));
+				_igmpv1_host_present_timer.schedule_after(timeval);
 				break;
 			case IGMP_V2:
-				_igmpv2_mldv1_host_present_timer = EventLoop::instance().new_oneoff_after(
-						timeval,
-						callback(this, &Mld6igmpGroupRecord::older_version_host_present_timer_timeout));
+				_igmpv2_mldv1_host_present_timer.schedule_after(timeval);
 				break;
 			default:
 				break;
@@ -1063,9 +1055,7 @@ Mld6igmpGroupRecord::received_older_membership_report(int message_version)
 		switch (message_version) 
 		{
 			case MLD_V1:
-				_igmpv2_mldv1_host_present_timer = EventLoop::instance().new_oneoff_after(
-						timeval,
-						callback(this, &Mld6igmpGroupRecord::older_version_host_present_timer_timeout));
+				_igmpv2_mldv1_host_present_timer.schedule_after(timeval);
 				break;
 			default:
 				break;
@@ -1396,7 +1386,8 @@ Mld6igmpGroupRecord::calculate_forwarding_changes(
  * @param mld6igmp_vif the interface this set belongs to.
  */
 	Mld6igmpGroupSet::Mld6igmpGroupSet(Mld6igmpVif& mld6igmp_vif)
-: _mld6igmp_vif(mld6igmp_vif)
+: _mld6igmp_vif(mld6igmp_vif),
+	_hash_buckets(HASH_INITIAL_BUCKETS)
 {
 
 }
@@ -1419,14 +1410,106 @@ Mld6igmpGroupSet::~Mld6igmpGroupSet()
 	Mld6igmpGroupRecord*
 Mld6igmpGroupSet::find_group_record(const IPvX& group)
 {
-	Mld6igmpGroupSet::iterator iter = this->find(group);
+	const HashChain& chain = _hash_buckets[hash_bucket(group)];
+	HashChain::const_iterator iter;
 
-	if (iter != this->end())
-		return (iter->second);
+	for (iter = chain.begin(); iter != chain.end(); ++iter) 
+	{
+		if ((*iter)->group() == group)
+			return (*iter);
+	}
 
 	return (NULL);
 }
 
+/**
+ * Add a group record.
+ *
+ * @param group_record the group record to add.
+ */
+	void
+Mld6igmpGroupSet::insert_group_record(Mld6igmpGroupRecord* group_record)
+{
+	if (! this->insert(make_pair(group_record->group(), group_record)).second)
+		return;
+
+	//
+	// XXX: growing the table rehashes every record in the map, including
+	// the new one, so it is only added to its chain if there was no grow.
+	//
+	if (this->size() > _hash_buckets.size()) 
+	{
+		hash_grow();
+		return;
+	}
+	_hash_buckets[hash_bucket(group_record->group())].push_back(group_record);
+}
+
+/**
+ * Remove a group record. Note that the group record itself is not deleted.
+ *
+ * @param group_record the group record to remove.
+ */
+	void
+Mld6igmpGroupSet::erase_group_record(Mld6igmpGroupRecord* group_record)
+{
+	HashChain& chain = _hash_buckets[hash_bucket(group_record->group())];
+	HashChain::iterator iter;
+
+	this->erase(group_record->group());
+
+	for (iter = chain.begin(); iter != chain.end(); ++iter) 
+	{
+		if (*iter == group_record) 
+		{
+			chain.erase(iter);
+			break;
+		}
+	}
+}
+
+/**
+ * Get the hash table bucket for a group address.
+ *
+ * @param group the group address.
+ * @return the index of the bucket.
+ */
+	size_t
+Mld6igmpGroupSet::hash_bucket(const IPvX& group) const
+{
+	uint8_t addr[sizeof(struct in6_addr)];
+	size_t addr_len = group.copy_out(addr);
+	uint32_t h = 2166136261U;	// FNV-1a
+
+	for (size_t i = 0; i < addr_len; i++) 
+	{
+		h ^= addr[i];
+		h *= 16777619U;
+	}
+
+	// XXX: the number of buckets is a power of two
+	return (h & (_hash_buckets.size() - 1));
+}
+
+/**
+ * Double the number of hash table buckets.
+ */
+	void
+Mld6igmpGroupSet::hash_grow()
+{
+	Mld6igmpGroupSet::iterator iter;
+
+	size_t buckets_n = _hash_buckets.size() * 2;
+
+	_hash_buckets.clear();
+	_hash_buckets.resize(buckets_n);
+	for (iter = this->begin(); iter != this->end(); ++iter) 
+	{
+		Mld6igmpGroupRecord* group_record = iter->second;
+		_hash_buckets[hash_bucket(group_record->group())].push_back(group_record);
+	}
+}
+
 /**
  * Delete the payload of the set, and clear the set itself.
  */
@@ -1448,6 +1531,8 @@ Mld6igmpGroupSet::delete_payload_and_clear()
 	// Clear the set itself
 	//
 	this->clear();
+	_hash_buckets.clear();
+	_hash_buckets.resize(HASH_INITIAL_BUCKETS);
 }
 
 /**
@@ -1463,17 +1548,13 @@ Mld6igmpGroupSet::process_mode_is_include(const IPvX& group,
 		const set<IPvX>& sources,
 		const IPvX& last_reported_host)
 {
-	Mld6igmpGroupSet::iterator iter;
 	Mld6igmpGroupRecord* group_record = NULL;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		group_record = iter->second;
-	} else 
+	group_record = find_group_record(group);
+	if (group_record == NULL) 
 	{
 		group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-		this->insert(make_pair(group, group_record));
+		insert_group_record(group_record);
 	}
 	XLOG_ASSERT(group_record != NULL);
 
@@ -1484,7 +1565,7 @@ Mld6igmpGroupSet::process_mode_is_include(const IPvX& group,
 	//
 	if (group_record->is_unused()) 
 	{
-		this->erase(group);
+		erase_group_record(group_record);
 		delete group_record;
 	}
 }
@@ -1502,17 +1583,13 @@ Mld6igmpGroupSet::process_mode_is_exclude(const IPvX& group,
 		const set<IPvX>& sources,
 		const IPvX& last_reported_host)
 {
-	Mld6igmpGroupSet::iterator iter;
 	Mld6igmpGroupRecord* group_record = NULL;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		group_record = iter->second;
-	} else 
+	group_record = find_group_record(group);
+	if (group_record == NULL) 
 	{
 		group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-		this->insert(make_pair(group, group_record));
+		insert_group_record(group_record);
 	}
 	XLOG_ASSERT(group_record != NULL);
 
@@ -1523,7 +1600,7 @@ Mld6igmpGroupSet::process_mode_is_exclude(const IPvX& group,
 	//
 	if (group_record->is_unused()) 
 	{
-		this->erase(group);
+		erase_group_record(group_record);
 		delete group_record;
 	}
 }
@@ -1541,17 +1618,13 @@ Mld6igmpGroupSet::process_change_to_include_mode(const IPvX& group,
 		const set<IPvX>& sources,
 		const IPvX& last_reported_host)
 {
-	Mld6igmpGroupSet::iterator iter;
 	Mld6igmpGroupRecord* group_record = NULL;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		group_record = iter->second;
-	} else 
+	group_record = find_group_record(group);
+	if (group_record == NULL) 
 	{
 		group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-		this->insert(make_pair(group, group_record));
+		insert_group_record(group_record);
 	}
 	XLOG_ASSERT(group_record != NULL);
 
@@ -1572,7 +1645,7 @@ Mld6igmpGroupSet::process_change_to_include_mode(const IPvX& group,
 	//
 	if (group_record->is_unused()) 
 	{
-		this->erase(group);
+		erase_group_record(group_record);
 		delete group_record;
 	}
 }
@@ -1590,17 +1663,13 @@ Mld6igmpGroupSet::process_change_to_exclude_mode(const IPvX& group,
 		const set<IPvX>& sources,
 		const IPvX& last_reported_host)
 {
-	Mld6igmpGroupSet::iterator iter;
 	Mld6igmpGroupRecord* group_record = NULL;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		group_record = iter->second;
-	} else 
+	group_record = find_group_record(group);
+	if (group_record == NULL) 
 	{
 		group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-		this->insert(make_pair(group, group_record));
+		insert_group_record(group_record);
 	}
 	XLOG_ASSERT(group_record != NULL);
 
@@ -1626,7 +1695,7 @@ Mld6igmpGroupSet::process_change_to_exclude_mode(const IPvX& group,
 	//
 	if (group_record->is_unused()) 
 	{
-		this->erase(group);
+		erase_group_record(group_record);
 		delete group_record;
 	}
 }
@@ -1644,17 +1713,13 @@ Mld6igmpGroupSet::process_allow_new_sources(const IPvX& group,
 		const set<IPvX>& sources,
 		const IPvX& last_reported_host)
 {
-	Mld6igmpGroupSet::iterator iter;
 	Mld6igmpGroupRecord* group_record = NULL;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		group_record = iter->second;
-	} else 
+	group_record = find_group_record(group);
+	if (group_record == NULL) 
 	{
 		group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-		this->insert(make_pair(group, group_record));
+		insert_group_record(group_record);
 	}
 	XLOG_ASSERT(group_record != NULL);
 
@@ -1665,7 +1730,7 @@ Mld6igmpGroupSet::process_allow_new_sources(const IPvX& group,
 	//
 	if (group_record->is_unused()) 
 	{
-		this->erase(group);
+		erase_group_record(group_record);
 		delete group_record;
 	}
 }
@@ -1683,17 +1748,13 @@ Mld6igmpGroupSet::process_block_old_sources(const IPvX& group,
 		const set<IPvX>& sources,
 		const IPvX& last_reported_host)
 {
-	Mld6igmpGroupSet::iterator iter;
 	Mld6igmpGroupRecord* group_record = NULL;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		group_record = iter->second;
-	} else 
+	group_record = find_group_record(group);
+	if (group_record == NULL) 
 	{
 		group_record = new Mld6igmpGroupRecord(_mld6igmp_vif, group);
-		this->insert(make_pair(group, group_record));
+		insert_group_record(group_record);
 	}
 	XLOG_ASSERT(group_record != NULL);
 
@@ -1715,7 +1776,7 @@ Mld6igmpGroupSet::process_block_old_sources(const IPvX& group,
 	//
 	if (group_record->is_unused()) 
 	{
-		this->erase(group);
+		erase_group_record(group_record);
 		delete group_record;
 	}
 }
@@ -1730,14 +1791,11 @@ Mld6igmpGroupSet::process_block_old_sources(const IPvX& group,
 Mld6igmpGroupSet::lower_group_timer(const IPvX& group,
 		const TimeVal& timeval)
 {
-	Mld6igmpGroupSet::iterator iter;
+	Mld6igmpGroupRecord* group_record;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		Mld6igmpGroupRecord* group_record = iter->second;
+	group_record = find_group_record(group);
+	if (group_record != NULL)
 		group_record->lower_group_timer(timeval);
-	}
 }
 
 /**
@@ -1752,12 +1810,9 @@ Mld6igmpGroupSet::lower_source_timer(const IPvX& group,
 		const set<IPvX>& sources,
 		const TimeVal& timeval)
 {
-	Mld6igmpGroupSet::iterator iter;
+	Mld6igmpGroupRecord* group_record;
 
-	iter = this->find(group);
-	if (iter != this->end()) 
-	{
-		Mld6igmpGroupRecord* group_record = iter->second;
+	group_record = find_group_record(group);
+	if (group_record != NULL)
 		group_record->lower_source_timer(sources, timeval);
-	}
 }
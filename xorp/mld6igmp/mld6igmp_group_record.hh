@@ -245,7 +245,7 @@ class Mld6igmpGroupRecord
 		 *
 		 * @return a reference to the group timer.
 		 */
-		XorpTimer& group_timer() { return _group_timer; }
+		BucketTimer& group_timer() { return _group_timer; }
 
 		/**
 		 * Schedule periodic Group-Specific and Group-and-Source-Specific Query
@@ -355,16 +355,21 @@ class Mld6igmpGroupRecord
 		IPvX	_last_reported_host;	// The host that last reported as member
 
 		// Timers indicating that hosts running older protocol version are present
-		XorpTimer	_igmpv1_host_present_timer;
-		XorpTimer	_igmpv2_mldv1_host_present_timer;
+		BucketTimer	_igmpv1_host_present_timer;
+		BucketTimer	_igmpv2_mldv1_host_present_timer;
 
-		XorpTimer	_group_timer;		// Group timer for filter mode switch
+		BucketTimer	_group_timer;	// Group timer for filter mode switch
 		XorpTimer	_group_query_timer;	// Timer for periodic Queries
 		size_t	_query_retransmission_count; // Count for periodic Queries
 };
 
 /**
  * @short A class to store information about a set of multicast groups.
+ *
+ * The group records are also kept in a hash table, so they can be found
+ * without searching the map. Therefore, the records must be added and
+ * removed only by @ref insert_group_record() and
+ * @ref erase_group_record().
  */
 class Mld6igmpGroupSet : public map<IPvX, Mld6igmpGroupRecord *> 
 {
@@ -390,6 +395,21 @@ class Mld6igmpGroupSet : public map<IPvX, Mld6igmpGroupRecord *>
 		 */
 		Mld6igmpGroupRecord* find_group_record(const IPvX& group);
 
+		/**
+		 * Add a group record.
+		 *
+		 * @param group_record the group record to add.
+		 */
+		void insert_group_record(Mld6igmpGroupRecord* group_record);
+
+		/**
+		 * Remove a group record. Note that the group record itself is
+		 * not deleted.
+		 *
+		 * @param group_record the group record to remove.
+		 */
+		void erase_group_record(Mld6igmpGroupRecord* group_record);
+
 		/**
 		 * Delete the payload of the set, and clear the set itself.
 		 */
@@ -484,7 +504,25 @@ class Mld6igmpGroupSet : public map<IPvX, Mld6igmpGroupRecord *>
 				const TimeVal& timeval);
 
 	private:
+		typedef list<Mld6igmpGroupRecord *> HashChain;
+
+		static const size_t HASH_INITIAL_BUCKETS = 256;
+
+		/**
+		 * Get the hash table bucket for a group address.
+		 *
+		 * @param group the group address.
+		 * @return the index of the bucket.
+		 */
+		size_t hash_bucket(const IPvX& group) const;
+
+		/**
+		 * Double the number of hash table buckets.
+		 */
+		void hash_grow();
+
 		Mld6igmpVif& _mld6igmp_vif;		// The interface this set belongs to
+		vector<HashChain> _hash_buckets;	// The group records by hash
 };
 
 //
@@ -69,6 +69,8 @@ Mld6igmpSourceRecord::Mld6igmpSourceRecord(Mld6igmpGroupRecord& group_record,
 		const IPvX& source)
 : _group_record(group_record),
 	_source(source),
+	_source_timer(group_record.mld6igmp_vif().timer_buckets(),
+			callback(this, &Mld6igmpSourceRecord::source_timer_timeout)),
 	_query_retransmission_count(0)
 {
 
@@ -93,10 +95,7 @@ Mld6igmpSourceRecord::~Mld6igmpSourceRecord()
 	void
 Mld6igmpSourceRecord::set_source_timer(const TimeVal& timeval)
 {
-
-	_source_timer = EventLoop::instance().new_oneoff_after(
-			timeval,
-			callback(this, &Mld6igmpSourceRecord::source_timer_timeout));
+	_source_timer.schedule_after(timeval);
 }
 
 /**
@@ -125,9 +124,7 @@ Mld6igmpSourceRecord::lower_source_timer(const TimeVal& timeval)
 	_source_timer.time_remaining(timeval_remaining);
 	if (timeval < timeval_remaining) 
 	{
-		_source_timer = EventLoop::instance().new_oneoff_after(
-				timeval,
-				callback(this, &Mld6igmpSourceRecord::source_timer_timeout));
+		_source_timer.schedule_after(timeval);
 	}
 }
 
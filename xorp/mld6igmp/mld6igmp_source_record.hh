@@ -33,6 +33,8 @@
 
 #include "libxorp/ipvx.hh"
 #include "libxorp/timer.hh"
+#include "libxorp/timer_buckets.hh"
+
 
 
 //
@@ -112,7 +114,7 @@ class Mld6igmpSourceRecord
 		 * 
 		 * @return a reference to the source timer.
 		 */
-		XorpTimer& source_timer() { return _source_timer; }
+		BucketTimer& source_timer() { return _source_timer; }
 
 		/**
 		 * Get the number of seconds until the source timer expires.
@@ -149,7 +151,7 @@ class Mld6igmpSourceRecord
 
 		Mld6igmpGroupRecord& _group_record;	// The group record we belong to
 		IPvX	_source;		// The source address
-		XorpTimer	_source_timer;		// The source timer
+		BucketTimer	_source_timer;	// The source timer
 		size_t	_query_retransmission_count; // Count for periodic Queries
 };
 
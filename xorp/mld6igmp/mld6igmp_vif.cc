@@ -50,6 +50,7 @@ Mld6igmpVif::Mld6igmpVif(Mld6igmpNode& mld6igmp_node, const Vif& vif)
 	_primary_addr(IPvX::ZERO(mld6igmp_node.family())),
 	_querier_addr(IPvX::ZERO(mld6igmp_node.family())),
 	_startup_query_count(0),
+	_timer_buckets(TIMER_BUCKET_MS),
 	_group_records(*this),
 	_ip_router_alert_option_check(false),
 	_configured_query_interval(
@@ -28,6 +28,7 @@
 
 #include "libxorp/config_param.hh"
 #include "libxorp/timer.hh"
+#include "libxorp/timer_buckets.hh"
 #include "libxorp/vif.hh"
 #include "libproto/proto_unit.hh"
 #include "mrt/buffer.h"
@@ -203,6 +204,20 @@ class Mld6igmpVif : public ProtoUnit, public Vif
 		 */
 		const Mld6igmpGroupSet& group_records() const { return (_group_records); }
 
+		/**
+		 * Get the time buckets with the group and source timers
+		 * (@ref TimerBuckets).
+		 *
+		 * @return the time buckets with the group and source timers.
+		 */
+		TimerBuckets& timer_buckets() { return (_timer_buckets); }
+
+		/**
+		 * The interval covered by each bucket of the group and source
+		 * timers (in milliseconds): the IGMP time unit.
+		 */
+		static const uint32_t TIMER_BUCKET_MS = 100;
+
 		/**
 		 * Test if the protocol is Source-Specific Multicast (e.g., IGMPv3
 		 * or MLDv2).
@@ -635,6 +650,8 @@ class Mld6igmpVif : public ProtoUnit, public Vif
 		XorpTimer	_query_timer;		// Timer to send queries
 		uint8_t	_startup_query_count;	// Number of queries to send quickly
 		// during startup
+		// XXX: the timer buckets must be destroyed after the group records
+		TimerBuckets	_timer_buckets;	// The group and source timers
 		Mld6igmpGroupSet _group_records;	// The group records
 
 		//
@@ -1671,7 +1671,7 @@ AreaRouter<A>::external_announce_complete()
 
 template <typename A>
     void
-AreaRouter<A>::external_refresh(Lsa::LsaRef lsar)
+AreaRouter<A>::external_refresh(Lsa::LsaRef lsar, bool push)
 {
     XLOG_ASSERT(lsar->external());
 
@@ -1704,7 +1704,8 @@ AreaRouter<A>::external_refresh(Lsa::LsaRef lsar)
     bool multicast_on_peer;
     publish(OspfTypes::ALLPEERS, OspfTypes::ALLNEIGHBOURS, lsar,
 	    multicast_on_peer);
-    push_lsas("external_refresh");
+    if (push)
+	push_lsas("external_refresh");
 }
 
 template <typename A>
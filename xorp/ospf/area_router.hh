@@ -326,8 +326,11 @@ class AreaRouter : public ServiceBase
 	 * Refresh this LSA either because a timer has expired or because
 	 * a newer LSA has arrived from another area. In either cause the
 	 * LSA should already be in this area's database.
+	 *
+	 * @param push true if the LSA should be sent immediately, false
+	 * if external_announce_complete() will be called to send it.
 	 */
-	void external_refresh(Lsa::LsaRef lsar);
+	void external_refresh(Lsa::LsaRef lsar, bool push);
 
 	/**
 	 * An AS-External-LSA being withdrawn either from another area or
@@ -48,7 +48,10 @@
     template <typename A>
 External<A>::External(Ospf<A>& ospf,
 	map<OspfTypes::AreaID, AreaRouter<A> *>& areas)
-: _ospf(ospf), _areas(areas), _originating(0), _lsid(1)
+: _ospf(ospf), _areas(areas), _originating(0), _lsid(1),
+    _refresh_queue(OspfTypes::LSRefreshTime, REFRESH_PER_TICK,
+	    callback(this, &External<A>::refresh_due),
+	    callback(this, &External<A>::refresh_complete))
 {
 }
 
@@ -139,8 +142,8 @@ External<IPv4>::unique_link_state_id(Lsa::LsaRef lsar)
     IPv4 mask_in_db = IPv4(htonl(aselsa_in_db->get_network_mask()));
     XLOG_ASSERT(mask != mask_in_db);
 
-    // Be very careful the AS-external-LSAs are stored in a set and
-    // the comparator method uses the link state ID. If the link state
+    // Be very careful the AS-external-LSAs are stored in a hash table
+    // keyed on the link state ID. If the link state
     // ID of the LSA in the database is going to be changed then it
     // must first be pulled out of the database and then re-inserted.
 
@@ -156,12 +159,15 @@ External<IPv4>::unique_link_state_id(Lsa::LsaRef lsar)
     } 
 
     // The harder case, the LSA already in the database needs to be
-    // changed. First pull it out of the database.
+    // changed. First pull it out of the database. It may also be on
+    // the neighbours retransmission lists, which are indexed by the
+    // link state ID.
     delete_lsa(lsar_in_db);
     Lsa_header& header = lsar_in_db->get_header();
     header.set_link_state_id(set_host_bits(header.get_link_state_id(),
 		ntohl(mask_in_db.addr())));
     lsar_in_db->encode();
+    _ospf.get_peer_manager().rekey_lsa(lsar_in_db);
     update_lsa(lsar_in_db);
     refresh(lsar_in_db);
 }
@@ -259,6 +265,75 @@ External<A>::announce(IPNet<A> net, A nexthop, uint32_t metric,
     if (1 == _originating)
 	_ospf.get_peer_manager().refresh_router_lsas();
 
+    // The route is originated with the next batch, if it is announced
+    // again before then only the latest announcement is kept.
+    typename map<IPNet<A>, typename list<Pending>::iterator>::iterator i =
+	_pending_index.find(net);
+    if (i != _pending_index.end()) 
+    {
+	*(i->second) = Pending(net, nexthop, metric, policytags);
+    } else 
+    {
+	_pending_index[net] = _pending.insert(_pending.end(),
+		Pending(net, nexthop, metric, policytags));
+    }
+
+    if (!_originate_timer.scheduled())
+	_originate_timer = EventLoop::instance().
+	    new_oneoff_after_ms(ORIGINATE_INTERVAL_MS,
+		    callback(this, &External<A>::originate_batch));
+
+    return true;
+}
+
+template <typename A>
+    void
+External<A>::originate_batch()
+{
+    uint32_t count = 0;
+    while (!_pending.empty() && count < ORIGINATE_PER_TICK) 
+    {
+	Pending pending = _pending.front();
+	_pending_index.erase(pending._net);
+	_pending.pop_front();
+	originate(pending);
+	count++;
+    }
+
+    set<IPNet<A> > changed;
+    changed.swap(_aggregates_changed);
+    typename set<IPNet<A> >::iterator i;
+    for (i = changed.begin(); i != changed.end(); i++)
+	aggregate_update(*i);
+
+    debug_msg("Originated %u routes, %u waiting\n", XORP_UINT_CAST(count),
+	    XORP_UINT_CAST(_pending.size()));
+
+    // Send everything originated by this batch together.
+    typename map<OspfTypes::AreaID, AreaRouter<A> *>::iterator ia;
+    for (ia = _areas.begin(); ia != _areas.end(); ia++) 
+    {
+	(*ia).second->external_announce_complete();
+    }
+
+    if (_pending.empty() && _aggregates_changed.empty()) 
+    {
+	_originate_timer.unschedule();
+	return;
+    }
+
+    _originate_timer = EventLoop::instance().
+	new_oneoff_after_ms(ORIGINATE_INTERVAL_MS,
+		callback(this, &External<A>::originate_batch));
+}
+
+template <typename A>
+    void
+External<A>::originate(const Pending& pending)
+{
+    IPNet<A> net = pending._net;
+    A nexthop = pending._nexthop;
+    uint32_t metric = pending._metric;
     bool ebit = true;
     uint32_t tag = 0;
     bool tag_set = false;
@@ -270,9 +345,38 @@ External<A>::announce(IPNet<A> net, A nexthop, uint32_t metric,
     if (!_ospf.get_peer_manager().configured_network(nexthop))
 	nexthop = A::ZERO();
 
-    if (!do_filtering(net, nexthop, metric, ebit, tag, tag_set, policytags))
-	return true;
+    if (!do_filtering(net, nexthop, metric, ebit, tag, tag_set,
+		pending._policytags)) 
+    {
+	// A route that the policy no longer accepts should not keep
+	// its aggregate alive.
+	component_delete(net);
+	return;
+    }
 
+    typename Trie<A, Aggregate>::iterator i = _aggregates.find(net);
+    if (i != _aggregates.end()) 
+    {
+	Component component;
+	component._aggregate = i.key();
+	component._nexthop = nexthop;
+	component._metric = metric;
+	component._e_bit = ebit;
+	component._tag = tag;
+	component._tag_set = tag_set;
+	component_add(net, component);
+	return;
+    }
+
+    originate_lsa(net, nexthop, metric, ebit, tag, tag_set,
+	    false /* push */);
+}
+
+template <typename A>
+    void
+External<A>::originate_lsa(const IPNet<A>& net, A nexthop, uint32_t metric,
+	bool ebit, uint32_t tag, bool tag_set, bool push)
+{
     OspfTypes::Version version = _ospf.version();
     // Don't worry about the memory it will be freed when the LSA goes
     // out of scope.
@@ -304,16 +408,14 @@ External<A>::announce(IPNet<A> net, A nexthop, uint32_t metric,
     aselsa->set_self_originating(true);
 
     if (suppress_candidate(lsar, net, nexthop, metric))
-	return true;
-
-    announce_lsa(lsar);
+	return;
 
-    return true;
+    announce_lsa(lsar, push);
 }
 
 template <typename A>
     void
-External<A>::announce_lsa(Lsa::LsaRef lsar)
+External<A>::announce_lsa(Lsa::LsaRef lsar, bool push)
 {
     TimeVal now;
     EventLoop::instance().current_time(now);
@@ -329,10 +431,11 @@ External<A>::announce_lsa(Lsa::LsaRef lsar)
     {
 	(*i).second->external_announce(lsar, false /* push */,
 		true /* redist */);
-	(*i).second->external_announce_complete();
+	if (push)
+	    (*i).second->external_announce_complete();
     }
 
-    start_refresh_timer(lsar);
+    start_refresh_timer(lsar, true);
 }
 
 template <typename A>
@@ -375,11 +478,9 @@ External<A>::do_filtering(IPNet<A>& network, A& nexthop, uint32_t& metric,
 
 template <typename A>
     void
-External<A>::start_refresh_timer(Lsa::LsaRef lsar)
+External<A>::start_refresh_timer(Lsa::LsaRef lsar, bool jitter)
 {
-    lsar->get_timer() = EventLoop::instance().
-	new_oneoff_after(TimeVal(OspfTypes::LSRefreshTime, 0),
-		callback(this, &External<A>::refresh, lsar));
+    _refresh_queue.add(lsar, jitter);
 }
 
 template <typename A>
@@ -395,10 +496,51 @@ External<A>::refresh(Lsa::LsaRef lsar)
     typename map<OspfTypes::AreaID, AreaRouter<A> *>::iterator i;
     for (i = _areas.begin(); i != _areas.end(); i++) 
     {
-	(*i).second->external_refresh(lsar);
+	(*i).second->external_refresh(lsar, true /* push */);
+    }
+
+    start_refresh_timer(lsar, false);
+}
+
+template <typename A>
+    void
+External<A>::refresh_due(Lsa::LsaRef lsar)
+{
+    // The LSA may have been withdrawn or replaced without being
+    // taken off the queue, only refresh the instance in the database.
+    if (!lsar->valid() || lsar->maxage())
+	return;
+    ASExternalDatabase::iterator i = find_lsa(lsar);
+    if (i == _lsas.end() || !(*i == lsar))
+	return;
+
+    TimeVal now;
+    EventLoop::instance().current_time(now);
+    lsar->update_age_and_seqno(now);
+
+    typename map<OspfTypes::AreaID, AreaRouter<A> *>::iterator ia;
+    for (ia = _areas.begin(); ia != _areas.end(); ia++) 
+    {
+	(*ia).second->external_refresh(lsar, false /* push */);
     }
 
-    start_refresh_timer(lsar);
+    start_refresh_timer(lsar, false);
+}
+
+template <typename A>
+    void
+External<A>::refresh_complete()
+{
+    XLOG_TRACE(_ospf.trace()._refresh,
+	    "Refreshed %u AS-external-LSAs, %u waiting\n",
+	    XORP_UINT_CAST(_refresh_queue.last_refreshed()),
+	    XORP_UINT_CAST(_refresh_queue.size()));
+
+    typename map<OspfTypes::AreaID, AreaRouter<A> *>::iterator i;
+    for (i = _areas.begin(); i != _areas.end(); i++) 
+    {
+	(*i).second->external_announce_complete();
+    }
 }
 
 template <typename A>
@@ -411,6 +553,32 @@ External<A>::withdraw(const IPNet<A>& net)
     if (0 == _originating)
 	_ospf.get_peer_manager().refresh_router_lsas();
 
+    // A route still waiting to be originated is simply forgotten.
+    typename map<IPNet<A>, typename list<Pending>::iterator>::iterator i =
+	_pending_index.find(net);
+    if (i != _pending_index.end()) 
+    {
+	_pending.erase(i->second);
+	_pending_index.erase(i);
+    }
+
+    if (component_delete(net))
+	return true;
+
+    // A route that was filtered has no LSA, don't mistake the LSA of
+    // an aggregate with the same network for it.
+    if (_aggregates.lookup_node(net) != _aggregates.end())
+	return true;
+
+    withdraw_lsa(net);
+
+    return true;
+}
+
+template <typename A>
+    void
+External<A>::withdraw_lsa(const IPNet<A>& net)
+{
 #ifdef	SUPPRESS_DB
     suppress_database_delete(net, true /* invalidate */);
 #endif
@@ -430,9 +598,7 @@ External<A>::withdraw(const IPNet<A>& net)
     {
 	// The LSA may not have been found because it has been filtered.
 	debug_msg("Lsa not found for net %s", cstring(net));
-	return true;
-	// 	XLOG_ERROR("Lsa not found for net %s", cstring(net));
-	// 	return false;
+	return;
     }
 
     Lsa::LsaRef lsar = *i;
@@ -440,20 +606,267 @@ External<A>::withdraw(const IPNet<A>& net)
     if (!lsar->get_self_originating()) 
     {
 	XLOG_FATAL("Matching LSA is not self originated %s", cstring(*lsar));
-	return false;
+	return;
     }
 
     lsar->set_maxage();
     maxage_reached(lsar);
+}
+
+template <typename A>
+    bool
+External<A>::add_aggregate(const IPNet<A>& net)
+{
+    debug_msg("net %s\n", cstring(net));
+
+    if (_aggregates.lookup_node(net) != _aggregates.end())
+	return true;
+
+    _aggregates.insert(net, Aggregate());
+
+    // Routes covered by a less specific aggregate move to this one.
+    list<IPNet<A> > moved;
+    typename map<IPNet<A>, Component>::iterator i;
+    for (i = _components.begin(); i != _components.end(); i++) 
+    {
+	if (net.contains(i->first) &&
+		i->second._aggregate.prefix_len() < net.prefix_len())
+	    moved.push_back(i->first);
+    }
+
+    typename list<IPNet<A> >::iterator m;
+    for (m = moved.begin(); m != moved.end(); m++) 
+    {
+	Component component = _components[*m];
+	component._aggregate = net;
+	component_add(*m, component);
+    }
+
+    // Routes that are being originated on their own are withdrawn and
+    // become components. The LSAs of other aggregates are left alone.
+    list<Lsa::LsaRef> covered;
+    ASExternalDatabase::iterator l;
+    for (l = _lsas.begin(); l != _lsas.end(); l++) 
+    {
+	if (!(*l)->get_self_originating())
+	    continue;
+	ASExternalLsa *aselsa = dynamic_cast<ASExternalLsa *>((*l).get());
+	XLOG_ASSERT(aselsa);
+	IPNet<A> lnet = aselsa->get_network(A::ZERO());
+	if (!net.contains(lnet))
+	    continue;
+	typename Trie<A, Aggregate>::iterator ai = _aggregates.lookup_node(lnet);
+	if (ai != _aggregates.end() && ai.payload()._originated)
+	    continue;
+	covered.push_back(*l);
+    }
+
+    list<Lsa::LsaRef>::iterator c;
+    for (c = covered.begin(); c != covered.end(); c++) 
+    {
+	ASExternalLsa *aselsa = dynamic_cast<ASExternalLsa *>((*c).get());
+	IPNet<A> lnet = aselsa->get_network(A::ZERO());
+	Component component = lsa_component(*c);
+	component._aggregate = net;
+	withdraw_lsa(lnet);
+	component_add(lnet, component);
+    }
+
+    return true;
+}
+
+template <typename A>
+    bool
+External<A>::delete_aggregate(const IPNet<A>& net)
+{
+    debug_msg("net %s\n", cstring(net));
+
+    typename Trie<A, Aggregate>::iterator ai = _aggregates.lookup_node(net);
+    if (ai == _aggregates.end())
+	return false;
+
+    bool originated = ai.payload()._originated;
+    _aggregates.erase(ai);
+    _aggregates_changed.erase(net);
+    if (originated)
+	withdraw_lsa(net);
+
+    list<IPNet<A> > orphans;
+    typename map<IPNet<A>, Component>::iterator i;
+    for (i = _components.begin(); i != _components.end(); i++) 
+    {
+	if (i->second._aggregate == net)
+	    orphans.push_back(i->first);
+    }
+
+    // The routes move to a less specific aggregate if there is one,
+    // otherwise they are originated on their own.
+    typename list<IPNet<A> >::iterator o;
+    for (o = orphans.begin(); o != orphans.end(); o++) 
+    {
+	Component component = _components[*o];
+	_components.erase(*o);
+	ai = _aggregates.find(*o);
+	if (ai != _aggregates.end()) 
+	{
+	    component._aggregate = ai.key();
+	    component_add(*o, component);
+	    continue;
+	}
+	originate_lsa(*o, component._nexthop, component._metric,
+		component._e_bit, component._tag, component._tag_set,
+		false /* push */);
+    }
+
+    typename map<OspfTypes::AreaID, AreaRouter<A> *>::iterator ia;
+    for (ia = _areas.begin(); ia != _areas.end(); ia++) 
+    {
+	(*ia).second->external_announce_complete();
+    }
 
     return true;
 }
 
+template <typename A>
+    void
+External<A>::component_add(const IPNet<A>& net, const Component& component)
+{
+    component_delete(net);
+
+    typename Trie<A, Aggregate>::iterator i =
+	_aggregates.lookup_node(component._aggregate);
+    XLOG_ASSERT(i != _aggregates.end());
+    Aggregate& aggregate = i.payload();
+    if (component._e_bit)
+	aggregate._type2.insert(component._metric);
+    else
+	aggregate._type1.insert(component._metric);
+
+    _components[net] = component;
+    aggregate_changed(component._aggregate);
+}
+
+template <typename A>
+    bool
+External<A>::component_delete(const IPNet<A>& net)
+{
+    typename map<IPNet<A>, Component>::iterator i = _components.find(net);
+    if (i == _components.end())
+	return false;
+
+    const Component& component = i->second;
+    typename Trie<A, Aggregate>::iterator ai =
+	_aggregates.lookup_node(component._aggregate);
+    XLOG_ASSERT(ai != _aggregates.end());
+    multiset<uint32_t>& metrics = component._e_bit ?
+	ai.payload()._type2 : ai.payload()._type1;
+    typename multiset<uint32_t>::iterator m = metrics.find(component._metric);
+    XLOG_ASSERT(m != metrics.end());
+    metrics.erase(m);
+
+    aggregate_changed(component._aggregate);
+    _components.erase(i);
+
+    return true;
+}
+
+template <typename A>
+    void
+External<A>::aggregate_changed(const IPNet<A>& net)
+{
+    _aggregates_changed.insert(net);
+
+    if (!_originate_timer.scheduled())
+	_originate_timer = EventLoop::instance().
+	    new_oneoff_after_ms(ORIGINATE_INTERVAL_MS,
+		    callback(this, &External<A>::originate_batch));
+}
+
+template <typename A>
+    void
+External<A>::aggregate_update(const IPNet<A>& net)
+{
+    typename Trie<A, Aggregate>::iterator i = _aggregates.lookup_node(net);
+    if (i == _aggregates.end())
+	return;
+    Aggregate& aggregate = i.payload();
+
+    if (aggregate._type1.empty() && aggregate._type2.empty()) 
+    {
+	if (aggregate._originated) 
+	{
+	    aggregate._originated = false;
+	    withdraw_lsa(net);
+	}
+	return;
+    }
+
+    // If any of the routes are type 2 the aggregate is type 2 with the
+    // largest type 2 metric, otherwise it is type 1 with the largest
+    // type 1 metric.
+    bool ebit = !aggregate._type2.empty();
+    uint32_t metric = ebit ? *aggregate._type2.rbegin() :
+	*aggregate._type1.rbegin();
+
+    if (aggregate._originated && aggregate._metric == metric &&
+	    aggregate._e_bit == ebit)
+	return;
+
+    aggregate._originated = true;
+    aggregate._metric = metric;
+    aggregate._e_bit = ebit;
+
+    originate_lsa(net, A::ZERO(), metric, ebit, 0, false, false /* push */);
+}
+
+template <typename A>
+    typename External<A>::Component
+External<A>::lsa_component(Lsa::LsaRef lsar)
+{
+    ASExternalLsa *aselsa = dynamic_cast<ASExternalLsa *>(lsar.get());
+    XLOG_ASSERT(aselsa);
+
+    Component component;
+    component._nexthop = A::ZERO();
+    component._metric = aselsa->get_metric();
+    component._e_bit = aselsa->get_e_bit();
+    component._tag = 0;
+    component._tag_set = false;
+
+    switch(_ospf.version()) 
+    {
+	case OspfTypes::V2:
+	    component._nexthop = aselsa->get_forwarding_address(A::ZERO());
+	    component._tag = aselsa->get_external_route_tag();
+	    break;
+	case OspfTypes::V3:
+	    if (aselsa->get_f_bit())
+		component._nexthop = aselsa->get_forwarding_address(A::ZERO());
+	    if (aselsa->get_t_bit()) 
+	    {
+		component._tag = aselsa->get_external_route_tag();
+		component._tag_set = true;
+	    }
+	    break;
+    }
+
+    return component;
+}
+
 template <typename A>
     bool
 External<A>::clear_database()
 {
     _lsas.clear();
+    _refresh_queue.clear();
+    _pending.clear();
+    _pending_index.clear();
+    _originate_timer.unschedule();
+    _components.clear();
+    _aggregates_changed.clear();
+    typename Trie<A, Aggregate>::iterator i;
+    for (i = _aggregates.begin(); i != _aggregates.end(); ++i)
+	i.payload() = Aggregate();
 #ifdef	SUPPRESS_DB
     _suppress_db.delete_all_nodes();
 #endif
@@ -835,6 +1248,7 @@ External<A>::update_lsa(Lsa::LsaRef lsar)
     if (i != _lsas.end()) 
     {
 	(*i)->invalidate();
+	_refresh_queue.remove(*i);
 	_lsas.erase(i);
     }
     _lsas.insert(lsar);
@@ -883,22 +1297,144 @@ External<A>::maxage_reached(Lsa::LsaRef lsar)
     // Clear the timer otherwise there is a circular dependency.
     // The LSA contains a XorpTimer that points back to the LSA.
     lsar->get_timer().clear();
+    _refresh_queue.remove(lsar);
+}
+
+ASExternalDatabase::ASExternalDatabase()
+    : _buckets(INITIAL_BUCKETS), _size(0)
+{
+}
+
+    ASExternalDatabase::iterator
+ASExternalDatabase::begin()
+{
+    iterator i(this, 0, _buckets[0].begin());
+    i.skip_empty();
+
+    return i;
+}
+
+    void
+ASExternalDatabase::erase(iterator i)
+{
+    XLOG_ASSERT(i._bucket < _buckets.size());
+    _buckets[i._bucket].erase(i._i);
+    _size--;
+}
+
+    void
+ASExternalDatabase::insert(Lsa::LsaRef lsar)
+{
+    if (find(lsar) != end())
+	return;
+
+    if (_size >= _buckets.size())
+	grow();
+
+    _buckets[bucket(lsar)].push_back(lsar);
+    _size++;
 }
 
     void
 ASExternalDatabase::clear()
 {
-    set <Lsa::LsaRef, compare>::iterator i;
-    for(i = _lsas.begin(); i != _lsas.end(); i++)
+    iterator i;
+    for(i = begin(); i != end(); i++)
 	(*i)->invalidate();
 
-    _lsas.clear();
+    _buckets.assign(INITIAL_BUCKETS, Chain());
+    _size = 0;
 }
 
     ASExternalDatabase::iterator
 ASExternalDatabase::find(Lsa::LsaRef lsar)
 {
-    return _lsas.find(lsar);
+    size_t b = bucket(lsar);
+    Chain::iterator i;
+    for (i = _buckets[b].begin(); i != _buckets[b].end(); i++)
+	if (same(*i, lsar))
+	    return iterator(this, b, i);
+
+    return end();
+}
+
+    size_t
+ASExternalDatabase::bucket(const Lsa::LsaRef lsar) const
+{
+    uint32_t hash = lsar->get_header().get_link_state_id() * 0x9e3779b1U;
+    hash ^= lsar->get_header().get_advertising_router() * 0x85ebca6bU;
+    hash ^= hash >> 16;
+
+    // The number of buckets is always a power of two.
+    return hash & (_buckets.size() - 1);
+}
+
+    bool
+ASExternalDatabase::same(const Lsa::LsaRef a, const Lsa::LsaRef b)
+{
+    return a->get_header().get_link_state_id() ==
+	b->get_header().get_link_state_id() &&
+	a->get_header().get_advertising_router() ==
+	b->get_header().get_advertising_router();
+}
+
+    void
+ASExternalDatabase::grow()
+{
+    vector<Chain> old(_buckets.size() * 2);
+    _buckets.swap(old);
+
+    vector<Chain>::iterator b;
+    for (b = old.begin(); b != old.end(); b++) 
+    {
+	while (!b->empty()) 
+	{
+	    Chain& chain = _buckets[bucket(b->front())];
+	    chain.splice(chain.end(), *b, b->begin());
+	}
+    }
+}
+
+    ASExternalDatabase::iterator&
+ASExternalDatabase::iterator::operator++()
+{
+    ++_i;
+    skip_empty();
+
+    return *this;
+}
+
+    ASExternalDatabase::iterator
+ASExternalDatabase::iterator::operator++(int)
+{
+    iterator old = *this;
+    ++(*this);
+
+    return old;
+}
+
+    bool
+ASExternalDatabase::iterator::operator==(const iterator& rhs) const
+{
+    if (_db != rhs._db || _bucket != rhs._bucket)
+	return false;
+    if (0 == _db || _bucket == _db->_buckets.size())
+	return true;
+
+    return _i == rhs._i;
+}
+
+    void
+ASExternalDatabase::iterator::skip_empty()
+{
+    while (_bucket < _db->_buckets.size() &&
+	    _i == _db->_buckets[_bucket].end()) 
+    {
+	if (++_bucket < _db->_buckets.size())
+	    _i = _db->_buckets[_bucket].begin();
+    }
+    if (_bucket == _db->_buckets.size())
+	_i = Chain::iterator();
 }
 
 template class External<IPv4>;
@@ -27,35 +27,82 @@
 
 /**
  * Storage for AS-external-LSAs with efficient access.
+ *
+ * The LSAs are held in a hash table keyed on the link state ID and
+ * advertising router, a router redistributing a full table may hold
+ * hundreds of thousands of them. Iteration is in no particular order.
  */
 class ASExternalDatabase 
 {
     public:
-	struct compare 
+	typedef list<Lsa::LsaRef> Chain;
+
+	class iterator 
 	{
-	    bool operator ()(const Lsa::LsaRef a, const Lsa::LsaRef b) const 
-	    {
-		if (a->get_header().get_link_state_id() ==
-			b->get_header().get_link_state_id())
-		    return a->get_header().get_advertising_router() <
-			b->get_header().get_advertising_router();
-		return a->get_header().get_link_state_id() <
-		    b->get_header().get_link_state_id();
-	    }
+	    public:
+		iterator() : _db(0), _bucket(0) {}
+
+		Lsa::LsaRef& operator*() const { return *_i; }
+		iterator& operator++();
+		iterator operator++(int);
+
+		bool operator==(const iterator& rhs) const;
+		bool operator!=(const iterator& rhs) const 
+		{
+		    return !(*this == rhs);
+		}
+
+	    private:
+		friend class ASExternalDatabase;
+
+		iterator(ASExternalDatabase *db, size_t bucket,
+			Chain::iterator i)
+		    : _db(db), _bucket(bucket), _i(i) {}
+
+		/**
+		 * Move forward to the next LSA if not on one.
+		 */
+		void skip_empty();
+
+		ASExternalDatabase *_db;
+		size_t _bucket;		// Number of buckets at the end.
+		Chain::iterator _i;	// Position in the bucket.
 	};
 
-	typedef set <Lsa::LsaRef, compare>::iterator iterator;
+	ASExternalDatabase();
 
-	iterator begin() { return _lsas.begin(); }
-	iterator end() { return _lsas.end(); }
-	void erase(iterator i) { _lsas.erase(i); }
-	void insert(Lsa::LsaRef lsar) { _lsas.insert(lsar); }
+	iterator begin();
+	iterator end() 
+	{
+	    return iterator(this, _buckets.size(), Chain::iterator());
+	}
+	void erase(iterator i);
+	void insert(Lsa::LsaRef lsar);
 	void clear();
+	size_t size() const { return _size; }
 
 	iterator find(Lsa::LsaRef lsar);
 
     private:
-	set <Lsa::LsaRef, compare> _lsas;		// Stored AS-external-LSAs.
+	static const size_t INITIAL_BUCKETS = 1024;
+
+	/**
+	 * The bucket that holds this LSA.
+	 */
+	size_t bucket(const Lsa::LsaRef lsar) const;
+
+	/**
+	 * Do these LSAs have the same link state ID and advertising router.
+	 */
+	static bool same(const Lsa::LsaRef a, const Lsa::LsaRef b);
+
+	/**
+	 * Double the number of buckets.
+	 */
+	void grow();
+
+	vector<Chain> _buckets;		// Stored AS-external-LSAs.
+	size_t _size;			// Number of stored LSAs.
 };
 
 /**
@@ -138,7 +185,85 @@ class External
 	 */
 	void push_routes();
 
+	/**
+	 * Summarise the redistributed routes that fall within this
+	 * network into a single AS-external-LSA. Routes are matched
+	 * after the export policy has been applied, the summary carries
+	 * the largest metric of the routes it covers and is only
+	 * originated while it covers at least one route.
+	 */
+	bool add_aggregate(const IPNet<A>& net);
+
+	/**
+	 * Stop summarising into this network, the routes it covered are
+	 * originated again on their own.
+	 */
+	bool delete_aggregate(const IPNet<A>& net);
+
     private:
+	/**
+	 * The number of AS-external-LSAs to refresh each second, more
+	 * will be refreshed if the queue requires it.
+	 */
+	static const uint32_t REFRESH_PER_TICK = 100;
+
+	/**
+	 * Redistributed routes are originated in batches of this many
+	 * AS-external-LSAs, so that they are packed into LS Updates
+	 * rather than flooded one at a time.
+	 */
+	static const uint32_t ORIGINATE_PER_TICK = 1000;
+
+	/**
+	 * Interval between batches when routes are waiting.
+	 */
+	static const uint32_t ORIGINATE_INTERVAL_MS = 50;
+
+	/**
+	 * A route redistributed from the RIB that has not yet been
+	 * originated.
+	 */
+	struct Pending 
+	{
+	    Pending(const IPNet<A>& net, const A& nexthop, uint32_t metric,
+		    const PolicyTags& policytags)
+		: _net(net), _nexthop(nexthop), _metric(metric),
+		_policytags(policytags)
+	    {}
+
+	    IPNet<A> _net;
+	    A _nexthop;
+	    uint32_t _metric;
+	    PolicyTags _policytags;
+	};
+
+	/**
+	 * A network that redistributed routes are summarised into.
+	 */
+	struct Aggregate 
+	{
+	    Aggregate() : _originated(false), _metric(0), _e_bit(false) {}
+
+	    multiset<uint32_t> _type1;	// Metrics of covered type 1 routes.
+	    multiset<uint32_t> _type2;	// Metrics of covered type 2 routes.
+	    bool _originated;		// An AS-external-LSA is out.
+	    uint32_t _metric;		// Metric as originated.
+	    bool _e_bit;		// External type as originated.
+	};
+
+	/**
+	 * A redistributed route that is covered by an aggregate.
+	 */
+	struct Component 
+	{
+	    IPNet<A> _aggregate;	// The covering aggregate.
+	    A _nexthop;
+	    uint32_t _metric;
+	    bool _e_bit;
+	    uint32_t _tag;
+	    bool _tag_set;
+	};
+
 	Ospf<A>& _ospf;			// Reference to the controlling class.
 	map<OspfTypes::AreaID, AreaRouter<A> *>& _areas;	// All the areas
 
@@ -149,6 +274,15 @@ class External
 	map<IPNet<IPv6>, uint32_t> _lsmap; 	// OSPFv3 only
 	list<Lsa::LsaRef> _suppress_temp;	// LSAs that could possibly
 	// suppress self originated LSAs
+	RefreshQueue _refresh_queue;		// Self originated LSAs
+	// waiting to be refreshed
+	list<Pending> _pending;			// Routes waiting to be
+	// originated in arrival order
+	map<IPNet<A>, typename list<Pending>::iterator> _pending_index;
+	XorpTimer _originate_timer;		// Originates a batch
+	Trie<A, Aggregate> _aggregates;		// Configured summaries
+	map<IPNet<A>, Component> _components;	// Routes covered by a summary
+	set<IPNet<A> > _aggregates_changed;	// Summaries to re-originate
 #ifdef SUPPRESS_DB
 	Trie<A, Lsa::LsaRef> _suppress_db;	// Database of suppressed self
 	// originated LSAs
@@ -205,8 +339,63 @@ class External
 
 	/**
 	 * Send this self originated LSA out.
+	 *
+	 * @param push if false the LSA is only queued in each area, it
+	 * is sent when the batch it is part of is complete.
+	 */
+	void announce_lsa(Lsa::LsaRef lsar, bool push = true);
+
+	/**
+	 * Originate the next batch of waiting routes and changed
+	 * aggregates, then send them.
+	 */
+	void originate_batch();
+
+	/**
+	 * Run a waiting route through the policy filter and originate
+	 * it, or account for it in the aggregate that covers it.
+	 */
+	void originate(const Pending& pending);
+
+	/**
+	 * Build and send an AS-external-LSA for a route that has been
+	 * through the policy filter.
+	 */
+	void originate_lsa(const IPNet<A>& net, A nexthop, uint32_t metric,
+		bool ebit, uint32_t tag, bool tag_set, bool push);
+
+	/**
+	 * Withdraw the self originated AS-external-LSA for this network.
+	 */
+	void withdraw_lsa(const IPNet<A>& net);
+
+	/**
+	 * Make this route a component of the aggregate that covers it.
 	 */
-	void announce_lsa(Lsa::LsaRef lsar);
+	void component_add(const IPNet<A>& net, const Component& component);
+
+	/**
+	 * This route is no longer a component of its aggregate.
+	 *
+	 * @return true if the route was a component.
+	 */
+	bool component_delete(const IPNet<A>& net);
+
+	/**
+	 * Re-originate or withdraw the aggregate with the next batch.
+	 */
+	void aggregate_changed(const IPNet<A>& net);
+
+	/**
+	 * Bring the AS-external-LSA of an aggregate in line with its
+	 * components.
+	 */
+	void aggregate_update(const IPNet<A>& net);
+
+	/**
+	 * Build a component from a self originated AS-external-LSA.
+	 */
+	Component lsa_component(Lsa::LsaRef lsar);
 
 	/**
 	 * Pass this outbound AS-external-LSA through the policy filter.
@@ -217,14 +406,29 @@ class External
 
 	/**
 	 * Start the refresh timer.
+	 *
+	 * @param jitter if true spread the first refresh of a newly
+	 * originated LSA over the second half of LSRefreshTime.
 	 */
-	void start_refresh_timer(Lsa::LsaRef lsar);
+	void start_refresh_timer(Lsa::LsaRef lsar, bool jitter);
 
 	/**
-	 * Called every LSRefreshTime seconds to refresh this LSA.
+	 * Refresh this LSA now and send it out.
 	 */
 	void refresh(Lsa::LsaRef lsar);
 
+	/**
+	 * Called from the refresh queue every LSRefreshTime seconds to
+	 * refresh this LSA, it is sent by refresh_complete().
+	 */
+	void refresh_due(Lsa::LsaRef lsar);
+
+	/**
+	 * Called from the refresh queue to send the LSAs refreshed by
+	 * refresh_due().
+	 */
+	void refresh_complete();
+
 	/**
 	 * Clone a self orignated LSA that is about to be removed for
 	 * possible later introduction.
@@ -45,6 +45,12 @@ onecomp(int32_t a)
     return res;
 }
 
+/*
+ ** The largest number of bytes that can be summed before the 32 bit
+ ** sums must be reduced modulo 255 to avoid overflow.
+ */
+static const size_t FLETCHER_BLOCK = 5802;
+
 /*
  ** generate iso checksums.
  */
@@ -52,17 +58,30 @@ onecomp(int32_t a)
 fletcher_checksum(uint8_t *bufp, size_t len, size_t off,
 	int32_t& x, int32_t& y)
 {
-    int32_t c0 = 0, c1 = 0;
+    uint32_t c0 = 0, c1 = 0;
+    size_t left = len;
 
-    for(size_t i = 0; i < len; i++) 
+    while (left > 0) 
     {
-	c0 = bufp[i] + c0;
-	c1 = c1 + c0;
+	size_t block = left < FLETCHER_BLOCK ? left : FLETCHER_BLOCK;
+	left -= block;
+
+	// Four bytes at a time, c1 gains c0 once for every byte.
+	for (; block >= 4; block -= 4, bufp += 4) 
+	{
+	    c1 += 4 * c0 + 4 * bufp[0] + 3 * bufp[1] + 2 * bufp[2] + bufp[3];
+	    c0 += bufp[0] + bufp[1] + bufp[2] + bufp[3];
+	}
+	for (; block > 0; block--, bufp++) 
+	{
+	    c0 += bufp[0];
+	    c1 += c0;
+	}
+	c0 %= 255;
+	c1 %= 255;
     }
-    c0 %= 255;
-    c1 %= 255;
 
     off += 1;	// C Arrays are from 0 not 1.
-    x = onecomp(-c1 + (len - off) * c0);
+    x = onecomp(-static_cast<int32_t>(c1) + (len - off) * c0);
     y = onecomp(c1 - (len - off + 1) * c0);
 }
@@ -64,6 +64,9 @@ verify_checksum(uint8_t *buf, size_t len, size_t offset)
     return true;
 }
 
+// Bytes of LSA encoded by this process.
+static uint64_t lsa_encoded_bytes = 0;
+
 /**
  * Compute the checksum.
  */
@@ -299,6 +302,12 @@ Lsa::update_age_inftransdelay(uint8_t *ptr, uint16_t inftransdelay)
     embed_16(&ptr[0], age);
 }
 
+    uint64_t
+Lsa::encoded_bytes()
+{
+    return lsa_encoded_bytes;
+}
+
     void
 Lsa::set_maxage()
 {
@@ -986,6 +995,8 @@ RouterLsa::encode()
     _header.set_ls_checksum(compute_checksum(ptr + 2, len - 2, 16 - 2));
     _header.copy_out(ptr);
 
+    lsa_encoded_bytes += len;
+
     return true;
 }
 
@@ -1164,6 +1175,8 @@ NetworkLsa::encode()
     _header.set_ls_checksum(compute_checksum(ptr + 2, len - 2, 16 - 2));
     _header.copy_out(ptr);
 
+    lsa_encoded_bytes += len;
+
     return true;
 }
 
@@ -1319,9 +1332,39 @@ SummaryNetworkLsa::encode()
     _header.set_ls_checksum(compute_checksum(ptr + 2, len - 2, 16 - 2));
     _header.copy_out(ptr);
 
+    lsa_encoded_bytes += len;
+
     return true;
 }
 
+void*
+SummaryNetworkLsa::operator new(size_t size)
+{
+    if (size != sizeof(SummaryNetworkLsa))
+	return ::operator new(size);
+    return memory_pool().alloc();
+}
+
+void
+SummaryNetworkLsa::operator delete(void* ptr, size_t size)
+{
+    if (size != sizeof(SummaryNetworkLsa)) 
+    {
+	::operator delete(ptr);
+	return;
+    }
+    memory_pool().free(ptr);
+}
+
+MemoryPool<SummaryNetworkLsa>&
+SummaryNetworkLsa::memory_pool()
+{
+    // Never destroyed, LSAs may still be referenced during shutdown.
+    static MemoryPool<SummaryNetworkLsa>* mp
+	= new MemoryPool<SummaryNetworkLsa>("SummaryNetworkLsa");
+    return *mp;
+}
+
 string
 SummaryNetworkLsa::str() const
 {
@@ -1458,6 +1501,8 @@ SummaryRouterLsa::encode()
     _header.set_ls_checksum(compute_checksum(ptr + 2, len - 2, 16 - 2));
     _header.copy_out(ptr);
 
+    lsa_encoded_bytes += len;
+
     return true;
 }
 
@@ -1688,6 +1733,8 @@ ASExternalLsa::encode()
     _header.set_ls_checksum(compute_checksum(ptr + 2, len - 2, 16 - 2));
     _header.copy_out(ptr);
 
+    lsa_encoded_bytes += len;
+
     return true;
 }
 
@@ -1753,6 +1800,34 @@ ASExternalLsa::get_forwarding_address<IPv6>(IPv6) const
     return get_forwarding_address_ipv6();
 }
 
+void*
+ASExternalLsa::operator new(size_t size)
+{
+    if (size != sizeof(ASExternalLsa))
+	return ::operator new(size);
+    return memory_pool().alloc();
+}
+
+void
+ASExternalLsa::operator delete(void* ptr, size_t size)
+{
+    if (size != sizeof(ASExternalLsa)) 
+    {
+	::operator delete(ptr);
+	return;
+    }
+    memory_pool().free(ptr);
+}
+
+MemoryPool<ASExternalLsa>&
+ASExternalLsa::memory_pool()
+{
+    // Never destroyed, LSAs may still be referenced during shutdown.
+    static MemoryPool<ASExternalLsa>* mp
+	= new MemoryPool<ASExternalLsa>("ASExternalLsa");
+    return *mp;
+}
+
 string
 ASExternalLsa::str() const
 {
@@ -1926,6 +2001,8 @@ LinkLsa::encode()
     _header.set_ls_checksum(compute_checksum(ptr + 2, len - 2, 16 - 2));
     _header.copy_out(ptr);
 
+    lsa_encoded_bytes += len;
+
     return true;
 }
 
@@ -2079,6 +2156,8 @@ IntraAreaPrefixLsa::encode()
     _header.set_ls_checksum(compute_checksum(ptr + 2, len - 2, 16 - 2));
     _header.copy_out(ptr);
 
+    lsa_encoded_bytes += len;
+
     return true;
 }
 
@@ -22,6 +22,8 @@
 #ifndef __OSPF_LSA_HH__
 #define __OSPF_LSA_HH__
 
+#include "libxorp/memory_pool.hh"
+
 /**
  * LSA Header. Common header for all LSAs.
  * Never store or pass a pointer, just deal with it inline.
@@ -285,14 +287,14 @@ compare_all_header_fields(const Lsa_header& lhs, const Lsa_header& rhs)
  *
  * A generic LSA. All actual LSAs should be derived from this LSA.
  */
-class Lsa 
+class Lsa : public iref_counted
 {
 	public:
 		/**
 		 * A reference counted pointer to an LSA which will be
 		 * automatically deleted.
 		 */
-		typedef ref_ptr<Lsa> LsaRef;
+		typedef iref_ptr<Lsa> LsaRef;
 
 		Lsa(OspfTypes::Version version)
 			:  _header(version), _version(version), _valid(true),
@@ -389,6 +391,16 @@ class Lsa
 			return &_pkt[0];
 		}
 
+		/**
+		 * The wire format is built once by encode() for each new
+		 * instance of a self originated LSA, or is the received
+		 * copy, and is then shared by every LS Update that carries
+		 * the LSA.
+		 *
+		 * @return the number of bytes of LSA that have been encoded.
+		 */
+		static uint64_t encoded_bytes();
+
 		/**
 		 * Is a wire format version available?
 		 *
@@ -1646,7 +1658,16 @@ class SummaryNetworkLsa : public Lsa
 		 */
 		string str() const;
 
+
+		/**
+		 * Allocated from a slab pool, unless a derived class has
+		 * grown beyond a SummaryNetworkLsa.
+		 */
+		void* operator new(size_t size);
+		void operator delete(void* ptr, size_t size);
 	private:
+		static MemoryPool<SummaryNetworkLsa>& memory_pool();
+
 		uint32_t _metric;
 		uint32_t _network_mask;		// OSPFv2 only.
 		IPv6Prefix _ipv6prefix;		// OSPFv3 only.
@@ -2060,7 +2081,16 @@ class ASExternalLsa : public Lsa
 		 */
 		string str() const;
 
+
+		/**
+		 * Allocated from a slab pool, unless a derived class has
+		 * grown beyond a ASExternalLsa.
+		 */
+		void* operator new(size_t size);
+		void operator delete(void* ptr, size_t size);
 	private:
+		static MemoryPool<ASExternalLsa>& memory_pool();
+
 		uint32_t _network_mask;		// OSPFv2 only.
 		bool _e_bit;
 		bool _f_bit;			// OSPFv3 only.
@@ -0,0 +1,237 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2009 XORP, Inc.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+// 
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __OSPF_LSA_LIST_HH__
+#define __OSPF_LSA_LIST_HH__
+
+/**
+ * A list of LSAs, or LSA headers, that keeps the order in which
+ * entries were added and is also indexed by LSA identity (LS type,
+ * Link State ID, Advertising Router). The retransmission and link
+ * state request lists of a neighbour are walked in order when
+ * retransmitting, but are searched once for every LSA that is
+ * received or acknowledged.
+ *
+ * The index is built from the header when an entry is added. If the
+ * identity of an LSA is changed while it is on the list it must be
+ * re-indexed with rekey(), otherwise it will not be found by its new
+ * identity.
+ */
+template <typename _Entry>
+class LsaList 
+{
+    public:
+	typedef typename list<_Entry>::iterator iterator;
+	typedef typename list<_Entry>::const_iterator const_iterator;
+
+	iterator begin() { return _list.begin(); }
+	iterator end() { return _list.end(); }
+	const_iterator begin() const { return _list.begin(); }
+	const_iterator end() const { return _list.end(); }
+
+	size_t size() const { return _list.size(); }
+	bool empty() const { return _list.empty(); }
+
+	/**
+	 * Add an entry to the end of the list.
+	 */
+	void push_back(const _Entry& entry) 
+	{
+	    iterator i = _list.insert(_list.end(), entry);
+	    _index.insert(make_pair(Key(header(entry)), i));
+	}
+
+	/**
+	 * Remove an entry.
+	 *
+	 * @return the entry following the one removed.
+	 */
+	iterator erase(iterator i);
+
+	/**
+	 * Remove all entries.
+	 */
+	void clear() 
+	{
+	    _list.clear();
+	    _index.clear();
+	}
+
+	/**
+	 * @return the earliest entry with the same identity as this
+	 * header or end().
+	 */
+	iterator find(const Lsa_header& lsah);
+	const_iterator find(const Lsa_header& lsah) const;
+
+	/**
+	 * @return the entry that is this LSA or end().
+	 */
+	iterator find(Lsa::LsaRef lsar);
+
+	/**
+	 * Find all the entries with the same identity as this header, in
+	 * the order that they were added.
+	 *
+	 * @param lsah header to match.
+	 * @param matches the entries found.
+	 */
+	void find_all(const Lsa_header& lsah, list<iterator>& matches);
+
+	/**
+	 * Re-index this LSA after its identity has been changed.
+	 *
+	 * @return true if the LSA is on the list.
+	 */
+	bool rekey(Lsa::LsaRef lsar);
+
+    private:
+	/**
+	 * LSA identity, RFC 2328 Section 12.1.
+	 */
+	struct Key 
+	{
+	    Key(const Lsa_header& lsah)
+		: _ls_type(lsah.get_ls_type()),
+		_link_state_id(lsah.get_link_state_id()),
+		_advertising_router(lsah.get_advertising_router())
+	    {}
+
+	    bool operator<(const Key& other) const 
+	    {
+		if (_ls_type != other._ls_type)
+		    return _ls_type < other._ls_type;
+		if (_link_state_id != other._link_state_id)
+		    return _link_state_id < other._link_state_id;
+		return _advertising_router < other._advertising_router;
+	    }
+
+	    uint16_t _ls_type;
+	    uint32_t _link_state_id;
+	    uint32_t _advertising_router;
+	};
+
+	typedef multimap<Key, iterator> Index;
+
+	static const Lsa_header& header(const Lsa_header& lsah) 
+	{
+	    return lsah;
+	}
+
+	static const Lsa_header& header(const Lsa::LsaRef& lsar) 
+	{
+	    return lsar->get_header();
+	}
+
+	list<_Entry> _list;	// Entries in the order that they were added.
+	Index _index;		// Entries by identity.
+};
+
+template <typename _Entry>
+    typename LsaList<_Entry>::iterator
+LsaList<_Entry>::erase(iterator i)
+{
+    pair<typename Index::iterator, typename Index::iterator> range =
+	_index.equal_range(Key(header(*i)));
+    typename Index::iterator ii;
+    for (ii = range.first; ii != range.second; ii++)
+	if (ii->second == i)
+	    break;
+
+    // The identity of the entry must have changed since it was added.
+    if (ii == range.second)
+	for (ii = _index.begin(); ii != _index.end(); ii++)
+	    if (ii->second == i)
+		break;
+
+    XLOG_ASSERT(ii != _index.end());
+    _index.erase(ii);
+
+    return _list.erase(i);
+}
+
+template <typename _Entry>
+    typename LsaList<_Entry>::iterator
+LsaList<_Entry>::find(const Lsa_header& lsah)
+{
+    pair<typename Index::iterator, typename Index::iterator> range =
+	_index.equal_range(Key(lsah));
+    if (range.first == range.second)
+	return _list.end();
+
+    return range.first->second;
+}
+
+template <typename _Entry>
+    typename LsaList<_Entry>::const_iterator
+LsaList<_Entry>::find(const Lsa_header& lsah) const
+{
+    Key key(lsah);
+    typename Index::const_iterator ii = _index.lower_bound(key);
+    if (ii == _index.end() || key < ii->first)
+	return _list.end();
+
+    return ii->second;
+}
+
+template <typename _Entry>
+    typename LsaList<_Entry>::iterator
+LsaList<_Entry>::find(Lsa::LsaRef lsar)
+{
+    pair<typename Index::iterator, typename Index::iterator> range =
+	_index.equal_range(Key(lsar->get_header()));
+    for (typename Index::iterator ii = range.first; ii != range.second; ii++)
+	if (*ii->second == lsar)
+	    return ii->second;
+
+    return _list.end();
+}
+
+template <typename _Entry>
+    void
+LsaList<_Entry>::find_all(const Lsa_header& lsah, list<iterator>& matches)
+{
+    pair<typename Index::iterator, typename Index::iterator> range =
+	_index.equal_range(Key(lsah));
+    for (typename Index::iterator ii = range.first; ii != range.second; ii++)
+	matches.push_back(ii->second);
+}
+
+template <typename _Entry>
+    bool
+LsaList<_Entry>::rekey(Lsa::LsaRef lsar)
+{
+    // The old identity is not known so the whole index is searched.
+    typename Index::iterator ii;
+    for (ii = _index.begin(); ii != _index.end(); ii++)
+	if (*ii->second == lsar)
+	    break;
+
+    if (ii == _index.end())
+	return false;
+
+    iterator i = ii->second;
+    _index.erase(ii);
+    _index.insert(make_pair(Key(header(*i)), i));
+
+    return true;
+}
+
+#endif // __OSPF_LSA_LIST_HH__
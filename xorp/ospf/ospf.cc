@@ -320,6 +320,12 @@ Ospf<A>::transmit(const string& interface, const string& vif,
 	    // Decode the packet in order to pretty print it.
 	    Packet *packet = _packet_decoder.decode(data, len);
 	    XLOG_TRACE(trace()._packets, "Transmit: %s\n", cstring(*packet));
+	    if (dynamic_cast<LinkStateUpdatePacket *>(packet))
+		XLOG_TRACE(trace()._packets,
+			"LSA bytes encoded %llu sent %llu\n",
+			(long long unsigned)Lsa::encoded_bytes(),
+			(long long unsigned)LinkStateUpdatePacket::
+			sent_lsa_bytes());
 	    delete packet;
 	} catch(InvalidPacket& e) 
 	{
@@ -848,6 +854,20 @@ Ospf<A>::withdraw_route(const IPNet<A>& net)
     return _peer_manager.external_withdraw(net);
 }
 
+template <typename A>
+    bool 
+Ospf<A>::add_external_aggregate(const IPNet<A>& net)
+{
+    return _peer_manager.external_add_aggregate(net);
+}
+
+template <typename A>
+    bool 
+Ospf<A>::delete_external_aggregate(const IPNet<A>& net)
+{
+    return _peer_manager.external_delete_aggregate(net);
+}
+
 template <typename A>
     void
 Ospf<A>::set_router_id(OspfTypes::RouterID id)
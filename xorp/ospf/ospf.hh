@@ -429,9 +429,11 @@ struct AddressInfo
 #include "io.hh"
 #include "exceptions.hh"
 #include "lsa.hh"
+#include "lsa_list.hh"
 #include "packet.hh"
 #include "transmit.hh"
 #include "peer_manager.hh"
+#include "refresh_queue.hh"
 #include "external.hh"
 #include "vlink.hh"
 #include "routing_table.hh"
@@ -918,6 +920,25 @@ class Ospf
 	 */
 	bool withdraw_route(const IPNet<A>&	net);
 
+	/**
+	 * Summarise originated routes.
+	 *
+	 * @param net the routes within this network are originated as a
+	 * single AS-External-LSA.
+	 *
+	 * @return true on success
+	 */
+	bool add_external_aggregate(const IPNet<A>& net);
+
+	/**
+	 * Stop summarising originated routes.
+	 *
+	 * @param net previously passed to add_external_aggregate().
+	 *
+	 * @return true on success
+	 */
+	bool delete_external_aggregate(const IPNet<A>& net);
+
 	/**
 	 * Get the current OSPF version.
 	 */
@@ -967,6 +967,15 @@ LinkStateUpdatePacket::encode(vector<uint8_t>& pkt)
     return encode(pkt, 0 /* inftransdelay */);
 }
 
+// Bytes of LSA copied into Link State Update Packets.
+static uint64_t lsup_sent_lsa_bytes = 0;
+
+    uint64_t
+LinkStateUpdatePacket::sent_lsa_bytes()
+{
+    return lsup_sent_lsa_bytes;
+}
+
     bool
 LinkStateUpdatePacket::encode(vector<uint8_t>& pkt, uint16_t inftransdelay)
 {
@@ -1013,6 +1022,7 @@ LinkStateUpdatePacket::encode(vector<uint8_t>& pkt, uint16_t inftransdelay)
 	Lsa::update_age_inftransdelay(&ptr[offset], inftransdelay);
 	offset += lsa_len;
     }
+    lsup_sent_lsa_bytes += offset - header_offset - 4;
 
     if (header_offset != encode_standard_header(ptr, len)) 
     {
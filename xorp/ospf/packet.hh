@@ -659,6 +659,12 @@ class LinkStateUpdatePacket : public Packet
 	 */
 	bool encode(vector<uint8_t>& pkt, uint16_t inftransdelay);
 
+	/**
+	 * @return the number of bytes of LSA copied into encoded Link
+	 * State Update Packets, compare with Lsa::encoded_bytes().
+	 */
+	static uint64_t sent_lsa_bytes();
+
 	list<Lsa::LsaRef>& get_lsas() 
 	{
 	    return _lsas;
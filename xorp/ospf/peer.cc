@@ -524,6 +524,15 @@ PeerOut<A>::on_link_state_request_list(OspfTypes::AreaID area,
     return _areas[area]->on_link_state_request_list(nid, lsar);
 }
 
+template <typename A>
+    void
+PeerOut<A>::rekey_lsa(Lsa::LsaRef lsar)
+{
+    typename map<OspfTypes::AreaID, Peer<A> *>::iterator i;
+    for(i = _areas.begin(); i != _areas.end(); i++)
+	(*i).second->rekey_lsa(lsar);
+}
+
 template <typename A>
     bool 
 PeerOut<A>::event_bad_link_state_request(OspfTypes::AreaID area,
@@ -1560,6 +1569,15 @@ Peer<A>::on_link_state_request_list(const OspfTypes::NeighbourID nid,
     return false;
 }
 
+template <typename A>
+    void
+Peer<A>::rekey_lsa(Lsa::LsaRef lsar)
+{
+    typename list<Neighbour<A> *>::iterator n;
+    for(n = _neighbours.begin(); n != _neighbours.end(); n++)
+	(*n)->rekey_lsa(lsar);
+}
+
 template <typename A>
 bool 
 Peer<A>::event_bad_link_state_request(const OspfTypes::NeighbourID nid) const
@@ -4004,7 +4022,7 @@ Neighbour<A>::retransmitter()
 	LinkStateRequestPacket lsrp(_ospf.get_version());
 
 	size_t lsr_len = 0;
-	list<Lsa_header>::iterator i;
+	LsaList<Lsa_header>::iterator i;
 	for (i = _ls_request_list.begin(); i != _ls_request_list.end(); i++) 
 	{
 	    if (lsrp.get_standard_header_length() +
@@ -4043,7 +4061,7 @@ Neighbour<A>::retransmitter()
 	LinkStateUpdatePacket lsup(_ospf.get_version(),
 		_ospf.get_lsa_decoder());
 	size_t lsas_len = 0;
-	list<Lsa::LsaRef>::iterator i = _lsa_rxmt.begin();
+	LsaList<Lsa::LsaRef>::iterator i = _lsa_rxmt.begin();
 	while (i != _lsa_rxmt.end()) 
 	{
 	    if ((*i)->valid() && (*i)->exists_nack(_neighbourid)) 
@@ -4064,12 +4082,13 @@ Neighbour<A>::retransmitter()
 			    cstring(lsup));
 		    send_link_state_update_packet(lsup, true /* direct */);
 		    lsup.get_lsas().clear();
-		    lsas_len = 0;
+		    lsas_len = len;
+		    lsup.get_lsas().push_back(*i);
 		}
 		i++;
 	    } else 
 	    {
-		_lsa_rxmt.erase(i++);
+		i = _lsa_rxmt.erase(i);
 	    }
 	}
 
@@ -4409,7 +4428,7 @@ Neighbour<A>::tear_down_state(State previous_state)
     // calling push_lsas will do the trick.
     XLOG_ASSERT(_lsa_queue.empty());
 
-    list<Lsa::LsaRef>::iterator i = _lsa_rxmt.begin();
+    LsaList<Lsa::LsaRef>::iterator i;
     for (i = _lsa_rxmt.begin(); i != _lsa_rxmt.end(); i++)
 	(*i)->remove_nack(_neighbourid);
     _lsa_rxmt.clear();
@@ -4983,7 +5002,8 @@ Neighbour<A>::link_state_request_received(LinkStateRequestPacket *lsrp)
 	{
 	    send_link_state_update_packet(lsup);
 	    lsup.get_lsas().clear();
-	    lsas_len = 0;
+	    lsas_len = len;
+	    lsup.get_lsas().push_back(*i);
 	}
     }
 
@@ -5058,30 +5078,27 @@ Neighbour<A>::link_state_update_received(LinkStateUpdatePacket *lsup)
     // 
     XLOG_TRACE(_ospf.trace()._neighbour_events, "MAX_AGE_IN_DATABASE is not defined.\n");
 
-again:
-    for (list<Lsa::LsaRef>::iterator i = _lsa_rxmt.begin();
-	    i != _lsa_rxmt.end(); i++) 
     {
-	iterations++;
-	if (!(*i)->maxage())
-	    continue;
-	if ((*i)->max_sequence_number())
-	    continue;
 	list<Lsa::LsaRef>& lsas = lsup->get_lsas();
 	list<Lsa::LsaRef>::const_iterator j;
 	for (j = lsas.begin(); j != lsas.end(); j++) 
 	{
-	    // Possibly rewritten
-	    iterations++;
-	    if (*i == *j) 
-	    {
-		continue;
-	    }
-	    if ((*i).get()->get_header() == (*j).get()->get_header()) 
+	    list<LsaList<Lsa::LsaRef>::iterator> matches;
+	    _lsa_rxmt.find_all((*j)->get_header(), matches);
+	    list<LsaList<Lsa::LsaRef>::iterator>::iterator m;
+	    for (m = matches.begin(); m != matches.end(); m++) 
 	    {
+		iterations++;
+		LsaList<Lsa::LsaRef>::iterator i = *m;
+		// Possibly rewritten
+		if (*i == *j)
+		    continue;
+		if (!(*i)->maxage())
+		    continue;
+		if ((*i)->max_sequence_number())
+		    continue;
 		//XLOG_INFO("Same LSA\n%s\n%s", cstring(*(*i)), cstring(*(*j)));
 		_lsa_rxmt.erase(i);
-		goto again;
 	    }
 	}
     }
@@ -5096,22 +5113,18 @@ again:
 
     list<Lsa::LsaRef>& lsas = lsup->get_lsas();
     list<Lsa::LsaRef>::const_iterator i;
-    list<Lsa_header>::iterator j;
+    LsaList<Lsa_header>::iterator j;
 
     int iter2 = 0;
     for (i = lsas.begin(); i != lsas.end(); i++) 
     {
 	//XLOG_TRACE(_ospf.trace()._neighbour_events, "lsa: %s\n", (*i)->str().c_str());
-	for (j = _ls_request_list.begin(); j != _ls_request_list.end(); j++) 
+	iter2++;
+	j = _ls_request_list.find((*i)->get_header());
+	if (j != _ls_request_list.end()) 
 	{
-	    //XLOG_TRACE(_ospf.trace()._neighbour_events, "lsa-req: %s\n", j->str().c_str());
-	    iter2++;
-	    if ((*j) == (*i)->get_header()) 
-	    {
-		XLOG_TRACE(_ospf.trace()._neighbour_events, "Header matched, erasing j\n");
-		_ls_request_list.erase(j);
-		break;
-	    }
+	    XLOG_TRACE(_ospf.trace()._neighbour_events, "Header matched, erasing j\n");
+	    _ls_request_list.erase(j);
 	}
     }
     if (_ls_request_list.empty())
@@ -5160,30 +5173,23 @@ link_state_acknowledgement_received(LinkStateAcknowledgementPacket *lsap)
 
     list<Lsa_header>& headers = lsap->get_lsa_headers();
     list<Lsa_header>::iterator i;
-    list<Lsa::LsaRef>::iterator j;
     for (i = headers.begin(); i != headers.end(); i++) 
     {
-	// Neither the found or partial variable are required they
-	// exist solely for monitoring. The double lookup is also
-	// unnecessary. A call to compare_all_header_fields is all
-	// that is required.
-	//bool found = false;
-	//bool partial = false;
-	for (j = _lsa_rxmt.begin(); j != _lsa_rxmt.end(); j++) 
+	// Only LSAs with the same identity are considered, the
+	// instance must then match all the header fields.
+	list<LsaList<Lsa::LsaRef>::iterator> matches;
+	_lsa_rxmt.find_all(*i, matches);
+	list<LsaList<Lsa::LsaRef>::iterator>::iterator m;
+	for (m = matches.begin(); m != matches.end(); m++) 
 	{
-	    if ((*i) == (*j)->get_header()) 
+	    LsaList<Lsa::LsaRef>::iterator j = *m;
+	    if (compare_all_header_fields((*i),(*j)->get_header())) 
 	    {
-		//partial = true;
-		if (compare_all_header_fields((*i),(*j)->get_header())) 
-		{
-		    //found = true;
-		    (*j)->remove_nack(get_neighbour_id());
-		    _lsa_rxmt.erase(j);
-		    break;
-		}
+		(*j)->remove_nack(get_neighbour_id());
+		_lsa_rxmt.erase(j);
+		break;
 	    }
 	}
-
     }
 }
 
@@ -5256,9 +5262,7 @@ Neighbour<A>::queue_lsa(OspfTypes::PeerID peerid, OspfTypes::NeighbourID nid,
 	    {
 		// (b) See if this LSA is on the link state request list.
 		Lsa_header& lsah = lsar->get_header();
-		list<Lsa_header>::iterator i = find(_ls_request_list.begin(),
-			_ls_request_list.end(),
-			lsah);
+		LsaList<Lsa_header>::iterator i = _ls_request_list.find(lsah);
 		if (i != _ls_request_list.end()) 
 		{
 		    switch(get_area_router()->compare_lsa(lsah, *i)) 
@@ -5316,22 +5320,23 @@ Neighbour<A>::queue_lsa(OspfTypes::PeerID peerid, OspfTypes::NeighbourID nid,
     // Once we are happy with this fix then combine this with the loop
     // below and do away with this define.
 
-    list<Lsa::LsaRef>::iterator i;
-    for (i = _lsa_rxmt.begin(); i != _lsa_rxmt.end(); i++) 
+    list<LsaList<Lsa::LsaRef>::iterator> matches;
+    _lsa_rxmt.find_all(lsar->get_header(), matches);
+    list<LsaList<Lsa::LsaRef>::iterator>::iterator m;
+    for (m = matches.begin(); m != matches.end(); m++) 
     {
-	if (lsar != (*i) &&
-		(*i).get()->get_header() == lsar.get()->get_header()) 
+	if (lsar != *(*m)) 
 	{
-	    // 	    XLOG_ASSERT((*i)->maxage());
-	    // 	    XLOG_INFO("Same LSA\n%s\n%s", cstring(*(*i)), cstring(*lsar));
-	    _lsa_rxmt.erase(i);
+	    // 	    XLOG_ASSERT((*(*m))->maxage());
+	    // 	    XLOG_INFO("Same LSA\n%s\n%s", cstring(*(*(*m))), cstring(*lsar));
+	    _lsa_rxmt.erase(*m);
 	    break;
 	}
     }
 #endif
 
     // (d) If this LSA isn't already on the retransmit queue add it.
-    if (find(_lsa_rxmt.begin(), _lsa_rxmt.end(), lsar) == _lsa_rxmt.end())
+    if (_lsa_rxmt.find(lsar) == _lsa_rxmt.end())
 	_lsa_rxmt.push_back(lsar);
 
     // Add this neighbour ID to the set of unacknowledged neighbours.
@@ -5430,7 +5435,8 @@ Neighbour<A>::push_lsas(const char* message)
 	    {
 		send_link_state_update_packet(lsup);
 		lsup.get_lsas().clear();
-		lsas_len = 0;
+		lsas_len = len;
+		lsup.get_lsas().push_back(*i);
 	    }
 	}
     }
@@ -5451,14 +5457,19 @@ template <typename A>
 bool
 Neighbour<A>::on_link_state_request_list(Lsa::LsaRef lsar) const
 {
-    if (_ls_request_list.end() != find(_ls_request_list.begin(),
-		_ls_request_list.end(),
-		lsar->get_header()))
+    if (_ls_request_list.end() != _ls_request_list.find(lsar->get_header()))
 	return true;
 
     return false;
 }
 
+template <typename A>
+    void
+Neighbour<A>::rekey_lsa(Lsa::LsaRef lsar)
+{
+    _lsa_rxmt.rekey(lsar);
+}
+
 template <typename A>
     bool
 Neighbour<A>::send_ack(list<Lsa_header>& ack, bool direct,
@@ -289,6 +289,11 @@ class PeerOut
 		const OspfTypes::NeighbourID nid,
 		Lsa::LsaRef lsar);
 
+	/**
+	 * Re-index this LSA on the neighbours retransmission lists.
+	 */
+	void rekey_lsa(Lsa::LsaRef lsar);
+
 	/**
 	 * Generate a BadLSReq event.
 	 *
@@ -869,6 +874,11 @@ class Peer
 	bool on_link_state_request_list(const OspfTypes::NeighbourID nid,
 		Lsa::LsaRef lsar) const;
 
+	/**
+	 * Re-index this LSA on the neighbours retransmission lists.
+	 */
+	void rekey_lsa(Lsa::LsaRef lsar);
+
 	/**
 	 * Generate a BadLSReq event.
 	 *
@@ -1637,6 +1647,11 @@ class Neighbour
 	 */
 	bool on_link_state_request_list(Lsa::LsaRef lsar) const;
 
+	/**
+	 * Re-index this LSA on the retransmission list.
+	 */
+	void rekey_lsa(Lsa::LsaRef lsar);
+
 	/**
 	 * @return the link type.
 	 */
@@ -1699,10 +1714,10 @@ class Neighbour
 	RxmtWrapper *_rxmt_wrapper[TIMERS];	// Wrappers to retransmiter.
 
 	DataBaseHandle _database_handle;	// Handle to the Link State Database.
-	list<Lsa_header> _ls_request_list;	// Link state request list.
+	LsaList<Lsa_header> _ls_request_list;	// Link state request list.
 
 	list<Lsa::LsaRef> _lsa_queue;	// Queue of LSAs waiting to be sent.
-	list<Lsa::LsaRef> _lsa_rxmt;	// Unacknowledged LSAs
+	LsaList<Lsa::LsaRef> _lsa_rxmt;	// Unacknowledged LSAs
 	// awaiting retransmission.
 	XorpTimer _inactivity_timer;	// Inactivity timer.
 
@@ -1156,6 +1156,15 @@ PeerManager<A>::on_link_state_request_list(const OspfTypes::PeerID peerid,
     return _peers[peerid]->on_link_state_request_list(area, nid, lsar);
 }
 
+template <typename A>
+    void
+PeerManager<A>::rekey_lsa(Lsa::LsaRef lsar)
+{
+    typename map<OspfTypes::PeerID, PeerOut<A> *>::iterator i;
+    for(i = _peers.begin(); i != _peers.end(); i++)
+	(*i).second->rekey_lsa(lsar);
+}
+
 template <typename A>
     bool
 PeerManager<A>::event_bad_link_state_request(const OspfTypes::PeerID peerid,
@@ -1945,6 +1954,24 @@ PeerManager<A>::external_push_routes()
     _external.push_routes();
 }
 
+template <typename A>
+    bool
+PeerManager<A>::external_add_aggregate(const IPNet<A>& net)
+{
+    debug_msg("Net %s\n", cstring(net));
+
+    return _external.add_aggregate(net);
+}
+
+template <typename A>
+    bool
+PeerManager<A>::external_delete_aggregate(const IPNet<A>& net)
+{
+    debug_msg("Net %s\n", cstring(net));
+
+    return _external.delete_aggregate(net);
+}
+
 template <typename A>
     void
 PeerManager<A>::external_suppress_lsas(OspfTypes::AreaID area)
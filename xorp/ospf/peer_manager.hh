@@ -394,6 +394,12 @@ class PeerManager
 		const OspfTypes::NeighbourID nid,
 		Lsa::LsaRef lsar);
 
+	/**
+	 * The Link State ID of this LSA has been changed, re-index it on
+	 * all the neighbours retransmission lists.
+	 */
+	void rekey_lsa(Lsa::LsaRef lsar);
+
 	/**
 	 * Generate a BadLSReq event.
 	 *
@@ -808,6 +814,17 @@ class PeerManager
 	 */
 	void external_push_routes();
 
+	/**
+	 * Summarise redistributed routes within this network into a
+	 * single AS-External-LSA.
+	 */
+	bool external_add_aggregate(const IPNet<A>& net);
+
+	/**
+	 * Stop summarising redistributed routes within this network.
+	 */
+	bool external_delete_aggregate(const IPNet<A>& net);
+
 	/**
 	 * Examine self originated AS-external-LSAs that may need to be
 	 * suppressed because another router's AS-external-LSA takes
@@ -0,0 +1,139 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+// 
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "ospf_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/debug.h"
+#include "libxorp/xlog.h"
+#include "libxorp/callback.hh"
+#include "libxorp/ipv4.hh"
+#include "libxorp/ipv6.hh"
+#include "libxorp/ipnet.hh"
+#include "libxorp/status_codes.h"
+#include "libxorp/service.hh"
+#include "libxorp/eventloop.hh"
+#include "libxorp/random.h"
+
+#include "libproto/spt.hh"
+
+#include "ospf.hh"
+
+    RefreshQueue::RefreshQueue(uint32_t period, uint32_t max_per_tick,
+	RefreshCallback refresh, CompleteCallback complete)
+    : _period(period), _max_per_tick(max_per_tick),
+      _refresh(refresh), _complete(complete),
+      _last_refreshed(0), _refreshed(0)
+{
+    XLOG_ASSERT(_period >= 2);
+    XLOG_ASSERT(_max_per_tick > 0);
+}
+
+    void
+RefreshQueue::add(Lsa::LsaRef lsar, bool jitter)
+{
+    remove(lsar);
+
+    TimeVal when;
+    EventLoop::instance().current_time(when);
+    if (jitter) 
+    {
+	uint32_t half = _period / 2;
+	when += TimeVal(_period - half + xorp_random() % (half + 1), 0);
+    } else 
+    {
+	when += TimeVal(_period, 0);
+    }
+
+    _index[lsar.get()] = _queue.insert(make_pair(when, lsar));
+    schedule(when);
+}
+
+    void
+RefreshQueue::remove(Lsa::LsaRef lsar)
+{
+    map<const Lsa *, Queue::iterator>::iterator i = _index.find(lsar.get());
+    if (i == _index.end())
+	return;
+
+    _queue.erase(i->second);
+    _index.erase(i);
+}
+
+    void
+RefreshQueue::clear()
+{
+    _queue.clear();
+    _index.clear();
+    _timer.clear();
+}
+
+    void
+RefreshQueue::schedule(const TimeVal& when)
+{
+    // Never run the queue more than once a second, that is where the
+    // batching comes from.
+    TimeVal now;
+    EventLoop::instance().current_time(now);
+    TimeVal at = when;
+    if (at < now + TimeVal(1, 0))
+	at = now + TimeVal(1, 0);
+
+    if (_timer.scheduled() && _timer.expiry() <= at)
+	return;
+
+    _timer = EventLoop::instance().
+	new_oneoff_at(at, callback(this, &RefreshQueue::tick));
+}
+
+    void
+RefreshQueue::tick()
+{
+    TimeVal now;
+    EventLoop::instance().current_time(now);
+
+    // Refresh more than the normal number if that is what it takes to
+    // get through the whole queue in half a period, nothing must be
+    // allowed to get close to MaxAge.
+    size_t limit = _queue.size() / (_period / 2) + 1;
+    if (limit < _max_per_tick)
+	limit = _max_per_tick;
+
+    uint32_t count = 0;
+    while (!_queue.empty() && _queue.begin()->first <= now && count < limit) 
+    {
+	Lsa::LsaRef lsar = _queue.begin()->second;
+	_index.erase(lsar.get());
+	_queue.erase(_queue.begin());
+
+	// The refresh callback will typically add the LSA back.
+	_refresh->dispatch(lsar);
+	count++;
+    }
+
+    _last_refreshed = count;
+    _refreshed += count;
+
+    if (0 != count)
+	_complete->dispatch();
+
+    if (!_queue.empty())
+	schedule(_queue.begin()->first);
+}
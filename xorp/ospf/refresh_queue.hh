@@ -0,0 +1,115 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2009 XORP, Inc.
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+// 
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __OSPF_REFRESH_QUEUE_HH__
+#define __OSPF_REFRESH_QUEUE_HH__
+
+/**
+ * Paced refresh of self originated LSAs.
+ *
+ * Rather than every LSA holding its own refresh timer all the LSAs
+ * are held in one queue ordered by the time that they are due. A
+ * single timer services the queue once a second, handing the due
+ * LSAs to the refresh callback and then calling the complete callback
+ * so that the whole batch can be flooded together.
+ *
+ * An LSA that is added with jitter is due somewhere in the second half
+ * of the refresh period, so that LSAs originated together (such as
+ * redistributed routes at startup) are spread out rather than all
+ * being refreshed in the same second thereafter.
+ */
+class RefreshQueue 
+{
+    public:
+	typedef XorpCallback1<void, Lsa::LsaRef>::RefPtr RefreshCallback;
+	typedef XorpCallback0<void>::RefPtr CompleteCallback;
+
+	/**
+	 * @param period the refresh period in seconds.
+	 * @param max_per_tick the number of LSAs to refresh in one
+	 * second, more are refreshed if required to get through the
+	 * queue in half a period.
+	 * @param refresh invoked for each LSA as it becomes due.
+	 * @param complete invoked after a batch of refreshes.
+	 */
+	RefreshQueue(uint32_t period, uint32_t max_per_tick,
+		RefreshCallback refresh, CompleteCallback complete);
+
+	/**
+	 * Schedule an LSA for refresh, if it is already on the queue
+	 * it is rescheduled.
+	 *
+	 * @param jitter if true the LSA is due at a random point in the
+	 * second half of the period otherwise at the end of the period.
+	 */
+	void add(Lsa::LsaRef lsar, bool jitter);
+
+	/**
+	 * Remove an LSA from the queue.
+	 */
+	void remove(Lsa::LsaRef lsar);
+
+	/**
+	 * Remove all LSAs from the queue.
+	 */
+	void clear();
+
+	/**
+	 * @return the number of LSAs waiting to be refreshed.
+	 */
+	size_t size() const { return _queue.size(); }
+
+	/**
+	 * @return the number of LSAs refreshed by the last tick.
+	 */
+	uint32_t last_refreshed() const { return _last_refreshed; }
+
+	/**
+	 * @return the total number of LSAs refreshed.
+	 */
+	uint64_t refreshed() const { return _refreshed; }
+
+    private:
+	typedef multimap<TimeVal, Lsa::LsaRef> Queue;
+
+	const uint32_t _period;		// Refresh period in seconds.
+	const uint32_t _max_per_tick;	// Normal refreshes per second.
+	RefreshCallback _refresh;	// Invoked to refresh an LSA.
+	CompleteCallback _complete;	// Invoked after a batch.
+
+	Queue _queue;			// LSAs ordered by due time.
+	map<const Lsa *, Queue::iterator> _index;	// Position on queue.
+	XorpTimer _timer;		// Timer that services the queue.
+
+	uint32_t _last_refreshed;	// Refreshed by the last tick.
+	uint64_t _refreshed;		// Total refreshed.
+
+	/**
+	 * Make sure the timer will fire no later than when.
+	 */
+	void schedule(const TimeVal& when);
+
+	/**
+	 * Invoked from the timer to refresh the due LSAs.
+	 */
+	void tick();
+};
+
+#endif // __OSPF_REFRESH_QUEUE_HH__
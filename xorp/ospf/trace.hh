@@ -39,7 +39,8 @@ struct Trace
     _routes(false),
     _retransmit(false),
     _election(false),
-    _packets(false)
+    _packets(false),
+    _refresh(false)
 	      // Don't forget to add new variables to the all() method.
     {}
 
@@ -51,7 +52,7 @@ struct Trace
 	_input_errors = _interface_events = _neighbour_events = _spt = 
 	    _import_policy = _export_policy = _virtual_link = 
 	    _find_interface_address = _routes = _retransmit = _election = 
-	    _packets = val;
+	    _packets = _refresh = val;
     }
 
     bool _input_errors;
@@ -66,6 +67,7 @@ struct Trace
     bool _retransmit;
     bool _election;	// DR and BDR election.
     bool _packets;	// Incoming and outgoing packets.
+    bool _refresh;	// Paced refresh of self originated LSAs.
 };
 
 #endif // __OSPF_TRACE_HH__
@@ -83,6 +83,133 @@ XrlIO<A>::recv(const string& interface,
 	    payload_copy.size());
 }
 
+template <typename A>
+    void
+XrlIO<A>::start_ring()
+{
+    string error_msg;
+
+    if (_ring != NULL || _ring_failed)
+	return;
+
+    _ring = new RawPacketRing(RawPacketRing::unique_name(A::af()));
+    if (_ring->create(RawPacketRing::DEFAULT_BYTES, error_msg) != XORP_OK) 
+    {
+	XLOG_INFO("Receiving packets with XRLs: %s", error_msg.c_str());
+	delete _ring;
+	_ring = NULL;
+	_ring_failed = true;
+	return;
+    }
+
+    EventLoop::instance().add_ioevent_cb(_ring->notify_fd(), IOT_READ,
+	    callback(this, &XrlIO::ring_event));
+
+    if (!register_ring()) 
+    {
+	stop_ring();
+	_ring_failed = true;
+    }
+}
+
+template <typename A>
+    void
+XrlIO<A>::stop_ring()
+{
+    if (_ring == NULL)
+	return;
+
+    EventLoop::instance().remove_ioevent_cb(_ring->notify_fd(), IOT_READ);
+    _ring->unlink();
+    delete _ring;
+    _ring = NULL;
+}
+
+template <typename A>
+    void
+XrlIO<A>::register_ring_cb(const XrlError& xrl_error)
+{
+    if (_ring == NULL)
+	return;
+
+    //
+    // Once the FEA has attached the names are no longer needed. If the
+    // FEA could not attach packets keep arriving as XRLs.
+    //
+    if (xrl_error != XrlError::OKAY()) 
+    {
+	XLOG_INFO("Receiving packets with XRLs: %s", xrl_error.str().c_str());
+	stop_ring();
+	_ring_failed = true;
+	return;
+    }
+
+    _ring->unlink();
+}
+
+template <typename A>
+    void
+XrlIO<A>::unregister_ring_cb(const XrlError& xrl_error)
+{
+    UNUSED(xrl_error);
+
+    stop_ring();
+}
+
+template <typename A>
+    void
+XrlIO<A>::ring_event(XorpFd fd, IoEventType type)
+{
+    UNUSED(fd);
+    UNUSED(type);
+
+    string interface, vif;
+    IPvX src, dst;
+    uint8_t ip_protocol;
+    int32_t ip_ttl, ip_tos;
+    bool ip_router_alert, ip_internet_control;
+    vector<uint8_t> ext_headers_type;
+    vector<vector<uint8_t> > ext_headers_payload;
+    vector<uint8_t> payload;
+
+    _ring->clear_notify();
+
+    for (size_t n = 0; n < RING_BATCH; n++) 
+    {
+	if (!_ring->recv(interface, vif, src, dst, ip_protocol,
+		    ip_ttl, ip_tos, ip_router_alert, ip_internet_control,
+		    ext_headers_type, ext_headers_payload, payload)) 
+	{
+	    if (_ring->is_broken()) 
+	    {
+		// The FEA falls back to XRLs when the ring is not read.
+		stop_ring();
+		_ring_failed = true;
+		return;
+	    }
+	    if (_ring->sleep())
+		return;
+	    continue;
+	}
+
+	if (src.af() != A::af() || dst.af() != A::af())
+	    continue;
+
+	A src_a, dst_a;
+	src.get(src_a);
+	dst.get(dst_a);
+	recv(interface, vif, src_a, dst_a, ip_protocol,
+		ip_ttl, ip_tos, ip_router_alert, ip_internet_control, payload);
+
+	// The receive may have torn down the IO.
+	if (_ring == NULL)
+	    return;
+    }
+
+    // Let other work run before reading any more.
+    _ring->wake();
+}
+
 template <>
     bool
 XrlIO<IPv4>::send(const string& interface, const string& vif,
@@ -184,6 +311,32 @@ XrlIO<IPv4>::enable_interface_vif(const string& interface, const string& vif)
 }
 
 
+template <>
+    bool
+XrlIO<IPv4>::register_ring()
+{
+    XrlRawPacket4V0p1Client fea_client(&_xrl_router);
+    return fea_client.send_register_receiver_ring(
+	    _feaname.c_str(),
+	    _xrl_router.instance_name(),
+	    _ring->name(),
+	    callback(this, &XrlIO::register_ring_cb));
+}
+
+template <>
+    void
+XrlIO<IPv4>::unregister_ring()
+{
+    if (_ring == NULL)
+	return;
+
+    XrlRawPacket4V0p1Client fea_client(&_xrl_router);
+    fea_client.send_unregister_receiver_ring(
+	    _feaname.c_str(),
+	    _xrl_router.instance_name(),
+	    callback(this, &XrlIO::unregister_ring_cb));
+}
+
 template <typename A>
     void
 XrlIO<A>::enable_interface_vif_cb(const XrlError& xrl_error, string interface,
@@ -195,6 +348,7 @@ XrlIO<A>::enable_interface_vif_cb(const XrlError& xrl_error, string interface,
     {
 	case OKAY:
 	    // Success
+	    start_ring();
 	    break;
 
 	case REPLY_TIMED_OUT:
@@ -1184,6 +1338,32 @@ XrlIO<IPv6>::enable_interface_vif(const string& interface, const string& vif)
 }
 
 
+template <>
+    bool
+XrlIO<IPv6>::register_ring()
+{
+    XrlRawPacket6V0p1Client fea_client(&_xrl_router);
+    return fea_client.send_register_receiver_ring(
+	    _feaname.c_str(),
+	    _xrl_router.instance_name(),
+	    _ring->name(),
+	    callback(this, &XrlIO::register_ring_cb));
+}
+
+template <>
+    void
+XrlIO<IPv6>::unregister_ring()
+{
+    if (_ring == NULL)
+	return;
+
+    XrlRawPacket6V0p1Client fea_client(&_xrl_router);
+    fea_client.send_unregister_receiver_ring(
+	    _feaname.c_str(),
+	    _xrl_router.instance_name(),
+	    callback(this, &XrlIO::unregister_ring_cb));
+}
+
 template <>
     bool
 XrlIO<IPv6>::disable_interface_vif(const string& interface, const string& vif)
@@ -26,6 +26,7 @@
 #include "libxipc/xrl_router.hh"
 
 #include "libfeaclient/ifmgr_xrl_mirror.hh"
+#include "libproto/raw_packet_ring.hh"
 #include "policy/backend/policytags.hh"
 
 #include "io.hh"
@@ -117,7 +118,9 @@ class XrlIO : public IO<A>,
 	    _component_count(0),
 	    _ifmgr( feaname.c_str(), _xrl_router.finder_address(),
 		    _xrl_router.finder_port()),
-	    _rib_queue( xrl_router)
+	    _rib_queue( xrl_router),
+	    _ring(NULL),
+	    _ring_failed(false)
 
     {
 	_ifmgr.set_observer(this);
@@ -140,6 +143,7 @@ class XrlIO : public IO<A>,
 
 	    _ifmgr.detach_hint_observer(this);
 	    _ifmgr.unset_observer(this);
+	    stop_ring();
 	}
 
 	/**
@@ -179,6 +183,7 @@ class XrlIO : public IO<A>,
 	    //
 
 	    unregister_rib();
+	    unregister_ring();
 	    component_down("shutdown");
 
 	    return (_ifmgr.shutdown());
@@ -441,10 +446,34 @@ class XrlIO : public IO<A>,
 	 */
 	void updates_made();
 
+	/**
+	 * Create a shared memory ring and ask the FEA to deliver packets
+	 * through it rather than with XRLs.
+	 */
+	void start_ring();
+
+	/**
+	 * Close the shared memory ring.
+	 */
+	void stop_ring();
+
+	/**
+	 * Send the ring registration XRLs.
+	 */
+	bool register_ring();
+	void unregister_ring();
+
+	/**
+	 * Receive the packets on the shared memory ring.
+	 */
+	void ring_event(XorpFd fd, IoEventType type);
+
 	//
 	// XRL callbacks
 	//
 	void send_cb(const XrlError& xrl_error, string interface, string vif);
+	void register_ring_cb(const XrlError& xrl_error);
+	void unregister_ring_cb(const XrlError& xrl_error);
 	void enable_interface_vif_cb(const XrlError& xrl_error, string interface,
 		string vif);
 	void disable_interface_vif_cb(const XrlError& xrl_error, string interface,
@@ -462,6 +491,12 @@ class XrlIO : public IO<A>,
 	IfMgrXrlMirror	_ifmgr;
 	XrlQueue<A>		_rib_queue;
 
+	// Maximum number of packets taken from the ring in one go.
+	static const size_t RING_BATCH = 64;
+
+	RawPacketRing*	_ring;		// Packets from the FEA.
+	bool		_ring_failed;	// Don't try to use a ring again.
+
 	//
 	// A local copy with the interface state information
 	//
@@ -512,6 +512,21 @@ class XrlOspfV2Target : XrlOspfv2TargetBase
 		const IPv4Net&	net,
 		const bool&	advertise);
 
+	/**
+	 *  Add a summary of the redistributed routes in a single
+	 *  AS-external-LSA.
+	 */
+	XrlCmdError ospfv2_0_1_external_aggregate_add(
+		// Input values,
+		const IPv4Net&	net);
+
+	/**
+	 *  Delete a summary of the redistributed routes.
+	 */
+	XrlCmdError ospfv2_0_1_external_aggregate_delete(
+		// Input values,
+		const IPv4Net&	net);
+
 	/**
 	 *  Enable/Disable tracing.
 	 *
@@ -789,6 +789,32 @@ XrlOspfV3Target::ospfv3_0_1_area_range_change_state(const IPv4& a,
     return XrlCmdError::OKAY();
 }
 
+    XrlCmdError
+XrlOspfV3Target::ospfv3_0_1_external_aggregate_add(const IPv6Net& net)
+{
+    debug_msg("net %s\n", cstring(net));
+
+    if (!_ospf_ipv6.add_external_aggregate(net))
+	return XrlCmdError::
+	    COMMAND_FAILED(c_format("Failed to add external aggregate "
+			"net %s\n", cstring(net)));
+
+    return XrlCmdError::OKAY();
+}
+
+    XrlCmdError
+XrlOspfV3Target::ospfv3_0_1_external_aggregate_delete(const IPv6Net& net)
+{
+    debug_msg("net %s\n", cstring(net));
+
+    if (!_ospf_ipv6.delete_external_aggregate(net))
+	return XrlCmdError::
+	    COMMAND_FAILED(c_format("Failed to delete external aggregate "
+			"net %s\n", cstring(net)));
+
+    return XrlCmdError::OKAY();
+}
+
     XrlCmdError
 XrlOspfV3Target::ospfv3_0_1_trace(const string&	tvar, const bool& enable)
 {
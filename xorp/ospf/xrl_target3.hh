@@ -525,6 +525,21 @@ class XrlOspfV3Target : XrlOspfv3TargetBase
 		const IPv6Net&	net,
 		const bool&	advertise);
 
+	/**
+	 *  Add a summary of the redistributed routes in a single
+	 *  AS-external-LSA.
+	 */
+	XrlCmdError ospfv3_0_1_external_aggregate_add(
+		// Input values,
+		const IPv6Net&	net);
+
+	/**
+	 *  Delete a summary of the redistributed routes.
+	 */
+	XrlCmdError ospfv3_0_1_external_aggregate_delete(
+		// Input values,
+		const IPv6Net&	net);
+
 	/**
 	 *  Enable/Disable tracing.
 	 *
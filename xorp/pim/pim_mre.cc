@@ -43,6 +43,7 @@
 	_pim_rp(NULL),
 	_mrib_rp(NULL),
 	_mrib_s(NULL),
+	_mrib_s_prefix_len(MRIB_S_NOT_INDEXED),
 	_nbr_mrib_next_hop_rp(NULL),
 	_nbr_mrib_next_hop_s(NULL),
 	_rpfp_nbr_wc(NULL),
@@ -97,6 +98,7 @@ PimMre::~PimMre()
 	//
 	// Remove this entry from the PimMrt table
 	//
+	pim_mrt()->delete_pim_mre_mrib_s(this);
 	pim_mrt()->remove_pim_mre(this);
 }
 
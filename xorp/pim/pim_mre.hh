@@ -148,7 +148,7 @@ class PimMre : public Mre<PimMre>, BugCatcher, NONCOPYABLE
 		uint32_t	rpf_interface_rp() const;
 		uint32_t	rpf_interface_s() const;
 		void	set_mrib_rp(Mrib *v)	{ _mrib_rp = v;			}
-		void	set_mrib_s(Mrib *v)	{ _mrib_s = v;			}
+		void	set_mrib_s(Mrib *v);
 		Mrib	*compute_mrib_rp() const;
 		Mrib	*compute_mrib_s() const;
 		void	recompute_mrib_rp_rp();		// Used by (*,*,RP)
@@ -158,6 +158,14 @@ class PimMre : public Mre<PimMre>, BugCatcher, NONCOPYABLE
 		void	recompute_mrib_s_sg();		// Used by (S,G)
 		void	recompute_mrib_s_sg_rpt();	// Used by (S,G,rpt)
 		//
+		// The prefix length of mrib_s() in the PimMrt index of entries
+		// by MRIB prefix, or one of the values below.
+		// Note: used only by (S,G) and (S,G,rpt) entry.
+		//
+		enum { MRIB_S_NOT_INDEXED = -2, MRIB_S_UNRESOLVED = -1 };
+		int	mrib_s_prefix_len() const { return (_mrib_s_prefix_len); }
+		void	set_mrib_s_prefix_len(int v) { _mrib_s_prefix_len = v; }
+		//
 
 		//
 		// RPF and RPF' neighbor info
@@ -294,6 +302,10 @@ class PimMre : public Mre<PimMre>, BugCatcher, NONCOPYABLE
 			return (_join_or_override_timer);
 		}
 		void	join_timer_timeout();
+		// Note: applies only for (S,G)
+		void	set_join_timer_periodic_sg(PimNbr *pim_nbr);
+		// Note: applies only for (S,G)
+		void	join_timer_remaining_sg(TimeVal& tv_left) const;
 		// Note: applies only for (S,G,rpt)
 		XorpTimer&	override_timer() { return (_join_or_override_timer); }
 		// Note: applies only for (S,G,rpt)
@@ -899,6 +911,7 @@ class PimMre : public Mre<PimMre>, BugCatcher, NONCOPYABLE
 		// Used by all entries
 		Mrib	*_mrib_s;		// The MRIB info to the source
 		// Used by (S,G) (S,G,rpt)
+		int	_mrib_s_prefix_len;	// The indexed prefix length of _mrib_s
 		//
 		PimNbr	*_nbr_mrib_next_hop_rp;	// Applies only for (*,*,RP) and (*,G)
 		PimNbr	*_nbr_mrib_next_hop_s;	// Applies only for (S,G)
@@ -1503,7 +1503,7 @@ joined_state_label:
 	t_joinsuppress = TimeVal(holdtime, 0);
 	if (t_suppressed < t_joinsuppress)
 		t_joinsuppress = t_suppressed;
-	join_timer().time_remaining(tv_left);
+	join_timer_remaining_sg(tv_left);
 	if (tv_left < t_joinsuppress) 
 	{
 		// Restart the timer with `t_joinsuppress'
@@ -1547,7 +1547,7 @@ joined_state_label:
 	if (pim_vif == NULL)
 		return;
 	t_override = pim_vif->upstream_join_timer_t_override();
-	join_timer().time_remaining(tv_left);
+	join_timer_remaining_sg(tv_left);
 	if (tv_left > t_override) 
 	{
 		// Restart the timer with `t_override'
@@ -1592,7 +1592,7 @@ joined_state_label:
 	if (pim_vif == NULL)
 		return;
 	t_override = pim_vif->upstream_join_timer_t_override();
-	join_timer().time_remaining(tv_left);
+	join_timer_remaining_sg(tv_left);
 	if (tv_left >  t_override) 
 	{
 		// Restart the timer with `t_override'
@@ -1636,7 +1636,7 @@ joined_state_label:
 	if (pim_vif == NULL)
 		return;
 	t_override = pim_vif->upstream_join_timer_t_override();
-	join_timer().time_remaining(tv_left);
+	join_timer_remaining_sg(tv_left);
 	if (tv_left > t_override) 
 	{
 		// Restart the timer with `t_override'
@@ -2079,7 +2079,6 @@ PimMre::is_join_desired_sg() const
 PimMre::recompute_is_join_desired_sg()
 {
 	PimNbr *pim_nbr;
-	uint16_t join_prune_period = PIM_JOIN_PRUNE_PERIOD_DEFAULT;
 
 	if (! is_sg())
 		return (false);
@@ -2114,15 +2113,11 @@ not_joined_state_label:
 				ACTION_JOIN,
 				pim_nbr->pim_vif()->join_prune_holdtime().get(),
 				is_new_group);
-		join_prune_period = pim_nbr->pim_vif()->join_prune_period().get();
 	}
-	// Set Join Timer to t_periodic
-	join_timer() =
-		EventLoop::instance().new_oneoff_after(
-				TimeVal(join_prune_period, 0),
-				callback(this, &PimMre::join_timer_timeout));
 	// Set the new state
 	set_joined_state();
+	// Set Join Timer to t_periodic
+	set_join_timer_periodic_sg(pim_nbr);
 	return (true);
 
 joined_state_label:
@@ -2148,6 +2143,7 @@ joined_state_label:
 				ACTION_PRUNE,
 				pim_nbr->pim_vif()->join_prune_holdtime().get(),
 				is_new_group);
+		pim_nbr->jp_periodic().delete_sg(this);
 	}
 	// Cancel Join Timer
 	join_timer().unschedule();
@@ -2569,14 +2565,63 @@ sg_entry_label:
 				ACTION_JOIN,
 				pim_nbr->pim_vif()->join_prune_holdtime().get(),
 				is_new_group);
-		join_prune_period = pim_nbr->pim_vif()->join_prune_period().get();
 	}
 	// Set Join Timer to t_periodic
+	set_join_timer_periodic_sg(pim_nbr);
+	return;
+}
+
+//
+// Set the Join Timer to t_periodic.
+// If RPF'(S,G) is known, the periodic Join(S,G) is sent by the neighbor
+// together with the Join(S,G) of all other (S,G) entries toward it,
+// hence the Join Timer itself is not running.
+//
+// Note: applies only for (S,G)
+	void
+PimMre::set_join_timer_periodic_sg(PimNbr *pim_nbr)
+{
+	if (! is_sg())
+		return;
+
+	if (pim_nbr != NULL) 
+	{
+		join_timer().unschedule();
+		pim_nbr->jp_periodic().add_sg(this);
+		return;
+	}
+
 	join_timer() =
 		EventLoop::instance().new_oneoff_after(
-				TimeVal(join_prune_period, 0),
+				TimeVal(PIM_JOIN_PRUNE_PERIOD_DEFAULT, 0),
 				callback(this, &PimMre::join_timer_timeout));
-	return;
+}
+
+//
+// Get the time until the next Join(S,G): either the remaining time of
+// the Join Timer, or the time until the next periodic Join(S,G)
+// to RPF'(S,G).
+//
+// Note: applies only for (S,G)
+	void
+PimMre::join_timer_remaining_sg(TimeVal& tv_left) const
+{
+	PimNbr *pim_nbr = rpfp_nbr_sg();
+
+	if (const_join_timer().scheduled()) 
+	{
+		const_join_timer().time_remaining(tv_left);
+		return;
+	}
+
+	if (is_sg() && is_joined_state() && (pim_nbr != NULL)
+			&& pim_nbr->jp_periodic().is_member_sg(this)) 
+	{
+		pim_nbr->jp_periodic().time_remaining(tv_left);
+		return;
+	}
+
+	tv_left = TimeVal::ZERO();
 }
 
 	void
@@ -294,6 +294,7 @@ PimMre::set_rpfp_nbr_wc(PimNbr *v)
 PimMre::set_rpfp_nbr_sg(PimNbr *v)
 {
 	PimNbr *old_pim_nbr = _rpfp_nbr_sg;
+	bool is_jp_periodic = false;
 
 	if (! is_sg())
 		return;
@@ -301,6 +302,10 @@ PimMre::set_rpfp_nbr_sg(PimNbr *v)
 	if (old_pim_nbr == v)
 		return;			// Nothing changed
 
+	// Stop the periodic Join(S,G) to the old neighbor
+	if ((old_pim_nbr != NULL) && old_pim_nbr->jp_periodic().delete_sg(this))
+		is_jp_periodic = true;
+
 	// Set the new value, and if necessary add to the list of PimMre entries
 	// for this neighbor.
 	bool is_new_nbr_in_use = is_pim_nbr_in_use(v);
@@ -323,6 +328,10 @@ PimMre::set_rpfp_nbr_sg(PimNbr *v)
 	{
 		pim_node()->delete_pim_mre_no_pim_nbr(this);
 	}
+
+	// Continue the periodic Join(S,G) to the new neighbor
+	if (is_jp_periodic)
+		set_join_timer_periodic_sg(v);
 }
 
 // Note: applies only for (S,G,rpt)
@@ -574,6 +583,19 @@ PimMre::recompute_mrib_rp_sg_rpt()
 	set_mrib_rp(new_mrib_rp);
 }
 
+// Used by (S,G), (S,G,rpt)
+	void
+PimMre::set_mrib_s(Mrib *v)
+{
+	//
+	// XXX: keep the PimMrt index of entries by MRIB prefix up to date,
+	// so only the dependent entries are re-evaluated on MRIB changes.
+	//
+	pim_mrt()->delete_pim_mre_mrib_s(this);
+	_mrib_s = v;
+	pim_mrt()->add_pim_mre_mrib_s(this);
+}
+
 // Used by (S,G)
 	void
 PimMre::recompute_mrib_s_sg()
@@ -1220,7 +1242,7 @@ joined_state_label:
 	if (pim_vif == NULL)
 		return;
 	t_override = pim_vif->upstream_join_timer_t_override();
-	join_timer().time_remaining(tv_left);
+	join_timer_remaining_sg(tv_left);
 	if (tv_left > t_override) 
 	{
 		// Restart the timer with `t_override'
@@ -1240,7 +1262,6 @@ joined_state_label:
 PimMre::recompute_rpfp_nbr_sg_not_assert_changed()
 {
 	PimNbr *old_pim_nbr, *new_pim_nbr;
-	uint16_t join_prune_period = PIM_JOIN_PRUNE_PERIOD_DEFAULT;
 
 	if (! is_sg())
 		return;
@@ -1284,7 +1305,6 @@ joined_state_label:
 				ACTION_JOIN,
 				new_pim_nbr->pim_vif()->join_prune_holdtime().get(),
 				is_new_group);
-		join_prune_period = new_pim_nbr->pim_vif()->join_prune_period().get();
 	}
 
 	// Send Prune(S,G) to the old value of RPF'(S,G)
@@ -1301,10 +1321,7 @@ joined_state_label:
 	// Set the new RPF'(S,G)
 	set_rpfp_nbr_sg(new_pim_nbr);
 	// Set Join Timer to t_periodic
-	join_timer() =
-		EventLoop::instance().new_oneoff_after(
-				TimeVal(join_prune_period, 0),
-				callback(this, &PimMre::join_timer_timeout));
+	set_join_timer_periodic_sg(new_pim_nbr);
 }
 
 //
@@ -1337,7 +1354,7 @@ joined_state_label:
 	if (pim_vif == NULL)
 		return;
 	t_override = pim_vif->upstream_join_timer_t_override();
-	join_timer().time_remaining(tv_left);
+	join_timer_remaining_sg(tv_left);
 	if (tv_left > t_override) 
 	{
 		// Restart the timer with `t_override'
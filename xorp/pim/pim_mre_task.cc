@@ -85,6 +85,7 @@ PimMreTask::PimMreTask(PimMrt* pim_mrt,
 	_is_processing_rp_addr_sg(false),
 	_is_processing_rp_addr_sg_rpt(false),
 	_processing_rp_addr_sg_sg_rpt(IPvX::ZERO(family())),
+	_mrib_changed_pim_mre_n(0),
 	//
 	_is_set_source_addr_mfc(false),
 	_source_addr_mfc(IPvX::ZERO(family())),
@@ -206,6 +207,12 @@ PimMreTask::run_task()
 		return (true);
 	}
 
+	if (_input_state == PimMreTrackState::INPUT_STATE_MRIB_S_CHANGED) 
+	{
+		pim_mrt()->record_mrib_changed(_source_addr_prefix_sg_sg_rpt,
+				_mrib_changed_pim_mre_n);
+	}
+
 	//
 	// The task has been completed, hence delete the task.
 	//
@@ -925,6 +932,40 @@ PimMreTask::run_task_sg_sg_rpt()
 	_is_set_source_addr_sg_sg_rpt = false;
 	_is_set_group_addr_sg_sg_rpt = false;
 
+	if (_is_set_source_addr_prefix_sg_sg_rpt
+			&& (! _mrib_modified_prefix_list.empty())) 
+	{
+		// Actions for the (S,G) and/or (S,G,rpt) entries that depend on
+		// the modified MRIB prefixes inside the unicast source address
+		// prefix. The entries are found by the MRIB prefix they resolved
+		// through, and are processed below one-by-one (including the
+		// PimMfc processing).
+		set<PimMre *> pim_mre_set;
+		list<IPvXNet>::const_iterator prefix_iter;
+		for (prefix_iter = _mrib_modified_prefix_list.begin();
+				prefix_iter != _mrib_modified_prefix_list.end();
+				++prefix_iter) 
+		{
+			pim_mrt()->find_pim_mre_mrib_s(*prefix_iter, pim_mre_set);
+		}
+		_mrib_modified_prefix_list.clear();
+
+		set<PimMre *>::const_iterator pim_mre_iter;
+		for (pim_mre_iter = pim_mre_set.begin();
+				pim_mre_iter != pim_mre_set.end();
+				++pim_mre_iter) 
+		{
+			PimMre *pim_mre = *pim_mre_iter;
+			if (pim_mre->is_sg())
+				_pim_mre_sg_list.push_back(pim_mre);
+			else
+				_pim_mre_sg_rpt_list.push_back(pim_mre);
+		}
+		_mrib_changed_pim_mre_n += pim_mre_set.size();
+
+		_is_set_source_addr_prefix_sg_sg_rpt = false;
+	}
+
 	if (_is_set_source_addr_prefix_sg_sg_rpt) 
 	{
 		// Actions for a set of (S,G) and/or (S,G,rpt) entries specified
@@ -966,6 +1007,7 @@ PimMreTask::run_task_sg_sg_rpt()
 
 			// Perform the (S,G) and (S,G,rpt) actions
 			perform_pim_mre_sg_sg_rpt_actions(pim_mre_sg, pim_mre_sg_rpt);
+			_mrib_changed_pim_mre_n++;
 
 			if (_time_slice.is_expired()) 
 			{
@@ -1017,6 +1059,7 @@ PimMreTask::run_task_sg_sg_rpt()
 
 			// Perform the (S,G,rpt) actions
 			perform_pim_mre_actions(pim_mre_sg_rpt);
+			_mrib_changed_pim_mre_n++;
 
 			if (_time_slice.is_expired()) 
 			{
@@ -125,6 +125,13 @@ class PimMreTask
 			_source_addr_prefix_sg_sg_rpt = addr_prefix;
 			_is_set_source_addr_prefix_sg_sg_rpt = true;
 		}
+		// The modified MRIB prefixes inside the source address prefix.
+		// If not empty, only the entries that depend on those prefixes
+		// are processed instead of all entries inside the source prefix.
+		void	set_mrib_modified_prefix_list(const list<IPvXNet>& v) 
+		{
+			_mrib_modified_prefix_list = v;
+		}
 		void	set_rp_addr_sg_sg_rpt(const IPvX& rp_addr) 
 		{
 			_rp_addr_sg_sg_rpt = rp_addr;
@@ -261,6 +268,8 @@ class PimMreTask
 		bool	_is_processing_rp_addr_sg;
 		bool	_is_processing_rp_addr_sg_rpt;
 		IPvX	_processing_rp_addr_sg_sg_rpt;
+		list<IPvXNet> _mrib_modified_prefix_list; // Modified MRIB prefixes
+		size_t	_mrib_changed_pim_mre_n; // Entries re-evaluated on MRIB change
 
 		//
 		// PimMfc related state
@@ -40,7 +40,8 @@
 
 	PimMribTable::PimMribTable(PimNode& pim_node)
 : MribTable(pim_node.family()),
-	_pim_node(pim_node)
+	_pim_node(pim_node),
+	_is_modified_all(false)
 {
 	//
 	// XXX: enable the preserving of the removed Mrib entries, because
@@ -72,6 +73,7 @@ PimMribTable::clear()
 	MribTable::clear();
 
 	add_modified_prefix(IPvXNet(IPvX::ZERO(family()), 0));
+	_is_modified_all = true;
 	apply_mrib_changes();
 }
 
@@ -145,6 +147,7 @@ PimMribTable::add_pending_remove(uint32_t tid, const Mrib& mrib)
 PimMribTable::add_pending_remove_all_entries(uint32_t tid)
 {
 	add_modified_prefix(IPvXNet(IPvX::ZERO(family()), 0));
+	_is_modified_all = true;
 	MribTable::add_pending_remove_all_entries(tid);
 }
 
@@ -170,8 +173,30 @@ PimMribTable::apply_mrib_changes()
 		IPvXNet modified_prefix_addr = _modified_prefix_list.front();
 		_modified_prefix_list.pop_front();
 
-		pim_node().pim_mrt().add_task_mrib_changed(modified_prefix_addr);
+		//
+		// Get the modified prefixes that were merged into this one.
+		// If all entries were modified, then the list is left empty
+		// so all PimMrt entries inside the prefix are re-evaluated.
+		//
+		list<IPvXNet> exact_prefix_list;
+		list<IPvXNet>::iterator iter;
+		for (iter = _modified_exact_prefix_list.begin();
+				iter != _modified_exact_prefix_list.end(); ) 
+		{
+			list<IPvXNet>::iterator iter2 = iter;
+			++iter;
+			if (! modified_prefix_addr.contains(*iter2))
+				continue;
+			if (! _is_modified_all)
+				exact_prefix_list.push_back(*iter2);
+			_modified_exact_prefix_list.erase(iter2);
+		}
+
+		pim_node().pim_mrt().add_task_mrib_changed(modified_prefix_addr,
+				exact_prefix_list);
 	}
+	_modified_exact_prefix_list.clear();
+	_is_modified_all = false;
 
 	//
 	// XXX: Add a task to delete all removed Mrib entries after they are
@@ -195,6 +220,8 @@ PimMribTable::apply_mrib_changes()
 	void
 PimMribTable::add_modified_prefix(const IPvXNet& modified_prefix)
 {
+	_modified_exact_prefix_list.push_back(modified_prefix);
+
 	//
 	// Search the list for overlapping address prefixes.
 	//
@@ -268,6 +295,7 @@ PimMribTable::resolve_prefixes_by_vif_name(const string& next_hop_vif_name,
 		MribTable::update_entry_vif_index(iter2->first,
 				next_hop_vif_index);
 		_modified_prefix_list.push_back(iter2->first);
+		_modified_exact_prefix_list.push_back(iter2->first);
 		_unresolved_prefixes.erase(iter2);
 	}
 
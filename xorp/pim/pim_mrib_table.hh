@@ -198,6 +198,15 @@ class PimMribTable : public MribTable
 		// to be applied to the PimMrt.
 		list<IPvXNet> _modified_prefix_list;
 
+		// The modified prefixes as they were added or removed, before
+		// merging. They are used to find only the PimMrt entries that
+		// depend on the modified MRIB entries.
+		list<IPvXNet> _modified_exact_prefix_list;
+
+		// True if all MRIB entries were modified (e.g., the table
+		// was cleared), and all PimMrt entries should be re-evaluated.
+		bool	_is_modified_all;
+
 		// The map of unresolved prefixes whose next-hop vif name was not resolved
 		map<IPvXNet, string> _unresolved_prefixes;
 };
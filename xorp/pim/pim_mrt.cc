@@ -46,7 +46,10 @@
 	_pim_mrt_g(*this),
 	_pim_mrt_rp(*this),
 	_pim_mrt_mfc(*this),
-	_pim_mre_track_state(this)
+	_pim_mre_track_state(this),
+	_mrib_changed_events(0),
+	_mrib_changed_pim_mre(0),
+	_mrib_changed_pim_mre_last(0)
 {
 
 }
@@ -146,6 +149,9 @@ PimMrt::clear()
 	_pim_mrt_sg_rpt.clear();
 	_pim_mrt_g.clear();
 	_pim_mrt_rp.clear();
+
+	_pim_mre_by_mrib_s.clear();
+	_pim_mre_mrib_s_unresolved.clear();
 }
 
 //
@@ -503,3 +509,123 @@ PimMrt::remove_pim_mfc(PimMfc *pim_mfc)
 
 	return (ret_value);
 }
+
+//
+// Add an (S,G) or (S,G,rpt) entry to the index by the prefix of its
+// mrib_s() entry. The indexed prefix is saved in the entry itself, because
+// the Mrib entry may be deleted before the PimMre entry is re-indexed.
+//
+	void
+PimMrt::add_pim_mre_mrib_s(PimMre *pim_mre)
+{
+	if (! (pim_mre->is_sg() || pim_mre->is_sg_rpt()))
+		return;
+
+	XLOG_ASSERT(pim_mre->mrib_s_prefix_len() == PimMre::MRIB_S_NOT_INDEXED);
+
+	pair<IPvX, PimMre *> key(pim_mre->source_addr(), pim_mre);
+	Mrib *mrib = pim_mre->mrib_s();
+
+	if (mrib == NULL) 
+	{
+		_pim_mre_mrib_s_unresolved.insert(key);
+		pim_mre->set_mrib_s_prefix_len(PimMre::MRIB_S_UNRESOLVED);
+		return;
+	}
+
+	int prefix_len = mrib->dest_prefix().prefix_len();
+	_pim_mre_by_mrib_s[IPvXNet(pim_mre->source_addr(), prefix_len)].insert(key);
+	pim_mre->set_mrib_s_prefix_len(prefix_len);
+}
+
+//
+// Remove an (S,G) or (S,G,rpt) entry from the index by the prefix of its
+// mrib_s() entry. It is safe to call it for an entry that is not indexed.
+//
+	void
+PimMrt::delete_pim_mre_mrib_s(PimMre *pim_mre)
+{
+	int prefix_len = pim_mre->mrib_s_prefix_len();
+
+	if (prefix_len == PimMre::MRIB_S_NOT_INDEXED)
+		return;
+
+	pair<IPvX, PimMre *> key(pim_mre->source_addr(), pim_mre);
+	pim_mre->set_mrib_s_prefix_len(PimMre::MRIB_S_NOT_INDEXED);
+
+	if (prefix_len == PimMre::MRIB_S_UNRESOLVED) 
+	{
+		_pim_mre_mrib_s_unresolved.erase(key);
+		return;
+	}
+
+	map<IPvXNet, PimMreBySource>::iterator iter;
+	iter = _pim_mre_by_mrib_s.find(IPvXNet(pim_mre->source_addr(),
+				prefix_len));
+	if (iter == _pim_mre_by_mrib_s.end())
+		return;
+	iter->second.erase(key);
+	if (iter->second.empty())
+		_pim_mre_by_mrib_s.erase(iter);
+}
+
+//
+// Find the (S,G) and (S,G,rpt) entries whose mrib_s() may change because
+// the MRIB entry for @modified_prefix was added, deleted or modified.
+// Those are the entries with a source address inside @modified_prefix that
+// resolved through the same or a less specific prefix, or did not resolve.
+// Entries that resolved through a more specific prefix are not affected.
+//
+	void
+PimMrt::find_pim_mre_mrib_s(const IPvXNet& modified_prefix,
+		set<PimMre *>& pim_mre_set)
+{
+	IPvX lo = modified_prefix.masked_addr();
+	IPvX hi = modified_prefix.top_addr();
+	PimMreBySource::const_iterator iter, iter_end;
+
+	for (int prefix_len = modified_prefix.prefix_len(); ; prefix_len--) 
+	{
+		const PimMreBySource *pim_mre_by_source = &_pim_mre_mrib_s_unresolved;
+
+		if (prefix_len >= 0) 
+		{
+			map<IPvXNet, PimMreBySource>::const_iterator map_iter;
+			map_iter = _pim_mre_by_mrib_s.find(IPvXNet(lo, prefix_len));
+			if (map_iter == _pim_mre_by_mrib_s.end())
+				continue;
+			pim_mre_by_source = &map_iter->second;
+		}
+
+		iter = pim_mre_by_source->lower_bound(make_pair(lo,
+					static_cast<PimMre *>(NULL)));
+		iter_end = pim_mre_by_source->end();
+		for ( ; iter != iter_end; ++iter) 
+		{
+			if (hi < iter->first)
+				break;
+			pim_mre_set.insert(iter->second);
+		}
+
+		if (prefix_len < 0)
+			break;
+	}
+}
+
+	void
+PimMrt::record_mrib_changed(const IPvXNet& modified_prefix, size_t pim_mre_n)
+{
+	_mrib_changed_events++;
+	_mrib_changed_pim_mre += pim_mre_n;
+	_mrib_changed_pim_mre_last = pim_mre_n;
+
+	UNUSED(modified_prefix);
+
+	XLOG_TRACE(pim_node()->is_log_trace(),
+			"MRIB change for %s: re-evaluated %u (S,G) and (S,G,rpt) "
+			"entries (%u in total after %u changes)",
+			cstring(modified_prefix),
+			XORP_UINT_CAST(pim_mre_n),
+			XORP_UINT_CAST(_mrib_changed_pim_mre),
+			XORP_UINT_CAST(_mrib_changed_events));
+}
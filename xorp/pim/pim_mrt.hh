@@ -195,7 +195,8 @@ class PimMrt : public BugCatcher
 		// The "add_task_*" methods
 		//
 		void add_task_rp_changed(const IPvX& affected_rp_addr);
-		void add_task_mrib_changed(const IPvXNet& modified_prefix_addr);
+		void add_task_mrib_changed(const IPvXNet& modified_prefix_addr,
+				const list<IPvXNet>& exact_prefix_list);
 		void add_task_delete_mrib_entries(const list<Mrib *>& mrib_list);
 		void add_task_nbr_mrib_next_hop_changed(const IPvXNet& modified_prefix_addr);
 		void add_task_nbr_mrib_next_hop_rp_gen_id_changed(const IPvX& rp_addr);
@@ -268,6 +269,28 @@ class PimMrt : public BugCatcher
 
 		list<PimMreTask *>& pim_mre_task_list() { return (_pim_mre_task_list); }
 
+		//
+		// The index of (S,G) and (S,G,rpt) entries by the MRIB prefix
+		// toward the source address (i.e., the prefix of mrib_s()).
+		//
+		void	add_pim_mre_mrib_s(PimMre *pim_mre);
+		void	delete_pim_mre_mrib_s(PimMre *pim_mre);
+		void	find_pim_mre_mrib_s(const IPvXNet& modified_prefix,
+				set<PimMre *>& pim_mre_set);
+
+		//
+		// Statistics about the entries re-evaluated because of
+		// MRIB changes.
+		//
+		void	record_mrib_changed(const IPvXNet& modified_prefix,
+				size_t pim_mre_n);
+		size_t	mrib_changed_events() const { return (_mrib_changed_events); }
+		size_t	mrib_changed_pim_mre() const { return (_mrib_changed_pim_mre); }
+		size_t	mrib_changed_pim_mre_last() const 
+		{
+			return (_mrib_changed_pim_mre_last);
+		}
+
 
 	private:
 		void pim_mre_task_timer_timeout();
@@ -291,6 +314,19 @@ class PimMrt : public BugCatcher
 
 		// Timer to schedule the processing for the next task or time slice.
 		XorpTimer	_pim_mre_task_timer;
+
+		//
+		// The (S,G) and (S,G,rpt) entries indexed by the MRIB prefix
+		// toward the source, and the entries without such MRIB entry.
+		// Within a prefix the entries are ordered by source address.
+		//
+		typedef set<pair<IPvX, PimMre *> > PimMreBySource;
+		map<IPvXNet, PimMreBySource> _pim_mre_by_mrib_s;
+		PimMreBySource	_pim_mre_mrib_s_unresolved;
+
+		size_t	_mrib_changed_events;	// Number of MRIB changes
+		size_t	_mrib_changed_pim_mre;	// Entries re-evaluated in total
+		size_t	_mrib_changed_pim_mre_last; // Entries re-evaluated last time
 };
 
 
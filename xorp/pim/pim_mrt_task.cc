@@ -133,7 +133,8 @@ PimMrt::add_task_rp_changed(const IPvX& affected_rp_addr)
 }
 
 	void
-PimMrt::add_task_mrib_changed(const IPvXNet& modified_prefix_addr)
+PimMrt::add_task_mrib_changed(const IPvXNet& modified_prefix_addr,
+		const list<IPvXNet>& exact_prefix_list)
 {
 	PimMreTask *pim_mre_task;
 
@@ -155,6 +156,7 @@ PimMrt::add_task_mrib_changed(const IPvXNet& modified_prefix_addr)
 			= new PimMreTask(this,
 					PimMreTrackState::INPUT_STATE_MRIB_S_CHANGED);
 		pim_mre_task->set_source_addr_prefix_sg_sg_rpt(modified_prefix_addr);
+		pim_mre_task->set_mrib_modified_prefix_list(exact_prefix_list);
 
 		add_task(pim_mre_task);
 	} while (false);
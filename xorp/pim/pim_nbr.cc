@@ -70,6 +70,7 @@
 	_primary_addr(primary_addr),
 	_proto_version(proto_version),
 	_jp_header(pim_vif->pim_node()),
+	_jp_periodic(*this),
 	_startup_time(TimeVal::MAXIMUM())
 {
 	reset_received_options();
@@ -323,6 +324,10 @@ PimNbr::delete_pim_mre(PimMre *pim_mre)
 {
 	list<PimMre *>::iterator pim_mre_iter;
 
+	// The entry doesn't send periodic Join(S,G) to this neighbor anymore
+	if (pim_mre->is_sg())
+		_jp_periodic.delete_sg(pim_mre);
+
 	do 
 	{
 		if (pim_mre->is_rp()) 
@@ -124,6 +124,8 @@ class PimNbr
 				action_jp_t action_jp, uint16_t holdtime,
 				bool is_new_group);
 
+		PimJpPeriodic& jp_periodic()	{ return (_jp_periodic); }
+
 		const XorpTimer& const_neighbor_liveness_timer() const 
 		{
 			return (_neighbor_liveness_timer);
@@ -188,6 +190,8 @@ class PimNbr
 
 		PimJpHeader _jp_header;
 
+		PimJpPeriodic _jp_periodic;		// The periodic Join(S,G) entries
+
 		TimeVal	_startup_time;		// Start-up time of this neighbor
 
 		//
@@ -34,6 +34,7 @@
 #include "libxorp/utils.hh"
 
 #include "pim_mre.hh"
+#include "pim_nbr.hh"
 #include "pim_node.hh"
 #include "pim_proto.h"
 #include "pim_proto_join_prune_message.hh"
@@ -1358,6 +1359,290 @@ invalid_addr_family_error:
 	XLOG_ERROR("%s", error_msg.c_str());
 	return (XORP_ERROR);
 
+buflen_error:
+	XLOG_UNREACHABLE();
+	error_msg = c_format("INTERNAL %s ERROR: "
+			"packet cannot fit into sending buffer",
+			PIMTYPE2ASCII(PIM_JOIN_PRUNE));
+	XLOG_ERROR("%s", error_msg.c_str());
+
+	return (XORP_ERROR);
+}
+
+	PimJpPeriodic::PimJpPeriodic(PimNbr& pim_nbr)
+: _pim_nbr(pim_nbr),
+	_sources_n(0),
+	_last_messages_n(0),
+	_last_entries_n(0),
+	_messages_n(0),
+	_entries_n(0)
+{
+}
+
+PimJpPeriodic::~PimJpPeriodic()
+{
+}
+
+	int
+PimJpPeriodic::family() const
+{
+	return (_pim_nbr.pim_node()->family());
+}
+
+	void
+PimJpPeriodic::add_sg(PimMre *pim_mre)
+{
+	PimJpPeriodicSources& sources = _groups[pim_mre->group_addr()];
+
+	if (sources.insert(make_pair(pim_mre->source_addr(), pim_mre)).second)
+		_sources_n++;
+
+	schedule_periodic_timer();
+}
+
+// Return true if @pim_mre was found and deleted
+	bool
+PimJpPeriodic::delete_sg(PimMre *pim_mre)
+{
+	PimJpPeriodicGroups::iterator group_iter;
+	PimJpPeriodicSources::iterator source_iter;
+
+	group_iter = _groups.find(pim_mre->group_addr());
+	if (group_iter == _groups.end())
+		return (false);
+	source_iter = group_iter->second.find(pim_mre->source_addr());
+	if ((source_iter == group_iter->second.end())
+			|| (source_iter->second != pim_mre))
+		return (false);
+
+	group_iter->second.erase(source_iter);
+	_sources_n--;
+	if (group_iter->second.empty())
+		_groups.erase(group_iter);
+
+	if (_groups.empty())
+		_periodic_timer.unschedule();
+
+	return (true);
+}
+
+	bool
+PimJpPeriodic::is_member_sg(const PimMre *pim_mre) const
+{
+	PimJpPeriodicGroups::const_iterator group_iter;
+	PimJpPeriodicSources::const_iterator source_iter;
+
+	group_iter = _groups.find(pim_mre->group_addr());
+	if (group_iter == _groups.end())
+		return (false);
+	source_iter = group_iter->second.find(pim_mre->source_addr());
+	if (source_iter == group_iter->second.end())
+		return (false);
+
+	return (source_iter->second == pim_mre);
+}
+
+	void
+PimJpPeriodic::time_remaining(TimeVal& tv_left) const
+{
+	_periodic_timer.time_remaining(tv_left);
+}
+
+	void
+PimJpPeriodic::schedule_periodic_timer()
+{
+	if (_periodic_timer.scheduled() || _groups.empty())
+		return;
+
+	_periodic_timer = EventLoop::instance().new_oneoff_after(
+			TimeVal(_pim_nbr.pim_vif()->join_prune_period().get(), 0),
+			callback(this, &PimJpPeriodic::periodic_timer_timeout));
+}
+
+	void
+PimJpPeriodic::periodic_timer_timeout()
+{
+	string dummy_error_msg;
+
+	remove_invalid_entries();
+
+	_last_messages_n = 0;
+	_last_entries_n = 0;
+	if (! _groups.empty())
+		network_send(dummy_error_msg);
+	_messages_n += _last_messages_n;
+	_entries_n += _last_entries_n;
+
+	XLOG_TRACE(_pim_nbr.pim_node()->is_log_trace(),
+			"TX periodic %s to %s on vif %s: "
+			"%u messages with %u (S,G) entries",
+			PIMTYPE2ASCII(PIM_JOIN_PRUNE),
+			cstring(_pim_nbr.primary_addr()),
+			_pim_nbr.pim_vif()->name().c_str(),
+			XORP_UINT_CAST(_last_messages_n),
+			XORP_UINT_CAST(_last_entries_n));
+
+	schedule_periodic_timer();
+}
+
+//
+// Remove the entries that don't send periodic Join(S,G) to the neighbor
+// anymore: they are not in Joined state, or their RPF'(S,G) has changed,
+// or their Join Timer was restarted and it will send the next Join(S,G).
+//
+	void
+PimJpPeriodic::remove_invalid_entries()
+{
+	PimJpPeriodicGroups::iterator group_iter;
+
+	for (group_iter = _groups.begin(); group_iter != _groups.end(); ) 
+	{
+		PimJpPeriodicGroups::iterator group_iter2 = group_iter;
+		++group_iter;
+		PimJpPeriodicSources& sources = group_iter2->second;
+		PimJpPeriodicSources::iterator source_iter;
+
+		for (source_iter = sources.begin(); source_iter != sources.end(); ) 
+		{
+			PimJpPeriodicSources::iterator source_iter2 = source_iter;
+			++source_iter;
+			PimMre *pim_mre = source_iter2->second;
+
+			if (pim_mre->is_joined_state()
+					&& (pim_mre->rpfp_nbr_sg() == &_pim_nbr)
+					&& (! pim_mre->const_join_timer().scheduled()))
+				continue;
+			sources.erase(source_iter2);
+			_sources_n--;
+		}
+		if (sources.empty())
+			_groups.erase(group_iter2);
+	}
+}
+
+//
+// Send Join(S,G) for all entries in as few messages as possible.
+// A group whose sources don't fit in one message is continued in
+// the next message.
+//
+	int
+PimJpPeriodic::network_send(string& error_msg)
+{
+	PimVif *pim_vif = _pim_nbr.pim_vif();
+	const size_t max_packet_size = PIM_MAXPACKET(family());
+	const size_t header_size = sizeof(struct pim)
+		+ ENCODED_UNICAST_ADDR_SIZE(family())
+		+ 2 * sizeof(uint8_t) + sizeof(uint16_t);
+	const size_t group_size = ENCODED_GROUP_ADDR_SIZE(family())
+		+ 2 * sizeof(uint16_t);
+	const size_t source_size = ENCODED_SOURCE_ADDR_SIZE(family());
+	const uint8_t addr_bitlen = IPvX::addr_bitlen(family());
+	uint8_t sparse_bit = _pim_nbr.pim_node()->proto_is_pimsm() ? ESADDR_S_BIT : 0;
+	uint16_t holdtime = pim_vif->join_prune_holdtime().get();
+	PimJpPeriodicGroups::const_iterator group_iter = _groups.begin();
+	PimJpPeriodicSources::const_iterator source_iter;
+	size_t source_offset = 0;	// Number of sources already sent
+	vector<size_t> sources_n_list;
+	buffer_t *buffer = NULL;
+
+	if (group_iter == _groups.end())
+		return (XORP_OK);
+	source_iter = group_iter->second.begin();
+
+	while (group_iter != _groups.end()) 
+	{
+		//
+		// Compute how many groups and sources fit in the next message
+		//
+		PimJpPeriodicGroups::const_iterator iter = group_iter;
+		size_t offset = source_offset;
+		size_t message_size = header_size;
+
+		sources_n_list.clear();
+		while ((iter != _groups.end()) && (sources_n_list.size() < 0xff)) 
+		{
+			if (message_size + group_size + source_size > max_packet_size)
+				break;
+			size_t left = iter->second.size() - offset;
+			size_t n = (max_packet_size - message_size - group_size)
+				/ source_size;
+			if (n > 0xffff)
+				n = 0xffff;
+			if (n > left)
+				n = left;
+			sources_n_list.push_back(n);
+			message_size += group_size + n * source_size;
+			if (n < left)
+				break;		// The group continues in the next message
+			++iter;
+			offset = 0;
+		}
+		XLOG_ASSERT(! sources_n_list.empty());
+
+		//
+		// Prepare the message
+		//
+		buffer = pim_vif->buffer_send_prepare();
+		PUT_ENCODED_UNICAST_ADDR(family(), _pim_nbr.primary_addr(), buffer);
+		BUFFER_PUT_OCTET(0, buffer);		// Reserved
+		BUFFER_PUT_OCTET(sources_n_list.size(), buffer); // Number of groups
+		BUFFER_PUT_HOST_16(holdtime, buffer);	// Holdtime
+
+		for (size_t i = 0; i < sources_n_list.size(); i++) 
+		{
+			uint8_t group_addr_reserved_flags = 0;
+			size_t n = sources_n_list[i];
+
+			PUT_ENCODED_GROUP_ADDR(family(), group_iter->first, addr_bitlen,
+					group_addr_reserved_flags, buffer);
+			// The number of joined sources
+			BUFFER_PUT_HOST_16(n, buffer);
+			// The number of pruned sources
+			BUFFER_PUT_HOST_16(0, buffer);
+
+			// (S,G) Join
+			for (size_t j = 0; j < n; j++) 
+			{
+				PUT_ENCODED_SOURCE_ADDR(family(), source_iter->first,
+						addr_bitlen, sparse_bit, buffer);
+				++source_iter;
+				source_offset++;
+			}
+			_last_entries_n += n;
+
+			if (source_iter == group_iter->second.end()) 
+			{
+				++group_iter;
+				if (group_iter != _groups.end())
+					source_iter = group_iter->second.begin();
+				source_offset = 0;
+			}
+		}
+
+		//
+		// Send the message
+		//
+		if (pim_vif->pim_send(pim_vif->primary_addr(),
+					IPvX::PIM_ROUTERS(family()),
+					PIM_JOIN_PRUNE, buffer, error_msg)
+				!= XORP_OK) 
+		{
+			return (XORP_ERROR);
+		}
+		_last_messages_n++;
+	}
+
+	return (XORP_OK);
+
+invalid_addr_family_error:
+	XLOG_UNREACHABLE();
+	error_msg = c_format("INTERNAL %s ERROR: "
+			"invalid address family error = %d",
+			PIMTYPE2ASCII(PIM_JOIN_PRUNE),
+			family());
+	XLOG_ERROR("%s", error_msg.c_str());
+	return (XORP_ERROR);
+
 buflen_error:
 	XLOG_UNREACHABLE();
 	error_msg = c_format("INTERNAL %s ERROR: "
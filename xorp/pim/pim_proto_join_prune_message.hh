@@ -226,6 +226,65 @@ class PimJpGroup
 		PimJpSources _sg_rpt;		// The (S,G,rpt) Join/Prune entries
 };
 
+//
+// Class to keep the (S,G) entries that are periodically joined toward
+// a neighbor, and to send their periodic Join(S,G) messages.
+//
+// XXX: the entries are added and removed as they start and stop sending
+// periodic Join(S,G) messages to the neighbor, hence the source lists
+// for each group and the size of their encoding are maintained
+// incrementally. A single timer per neighbor sends all entries in
+// fully packed messages, instead of a Join Timer per entry.
+// An entry whose Join Timer was restarted (e.g., by the Join suppression
+// or the Prune override rules) is removed from this set, and it is
+// added back after its Join Timer expires.
+//
+class PimJpPeriodic 
+{
+	public:
+		PimJpPeriodic(PimNbr& pim_nbr);
+		~PimJpPeriodic();
+
+		PimNbr&	pim_nbr() const		{ return (_pim_nbr); }
+		int		family() const;
+
+		void	add_sg(PimMre *pim_mre);
+		bool	delete_sg(PimMre *pim_mre);
+		bool	is_member_sg(const PimMre *pim_mre) const;
+
+		/**
+		 * Get the time until the next periodic Join/Prune message(s).
+		 *
+		 * @param tv_left the time until the next message(s), or zero
+		 * if nothing is scheduled.
+		 */
+		void	time_remaining(TimeVal& tv_left) const;
+
+		size_t	sources_n() const	{ return (_sources_n);		}
+		uint32_t	last_messages_n() const	{ return (_last_messages_n); }
+		uint32_t	last_entries_n() const	{ return (_last_entries_n);	}
+		uint32_t	messages_n() const	{ return (_messages_n);		}
+		uint32_t	entries_n() const	{ return (_entries_n);		}
+
+	private:
+		typedef map<IPvX, PimMre *> PimJpPeriodicSources;
+		typedef map<IPvX, PimJpPeriodicSources> PimJpPeriodicGroups;
+
+		void	schedule_periodic_timer();
+		void	periodic_timer_timeout();
+		void	remove_invalid_entries();
+		int		network_send(string& error_msg);
+
+		PimNbr&	_pim_nbr;		// The neighbor to send the Joins to
+		PimJpPeriodicGroups _groups;	// The (S,G) entries by group
+		size_t	_sources_n;		// Total number of sources
+		XorpTimer	_periodic_timer;	// Timer to send the periodic Joins
+		uint32_t	_last_messages_n;	// Messages sent last period
+		uint32_t	_last_entries_n;	// Entries sent last period
+		uint32_t	_messages_n;		// Messages sent in total
+		uint32_t	_entries_n;		// Entries sent in total
+};
+
 //
 // Global variables
 //
@@ -137,8 +137,10 @@ inline
     MemoryPool<IPRouteEntry<A> >&
 IPRouteEntry<A>::memory_pool()
 {
-    static MemoryPool<IPRouteEntry<A> > mp;
-    return mp;
+    // Never destroyed, routes may still be referenced during shutdown.
+    static MemoryPool<IPRouteEntry<A> >* mp
+	= new MemoryPool<IPRouteEntry<A> >("IPRouteEntry");
+    return *mp;
 }
 
 template<class A>
@@ -160,8 +162,10 @@ inline
     MemoryPool<ResolvedIPRouteEntry<A> >&
 ResolvedIPRouteEntry<A>::memory_pool()
 {
-    static MemoryPool<ResolvedIPRouteEntry<A> > mp;
-    return mp;
+    // Never destroyed, routes may still be referenced during shutdown.
+    static MemoryPool<ResolvedIPRouteEntry<A> >* mp
+	= new MemoryPool<ResolvedIPRouteEntry<A> >("ResolvedIPRouteEntry");
+    return *mp;
 }
 
 template<class A>
@@ -183,8 +187,10 @@ inline
     MemoryPool<UnresolvedIPRouteEntry<A> >&
 UnresolvedIPRouteEntry<A>::memory_pool()
 {
-    static MemoryPool<UnresolvedIPRouteEntry<A> > mp;
-    return mp;
+    // Never destroyed, routes may still be referenced during shutdown.
+    static MemoryPool<UnresolvedIPRouteEntry<A> >* mp
+	= new MemoryPool<UnresolvedIPRouteEntry<A> >("UnresolvedIPRouteEntry");
+    return *mp;
 }
 
     template<class A>
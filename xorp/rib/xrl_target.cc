@@ -617,6 +617,190 @@ XrlRibTarget::rib_0_1_replace_interface_route4(const string&	    protocol,
     return XrlCmdError::OKAY();
 }
 
+static void
+get_atom_value(const XrlAtom& atom, IPv4Net& v)	{ v = atom.ipv4net(); }
+static void
+get_atom_value(const XrlAtom& atom, IPv4& v)	{ v = atom.ipv4(); }
+static void
+get_atom_value(const XrlAtom& atom, IPv6Net& v)	{ v = atom.ipv6net(); }
+static void
+get_atom_value(const XrlAtom& atom, IPv6& v)	{ v = atom.ipv6(); }
+
+/**
+ * Apply one change of a route batch to a RIB.
+ *
+ * @return XORP_OK on success, otherwise XORP_ERROR.
+ */
+template <class A>
+static int
+apply_route_change(RIB<A>& rib, const string& op, const string& protocol,
+		   const IPNet<A>& network, const A& nexthop,
+		   const string& ifname, const string& vifname,
+		   uint32_t metric, const XrlAtomList& policytags)
+{
+    if (op == "add")
+	return rib.add_route(protocol, network, nexthop, ifname, vifname,
+			     metric, policytags);
+    if (op == "replace")
+	return rib.replace_route(protocol, network, nexthop, ifname, vifname,
+				 metric, policytags);
+    if (op == "delete")
+	return rib.delete_route(protocol, network);
+
+    return XORP_ERROR;
+}
+
+/**
+ * Apply a batch of route changes to the unicast and/or multicast RIB.
+ *
+ * The lists are walked with iterators, because retrieving each atom
+ * by its index takes time proportional to the index. A route that
+ * can't be changed doesn't stop the rest of the batch.
+ */
+template <class A>
+static XrlCmdError
+apply_route_batch(RibManager* rib_manager, RIB<A>& urib, RIB<A>& mrib,
+		  const string& protocol, bool unicast, bool multicast,
+		  const XrlAtomList& op,
+		  const XrlAtomList& network,
+		  const XrlAtomList& nexthop,
+		  const XrlAtomList& ifname,
+		  const XrlAtomList& vifname,
+		  const XrlAtomList& metric,
+		  const XrlAtomList& policytag_count,
+		  const XrlAtomList& policytags)
+{
+    size_t routes_n = op.size();
+    size_t failed_n = 0;
+    string error_msg;
+
+    UNUSED(rib_manager);
+
+    if ((network.size() != routes_n)
+	|| (nexthop.size() != routes_n)
+	|| (ifname.size() != routes_n)
+	|| (vifname.size() != routes_n)
+	|| (metric.size() != routes_n)
+	|| (policytag_count.size() != routes_n)) 
+    {
+	return XrlCmdError::BAD_ARGS("Route batch lists have different sizes");
+    }
+
+    try 
+    {
+	size_t policytags_n = 0;
+	XrlAtomList::const_iterator count_iter;
+	for (count_iter = policytag_count.begin();
+	     count_iter != policytag_count.end();
+	     ++count_iter) 
+	{
+	    policytags_n += count_iter->uint32();
+	}
+	if (policytags_n != policytags.size())
+	    return XrlCmdError::BAD_ARGS("Route batch has the wrong number "
+					 "of policy tags");
+
+	XrlAtomList::const_iterator op_iter = op.begin();
+	XrlAtomList::const_iterator network_iter = network.begin();
+	XrlAtomList::const_iterator nexthop_iter = nexthop.begin();
+	XrlAtomList::const_iterator ifname_iter = ifname.begin();
+	XrlAtomList::const_iterator vifname_iter = vifname.begin();
+	XrlAtomList::const_iterator metric_iter = metric.begin();
+	XrlAtomList::const_iterator policytags_iter = policytags.begin();
+	count_iter = policytag_count.begin();
+
+	for (size_t i = 0; i < routes_n; i++) 
+	{
+	    const string& route_op = (op_iter++)->text();
+	    IPNet<A> route_network;
+	    A route_nexthop;
+	    get_atom_value(*network_iter++, route_network);
+	    get_atom_value(*nexthop_iter++, route_nexthop);
+	    const string& route_ifname = (ifname_iter++)->text();
+	    const string& route_vifname = (vifname_iter++)->text();
+	    uint32_t route_metric = (metric_iter++)->uint32();
+
+	    XrlAtomList route_policytags;
+	    for (uint32_t n = (count_iter++)->uint32(); n > 0; n--)
+		route_policytags.append(*policytags_iter++);
+
+#ifndef XORP_DISABLE_PROFILE
+	    if (rib_manager->profile().enabled(profile_route_ribin)) 
+	    {
+		rib_manager->profile().log(profile_route_ribin,
+			c_format("%s %s %s%s %s %s %s/%s %u",
+			    route_op.c_str(),
+			    protocol.c_str(),
+			    unicast ? "u" : "",
+			    multicast ? "m" : "",
+			    route_network.str().c_str(),
+			    route_nexthop.str().c_str(),
+			    route_ifname.c_str(),
+			    route_vifname.c_str(),
+			    XORP_UINT_CAST(route_metric)));
+	    }
+#endif
+
+	    if ((unicast
+		 && apply_route_change(urib, route_op, protocol, route_network,
+				       route_nexthop, route_ifname,
+				       route_vifname, route_metric,
+				       route_policytags) != XORP_OK)
+		|| (multicast
+		    && apply_route_change(mrib, route_op, protocol,
+					  route_network, route_nexthop,
+					  route_ifname, route_vifname,
+					  route_metric, route_policytags)
+		    != XORP_OK)) 
+	    {
+		// Report the first failure, with the number that failed
+		if (failed_n++ == 0)
+		    error_msg = c_format("Could not %s route %s",
+					 route_op.c_str(),
+					 route_network.str().c_str());
+	    }
+	}
+    } catch (const XorpException& e) 
+    {
+	return XrlCmdError::BAD_ARGS(c_format("Invalid route batch: %s",
+					      e.str().c_str()));
+    }
+
+    if (failed_n > 0)
+	return XrlCmdError::COMMAND_FAILED(c_format("%s (%u of %u routes "
+						    "failed)",
+						    error_msg.c_str(),
+						    XORP_UINT_CAST(failed_n),
+						    XORP_UINT_CAST(routes_n)));
+
+    return XrlCmdError::OKAY();
+}
+
+    XrlCmdError
+XrlRibTarget::rib_0_1_apply_route_batch4(const string&	    protocol,
+	const bool&	    unicast,
+	const bool&	    multicast,
+	const XrlAtomList&  op,
+	const XrlAtomList&  network,
+	const XrlAtomList&  nexthop,
+	const XrlAtomList&  ifname,
+	const XrlAtomList&  vifname,
+	const XrlAtomList&  metric,
+	const XrlAtomList&  policytag_count,
+	const XrlAtomList&  policytags)
+{
+    debug_msg("apply_route_batch4 protocol: %s unicast: %s multicast: %s "
+	    "routes %u\n",
+	    protocol.c_str(),
+	    bool_c_str(unicast),
+	    bool_c_str(multicast),
+	    XORP_UINT_CAST(op.size()));
+
+    return apply_route_batch(_rib_manager, _urib4, _mrib4, protocol,
+	    unicast, multicast, op, network, nexthop, ifname, vifname,
+	    metric, policytag_count, policytags);
+}
+
 XrlCmdError
 XrlRibTarget::rib_0_1_lookup_route_by_dest4(
 	// Input values,
@@ -1603,6 +1787,31 @@ XrlRibTarget::rib_0_1_replace_interface_route6(const string&	    protocol,
     return XrlCmdError::OKAY();
 }
 
+    XrlCmdError
+XrlRibTarget::rib_0_1_apply_route_batch6(const string&	    protocol,
+	const bool&	    unicast,
+	const bool&	    multicast,
+	const XrlAtomList&  op,
+	const XrlAtomList&  network,
+	const XrlAtomList&  nexthop,
+	const XrlAtomList&  ifname,
+	const XrlAtomList&  vifname,
+	const XrlAtomList&  metric,
+	const XrlAtomList&  policytag_count,
+	const XrlAtomList&  policytags)
+{
+    debug_msg("apply_route_batch6 protocol: %s unicast: %s multicast: %s "
+	    "routes %u\n",
+	    protocol.c_str(),
+	    bool_c_str(unicast),
+	    bool_c_str(multicast),
+	    XORP_UINT_CAST(op.size()));
+
+    return apply_route_batch(_rib_manager, _urib6, _mrib6, protocol,
+	    unicast, multicast, op, network, nexthop, ifname, vifname,
+	    metric, policytag_count, policytags);
+}
+
 XrlCmdError
 XrlRibTarget::rib_0_1_lookup_route_by_dest6(
 	// Input values,
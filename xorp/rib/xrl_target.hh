@@ -332,6 +332,45 @@ class XrlRibTarget : public XrlRibTargetBase
 		const uint32_t&	    metric,
 		const XrlAtomList&  policytags);
 
+	/**
+	 *  Add, replace or delete a batch of routes, in order.
+	 *
+	 *  @param protocol the name of the protocol the routes come from.
+	 *
+	 *  @param unicast true if the routes are for the unicast RIB.
+	 *
+	 *  @param multicast true if the routes are for the multicast RIB.
+	 *
+	 *  @param op the change to each route: "add", "replace" or "delete".
+	 *
+	 *  @param network the network address prefixes of the routes.
+	 *
+	 *  @param nexthop the addresses of the next-hop routers.
+	 *
+	 *  @param ifname the names of the physical interfaces.
+	 *
+	 *  @param vifname the names of the virtual interfaces.
+	 *
+	 *  @param metric the routing metrics.
+	 *
+	 *  @param policytag_count the number of policy tags of each route.
+	 *
+	 *  @param policytags the policy tags of the routes.
+	 */
+	XrlCmdError rib_0_1_apply_route_batch4(
+		// Input values,
+		const string&	    protocol,
+		const bool&	    unicast,
+		const bool&	    multicast,
+		const XrlAtomList&  op,
+		const XrlAtomList&  network,
+		const XrlAtomList&  nexthop,
+		const XrlAtomList&  ifname,
+		const XrlAtomList&  vifname,
+		const XrlAtomList&  metric,
+		const XrlAtomList&  policytag_count,
+		const XrlAtomList&  policytags);
+
 	/**
 	 *  Lookup nexthop.
 	 *
@@ -747,6 +786,45 @@ class XrlRibTarget : public XrlRibTargetBase
 		const uint32_t&	    metric,
 		const XrlAtomList&  policytags);
 
+	/**
+	 *  Add, replace or delete a batch of routes, in order.
+	 *
+	 *  @param protocol the name of the protocol the routes come from.
+	 *
+	 *  @param unicast true if the routes are for the unicast RIB.
+	 *
+	 *  @param multicast true if the routes are for the multicast RIB.
+	 *
+	 *  @param op the change to each route: "add", "replace" or "delete".
+	 *
+	 *  @param network the network address prefixes of the routes.
+	 *
+	 *  @param nexthop the addresses of the next-hop routers.
+	 *
+	 *  @param ifname the names of the physical interfaces.
+	 *
+	 *  @param vifname the names of the virtual interfaces.
+	 *
+	 *  @param metric the routing metrics.
+	 *
+	 *  @param policytag_count the number of policy tags of each route.
+	 *
+	 *  @param policytags the policy tags of the routes.
+	 */
+	XrlCmdError rib_0_1_apply_route_batch6(
+		// Input values,
+		const string&	    protocol,
+		const bool&	    unicast,
+		const bool&	    multicast,
+		const XrlAtomList&  op,
+		const XrlAtomList&  network,
+		const XrlAtomList&  nexthop,
+		const XrlAtomList&  ifname,
+		const XrlAtomList&  vifname,
+		const XrlAtomList&  metric,
+		const XrlAtomList&  policytag_count,
+		const XrlAtomList&  policytags);
+
 	/**
 	 *  Lookup nexthop.
 	 *
@@ -59,6 +59,11 @@ static const uint32_t MAXIMUM_INTERPACKET_DELAY_MS = 250;
  */
 static const uint32_t DEFAULT_INTERQUERY_GAP_MS = 250;
 
+/**
+ * The interval between the trace logs of the route timer statistics.
+ */
+static const uint32_t TIMER_STATS_INTERVAL_SECS = 60;
+
 /**
  * Protocol specified metric corresponding to an unreachable (or expired)
  * host or network.
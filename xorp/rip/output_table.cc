@@ -27,72 +27,273 @@
 #include "packet_queue.hh"
 #include "route_db.hh"
 
+template <typename A>
+OutputTable<A>::OutputTable(Port<A>&		port,
+			    PacketQueue<A>&	pkt_queue,
+			    RouteDB<A>&		rdb,
+			    const A&		ip_addr,
+			    uint16_t		ip_port,
+			    bool		keep_packets)
+    : OutputBase<A>(port, pkt_queue, ip_addr, ip_port),
+      _rdb(rdb), _rw(rdb), _uq(rdb.update_queue()), _next_packet(0),
+      _keep_packets(keep_packets),
+      _cache_valid(false), _removals(0), _horizon(NONE), _adv_def_rt(false),
+      _layout(0)
+{
+}
+
+template <typename A>
+OutputTable<A>::~OutputTable()
+{
+    stop_output_processing();
+    drop_cache();
+}
+
+template <>
+    uint32_t
+OutputTable<IPv4>::packet_layout() const
+{
+    const AuthHandlerBase* ah = this->_port.af_state().auth_handler();
+
+    return (ah->head_entries() << 16) | ah->max_routing_entries();
+}
+
+template <>
+    uint32_t
+OutputTable<IPv6>::packet_layout() const
+{
+    return this->_port.af_state().max_entries_per_packet();
+}
+
 template <typename A>
     void
-OutputTable<A>::output_packet()
+OutputTable<A>::clear_cache()
+{
+    for (size_t i = 0; i < _packets.size(); i++)
+	delete _packets[i].pkt;
+    _packets.clear();
+    _packet_of.clear();
+    _pending.clear();
+    _pending_nets.clear();
+}
+
+template <typename A>
+    void
+OutputTable<A>::drop_cache()
+{
+    // The reader holds on to the updates queued after it.
+    if (_uq.reader_valid(_uq_iter))
+	_uq.destroy_reader(_uq_iter);
+    clear_cache();
+    _cache_valid = false;
+}
+
+template <typename A>
+    void
+OutputTable<A>::push_pending(const Net& net)
+{
+    if (_pending_nets.insert(net).second)
+	_pending.push_back(net);
+}
+
+template <typename A>
+    typename OutputTable<A>::Net
+OutputTable<A>::pop_pending()
 {
-    if (_rw_valid == false) 
+    Net net = _pending.front();
+    _pending.pop_front();
+    _pending_nets.erase(net);
+    return net;
+}
+
+template <typename A>
+    void
+OutputTable<A>::rebuild_cache()
+{
+    clear_cache();
+
+    _rw.reset();
+    for (const RouteEntry<A>* r = _rw.current_route(); r != 0;
+	 r = _rw.next_route()) 
     {
-	_rw.reset();
-	_rw_valid = true;
+	push_pending(r->net());
     }
-    _rw.resume();
 
-    ResponsePacketAssembler<A> rpa(this->_port);
-    RipPacket<A>* pkt = new RipPacket<A>(this->ip_addr(), this->ip_port());
-    rpa.packet_start(pkt);
+    // Everything up to now is in the routes just queued.
+    if (_uq.reader_valid(_uq_iter) == false)
+	_uq_iter = _uq.create_reader();
+    _uq.ffwd(_uq_iter);
 
-    uint32_t done = 0;
-    const RouteEntry<A>* r = 0;
-    for (r = _rw.current_route(); r != 0; r = _rw.next_route()) 
+    _removals = _rdb.removals();
+    _horizon = this->_port.horizon();
+    _adv_def_rt = this->_port.advertise_default_route();
+    _layout = packet_layout();
+    _cache_valid = true;
+}
+
+template <typename A>
+    void
+OutputTable<A>::update_cache()
+{
+    if (_cache_valid == false
+	|| _uq.reader_valid(_uq_iter) == false
+	|| _removals != _rdb.removals()
+	|| _horizon != this->_port.horizon()
+	|| _adv_def_rt != this->_port.advertise_default_route()
+	|| _layout != packet_layout()) 
     {
+	rebuild_cache();
+	return;
+    }
 
-	//
-	// We may either "drop the packet..."
-	// or set cost to infinity...
-	// or depending on poison-reverse / horizon settings
-	//
-	if (r->filtered())
+    //
+    // A changed route is built again in the packet that holds it, a
+    // route that is not in a packet is added at the end.
+    //
+    for (const RouteEntry<A>* r = _uq.get(_uq_iter); r != 0;
+	 r = _uq.next(_uq_iter)) 
+    {
+	typename map<Net, size_t, NetCmp<A> >::const_iterator i
+	    = _packet_of.find(r->net());
+	if (i == _packet_of.end()) 
+	{
+	    push_pending(r->net());
 	    continue;
+	}
 
-	pair<A,uint16_t> p = this->_port.route_policy(*r);
+	CachedPacket& cp = _packets[i->second];
+	delete cp.pkt;
+	cp.pkt = 0;
+    }
+}
 
-	if (p.second > RIP_INFINITY)
-	    continue;
+template <typename A>
+    bool
+OutputTable<A>::add_route(ResponsePacketAssembler<A>& rpa, const Net& net)
+{
+    const RouteEntry<A>* r = _rdb.find_route(net);
+    if (r == 0)
+	return false;
+
+    //
+    // We may either "drop the packet..."
+    // or set cost to infinity...
+    // or depending on poison-reverse / horizon settings
+    //
+    if (r->filtered())
+	return false;
 
-	RouteEntryOrigin<A>* origin = NULL;	// XXX
-	string ifname, vifname;		// XXX: not set, because not needed
-	RouteEntry<A>* copy = new RouteEntry<A>(r->net(), p.first,
-		ifname, vifname,
-		p.second,
-		origin, r->tag(),
-		r->policytags());
+    pair<A,uint16_t> p = this->_port.route_policy(*r);
 
-	// Policy EXPORT filtering was done here.
-	// It's moved to RouteDB<A>::do_filtering.
-	// This was done because EXPORT filter could possibly change route metric,
-	// and thus make it lower then RIP_INFINITY.
-	// Routes with cost > RIP_INFINTY would never come here, because they would be filtered out in RouteDB<A>::update_route
-	// - IMAR
+    if (p.second > RIP_INFINITY)
+	return false;
 
-	rpa.packet_add_route(copy->net(), copy->nexthop(), copy->cost(), copy->tag());
+    // Policy EXPORT filtering was done here.
+    // It's moved to RouteDB<A>::do_filtering.
+    // This was done because EXPORT filter could possibly change route metric,
+    // and thus make it lower then RIP_INFINITY.
+    // Routes with cost > RIP_INFINTY would never come here, because they would be filtered out in RouteDB<A>::update_route
+    // - IMAR
+
+    return rpa.packet_add_route(net, p.first, p.second, r->tag());
+}
+
+template <typename A>
+    void
+OutputTable<A>::build_packet(size_t n, list<RipPacket<A>*>& auth_packets)
+{
+    CachedPacket& cp = _packets[n];
+    vector<Net> nets;
+    nets.swap(cp.nets);
 
-	// XXX: packet_add_route stores args
-	delete copy;
+    ResponsePacketAssembler<A> rpa(this->_port);
+    RipPacket<A>* pkt = new RipPacket<A>(this->ip_addr(), this->ip_port());
+    rpa.packet_start(pkt);
 
-	done++;
+    typename vector<Net>::const_iterator ni;
+    for (ni = nets.begin(); ni != nets.end(); ++ni) 
+    {
+	_packet_of.erase(*ni);
 	if (rpa.packet_full()) 
 	{
-	    _rw.next_route();
-	    break;
+	    push_pending(*ni);
+	    continue;
+	}
+	if (add_route(rpa, *ni)) 
+	{
+	    cp.nets.push_back(*ni);
+	    _packet_of[*ni] = n;
+	}
+    }
+
+    while (_pending.empty() == false && rpa.packet_full() == false) 
+    {
+	Net net = pop_pending();
+	if (add_route(rpa, net)) 
+	{
+	    cp.nets.push_back(net);
+	    _packet_of[net] = n;
 	}
     }
 
+    if (cp.nets.empty()) 
+    {
+	delete pkt;
+	return;
+    }
+
+    // Authentication may change the packet, keep it as it was before.
+    RipPacket<A>* cached = new RipPacket<A>(*pkt);
+    if (rpa.packet_finish(auth_packets) == false) 
+    {
+	// Error finishing packet off.
+	delete cached;
+	delete pkt;
+	return;
+    }
+    cached->set_max_entries(pkt->max_entries());
+    cp.pkt = cached;
+    delete pkt;
+}
+
+template <typename A>
+    void
+OutputTable<A>::output_packet()
+{
+    if (_next_packet == 0)
+	update_cache();
+
+    //
+    // Find the next packet with routes in it, building it if needed.
+    // Routes not yet in a packet fill the packets that are built.
+    //
     list<RipPacket<A>*> auth_packets;
-    if (done == 0 || rpa.packet_finish(auth_packets) == false) 
+    bool found = false;
+    while (found == false) 
     {
-	// No routes added to packet or error finishing packet off.
-    } else 
+	if (_next_packet == _packets.size()) 
+	{
+	    if (_pending.empty())
+		break;
+	    _packets.push_back(CachedPacket());
+	    _packets.back().pkt = 0;
+	}
+	size_t n = _next_packet++;
+	if (_packets[n].pkt == 0) 
+	{
+	    build_packet(n, auth_packets);
+	} else 
+	{
+	    ResponsePacketAssembler<A> rpa(this->_port);
+	    RipPacket<A>* pkt = new RipPacket<A>(*_packets[n].pkt);
+	    rpa.packet_resume(pkt);
+	    rpa.packet_finish(auth_packets);
+	    delete pkt;
+	}
+	found = (_packets[n].pkt != 0);
+    }
+
+    if (auth_packets.empty() == false) 
     {
 	typename list<RipPacket<A>*>::iterator iter;
 	for (iter = auth_packets.begin(); iter != auth_packets.end(); ++iter) 
@@ -110,20 +311,19 @@ OutputTable<A>::output_packet()
 	}
 	this->_port.push_packets();
     }
-    delete pkt;
 
-    if (r == 0) 
+    if (found == false) 
     {
-	// Reached null route so note route walker is now invalid.
-	_rw_valid = false;
+	// Sent the last packet, the next dump starts from the first.
+	_next_packet = 0;
+	if (_keep_packets == false)
+	    drop_cache();
     } else 
     {
-	// Not finished so set time to reschedule self and pause
-	// route walker.
+	// Not finished so set time to reschedule self.
 	this->_op_timer 
 	    = EventLoop::instance().new_oneoff_after_ms(this->interpacket_gap_ms(),
 		    callback(this, &OutputTable<A>::output_packet));
-	_rw.pause(this->interpacket_gap_ms());
     }
 }
 
@@ -131,6 +331,7 @@ template <typename A>
     void
 OutputTable<A>::start_output_processing()
 {
+    _next_packet = 0;
     output_packet();		// starts timer
 }
 
@@ -139,9 +340,11 @@ template <typename A>
 OutputTable<A>::stop_output_processing()
 {
     this->_op_timer.unschedule();	// stop timer
+    if (_keep_packets == false)
+	drop_cache();
 }
 
-
+
 // ----------------------------------------------------------------------------
 // Instantiations
 
@@ -27,6 +27,13 @@
 
 #include "output.hh"
 #include "route_db.hh"
+#include "update_queue.hh"
+
+template <typename A>
+class ResponsePacketAssembler;
+
+template <typename A>
+class RipPacket;
 
 /**
  * @short Route Table Output class.
@@ -34,6 +41,16 @@
  * The OutputTable class produces an asynchronous RIP table dump. It's
  * intended use is for solicited and unsolicited routing table.
  *
+ * The response packets are kept between dumps, encoded but not
+ * authenticated.  At the start of each dump the routes changed since
+ * the last one are read from the UpdateQueue and only the packets that
+ * hold them are built again, new routes fill the packets being built
+ * and then new packets at the end.  Unchanged packets are only
+ * authenticated and sent.  All the
+ * packets are built again when routes are removed from the RouteDB or
+ * the port configuration they depend on changes.  A table that is
+ * dumped only once does not keep its packets.
+ *
  * Specialized implementations exist for IPv4 and IPv6.
  * Non-copyable due to inheritance from OutputBase<A>.
  */
@@ -41,15 +58,17 @@ template <typename A>
 class OutputTable :
 	public OutputBase<A>
 {
+	public:
+		typedef typename OutputBase<A>::Net	Net;
+
 	public:
 		OutputTable( Port<A>&	port,
 				PacketQueue<A>&	pkt_queue,
 				RouteDB<A>&	rdb,
 				const A&	ip_addr = RIP_AF_CONSTANTS<A>::IP_GROUP(),
-				uint16_t	ip_port = RIP_AF_CONSTANTS<A>::IP_PORT)
-			: OutputBase<A>( port, pkt_queue, ip_addr, ip_port),
-			_rw(rdb), _rw_valid(false)
-	{}
+				uint16_t	ip_port = RIP_AF_CONSTANTS<A>::IP_PORT,
+				bool		keep_packets = true);
+		~OutputTable();
 
 	protected:
 		void output_packet();
@@ -57,8 +76,80 @@ class OutputTable :
 		void stop_output_processing();
 
 	private:
-		RouteWalker<A>	_rw;		// RouteWalker
-		bool		_rw_valid;	// RouteWalker is valid (no reset req).
+		/**
+		 * A response packet kept between dumps.
+		 */
+		struct CachedPacket
+		{
+			vector<Net>	nets;	// Routes in the packet, in order.
+			RipPacket<A>*	pkt;	// Encoded packet, 0 if to be built.
+		};
+
+		/**
+		 * Bring the packets up to date with the RouteDB.
+		 */
+		void update_cache();
+
+		/**
+		 * Drop all the packets and queue every route for a new one.
+		 */
+		void rebuild_cache();
+
+		/**
+		 * Encode the routes of packet n, followed by as many routes
+		 * not yet in a packet as fit, and finish it.
+		 *
+		 * @param n the index of the packet.
+		 * @param auth_packets the authenticated packets to send.
+		 */
+		void build_packet(size_t n, list<RipPacket<A>*>& auth_packets);
+
+		/**
+		 * Add route to a packet if it should be advertised on this port.
+		 */
+		bool add_route(ResponsePacketAssembler<A>& rpa, const Net& net);
+
+		/**
+		 * @return a value that changes when the number of routes that
+		 * fit in a packet changes.
+		 */
+		uint32_t packet_layout() const;
+
+		void clear_cache();
+
+		/**
+		 * Drop all the packets and stop reading the UpdateQueue.
+		 */
+		void drop_cache();
+
+		/**
+		 * Queue a route for a new packet unless it is queued already.
+		 */
+		void push_pending(const Net& net);
+
+		/**
+		 * Take the first route queued for a new packet.
+		 */
+		Net pop_pending();
+
+		RouteDB<A>&		_rdb;
+		RouteWalker<A>		_rw;		// RouteWalker
+		UpdateQueue<A>&		_uq;
+		typename UpdateQueue<A>::ReadIterator _uq_iter;
+
+		vector<CachedPacket>	_packets;
+		map<Net, size_t, NetCmp<A> > _packet_of; // Packet holding route.
+		list<Net>		_pending;	// Routes not in a packet.
+		set<Net, NetCmp<A> >	_pending_nets;	// Routes in _pending.
+		size_t			_next_packet;	// Next packet of the dump.
+		bool			_keep_packets;	// Keep packets between dumps.
+
+		// State the packets were built with.
+		bool			_cache_valid;
+		uint32_t		_removals;
+		RipHorizon		_horizon;
+		bool			_adv_def_rt;
+		uint32_t		_layout;
 };
 
 #endif // __RIP_OUTPUT_TABLE_HH__
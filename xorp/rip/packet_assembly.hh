@@ -174,6 +174,13 @@ class ResponsePacketAssembler
 		 */
 		void packet_start(RipPacket<A>* pkt);
 
+		/**
+		 * Resume a packet whose routes were added earlier, so that it
+		 * can be finished.  The packet must hold only its entries,
+		 * as set by an earlier @ref packet_finish.
+		 */
+		void packet_resume(RipPacket<A>* pkt);
+
 		/**
 		 * Add a route to RIP response packet.
 		 *
@@ -291,6 +298,14 @@ ResponsePacketAssembler<IPv4>::packet_start(RipPacket<IPv4>* pkt)
 	rph.initialize(RipPacketHeader::RESPONSE, RipPacketHeader::IPv4_VERSION);
 }
 
+template <>
+	inline void
+ResponsePacketAssembler<IPv4>::packet_resume(RipPacket<IPv4>* pkt)
+{
+	_pkt = pkt;
+	_pos = pkt->max_entries();
+}
+
 template <>
 inline bool
 ResponsePacketAssembler<IPv4>::packet_full() const
@@ -369,6 +384,14 @@ ResponsePacketAssembler<IPv6>::packet_start(RipPacket<IPv6>* pkt)
 	rph.initialize(RipPacketHeader::RESPONSE, RipPacketHeader::IPv6_VERSION);
 }
 
+template <>
+	inline void
+ResponsePacketAssembler<IPv6>::packet_resume(RipPacket<IPv6>* pkt)
+{
+	_pkt = pkt;
+	_pos = pkt->max_entries();
+}
+
 template <>
 inline bool
 ResponsePacketAssembler<IPv6>::packet_full() const
@@ -40,6 +40,8 @@ PeerRoutes<A>::deletion_secs() const
 	template <typename A>
 	Peer<A>::Peer(RipPort& p, const Addr& addr)
 : RouteEntryOrigin<A>(false), _port(p), _addr(addr),
+	_expiry_timers("Peer route expiry",
+			callback(this, &Peer<A>::expire_route)),
 	_peer_routes(*this)
 {
 	RouteDB<A>& rdb = _port.port_manager().system().route_db();
@@ -128,15 +130,12 @@ template <typename A>
 	void
 Peer<A>::set_expiry_timer(Route* route)
 {
-	XorpTimer t;
 	uint32_t secs = expiry_secs();
 
-	if (secs) 
-	{
-		t = EventLoop::instance().new_oneoff_after_ms(secs * 1000,
-				callback(this, &Peer<A>::expire_route, route));
-	}
-	route->set_timer(t);
+	if (secs)
+		_expiry_timers.schedule_after_ms(route, secs * 1000);
+	else
+		_expiry_timers.unschedule(route);
 }
 
 template <typename A>
@@ -24,6 +24,7 @@
 
 #include "libxorp/timeval.hh"
 #include "route_entry.hh"
+#include "route_timers.hh"
 
 /**
  * @short Container of counters associated with a peer.
@@ -227,6 +228,7 @@ class Peer : public RouteEntryOrigin<A>
 		Addr		_addr;
 		PeerCounters	_counters;
 		TimeVal		_last_active;
+		RouteTimers<A>	_expiry_timers;
 		PeerRoutes<A>	_peer_routes;
 };
 
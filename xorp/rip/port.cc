@@ -751,7 +751,7 @@ Port<A>::parse_request(const Addr&			src_addr,
 
 			RouteDB<A>& rdb = _pm.system().route_db();
 			_su_out = new OutputTable<A>( *this, *_packet_queue, rdb,
-					src_addr, src_port);
+					src_addr, src_port, false);
 			_su_out->start();
 
 			block_queries();
@@ -34,6 +34,9 @@
 #include "route_entry.hh"
 #include "redist.hh"
 
+// The interval between the batches of routes withdrawn
+static const uint32_t WITHDRAW_BATCH_MS = 5;
+
 // ----------------------------------------------------------------------------
 // RedistRouteOrigin
 
@@ -110,7 +113,7 @@ RouteRedistributor<A>::withdraw_routes()
 {
     if (_wtimer.scheduled() == false) 
     {
-	_wtimer = EventLoop::instance().new_periodic_ms(5,
+	_wtimer = EventLoop::instance().new_periodic_ms(WITHDRAW_BATCH_MS,
 		callback(this, &RouteRedistributor::withdraw_batch));
     }
 }
@@ -130,6 +133,9 @@ RouteRedistributor<A>::withdraw_batch()
     {
 	_wdrawer = new RouteWalker<A>(_route_db);
 	_wdrawer->reset();
+    } else 
+    {
+	_wdrawer->resume();
     }
 
     XLOG_ASSERT(_wdrawer->state() == RouteWalker<A>::STATE_RUNNING);
@@ -148,6 +154,8 @@ RouteRedistributor<A>::withdraw_batch()
 
 	if (++visited == 5) 
 	{
+	    // Keep our place in the RouteDB until the next batch
+	    _wdrawer->pause(WITHDRAW_BATCH_MS);
 	    return true;	// we're not finished - reschedule timer
 	}
     }
@@ -59,9 +59,16 @@ NetCmp<A>::operator() (const IPNet<A>& l, const IPNet<A>& r) const
 
     template <typename A>
     RouteDB<A>::RouteDB( PolicyFilters& pfs)
-: _policy_filters(pfs)
+: _policy_filters(pfs), _removals(0),
+    _expiry_timers("Route expiry",
+	    callback(this, &RouteDB<A>::expire_route)),
+    _deletion_timers("Route deletion",
+	    callback(this, &RouteDB<A>::delete_route))
 {
     _uq = new UpdateQueue<A>();
+    _timer_stats_timer = EventLoop::instance().new_periodic_ms(
+	TIMER_STATS_INTERVAL_SECS * 1000,
+	callback(this, &RouteDB<A>::log_timer_stats));
 }
 
     template <typename A>
@@ -103,6 +110,7 @@ RouteDB<A>::erase_peer(Peer<A>* peer)
 	return (false);
 
     _peers.erase(iter);
+    _removals++;
     return (true);
 }
 
@@ -126,6 +134,7 @@ RouteDB<A>::delete_route(Route* r)
     typename RouteContainerNoRef::iterator iter = _rib_routes.find(r->net());
 
     _routes.erase(i);
+    _removals++;
 
     // add possible rib route
     if (iter != _rib_routes.end()) 
@@ -151,10 +160,7 @@ RouteDB<A>::set_deletion_timer(Route* r)
     RouteOrigin* o = r->origin();
     uint32_t deletion_ms = o->deletion_secs() * 1000;
 
-    XorpTimer t = EventLoop::instance().new_oneoff_after_ms(deletion_ms,
-	    callback(this, &RouteDB<A>::delete_route, r));
-
-    r->set_timer(t);
+    _deletion_timers.schedule_after_ms(r, deletion_ms);
 }
 
 template <typename A>
@@ -173,16 +179,33 @@ template <typename A>
     void
 RouteDB<A>::set_expiry_timer(Route* r)
 {
-    XorpTimer t;
     RouteOrigin* o = r->origin();
     uint32_t expiry_secs = o->expiry_secs();
 
     if (expiry_secs) 
     {
-	t = EventLoop::instance().new_oneoff_after_ms(expiry_secs * 1000,
-		callback(this, &RouteDB<A>::expire_route, r));
+	_expiry_timers.schedule_after_ms(r, expiry_secs * 1000);
+    } else 
+    {
+	_expiry_timers.unschedule(r);
+	_deletion_timers.unschedule(r);
     }
-    r->set_timer(t);
+}
+
+template <typename A>
+string
+RouteDB<A>::timer_stats()
+{
+    return _expiry_timers.str() + "\n" + _deletion_timers.str();
+}
+
+template <typename A>
+    bool
+RouteDB<A>::log_timer_stats()
+{
+    XLOG_TRACE(trace()._routes, "%s", timer_stats().c_str());
+
+    return true;		// Keep the periodic timer running
 }
 
 template <typename A>
@@ -347,7 +370,7 @@ RouteDB<A>::update_route(const Net&		net,
 
 	if (cost == RIP_INFINITY) 
 	{
-	    if ((orig_cost == RIP_INFINITY) && r->timer().scheduled()) 
+	    if ((orig_cost == RIP_INFINITY) && r->timer_scheduled()) 
 	    {
 		//
 		// XXX: The deletion process is started only when the
@@ -462,7 +485,7 @@ RouteDB<A>::update_route(const Net&		net,
 		break;		// XXX: the old route would never expire
 
 	    TimeVal remain;
-	    if (r->timer().time_remaining(remain) != true)
+	    if (r->timer_remaining(remain) != true)
 		break;		// XXX: couldn't get the remaining time
 	    if (remain < (expiry_timeval / 2)) 
 	    {
@@ -512,6 +535,7 @@ RouteDB<A>::flush_routes()
 {
     _uq->flush();
     _routes.erase(_routes.begin(), _routes.end());
+    _removals++;
 }
 
 template <typename A>
@@ -626,17 +650,14 @@ RouteWalker<A>::pause(uint32_t pause_ms)
     // point to resume from.  We're advertising the route at infinity
     // so advertising it once past it's original expiry is no big deal
 
-    XorpTimer t = _pos->second->timer();
-    if (t.scheduled() && _pos->second->cost() == RIP_INFINITY) 
+    Route* r = _pos->second.get();
+    if (r->timer_scheduled() && r->cost() == RIP_INFINITY) 
     {
 	TimeVal next_run;
 	EventLoop::instance().current_time(next_run);
 	next_run += TimeVal(0, 1000 * pause_ms * 2); // factor of 2 == slack
-	if (t.expiry() <= next_run) 
-	{
-	    t.schedule_at(next_run);
-	    _pos->second->set_timer(t);
-	}
+	if (r->timer_expiry() <= next_run)
+	    _route_db._deletion_timers.schedule_at(r, next_run);
     }
     _last_visited = _pos->second->net();
 }
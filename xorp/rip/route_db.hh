@@ -25,6 +25,7 @@
 #include "libxorp/ref_ptr.hh"
 #include "policy/backend/policy_filters.hh"
 #include "route_entry.hh"
+#include "route_timers.hh"
 #include "trace.hh"
 
 
@@ -193,6 +194,22 @@ class RouteDB :
 	 */
 	const UpdateQueue<A>& update_queue() const;
 
+	/**
+	 * Get the number of times routes or peers have been removed from
+	 * the database.  Removals do not appear in the UpdateQueue, so
+	 * this lets a reader of the queue tell when it has missed a change.
+	 *
+	 * @return the removal count.
+	 */
+	uint32_t removals() const			{ return _removals; }
+
+	/**
+	 * Get the statistics of the route expiry and deletion timers.
+	 *
+	 * @return human readable statistics, with the timer operation
+	 * rates since the last call.
+	 */
+	string timer_stats();
 
 	/**
 	 * Push routes through policy filters for re-filtering.
@@ -216,6 +233,8 @@ class RouteDB :
 	void delete_route(Route* r);
 	void set_deletion_timer(Route* r);
 
+	bool log_timer_stats();
+
     protected:
 	RouteContainer& routes();
 
@@ -234,6 +253,11 @@ class RouteDB :
 	// Also need to be able to re-filter original routes
 	RouteContainerNoRef	_rib_routes;
 	RouteOrigin*	_rib_origin;
+	uint32_t	_removals;
+
+	RouteTimers<A>	_expiry_timers;		// Routes waiting to expire
+	RouteTimers<A>	_deletion_timers;	// Expired routes
+	XorpTimer	_timer_stats_timer;	// Logs the timer statistics
 
 	friend class RouteWalker<A>;
 
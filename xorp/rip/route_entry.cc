@@ -25,8 +25,10 @@
 #include "libxorp/ipv4.hh"
 #include "libxorp/ipv6.hh"
 #include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
 
 #include "route_entry.hh"
+#include "route_timers.hh"
 
 template <typename A>
     inline void
@@ -58,7 +60,8 @@ RouteEntry<A>::RouteEntry(const Net&	n,
 	Origin*&	o,
 	uint16_t	tag)
 : _net(n), _nh(nh), _ifname(ifname), _vifname(vifname),
-    _cost(cost), _tag(tag), _ref_cnt(0), _filtered(false)
+    _cost(cost), _tag(tag), _ref_cnt(0), _timers(0),
+    _timer(callback(this, &RouteEntry<A>::timer_expired)), _filtered(false)
 {
     associate(o);
 }
@@ -73,8 +76,9 @@ RouteEntry<A>::RouteEntry(const Net&		n,
 	uint16_t		tag,
 	const PolicyTags&	policytags)
 : _net(n), _nh(nh), _ifname(ifname), _vifname(vifname),
-    _cost(cost), _tag(tag), _ref_cnt(0), _policytags(policytags),
-    _filtered(false)
+    _cost(cost), _tag(tag), _ref_cnt(0), _timers(0),
+    _timer(callback(this, &RouteEntry<A>::timer_expired)),
+    _policytags(policytags), _filtered(false)
 {
     associate(o);
 }
@@ -90,6 +94,20 @@ RouteEntry<A>::~RouteEntry()
     }
 }
 
+template <typename A>
+bool
+RouteEntry<A>::timer_remaining(TimeVal& remain) const
+{
+    return _timer.time_remaining(remain);
+}
+
+template <typename A>
+    void
+RouteEntry<A>::timer_expired()
+{
+    _timers->expired(this);
+}
+
 template <typename A>
 string
 RouteEntry<A>::str() const 
@@ -24,11 +24,13 @@
 
 #include "libxorp/xorp.h"
 #include "libxorp/ipnet.hh"
-#include "libxorp/timer.hh"
+#include "libxorp/timeval.hh"
+#include "libxorp/timer_buckets.hh"
 #include "policy/backend/policytags.hh"
 
 template<typename A> class RouteEntryOrigin;
 template<typename A> class RouteEntryRef;
+template<typename A> class RouteTimers;
 
 /**
  * RIP Route Entry Class.
@@ -188,14 +190,23 @@ class RouteEntry :
 	uint16_t tag() const 		{ return _tag; }
 
 	/**
-	 * Set a Timer Event associated with this route.
+	 * @return true if the route's timer is scheduled.
 	 */
-	void set_timer(const XorpTimer& t) 	{ _timer = t; }
+	bool timer_scheduled() const		{ return _timer.scheduled(); }
 
 	/**
-	 * Get Timer associated with route.
+	 * Get the time the route's timer is due, valid while it is
+	 * scheduled.
 	 */
-	const XorpTimer& timer() const 	{ return _timer; }
+	const TimeVal& timer_expiry() const	{ return _timer.expiry(); }
+
+	/**
+	 * Get the time remaining before the route's timer is due.
+	 *
+	 * @param remain the time remaining.
+	 * @return true if the timer is scheduled, false otherwise.
+	 */
+	bool timer_remaining(TimeVal& remain) const;
 
 	/**
 	 * @return policy-tags associated with route.
@@ -226,9 +237,11 @@ class RouteEntry :
 
     private:
 	friend class RouteEntryRef<A>;
+	friend class RouteTimers<A>;
 	void ref()				{ _ref_cnt++; }
 	uint16_t unref()			{ return --_ref_cnt; }
 	uint16_t ref_cnt() const		{ return _ref_cnt; }
+	void timer_expired();
 
     protected:
 	void dissociate();
@@ -244,7 +257,8 @@ class RouteEntry :
 	uint16_t	_tag;
 	uint16_t	_ref_cnt;
 
-	XorpTimer	_timer;
+	RouteTimers<A>* _timers;	// Timers the route was last scheduled in.
+	BucketTimer	_timer;
 
 	PolicyTags	_policytags;
 	bool	_filtered;
@@ -0,0 +1,96 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+// 
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#include "rip_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/eventloop.hh"
+
+#include "route_timers.hh"
+
+template <typename A>
+RouteTimers<A>::RouteTimers(const char* name, const FireCallback& cb)
+    : _name(name), _cb(cb), _buckets(BUCKET_MS), _last_route_ops(0),
+      _last_timer_ops(0)
+{
+    EventLoop::instance().current_time(_last_str);
+}
+
+template <typename A>
+    void
+RouteTimers<A>::schedule_after_ms(Route* r, uint32_t ms)
+{
+    r->_timers = this;
+    _buckets.schedule_after(r->_timer, TimeVal(ms / 1000, (ms % 1000) * 1000));
+}
+
+template <typename A>
+    void
+RouteTimers<A>::schedule_at(Route* r, const TimeVal& when)
+{
+    r->_timers = this;
+    _buckets.schedule_at(r->_timer, when);
+}
+
+template <typename A>
+    void
+RouteTimers<A>::unschedule(Route* r)
+{
+    _buckets.unschedule(r->_timer);
+}
+
+template <typename A>
+string
+RouteTimers<A>::str()
+{
+    TimeVal now;
+    EventLoop::instance().current_time(now);
+
+    double secs = (now - _last_str).get_double();
+    double route_rate = 0.0;
+    double timer_rate = 0.0;
+    if (secs > 0.0) 
+    {
+	route_rate = (_buckets.timer_ops() - _last_route_ops) / secs;
+	timer_rate = (_buckets.event_loop_timer_ops() - _last_timer_ops) / secs;
+    }
+    _last_route_ops = _buckets.timer_ops();
+    _last_timer_ops = _buckets.event_loop_timer_ops();
+    _last_str = now;
+
+    return c_format("%s: %u routes in %u buckets, "
+		    "%.1f route timer operations/s, "
+		    "%.1f event loop timer operations/s",
+		    _name, XORP_UINT_CAST(routes()),
+		    XORP_UINT_CAST(buckets()), route_rate, timer_rate);
+}
+
+
+// ----------------------------------------------------------------------------
+// Instantiations
+
+#ifdef INSTANTIATE_IPV4
+template class RouteTimers<IPv4>;
+#endif
+
+#ifdef INSTANTIATE_IPV6
+template class RouteTimers<IPv6>;
+#endif
@@ -0,0 +1,116 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+// vim:set sts=4 ts=8:
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+// 
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+// 
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __RIP_ROUTE_TIMERS_HH__
+#define __RIP_ROUTE_TIMERS_HH__
+
+#include "libxorp/xorp.h"
+#include "libxorp/callback.hh"
+#include "libxorp/timeval.hh"
+#include "libxorp/timer_buckets.hh"
+
+#include "route_entry.hh"
+
+/**
+ * @short Timers for a set of routes, kept in time buckets.
+ *
+ * The route timers are kept in a @ref TimerBuckets, so routes refreshed
+ * by the same response packet share one bucket.  A route fires up to
+ * one bucket interval after its due time, never before it.  A route is
+ * in at most one RouteTimers instance at a time, scheduling it in one
+ * removes it from any other.
+ */
+template <typename A>
+class RouteTimers :
+    public NONCOPYABLE
+{
+    public:
+	typedef RouteEntry<A>					Route;
+	typedef typename XorpCallback1<void, Route*>::RefPtr	FireCallback;
+
+	/**
+	 * Constructor.
+	 *
+	 * @param name the name of the timers, for statistics.
+	 * @param cb the callback invoked for each route whose timer fires.
+	 * The route is no longer scheduled when the callback is invoked.
+	 */
+	RouteTimers(const char* name, const FireCallback& cb);
+
+	/**
+	 * Schedule route's timer to fire after a delay.
+	 *
+	 * @param r the route.
+	 * @param ms the delay in milliseconds.
+	 */
+	void schedule_after_ms(Route* r, uint32_t ms);
+
+	/**
+	 * Schedule route's timer to fire at a time.
+	 *
+	 * @param r the route.
+	 * @param when the time the timer should fire.
+	 */
+	void schedule_at(Route* r, const TimeVal& when);
+
+	/**
+	 * Unschedule route's timer, if it is in this instance.
+	 */
+	void unschedule(Route* r);
+
+	/**
+	 * @return the number of routes scheduled.
+	 */
+	size_t routes() const			{ return _buckets.timers(); }
+
+	/**
+	 * @return the number of buckets in use.
+	 */
+	size_t buckets() const			{ return _buckets.buckets(); }
+
+	/**
+	 * @return human readable statistics, with the operation rates per
+	 * second since the last call.
+	 */
+	string str();
+
+	/**
+	 * Interval covered by each bucket.
+	 */
+	static const uint32_t BUCKET_MS = 1000;
+
+    private:
+	friend class RouteEntry<A>;
+
+	/**
+	 * Called by the route when its timer in these buckets fires.
+	 */
+	void expired(Route* r)			{ _cb->dispatch(r); }
+
+	const char*	_name;
+	FireCallback	_cb;
+	TimerBuckets	_buckets;
+
+	uint64_t	_last_route_ops;	// Counts at the last str().
+	uint64_t	_last_timer_ops;
+	TimeVal		_last_str;
+};
+
+#endif // __RIP_ROUTE_TIMERS_HH__
@@ -194,7 +194,6 @@ ConfigTree::add_node(const string& segment, int type,
 		const ConfigNodeId& node_id)
 throw (ParseError)
 {
-	list<ConfigTreeNode*>::const_iterator iter;
 	ConfigTreeNode *found = NULL;
 
 	if (_current_node->template_tree_node() != NULL
@@ -227,28 +226,21 @@ throw (ParseError)
 		return;
 	}
 
-	iter = _current_node->children().begin();
-	while (iter != _current_node->children().end()) 
+	found = _current_node->find_child(segment);
+	if ((found != NULL)
+			&& (_current_node->count_children_with_name(segment) > 1)) 
 	{
-		if ((*iter)->segname() == segment) 
-		{
-			if (found != NULL) 
-			{
-				//
-				// If there are two nodes with the same segment name,
-				// we can only distinguish between them by type.
-				// extend_path doesn't have the type information
-				// available because it wasn't at the relevant point
-				// in the template file, so this is an error.  The
-				// correct way to step past such a node would be
-				// through a call to add_node().
-				//
-				string err = "Need to qualify type of " + segment + "\n";
-				xorp_throw(ParseError, err);
-			}
-			found = *iter;
-		}
-		++iter;
+		//
+		// If there are two nodes with the same segment name,
+		// we can only distinguish between them by type.
+		// extend_path doesn't have the type information
+		// available because it wasn't at the relevant point
+		// in the template file, so this is an error.  The
+		// correct way to step past such a node would be
+		// through a call to add_node().
+		//
+		string err = "Need to qualify type of " + segment + "\n";
+		xorp_throw(ParseError, err);
 	}
 	if (found != NULL) 
 	{
@@ -176,6 +176,7 @@ ConfigTreeNode::~ConfigTreeNode()
 	delete _children.front();
 	_children.pop_front();
     }
+    _children_index.clear();
 
     // Detect accidental reuse
     _template_tree_node = reinterpret_cast<TemplateTreeNode *>(0xbad);
@@ -244,25 +245,39 @@ ConfigTreeNode::add_child(ConfigTreeNode* child)
 	_variables.erase(iter);
     }
 
-    _children.push_back(child);
-    list<ConfigTreeNode *> sorted_children = _children;
-    sort_by_template(sorted_children);
-    _children = sorted_children;
+    //
+    // Keep the children in template tree order: insert the new child
+    // after all children that don't sort after it, which is where a
+    // stable sort would move it. The children are usually added in
+    // order, hence search from the end.
+    //
+    CTN_Compare compare;
+    list<ConfigTreeNode*>::iterator pos = _children.end();
+    while (pos != _children.begin()) 
+    {
+	list<ConfigTreeNode*>::iterator prev = pos;
+	--prev;
+	if (! compare(child, *prev))
+	    break;
+	pos = prev;
+    }
+    pos = _children.insert(pos, child);
+    _children_index.insert(make_pair(child->segname(), pos));
 }
 
     void
 ConfigTreeNode::remove_child(ConfigTreeNode* child)
 {
-    //
-    // It's faster to implement this ourselves than use _children.remove()
-    // because _children has no duplicates.
-    //
-    list<ConfigTreeNode*>::iterator iter;
-    for (iter = _children.begin(); iter != _children.end(); ++iter) 
+    pair<ChildIndex::iterator, ChildIndex::iterator> range;
+    ChildIndex::iterator iter;
+
+    range = _children_index.equal_range(child->segname());
+    for (iter = range.first; iter != range.second; ++iter) 
     {
-	if ((*iter) == child) 
+	if (*(iter->second) == child) 
 	{
-	    _children.erase(iter);
+	    _children.erase(iter->second);
+	    _children_index.erase(iter);
 	    return;
 	}
     }
@@ -270,6 +285,16 @@ ConfigTreeNode::remove_child(ConfigTreeNode* child)
     XLOG_UNREACHABLE();
 }
 
+    ConfigTreeNode*
+ConfigTreeNode::find_child(const string& segname)
+{
+    ChildIndex::iterator iter = _children_index.lower_bound(segname);
+
+    if ((iter == _children_index.end()) || (iter->first != segname))
+	return NULL;
+    return *(iter->second);
+}
+
     void
 ConfigTreeNode::add_default_children()
 {
@@ -491,27 +516,19 @@ ConfigTreeNode::merge_deltas(uid_t user_id,
     {
 	ConfigTreeNode *delta_child = *iter;
 
-	bool delta_child_done = false;
-	list<ConfigTreeNode*>::iterator ci;
-	for (ci = _children.begin(); ci != _children.end(); ++ci) 
+	ConfigTreeNode *my_child = find_child(delta_child->segname());
+	if (my_child != NULL) 
 	{
-	    ConfigTreeNode *my_child = *ci;
-	    if (my_child->segname() == delta_child->segname()) 
+	    bool success = my_child->merge_deltas(user_id, *delta_child,
+		    provisional_change,
+		    preserve_node_id,
+		    error_msg);
+	    if (success == false) 
 	    {
-		delta_child_done = true;
-		bool success = my_child->merge_deltas(user_id, *delta_child,
-			provisional_change,
-			preserve_node_id,
-			error_msg);
-		if (success == false) 
-		{
-		    // If something failed, abort the merge
-		    return false;
-		}
-		break;
+		// If something failed, abort the merge
+		return false;
 	    }
-	}
-	if (delta_child_done == false) 
+	} else 
 	{
 	    ConfigTreeNode* new_node;
 	    ConfigNodeId new_node_id = ConfigNodeId::ZERO();
@@ -572,27 +589,19 @@ ConfigTreeNode::merge_deletions(uid_t user_id,
     {
 	ConfigTreeNode *deletion_child = *iter;
 
-	bool deletion_child_done = false;
-	list<ConfigTreeNode*>::iterator ci;
-	for (ci = _children.begin(); ci != _children.end(); ++ci) 
+	ConfigTreeNode *my_child = find_child(deletion_child->segname());
+	if (my_child != NULL) 
 	{
-	    ConfigTreeNode *my_child = *ci;
-	    if (my_child->segname() == deletion_child->segname()) 
+	    bool success = my_child->merge_deletions(user_id,
+		    *deletion_child,
+		    provisional_change,
+		    error_msg);
+	    if (success == false) 
 	    {
-		deletion_child_done = true;
-		bool success = my_child->merge_deletions(user_id,
-			*deletion_child,
-			provisional_change,
-			error_msg);
-		if (success == false) 
-		{
-		    // If something failed, abort the merge
-		    return false;
-		}
-		break;
+		// If something failed, abort the merge
+		return false;
 	    }
-	}
-	if (deletion_child_done == false) 
+	} else 
 	{
 	    error_msg = c_format("Failed to delete node:\n"
 		    "   %s\n"
@@ -1094,14 +1103,13 @@ void
 ConfigTreeNode::get_children_with_name(list<const ConfigTreeNode*>& children_ret,
 	const string& name_str) const
 {
+    pair<ChildIndex::const_iterator, ChildIndex::const_iterator> range;
+    ChildIndex::const_iterator iter;
+
     children_ret.clear();
-    list<ConfigTreeNode*>::const_iterator iter;
-    for (iter = _children.begin(); iter != _children.end(); ++iter) 
-    {
-	ConfigTreeNode* child = *iter;
-	if (child->segname() == name_str)
-	    children_ret.push_back(child);
-    }
+    range = _children_index.equal_range(name_str);
+    for (iter = range.first; iter != range.second; ++iter)
+	children_ret.push_back(*(iter->second));
 }
 void
 ConfigTreeNode::get_children_with_type(list<const ConfigTreeNode*>& children_ret,
@@ -1473,42 +1481,33 @@ ConfigTreeNode::find_const_node(const list<string>& path) const
     ConfigTreeNode*
 ConfigTreeNode::find_node(const list<string>& path)
 {
-    list<string> path_copy = path;
-
     // Are we looking for the root node?
-    if (path_copy.empty())
+    if (path.empty())
 	return this;
 
+    list<string>::const_iterator iter = path.begin();
     if (_template_tree_node != NULL) 
     {
 	// XXX: not a root node
-	if (path_copy.front() == _segname) 
-	{
-	    if (path_copy.size() == 1) 
-	    {
-		return this;
-	    } else 
-	    {
-		path_copy.pop_front();
-	    }
-	} else 
+	if (*iter != _segname) 
 	{
 	    // We must have screwed up
 	    XLOG_UNREACHABLE();
 	}
+	++iter;
     }
 
-    list<ConfigTreeNode *>::const_iterator iter;
-    for (iter = _children.begin(); iter != _children.end(); ++iter) 
+    //
+    // Walk down the tree one path segment at a time
+    //
+    ConfigTreeNode* found = this;
+    for ( ; iter != path.end(); ++iter) 
     {
-	if ((*iter)->segname() == path_copy.front()) 
-	{
-	    return ((*iter)->find_node(path_copy));
-	}
+	found = found->find_child(*iter);
+	if (found == NULL)
+	    return NULL;	// None of the nodes match the path
     }
-
-    // None of the nodes match the path
-    return NULL;
+    return found;
 }
 
 
@@ -1517,7 +1516,8 @@ ConfigTreeNode::retain_different_nodes(const ConfigTreeNode& them,
 	bool retain_value_changed)
 {
     list<ConfigTreeNode*>::iterator my_iter;
-    list<ConfigTreeNode*>::const_iterator their_iter;
+    pair<ChildIndex::const_iterator, ChildIndex::const_iterator> range;
+    ChildIndex::const_iterator index_iter;
     bool retained_children = false;
 
     XLOG_ASSERT(_segname == them.segname());
@@ -1530,11 +1530,12 @@ ConfigTreeNode::retain_different_nodes(const ConfigTreeNode& them,
 	// Be careful not to invalidate the iterator when we remove children
 	++my_iter;
 
-	for (their_iter = them.const_children().begin();
-		their_iter != them.const_children().end();
-		++their_iter) 
+	// Only their children with the same name can match
+	range = them._children_index.equal_range(my_child->segname());
+	for (index_iter = range.first; index_iter != range.second;
+		++index_iter) 
 	{
-	    ConfigTreeNode* their_child = *their_iter;
+	    ConfigTreeNode* their_child = *(index_iter->second);
 
 	    if (their_child->deleted())
 		continue;	// XXX: ignore deleted nodes
@@ -1576,6 +1577,8 @@ ConfigTreeNode::retain_deletion_nodes(const ConfigTreeNode& them,
 {
     list<ConfigTreeNode*>::iterator my_iter;
     list<ConfigTreeNode*>::const_iterator their_iter;
+    pair<ChildIndex::const_iterator, ChildIndex::const_iterator> range;
+    ChildIndex::const_iterator index_iter;
     bool found_deletion_children = false;
 
     XLOG_ASSERT(_segname == them.segname());
@@ -1590,11 +1593,12 @@ ConfigTreeNode::retain_deletion_nodes(const ConfigTreeNode& them,
 	// Be careful not to invalidate the iterator when we remove children
 	++my_iter;
 
-	for (their_iter = them.const_children().begin();
-		their_iter != them.const_children().end();
-		++their_iter) 
+	// Only their children with the same name can match
+	range = them._children_index.equal_range(my_child->segname());
+	for (index_iter = range.first; index_iter != range.second;
+		++index_iter) 
 	{
-	    ConfigTreeNode* their_child = *their_iter;
+	    ConfigTreeNode* their_child = *(index_iter->second);
 
 	    if (their_child->deleted())
 		continue;	// XXX: ignore deleted nodes
@@ -1660,7 +1664,8 @@ ConfigTreeNode::retain_deletion_nodes(const ConfigTreeNode& them,
 ConfigTreeNode::retain_common_nodes(const ConfigTreeNode& them)
 {
     list<ConfigTreeNode*>::iterator my_iter;
-    list<ConfigTreeNode*>::const_iterator their_iter;
+    pair<ChildIndex::const_iterator, ChildIndex::const_iterator> range;
+    ChildIndex::const_iterator index_iter;
     bool retained_children = false;
 
     XLOG_ASSERT(_segname == them.segname());
@@ -1673,11 +1678,12 @@ ConfigTreeNode::retain_common_nodes(const ConfigTreeNode& them)
 	// Be careful not to invalidate the iterator when we remove children
 	++my_iter;
 
-	for (their_iter = them.const_children().begin();
-		their_iter != them.const_children().end();
-		++their_iter) 
+	// Only their children with the same name can match
+	range = them._children_index.equal_range(my_child->segname());
+	for (index_iter = range.first; index_iter != range.second;
+		++index_iter) 
 	{
-	    ConfigTreeNode* their_child = *their_iter;
+	    ConfigTreeNode* their_child = *(index_iter->second);
 	    if ((*my_child) == (*their_child)) 
 	    {
 		my_child->retain_common_nodes(*their_child);
@@ -2413,6 +2419,45 @@ ConfigTreeNode::sort_by_template(list<ConfigTreeNode*>& children) const
     children.sort(CTN_Compare());
 }
 
+//
+// Find the position of a child in the (ordered) list of children.
+// Return the end of the list if the node is not one of our children.
+//
+list<ConfigTreeNode*>::const_iterator
+ConfigTreeNode::child_position(const ConfigTreeNode* child) const
+{
+    pair<ChildIndex::const_iterator, ChildIndex::const_iterator> range;
+    ChildIndex::const_iterator iter;
+
+    range = _children_index.equal_range(child->segname());
+    for (iter = range.first; iter != range.second; ++iter) 
+    {
+	if (*(iter->second) == child)
+	    return (iter->second);
+    }
+    return (_children.end());
+}
+
+//
+// Find the last child that is ordered before the given child and that
+// is not deleted. If the node is not one of our children, find the
+// last child that is not deleted.
+//
+    ConfigTreeNode*
+ConfigTreeNode::prev_undeleted_child(const ConfigTreeNode* child) const
+{
+    list<ConfigTreeNode*>::const_iterator iter = child_position(child);
+
+    while (iter != _children.begin()) 
+    {
+	--iter;
+	// Ignore nodes that were deleted
+	if (! (*iter)->deleted())
+	    return (*iter);
+    }
+    return (NULL);
+}
+
 string
 ConfigTreeNode::show_node_id(bool numbered, const ConfigNodeId& node_id) const
 {
@@ -2442,34 +2487,29 @@ ConfigTreeNode::allocate_unique_node_id()
     // node.
     //
     debug_msg("finding order (phase 1)...\n");
-    list<ConfigTreeNode *> sorted_children = _parent->children();
-    sort_by_template(sorted_children);
-    bool found_this = false;
-    list<ConfigTreeNode*>::iterator iter;
-    for (iter = sorted_children.begin();
-	    iter != sorted_children.end();
-	    ++iter) 
-    {
-	if ((*iter) == this) 
-	{
-	    // We found this node
-	    found_this = true;
-	    debug_msg("found this: %s\n", _segname.c_str());
-	    continue;
-	}
-	if (found_this) 
-	{
-	    if (next == NULL)
-		next = *iter;
+    const list<ConfigTreeNode *>& siblings = _parent->const_children();
+    list<ConfigTreeNode*>::const_iterator iter, next_iter;
+    iter = _parent->child_position(this);
+    if (iter != siblings.end()) 
+    {
+	// We found this node
+	debug_msg("found this: %s\n", _segname.c_str());
+	next_iter = iter;
+	++next_iter;
+	if (next_iter != siblings.end()) 
+	{
+	    next = *next_iter;
 	    debug_msg("next: %s %s\n", next->segname().c_str(),
 		    next->node_id().str().c_str());
-	} else 
-	{
-	    prev = *iter;
-	    debug_msg("prev: %s %s\n", prev->segname().c_str(),
-		    prev->node_id().str().c_str());
 	}
     }
+    if (iter != siblings.begin()) 
+    {
+	--iter;
+	prev = *iter;
+	debug_msg("prev: %s %s\n", prev->segname().c_str(),
+		prev->node_id().str().c_str());
+    }
 
     //
     // Found the previous and the next (ordered) sibling
@@ -2484,39 +2524,30 @@ ConfigTreeNode::allocate_unique_node_id()
 
 	debug_msg("node: %s effective parent: %s\n", _segname.c_str(),
 		effective_parent->segname().c_str());
-	found_this = false;
 	debug_msg("finding order (phase 2)...\n");
-	list<ConfigTreeNode *> sorted_children = effective_parent->children();
-	sort_by_template(sorted_children);
-	for (iter = sorted_children.begin();
-		iter != sorted_children.end();
-		++iter) 
+	const list<ConfigTreeNode *>& parent_siblings =
+	    effective_parent->const_children();
+	iter = effective_parent->child_position(_parent);
+	if (iter != parent_siblings.end()) 
 	{
-	    if ((*iter) == _parent) 
-	    {
-		// We found the tag parent
-		found_this = true;
-		debug_msg("found this: %s\n", _segname.c_str());
-		if (next != NULL)
-		    break;
-		continue;
-	    }
-	    if (found_this) 
+	    // We found the tag parent
+	    debug_msg("found this: %s\n", _segname.c_str());
+	    next_iter = iter;
+	    ++next_iter;
+	    if ((next == NULL) && (next_iter != parent_siblings.end())) 
 	    {
-		next = *iter;
+		next = *next_iter;
 		debug_msg("next: %s %s\n", next->segname().c_str(),
 			next->node_id().str().c_str());
-		break;
-	    } else 
-	    {
-		if (!found_prev) 
-		{
-		    prev = *iter;
-		    debug_msg("prev: %s %s\n", prev->segname().c_str(),
-			    prev->node_id().str().c_str());
-		}
 	    }
 	}
+	if ((!found_prev) && (iter != parent_siblings.begin())) 
+	{
+	    --iter;
+	    prev = *iter;
+	    debug_msg("prev: %s %s\n", prev->segname().c_str(),
+		    prev->node_id().str().c_str());
+	}
     }
 
     //
@@ -2546,8 +2577,7 @@ ConfigTreeNode::update_node_id_position()
 {
     ConfigTreeNode *prev = NULL;
     ConfigTreeNode *effective_parent = _parent;
-    list<ConfigTreeNode*>::iterator iter;
-    list<ConfigTreeNode *> sorted_children;
+    list<ConfigTreeNode*>::const_iterator iter;
 
     if (_parent == NULL)
 	goto process_subtree;
@@ -2563,23 +2593,7 @@ ConfigTreeNode::update_node_id_position()
     // If the parent node is a tag, then we need to consider the children
     // of the tag's parent node.
     //
-    sorted_children = _parent->children();
-    sort_by_template(sorted_children);
-    for (iter = sorted_children.begin();
-	    iter != sorted_children.end();
-	    ++iter) 
-    {
-	ConfigTreeNode* ctn = *iter;
-	if (ctn == this)
-	    break;		// We reached this node
-
-	// Ignore nodes that were deleted
-	if (ctn->deleted())
-	    continue;
-
-	// The previous node
-	prev = ctn;
-    }
+    prev = _parent->prev_undeleted_child(this);
 
     //
     // Found the previous (ordered) sibling
@@ -2589,23 +2603,7 @@ ConfigTreeNode::update_node_id_position()
     {
 	effective_parent = _parent->parent();
 	XLOG_ASSERT(effective_parent != NULL);
-	sorted_children = effective_parent->children();
-	sort_by_template(sorted_children);
-	for (iter = sorted_children.begin();
-		iter != sorted_children.end();
-		++iter) 
-	{
-	    ConfigTreeNode* ctn = *iter;
-	    if (ctn == _parent)
-		break;		// We reached the tag parent for this node
-
-	    // Ignore nodes that were deleted
-	    if (ctn->deleted())
-		continue;
-
-	    // The previous node
-	    prev = ctn;
-	}
+	prev = effective_parent->prev_undeleted_child(_parent);
     }
 
     if (prev == NULL)
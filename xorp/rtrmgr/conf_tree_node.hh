@@ -77,6 +77,11 @@ class ConfigTreeNode
 
 		void add_child(ConfigTreeNode* child);
 		void remove_child(ConfigTreeNode* child);
+		ConfigTreeNode* find_child(const string& segname);
+		size_t count_children_with_name(const string& segname) const 
+		{
+			return _children_index.count(segname);
+		}
 		void add_default_children();
 		void recursive_add_default_children();
 		bool check_allowed_value(string& error_msg) const;
@@ -203,6 +208,9 @@ class ConfigTreeNode
 		ConfigTreeNode* find_child_varname_node(const list<string>& var_parts,
 				VarType& type);
 		void sort_by_template(list<ConfigTreeNode*>& children) const;
+		list<ConfigTreeNode*>::const_iterator child_position(
+				const ConfigTreeNode* child) const;
+		ConfigTreeNode* prev_undeleted_child(const ConfigTreeNode* child) const;
 		string show_node_id(bool numbered, const ConfigNodeId& node_id) const;
 		virtual void allocate_unique_node_id();
 		string quoted_value(const string& value) const;
@@ -217,7 +225,10 @@ class ConfigTreeNode
 		string _segname;
 		string _path;
 		ConfigTreeNode* _parent;
-		list<ConfigTreeNode *> _children;
+		list<ConfigTreeNode *> _children;	// In template tree order
+		// The children by segment name, in the order they were added
+		typedef multimap<string, list<ConfigTreeNode *>::iterator> ChildIndex;
+		ChildIndex _children_index;
 		ConfigNodeId _node_id;
 		ConfigNodeId _node_id_generator;
 		uid_t _user_id;	// the user ID of the user who last changed this node
@@ -51,12 +51,14 @@
 #include "main_rtrmgr.hh"
 #include "master_conf_tree.hh"
 #include "module_manager.hh"
+#include "op_commands.hh"
 #include "randomness.hh"
 #include "rtrmgr_error.hh"
 #include "task.hh"
 #include "template_commands.hh"
 #include "master_template_tree.hh"
 #include "master_template_tree_node.hh"
+#include "slave_module_manager.hh"
 #include "userdb.hh"
 #include "util.hh"
 #include "xrl_rtrmgr_interface.hh"
@@ -77,6 +79,7 @@ static bool default_verbose = false;
 static string	module_dir;
 static string	command_dir;
 static string	template_dir;
+static string	cache_dir;		// The templates directory if empty
 static string	config_file;
 static string	xrl_targets_dir;	// for DEBUG_XRLDB
 
@@ -123,6 +126,7 @@ usage(const char* argv0)
     // This option is only for testing
     fprintf(stderr, "  -q <secs> Set forced quit period\n");
     fprintf(stderr, "  -r        Restart failed processes (not implemented yet)\n");
+    fprintf(stderr, "  -T <dir>  Specify parse cache directory\n");
     fprintf(stderr, "  -t <dir>  Specify templates directory\n");
     fprintf(stderr, "  -v        Print verbose information\n");
     // This option is only for testing
@@ -144,6 +148,8 @@ display_defaults()
 	    xorp_command_dir().c_str());
     fprintf(stderr, "  Templates directory        := %s\n",
 	    xorp_template_dir().c_str());
+    fprintf(stderr, "  Parse cache directory      := %s\n",
+	    "the templates directory");
 #ifdef DEBUG_XRLDB
     fprintf(stderr, "  Xrl targets directory      := %s\n",
 	    xorp_xrl_targets_dir().c_str());
@@ -176,6 +182,7 @@ add_cmd_action_adaptor(const string& cmd, const list<string>& action,
 Rtrmgr::Rtrmgr(const string& module_dir, 
 	const string& command_dir, 
 	const string& template_dir, 
+	const string& cache_dir, 
 	const string& xrl_targets_dir,
 	const string& config_file,
 	const list<IPv4>& bind_addrs,
@@ -188,6 +195,7 @@ Rtrmgr::Rtrmgr(const string& module_dir,
 : _module_dir(module_dir),
     _command_dir(command_dir),
     _template_dir(template_dir),
+    _cache_dir(cache_dir),
     _xrl_targets_dir(xrl_targets_dir),
     _config_file(config_file),
     _bind_addrs(bind_addrs),
@@ -238,6 +246,8 @@ Rtrmgr::run()
 	    command_dir.c_str());
     XLOG_TRACE(_verbose, "Templates directory        := %s\n",
 	    template_dir.c_str());
+    XLOG_TRACE(_verbose, "Parse cache directory      := %s\n",
+	    cache_dir.c_str());
     XLOG_TRACE(_verbose, "Execute Xrls               := %s\n",
 	    bool_c_str(do_exec));
     XLOG_TRACE(_verbose, "Restart failed processes   := %s\n",
@@ -271,13 +281,27 @@ Rtrmgr::run()
     MasterTemplateTree* tt = new MasterTemplateTree(xorp_config_root_dir(),
 	    DEBUG_XRLDB_INSTANCE,
 	    _verbose);
-    if (!tt->load_template_tree(_template_dir, errmsg)) 
+    if (!tt->load_template_tree(_template_dir, _cache_dir, errmsg)) 
     {
 	XLOG_ERROR("Shutting down due to an init error: %s", errmsg.c_str());
 	return (1);
     }
     debug_msg("%s", tt->tree_str().c_str());
 
+    //
+    // Bring the operational command cache up to date for xorpsh, which
+    // usually can't write to the cache directory.
+    //
+    {
+	SlaveModuleManager smm;
+	OpCommandList ocl(tt, smm);
+	if (ocl.read_templates(_template_dir, _cache_dir, errmsg) != XORP_OK) 
+	{
+	    XLOG_WARNING("Cannot read the operational command files: %s",
+		    errmsg.c_str());
+	}
+    }
+
     //
     // Start the finder and the rest of the rtrmgr components.
     // These are dynamically created so we have control over the
@@ -578,7 +602,7 @@ main(int argc, char* const argv[])
 #endif
 
     static const char* optstring =
-	"a:b:c:C:dhi:L:l:m:P:p:q:Nn:rt:v" RTRMGR_X_OPT;
+	"a:b:c:C:dhi:L:l:m:P:p:q:Nn:rT:t:v" RTRMGR_X_OPT;
     int c;
     while ((c = getopt(argc, argv, optstring)) != EOF) 
     {
@@ -634,6 +658,9 @@ main(int argc, char* const argv[])
 	    case 't':
 		template_dir = optarg;
 		break;
+	    case 'T':
+		cache_dir = optarg;
+		break;
 	    case 'b':
 		/* FALLTHROUGH */
 	    case 'c':
@@ -745,10 +772,14 @@ main(int argc, char* const argv[])
 
 
 
+    if (cache_dir.empty())
+	cache_dir = template_dir;
+
     //
     // The main procedure
     //
-    Rtrmgr rtrmgr(module_dir, command_dir, template_dir, xrl_targets_dir,
+    Rtrmgr rtrmgr(module_dir, command_dir, template_dir, cache_dir,
+	    xrl_targets_dir,
 	    config_file, bind_addrs,
 	    bind_port, do_exec, do_restart, verbose, quit_time,
 	    daemon_mode);
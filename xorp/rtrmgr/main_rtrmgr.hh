@@ -38,6 +38,7 @@ class Rtrmgr
 		Rtrmgr(const string& module_dir,
 				const string& command_dir,
 				const string& template_dir,
+				const string& cache_dir,
 				const string& xrl_targets_dir,
 				const string& config_file,
 				const list<IPv4>& bind_addrs,
@@ -60,6 +61,7 @@ class Rtrmgr
 		string	_module_dir;
 		string	_command_dir;
 		string	_template_dir;
+		string	_cache_dir;		// Parse cache directory
 		string	_xrl_targets_dir;        // Only used by DEBUG_XRLDB.
 		string	_config_file;
 		list<IPv4>	_bind_addrs;
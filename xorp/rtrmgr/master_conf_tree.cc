@@ -533,6 +533,41 @@ MasterConfigTree::order_module_list(const set<string>& module_set,
 	debug_msg("\n");
 }
 
+bool
+MasterConfigTree::module_depends_on(const string& module_name,
+		const string& other_module_name) const
+{
+	list<string> pending;
+	set<string> visited;
+
+	pending.push_back(module_name);
+	while (! pending.empty()) 
+	{
+		string name = pending.front();
+		pending.pop_front();
+		if (visited.find(name) != visited.end())
+			continue;
+		visited.insert(name);
+
+		ModuleCommand* mc = _template_tree->find_module(name);
+		if (mc == NULL)
+			continue;
+
+		list<string>::const_iterator di;
+		for (di = mc->depends().begin(); di != mc->depends().end(); ++di) 
+		{
+			ModuleCommand* depends_mc
+				= _template_tree->find_module_by_target_name(*di);
+			if (depends_mc == NULL)
+				return true;	// XXX: it could be any module
+			if (depends_mc->module_name() == other_module_name)
+				return true;
+			pending.push_back(depends_mc->module_name());
+		}
+	}
+	return false;
+}
+
 	void
 MasterConfigTree::commit_changes_pass1(CallBack cb)
 {
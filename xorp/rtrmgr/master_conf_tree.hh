@@ -126,6 +126,19 @@ class MasterConfigTree : public ConfigTree
 		return (MasterConfigTreeNode*)(ConfigTree::find_config_module(module_name));
 	}
 
+	/**
+	 * Test whether a module depends on another module, either directly
+	 * or through the modules it depends on.  A dependency may name a
+	 * module or its default target name, and a dependency that names
+	 * neither is taken as a dependency on every module.
+	 *
+	 * @param module_name the name of the module.
+	 * @param other_module_name the name of the other module.
+	 * @return true if the module depends on the other module.
+	 */
+	bool module_depends_on(const string& module_name,
+			const string& other_module_name) const;
+
 	/**
 	 * A callback to be called once when the initial config has been installed.
 	 */
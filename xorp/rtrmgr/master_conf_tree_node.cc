@@ -613,8 +613,8 @@ MasterConfigTreeNode::commit_changes(TaskManager& task_manager,
 	}
     }
 
+    // XXX: the children are kept sorted, but the commit may remove some
     list<ConfigTreeNode *> sorted_children = _children;
-    sort_by_template(sorted_children);
 
     list<ConfigTreeNode *>::iterator iter, prev_iter;
     iter = sorted_children.begin();
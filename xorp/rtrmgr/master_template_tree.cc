@@ -42,9 +42,10 @@ MasterTemplateTree::MasterTemplateTree(const string& xorp_root_dir,
 
 	bool 
 MasterTemplateTree::load_template_tree(const string& config_template_dir,
-		string& error_msg)
+		const string& cache_dir, string& error_msg)
 {
-	if (TemplateTree::load_template_tree(config_template_dir, error_msg)
+	if (TemplateTree::load_template_tree(config_template_dir, cache_dir,
+				error_msg)
 			!= true) 
 	{
 		return (false);
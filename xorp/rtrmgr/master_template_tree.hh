@@ -39,7 +39,7 @@ class MasterTemplateTree : public TemplateTree
 				bool verbose)  throw (InitError);
 
 		bool load_template_tree(const string& config_template_dir,
-				string& error_msg);
+				const string& cache_dir, string& error_msg);
 
 		void add_cmd(char* cmd) throw (ParseError);
 		void add_cmd_action(const string& cmd, const list<string>& action)
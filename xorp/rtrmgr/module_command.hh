@@ -53,6 +53,7 @@ class ModuleCommand : public Command
 
 		const string& module_name() const { return _module_name; }
 		const string& module_exec_path() const { return _module_exec_path; }
+		const string& default_target_name() const { return _default_target_name; }
 		const list<string>& depends() const { return _depends; }
 		int start_transaction(MasterConfigTreeNode& ctn,
 				TaskManager& task_manager) const;
@@ -26,6 +26,7 @@
 #include "libxorp/xlog.h"
 #include "libxorp/debug.h"
 #include "libxorp/run_command.hh"
+#include "libxorp/timer.hh"
 #include "libxorp/utils.hh"
 
 #include <glob.h>
@@ -39,6 +40,7 @@
 
 #include "cli.hh"
 #include "op_commands.hh"
+#include "parse_cache.hh"
 #include "slave_conf_tree.hh"
 #include "template_tree.hh"
 #include "slave_module_manager.hh"
@@ -51,6 +53,9 @@
 
 extern int init_opcmd_parser(const char *filename, OpCommandList *o);
 extern void parse_opcmd() throw (ParseError);
+extern void set_opcmd_parser_cache(ParseCache* cache);
+extern void replay_opcmd_parser(ParseCache& cache, OpCommandList* o)
+	throw (ParseError);
 extern int opcmderror(const char *s);
 
 OpInstance::OpInstance( OpCommand&			op_command,
@@ -592,6 +597,7 @@ OpCommand::remove_instance(OpInstance* instance)
 }
 
 OpCommandList::OpCommandList(const string& config_template_dir,
+		const string& cache_dir,
 		const TemplateTree* tt,
 		SlaveModuleManager& mmgr) throw (InitError)
 : _running_op_instances_n(0),
@@ -600,7 +606,7 @@ OpCommandList::OpCommandList(const string& config_template_dir,
 {
 	string errmsg;
 
-	if (read_templates(config_template_dir, errmsg) != XORP_OK)
+	if (read_templates(config_template_dir, cache_dir, errmsg) != XORP_OK)
 		xorp_throw(InitError, errmsg);
 }
 
@@ -615,7 +621,7 @@ OpCommandList::~OpCommandList()
 
 	int
 OpCommandList::read_templates(const string& config_template_dir,
-		string& errmsg)
+		const string& cache_dir, string& errmsg)
 {
 	list<string> files;
 
@@ -653,34 +659,90 @@ OpCommandList::read_templates(const string& config_template_dir,
 		return (XORP_ERROR);
 	}
 
-	for (size_t i = 0; i < (size_t)pglob.gl_pathc; i++) 
+	for (size_t i = 0; i < (size_t)pglob.gl_pathc; i++)
+		files.push_back(string(pglob.gl_pathv[i]));
+	globfree(&pglob);
+
+	TimeVal start_time, end_time;
+	TimerList::system_gettimeofday(&start_time);
+
+	//
+	// Replay the operational command cache if it is up to date,
+	// otherwise parse the command files and record a new cache. An
+	// empty cache directory disables the cache.
+	//
+	ParseCache cache(cache_dir + "/" + ParseCache::OP_COMMANDS_CACHE_FILENAME,
+			"opcmd");
+	string cache_errmsg = "no cache directory";
+	bool has_digest = false;
+	if (! cache_dir.empty())
+		has_digest = cache.compute_digest(files, cache_errmsg);
+	bool is_cached = false;
+	bool verbose = (_template_tree != NULL) && _template_tree->verbose();
+
+	if (has_digest && cache.load(cache_errmsg)) 
 	{
-		if (init_opcmd_parser(pglob.gl_pathv[i], this) < 0) 
-		{
-			globfree(&pglob);
-			errmsg = c_format("Failed to open template file: %s",
-					config_template_dir.c_str());
-			return (XORP_ERROR);
-		}
 		try 
 		{
-			parse_opcmd();
+			replay_opcmd_parser(cache, this);
 		} catch (const ParseError& pe) 
 		{
-			globfree(&pglob);
 			errmsg = pe.why();
 			return (XORP_ERROR);
 		}
-		if (_path_segments.size() != 0) 
+		is_cached = true;
+	} else 
+	{
+		XLOG_TRACE(verbose, "Not using the operational command cache: %s",
+				cache_errmsg.c_str());
+		if (has_digest)
+			set_opcmd_parser_cache(&cache);
+
+		list<string>::const_iterator iter;
+		for (iter = files.begin(); iter != files.end(); ++iter) 
+		{
+			if (init_opcmd_parser(iter->c_str(), this) < 0) 
+			{
+				set_opcmd_parser_cache(NULL);
+				errmsg = c_format("Failed to open template file: %s",
+						config_template_dir.c_str());
+				return (XORP_ERROR);
+			}
+			try 
+			{
+				parse_opcmd();
+			} catch (const ParseError& pe) 
+			{
+				set_opcmd_parser_cache(NULL);
+				errmsg = pe.why();
+				return (XORP_ERROR);
+			}
+			if (_path_segments.size() != 0) 
+			{
+				set_opcmd_parser_cache(NULL);
+				errmsg = c_format("File %s is not terminated properly",
+						iter->c_str());
+				return (XORP_ERROR);
+			}
+		}
+		set_opcmd_parser_cache(NULL);
+
+		if (has_digest && (! cache.save(cache_errmsg))) 
 		{
-			globfree(&pglob);
-			errmsg = c_format("File %s is not terminated properly",
-					pglob.gl_pathv[i]);
-			return (XORP_ERROR);
+			XLOG_TRACE(verbose, "Cannot save the operational command "
+					"cache: %s", cache_errmsg.c_str());
 		}
 	}
 
-	globfree(&pglob);
+	TimerList::system_gettimeofday(&end_time);
+	XLOG_TRACE(verbose, "Loaded %u operational command files (%u actions) "
+			"%s in %s seconds",
+			XORP_UINT_CAST(files.size()),
+			XORP_UINT_CAST(cache.entries_n()),
+			is_cached ? "from the cache" : "by parsing them",
+			(end_time - start_time).str().c_str());
+	UNUSED(is_cached);		// XXX: if the trace logs are disabled
+	UNUSED(verbose);
 
 	return (XORP_OK);
 }
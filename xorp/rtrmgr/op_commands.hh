@@ -181,7 +181,8 @@ class OpCommandList
 {
 	public:
 		OpCommandList(const TemplateTree* tt, SlaveModuleManager& mmgr);
-		OpCommandList(const string& config_template_dir, const TemplateTree* tt,
+		OpCommandList(const string& config_template_dir,
+				const string& cache_dir, const TemplateTree* tt,
 				SlaveModuleManager& mmgr) throw (InitError);
 		~OpCommandList();
 
@@ -189,7 +190,8 @@ class OpCommandList
 		void incr_running_op_instances_n();
 		void decr_running_op_instances_n();
 
-		int read_templates(const string& config_template_dir, string& errmsg);
+		int read_templates(const string& config_template_dir,
+				const string& cache_dir, string& errmsg);
 		void set_slave_config_tree(SlaveConfigTree* sct) { _slave_config_tree = sct; }
 		bool check_variable_name(const string& variable_name) const;
 		OpCommand* find_op_command(const list<string>& command_parts);
@@ -13,6 +13,7 @@
 #include "libxorp/utils.hh"
 
 #include "op_commands.hh"
+#include "parse_cache.hh"
 #include "util.hh"
 
 /* XXX: sigh - -p flag to yacc should do this for us */
@@ -43,6 +44,25 @@ static string help_string;
 
 static string opcmd_filename;
 static string lastsymbol;
+static ParseCache* opcmd_cache = NULL;
+
+/**
+ * The parser actions recorded in the operational command cache
+ */
+enum {
+    OPCMD_CACHE_FILE = 0,
+    OPCMD_CACHE_APPEND_PATH_WORD,
+    OPCMD_CACHE_APPEND_PATH_VARIABLE,
+    OPCMD_CACHE_PUSH_PATH,
+    OPCMD_CACHE_POP_PATH,
+    OPCMD_CACHE_ADD_CMD_MODULE,
+    OPCMD_CACHE_ADD_CMD_COMMAND,
+    OPCMD_CACHE_ADD_CMD_OPT_PARAMETER,
+    OPCMD_CACHE_ADD_CMD_TAG,
+    OPCMD_CACHE_ADD_CMD_HELP_TAG,
+    OPCMD_CACHE_ADD_CMD_HELP_STRING,
+    OPCMD_CACHE_SET_NOMORE_MODE
+};
 
 /**
  * Function declarations
@@ -86,6 +106,9 @@ add_cmd_help_string(char *s);
 static void
 set_nomore_mode(bool v);
 
+static void
+record_action(int op, const char *s1 = NULL, const char *s2 = NULL);
+
 void
 opcmderror(const char *s) throw (ParseError);
 
@@ -98,6 +121,12 @@ init_opcmd_parser(const char *filename, OpCommandList *o);
 void
 parse_opcmd() throw (ParseError);
 
+void
+set_opcmd_parser_cache(ParseCache* cache);
+
+void
+replay_opcmd_parser(ParseCache& cache, OpCommandList *o) throw (ParseError);
+
 %}
 
 %token UPLEVEL
@@ -243,6 +272,8 @@ resolve_tag(const string& tag, string& value)
 void
 append_path_word(char *s)
 {
+    record_action(OPCMD_CACHE_APPEND_PATH_WORD, s);
+
     string word = s;
     lastsymbol = s;
     free(s);
@@ -253,6 +284,8 @@ append_path_word(char *s)
 void
 append_path_variable(char *s)
 {
+    record_action(OPCMD_CACHE_APPEND_PATH_VARIABLE, s);
+
     string variable = s;
     lastsymbol = s;
     free(s);
@@ -268,6 +301,8 @@ append_path_variable(char *s)
 void
 push_path()
 {
+    record_action(OPCMD_CACHE_PUSH_PATH);
+
     if (! path_segments_stack.empty()) {
 	// Extend the nested path
 	list<string>& tmp_prefix = path_segments_stack.back();
@@ -297,6 +332,8 @@ pop_path()
 {
     string help;
 
+    record_action(OPCMD_CACHE_POP_PATH);
+
     if (op_command_stack.empty())
 	opcmderror("Invalid end of block");
 
@@ -344,6 +381,8 @@ pop_path()
 void
 add_cmd_module(char *s)
 {
+    record_action(OPCMD_CACHE_ADD_CMD_MODULE, s);
+
     string module = s;
     lastsymbol = s;
     free(s);
@@ -361,6 +400,8 @@ add_cmd_module(char *s)
 void
 add_cmd_command(char *s)
 {
+    record_action(OPCMD_CACHE_ADD_CMD_COMMAND, s);
+
     string command = s;
     lastsymbol = s;
     free(s);
@@ -465,6 +506,8 @@ add_cmd_command(char *s)
 void
 add_cmd_opt_parameter(char *s)
 {
+    record_action(OPCMD_CACHE_ADD_CMD_OPT_PARAMETER, s);
+
     string opt_parameter = s;
     lastsymbol = s;
     free(s);
@@ -495,6 +538,8 @@ add_cmd_opt_parameter(char *s)
 void
 add_cmd_tag(char *t, char *v)
 {
+    record_action(OPCMD_CACHE_ADD_CMD_TAG, t, v);
+
     string tag = t;
     string value = v;
     lastsymbol = v;
@@ -516,6 +561,8 @@ add_cmd_tag(char *t, char *v)
 void
 add_cmd_help_tag(char *s)
 {
+    record_action(OPCMD_CACHE_ADD_CMD_HELP_TAG, s);
+
     string tag = s;
     lastsymbol = s;
     free(s);
@@ -527,6 +574,8 @@ add_cmd_help_tag(char *s)
 void
 add_cmd_help_string(char *s)
 {
+    record_action(OPCMD_CACHE_ADD_CMD_HELP_STRING, s);
+
     string help = s;
     lastsymbol = s;
     free(s);
@@ -541,6 +590,8 @@ add_cmd_help_string(char *s)
 void
 set_nomore_mode(bool v)
 {
+    record_action(OPCMD_CACHE_SET_NOMORE_MODE, v ? "1" : "0");
+
     OpCommand& op_command = op_command_stack.back();
     op_command.set_default_nomore_mode(v);
 }
@@ -578,6 +629,7 @@ init_opcmd_parser(const char *filename, OpCommandList *o)
 	return -1;
 
     opcmd_filename = filename;
+    record_action(OPCMD_CACHE_FILE, filename);
     return 0;
 }
 
@@ -587,3 +639,118 @@ parse_opcmd() throw (ParseError)
     if (opcmdparse() != 0)
 	opcmderror("unknown error");
 }
+
+void
+set_opcmd_parser_cache(ParseCache* cache)
+{
+    opcmd_cache = cache;
+}
+
+void
+record_action(int op, const char *s1, const char *s2)
+{
+    if (opcmd_cache == NULL)
+	return;
+
+    vector<string> args;
+    if (s1 != NULL)
+	args.push_back(s1);
+    if (s2 != NULL)
+	args.push_back(s2);
+    opcmd_cache->record(op, opcmd_linenum, args);
+}
+
+//
+// Replay the parser actions from an operational command cache, instead
+// of parsing the command files.
+//
+// XXX: the actions are replayed by the same functions the parser calls,
+// so the executable files of the commands are looked up again.
+//
+void
+replay_opcmd_parser(ParseCache& cache, OpCommandList *o) throw (ParseError)
+{
+    ParseCache::Entry entry;
+
+    ocl = o;
+    opcmd_filename = cache.cache_filename();
+    opcmd_linenum = 0;
+    lastsymbol = "";
+
+    while (cache.next_entry(entry)) {
+	const vector<string>& args = entry.args;
+	size_t args_n = 0;
+
+	opcmd_linenum = entry.line;
+	switch (entry.op) {
+	case OPCMD_CACHE_FILE:
+	case OPCMD_CACHE_APPEND_PATH_WORD:
+	case OPCMD_CACHE_APPEND_PATH_VARIABLE:
+	case OPCMD_CACHE_ADD_CMD_MODULE:
+	case OPCMD_CACHE_ADD_CMD_COMMAND:
+	case OPCMD_CACHE_ADD_CMD_OPT_PARAMETER:
+	case OPCMD_CACHE_ADD_CMD_HELP_TAG:
+	case OPCMD_CACHE_ADD_CMD_HELP_STRING:
+	case OPCMD_CACHE_SET_NOMORE_MODE:
+	    args_n = 1;
+	    break;
+	case OPCMD_CACHE_ADD_CMD_TAG:
+	    args_n = 2;
+	    break;
+	case OPCMD_CACHE_PUSH_PATH:
+	case OPCMD_CACHE_POP_PATH:
+	    args_n = 0;
+	    break;
+	default:
+	    opcmderror(c_format("bad action %u in cache file %s",
+				XORP_UINT_CAST(entry.op),
+				cache.cache_filename().c_str()).c_str());
+	    break;
+	}
+	if (args.size() != args_n) {
+	    opcmderror(c_format("bad action %u in cache file %s",
+				XORP_UINT_CAST(entry.op),
+				cache.cache_filename().c_str()).c_str());
+	}
+
+	// XXX: the action functions free their arguments
+	switch (entry.op) {
+	case OPCMD_CACHE_FILE:
+	    opcmd_filename = args[0];
+	    break;
+	case OPCMD_CACHE_APPEND_PATH_WORD:
+	    append_path_word(strdup(args[0].c_str()));
+	    break;
+	case OPCMD_CACHE_APPEND_PATH_VARIABLE:
+	    append_path_variable(strdup(args[0].c_str()));
+	    break;
+	case OPCMD_CACHE_PUSH_PATH:
+	    push_path();
+	    break;
+	case OPCMD_CACHE_POP_PATH:
+	    pop_path();
+	    break;
+	case OPCMD_CACHE_ADD_CMD_MODULE:
+	    add_cmd_module(strdup(args[0].c_str()));
+	    break;
+	case OPCMD_CACHE_ADD_CMD_COMMAND:
+	    add_cmd_command(strdup(args[0].c_str()));
+	    break;
+	case OPCMD_CACHE_ADD_CMD_OPT_PARAMETER:
+	    add_cmd_opt_parameter(strdup(args[0].c_str()));
+	    break;
+	case OPCMD_CACHE_ADD_CMD_TAG:
+	    add_cmd_tag(strdup(args[0].c_str()), strdup(args[1].c_str()));
+	    break;
+	case OPCMD_CACHE_ADD_CMD_HELP_TAG:
+	    add_cmd_help_tag(strdup(args[0].c_str()));
+	    break;
+	case OPCMD_CACHE_ADD_CMD_HELP_STRING:
+	    add_cmd_help_string(strdup(args[0].c_str()));
+	    break;
+	case OPCMD_CACHE_SET_NOMORE_MODE:
+	    set_nomore_mode(args[0] == "1");
+	    break;
+	}
+    }
+}
@@ -0,0 +1,436 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+
+
+#include "rtrmgr_module.h"
+
+#include "libxorp/xorp.h"
+#include "libxorp/xlog.h"
+#include "libxorp/debug.h"
+#include "libxorp/c_format.hh"
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+// XXX: Needs HAVE_OPENSSL_MD5_H
+#include <openssl/md5.h>
+
+#include "parse_cache.hh"
+
+
+//
+// The layout of a cache file, with all integers in host byte order:
+//
+//   MAGIC
+//   uint32_t BYTE_ORDER_MARK
+//   string   the format (i.e., the parser)
+//   DIGEST   the digest of the parsed files
+//   DIGEST   the digest of the actions that follow
+//   uint32_t the number of actions
+//   uint32_t the length of the actions
+//   the actions
+//
+// A string is its uint32_t length followed by its bytes. An action is
+// its uint32_t opcode, line number and number of arguments, followed
+// by the arguments as strings.
+//
+const char ParseCache::MAGIC[8] = { 'X', 'O', 'R', 'P', 'P', 'C', '0', '1' };
+
+const string ParseCache::TEMPLATE_CACHE_FILENAME = "templates.cache";
+const string ParseCache::OP_COMMANDS_CACHE_FILENAME = "op_commands.cache";
+
+ParseCache::ParseCache(const string& cache_filename, const string& format)
+: _cache_filename(cache_filename),
+	_format(format),
+	_has_digest(false),
+	_entries_n(0),
+	_data(NULL),
+	_data_size(0),
+	_is_mapped(false),
+	_pos(NULL),
+	_end(NULL)
+{
+	memset(_digest, 0, sizeof(_digest));
+}
+
+ParseCache::~ParseCache()
+{
+	unload();
+}
+
+	bool
+ParseCache::compute_digest(const list<string>& filenames, string& error_msg)
+{
+	MD5_CTX md5_context;
+	list<string>::const_iterator iter;
+	char buf[8192];
+
+	MD5_Init(&md5_context);
+	for (iter = filenames.begin(); iter != filenames.end(); ++iter) 
+	{
+		const string& filename = *iter;
+		string header;
+
+		FILE* file = fopen(filename.c_str(), "r");
+		if (file == NULL) 
+		{
+			error_msg = c_format("Cannot open file %s: %s",
+					filename.c_str(), strerror(errno));
+			return (false);
+		}
+
+		// The file name is part of the digest, so is the file order
+		append_string(header, filename);
+		MD5_Update(&md5_context, header.data(), header.size());
+
+		size_t n;
+		while ((n = fread(buf, 1, sizeof(buf), file)) > 0)
+			MD5_Update(&md5_context, buf, n);
+		if (ferror(file)) 
+		{
+			error_msg = c_format("Cannot read file %s: %s",
+					filename.c_str(), strerror(errno));
+			fclose(file);
+			return (false);
+		}
+		fclose(file);
+
+		// Separate the contents of the file from the next file name
+		MD5_Update(&md5_context, MAGIC, sizeof(MAGIC));
+	}
+	MD5_Final(_digest, &md5_context);
+	_has_digest = true;
+
+	return (true);
+}
+
+	bool
+ParseCache::load(string& error_msg)
+{
+	XLOG_ASSERT(_has_digest);
+
+	unload();
+
+	int fd = open(_cache_filename.c_str(), O_RDONLY);
+	if (fd < 0) 
+	{
+		error_msg = c_format("Cannot open cache file %s: %s",
+				_cache_filename.c_str(), strerror(errno));
+		return (false);
+	}
+
+	struct stat file_data;
+	if ((fstat(fd, &file_data) < 0) || (file_data.st_size <= 0)) 
+	{
+		error_msg = c_format("Cannot use cache file %s: empty file",
+				_cache_filename.c_str());
+		close(fd);
+		return (false);
+	}
+	_data_size = file_data.st_size;
+
+#ifdef HAVE_SYS_MMAN_H
+	void* addr = mmap(NULL, _data_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (addr != MAP_FAILED) 
+	{
+		_data = static_cast<const uint8_t*>(addr);
+		_is_mapped = true;
+	}
+#endif // HAVE_SYS_MMAN_H
+	if (_data == NULL) 
+	{
+		uint8_t* buf = static_cast<uint8_t*>(malloc(_data_size));
+		ssize_t n = -1;
+		if (buf != NULL)
+			n = read(fd, buf, _data_size);
+		if ((n < 0) || (static_cast<size_t>(n) != _data_size)) 
+		{
+			error_msg = c_format("Cannot read cache file %s",
+					_cache_filename.c_str());
+			free(buf);
+			close(fd);
+			_data_size = 0;
+			return (false);
+		}
+		_data = buf;
+	}
+	close(fd);
+
+	_pos = _data;
+	_end = _data + _data_size;
+
+	//
+	// Verify the header
+	//
+	uint32_t byte_order_mark, entries_n, entries_len;
+	string format;
+	const uint8_t* digest;
+	const uint8_t* entries_digest;
+
+	if ((_data_size < sizeof(MAGIC))
+			|| (memcmp(_data, MAGIC, sizeof(MAGIC)) != 0)) 
+	{
+		error_msg = c_format("Cannot use cache file %s: bad magic",
+				_cache_filename.c_str());
+		unload();
+		return (false);
+	}
+	_pos += sizeof(MAGIC);
+
+	if ((! read_uint32(byte_order_mark))
+			|| (byte_order_mark != BYTE_ORDER_MARK)
+			|| (! read_string(format))
+			|| (format != _format)
+			|| (static_cast<size_t>(_end - _pos) < 2 * DIGEST_SIZE)) 
+	{
+		error_msg = c_format("Cannot use cache file %s: bad header",
+				_cache_filename.c_str());
+		unload();
+		return (false);
+	}
+	digest = _pos;
+	entries_digest = _pos + DIGEST_SIZE;
+	_pos += 2 * DIGEST_SIZE;
+
+	if (memcmp(digest, _digest, DIGEST_SIZE) != 0) 
+	{
+		error_msg = c_format("Cannot use cache file %s: the files have "
+				"been modified",
+				_cache_filename.c_str());
+		unload();
+		return (false);
+	}
+
+	if ((! read_uint32(entries_n))
+			|| (! read_uint32(entries_len))
+			|| (static_cast<size_t>(_end - _pos) != entries_len)) 
+	{
+		error_msg = c_format("Cannot use cache file %s: truncated file",
+				_cache_filename.c_str());
+		unload();
+		return (false);
+	}
+
+	//
+	// Verify the actions, so the replay doesn't stop half-way
+	// through a corrupted file.
+	//
+	uint8_t computed_digest[DIGEST_SIZE];
+	MD5_CTX md5_context;
+	MD5_Init(&md5_context);
+	MD5_Update(&md5_context, _pos, entries_len);
+	MD5_Final(computed_digest, &md5_context);
+	if (memcmp(entries_digest, computed_digest, DIGEST_SIZE) != 0) 
+	{
+		error_msg = c_format("Cannot use cache file %s: corrupted file",
+				_cache_filename.c_str());
+		unload();
+		return (false);
+	}
+
+	_entries_n = entries_n;
+
+	return (true);
+}
+
+	bool
+ParseCache::next_entry(Entry& entry)
+{
+	uint32_t args_n;
+
+	if ((_pos == NULL) || (_pos >= _end))
+		return (false);
+
+	entry.args.clear();
+	if ((! read_uint32(entry.op))
+			|| (! read_uint32(entry.line))
+			|| (! read_uint32(args_n))) 
+	{
+		_pos = _end;
+		return (false);
+	}
+	entry.args.resize(args_n);
+	for (uint32_t i = 0; i < args_n; i++) 
+	{
+		if (! read_string(entry.args[i])) 
+		{
+			_pos = _end;
+			return (false);
+		}
+	}
+
+	return (true);
+}
+
+	void
+ParseCache::record(uint32_t op, uint32_t line, const vector<string>& args)
+{
+	vector<string>::const_iterator iter;
+
+	append_uint32(_recorded, op);
+	append_uint32(_recorded, line);
+	append_uint32(_recorded, args.size());
+	for (iter = args.begin(); iter != args.end(); ++iter)
+		append_string(_recorded, *iter);
+	_entries_n++;
+}
+
+	void
+ParseCache::record(uint32_t op, uint32_t line)
+{
+	record(op, line, vector<string>());
+}
+
+	void
+ParseCache::record(uint32_t op, uint32_t line, const string& arg)
+{
+	record(op, line, vector<string>(1, arg));
+}
+
+	bool
+ParseCache::save(string& error_msg)
+{
+	XLOG_ASSERT(_has_digest);
+
+	string header;
+	uint8_t entries_digest[DIGEST_SIZE];
+	MD5_CTX md5_context;
+
+	MD5_Init(&md5_context);
+	MD5_Update(&md5_context, _recorded.data(), _recorded.size());
+	MD5_Final(entries_digest, &md5_context);
+
+	header.append(MAGIC, sizeof(MAGIC));
+	append_uint32(header, BYTE_ORDER_MARK);
+	append_string(header, _format);
+	header.append(reinterpret_cast<const char*>(_digest), DIGEST_SIZE);
+	header.append(reinterpret_cast<const char*>(entries_digest), DIGEST_SIZE);
+	append_uint32(header, _entries_n);
+	append_uint32(header, _recorded.size());
+
+	//
+	// Write a temporary file and rename it, so a concurrent reader
+	// never sees a partially written cache file.
+	//
+	string tmp_filename = c_format("%s.%u", _cache_filename.c_str(),
+			XORP_UINT_CAST(getpid()));
+	FILE* file = fopen(tmp_filename.c_str(), "w");
+	if (file == NULL) 
+	{
+		error_msg = c_format("Cannot create cache file %s: %s",
+				tmp_filename.c_str(), strerror(errno));
+		return (false);
+	}
+	if ((fwrite(header.data(), 1, header.size(), file) != header.size())
+			|| (fwrite(_recorded.data(), 1, _recorded.size(), file)
+				!= _recorded.size())) 
+	{
+		error_msg = c_format("Cannot write cache file %s: %s",
+				tmp_filename.c_str(), strerror(errno));
+		fclose(file);
+		unlink(tmp_filename.c_str());
+		return (false);
+	}
+	if (fclose(file) != 0) 
+	{
+		error_msg = c_format("Cannot write cache file %s: %s",
+				tmp_filename.c_str(), strerror(errno));
+		unlink(tmp_filename.c_str());
+		return (false);
+	}
+	if (rename(tmp_filename.c_str(), _cache_filename.c_str()) != 0) 
+	{
+		error_msg = c_format("Cannot rename cache file %s to %s: %s",
+				tmp_filename.c_str(), _cache_filename.c_str(),
+				strerror(errno));
+		unlink(tmp_filename.c_str());
+		return (false);
+	}
+
+	return (true);
+}
+
+	void
+ParseCache::unload()
+{
+	if (_data != NULL) 
+	{
+#ifdef HAVE_SYS_MMAN_H
+		if (_is_mapped)
+			munmap(const_cast<uint8_t*>(_data), _data_size);
+		else
+#endif
+			free(const_cast<uint8_t*>(_data));
+	}
+	_data = NULL;
+	_data_size = 0;
+	_is_mapped = false;
+	_pos = NULL;
+	_end = NULL;
+}
+
+	bool
+ParseCache::read_uint32(uint32_t& value)
+{
+	if (static_cast<size_t>(_end - _pos) < sizeof(value))
+		return (false);
+
+	// XXX: the data may not be aligned
+	memcpy(&value, _pos, sizeof(value));
+	_pos += sizeof(value);
+
+	return (true);
+}
+
+	bool
+ParseCache::read_string(string& value)
+{
+	uint32_t len;
+
+	if (! read_uint32(len))
+		return (false);
+	if (static_cast<size_t>(_end - _pos) < len)
+		return (false);
+
+	value.assign(reinterpret_cast<const char*>(_pos), len);
+	_pos += len;
+
+	return (true);
+}
+
+	void
+ParseCache::append_uint32(string& buffer, uint32_t value)
+{
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+	void
+ParseCache::append_string(string& buffer, const string& value)
+{
+	append_uint32(buffer, value.size());
+	buffer.append(value);
+}
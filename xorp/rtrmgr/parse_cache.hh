@@ -0,0 +1,163 @@
+// -*- c-basic-offset: 4; tab-width: 8; indent-tabs-mode: t -*-
+
+// Copyright (c) 2001-2011 XORP, Inc and Others
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License, Version 2, June
+// 1991 as published by the Free Software Foundation. Redistribution
+// and/or modification of this program under the terms of any other
+// version of the GNU General Public License is not permitted.
+//
+// This program is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. For more details,
+// see the GNU General Public License, Version 2, a copy of which can be
+// found in the XORP LICENSE.gpl file.
+//
+// XORP Inc, 2953 Bunker Hill Lane, Suite 204, Santa Clara, CA 95054, USA;
+// http://xorp.net
+
+#ifndef __RTRMGR_PARSE_CACHE_HH__
+#define __RTRMGR_PARSE_CACHE_HH__
+
+
+#include "libxorp/xorp.h"
+
+
+/**
+ * @short A precompiled form of a set of parsed files.
+ *
+ * The template and the operational command files are parsed into a
+ * sequence of parser actions (e.g., "extend the path with segment X",
+ * "add command Y"). While the files are parsed the actions are
+ * recorded, and saved in a cache file together with a digest of the
+ * names and the contents of the files. The next time the same files
+ * are loaded, the cache file is memory-mapped and the actions are
+ * replayed, without running the lexer and the parser. The cache file
+ * is ignored if any of the files was added, removed or modified.
+ *
+ * Each action is an opcode, the line number it came from (for the
+ * error messages), and a list of string arguments. The meaning of the
+ * opcodes is up to the parser.
+ */
+class ParseCache : public NONCOPYABLE
+{
+	public:
+		/**
+		 * @short A parser action.
+		 */
+		struct Entry
+		{
+			uint32_t	op;	// The parser specific opcode
+			uint32_t	line;	// The line number in the file
+			vector<string>	args;	// The arguments
+		};
+
+		/**
+		 * Constructor.
+		 *
+		 * @param cache_filename the name of the cache file.
+		 * @param format the name of the parser the cache is for. A
+		 * cache file written for another parser is ignored.
+		 */
+		ParseCache(const string& cache_filename, const string& format);
+
+		/**
+		 * Destructor.
+		 */
+		~ParseCache();
+
+		/**
+		 * Compute the digest of a set of files.
+		 *
+		 * @param filenames the names of the files, in the order they
+		 * are parsed.
+		 * @param error_msg the error message (if error).
+		 * @return true on success, otherwise false.
+		 */
+		bool compute_digest(const list<string>& filenames,
+				string& error_msg);
+
+		/**
+		 * Map the cache file, and verify that it is valid for the
+		 * digest computed by @ref compute_digest().
+		 *
+		 * @param error_msg the reason the cache file is not used
+		 * (if error).
+		 * @return true if the cache file may be replayed, otherwise
+		 * false.
+		 */
+		bool load(string& error_msg);
+
+		/**
+		 * Get the next action from the mapped cache file.
+		 *
+		 * @param entry the entry to store the action.
+		 * @return true if an action was stored, or false if there
+		 * are no more actions.
+		 */
+		bool next_entry(Entry& entry);
+
+		/**
+		 * Record an action.
+		 *
+		 * @param op the opcode of the action.
+		 * @param line the line number of the action.
+		 * @param args the arguments of the action.
+		 */
+		void record(uint32_t op, uint32_t line, const vector<string>& args);
+		void record(uint32_t op, uint32_t line);
+		void record(uint32_t op, uint32_t line, const string& arg);
+
+		/**
+		 * Save the recorded actions to the cache file.
+		 *
+		 * The file is written under a temporary name and renamed,
+		 * so a concurrent reader sees either the old or the new file.
+		 *
+		 * @param error_msg the error message (if error).
+		 * @return true on success, otherwise false.
+		 */
+		bool save(string& error_msg);
+
+		/**
+		 * @return the number of recorded or mapped actions.
+		 */
+		size_t entries_n() const { return (_entries_n); }
+
+		/**
+		 * @return the name of the cache file.
+		 */
+		const string& cache_filename() const { return (_cache_filename); }
+
+		// The names of the cache files in the cache directory
+		static const string	TEMPLATE_CACHE_FILENAME;
+		static const string	OP_COMMANDS_CACHE_FILENAME;
+
+	private:
+		void unload();
+		bool read_uint32(uint32_t& value);
+		bool read_string(string& value);
+		static void append_uint32(string& buffer, uint32_t value);
+		static void append_string(string& buffer, const string& value);
+
+		static const char	MAGIC[8];
+		static const uint32_t	BYTE_ORDER_MARK = 0x01020304;
+		static const size_t	DIGEST_SIZE = 16;
+
+		string		_cache_filename;
+		string		_format;
+		uint8_t		_digest[DIGEST_SIZE];	// The digest of the files
+		bool		_has_digest;
+
+		string		_recorded;		// The recorded actions
+		size_t		_entries_n;
+
+		const uint8_t*	_data;			// The mapped cache file
+		size_t		_data_size;
+		bool		_is_mapped;		// True if _data is mmap()-ed
+		const uint8_t*	_pos;			// The next action to read
+		const uint8_t*	_end;			// The end of the actions
+};
+
+#endif // __RTRMGR_PARSE_CACHE_HH__
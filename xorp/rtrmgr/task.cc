@@ -1347,6 +1347,9 @@ TaskXrlItem::TaskXrlItem(const UnexpandedXrl& uxrl,
 	_xrl_resend_count_limit(xrl_resend_count),
 	_xrl_resend_count(_xrl_resend_count_limit),
 	_xrl_resend_delay_ms(xrl_resend_delay_ms),
+	_is_sent(false),
+	_is_pipelined(false),
+	_is_resend_pending(false),
 	_verbose(task.verbose())
 {
 }
@@ -1358,6 +1361,9 @@ TaskXrlItem::TaskXrlItem(const UnexpandedXrl& uxrl,
 	_xrl_resend_count_limit(them._xrl_resend_count_limit),
 	_xrl_resend_count(_xrl_resend_count_limit),
 	_xrl_resend_delay_ms(them._xrl_resend_delay_ms),
+	_is_sent(false),
+	_is_pipelined(false),
+	_is_resend_pending(false),
 	_verbose(them._verbose)
 {
 }
@@ -1381,6 +1387,9 @@ TaskXrlItem::execute(string& errmsg)
 	string xrl_return_spec = _unexpanded_xrl.return_spec();
 
 	_xrl_resend_count = _xrl_resend_count_limit;
+	_is_pipelined = (xrl_return_spec.empty()
+			&& task().xorp_client().is_resolved(*xrl));
+	_is_sent = true;
 	task().xorp_client().send_now(*xrl,
 			callback(this, &TaskXrlItem::execute_done),
 			xrl_return_spec,
@@ -1402,11 +1411,63 @@ TaskXrlItem::unschedule()
 	_xrl_callback->dispatch(XrlError::OKAY(), &xrl_args);
 }
 
+//
+// An XRL whose return values are not used may be sent before the
+// replies to the earlier XRLs of the same task are received. The XRLs
+// after one that returns values may refer to those values, hence they
+// wait for its reply.
+//
+// XXX: the XrlRouter sends an XRL that is not in the Finder cache only
+// after the Finder replies, so the XRLs sent after it may overtake it.
+// Hence an XRL that is not resolved yet, or that is being resent, is
+// always sent on its own.
+//
+	bool
+TaskXrlItem::is_pipelined() const
+{
+	if (_is_sent)
+		return (_is_pipelined);
+
+	if (! _unexpanded_xrl.return_spec().empty())
+		return (false);
+
+	string errmsg;
+	Xrl* xrl = _unexpanded_xrl.expand(errmsg);
+	if (xrl == NULL)
+		return (false);
+
+	return (task().xorp_client().is_resolved(*xrl));
+}
+
+	void
+TaskXrlItem::items_drained()
+{
+	if (! _is_resend_pending)
+		return;
+
+	// Resend from the eventloop, not from within Task::item_done()
+	_is_resend_pending = false;
+	_xrl_resend_timer = EventLoop::instance().new_oneoff_after_ms(
+			0,
+			callback(this, &TaskXrlItem::resend));
+}
+
 	void
 TaskXrlItem::resend()
 {
 	string errmsg;
 
+	//
+	// The XRL is resent once the other XRLs of the task that are in
+	// progress are done, and no XRL is sent until it is done.
+	//
+	_is_pipelined = false;
+	if (! task().is_only_running_item(this)) 
+	{
+		_is_resend_pending = true;
+		return;
+	}
+
 	Xrl* xrl = _unexpanded_xrl.expand(errmsg);
 	if (xrl == NULL) 
 	{
@@ -1468,6 +1529,7 @@ TaskXrlItem::execute_done(const XrlError& err, XrlArgs* xrl_args)
 			if (--_xrl_resend_count > 0) 
 			{
 				// Re-send the Xrl after a short delay.
+				_is_pipelined = false;
 				_xrl_resend_timer = EventLoop::instance().new_oneoff_after_ms(
 						_xrl_resend_delay_ms,
 						callback(this, &TaskXrlItem::resend));
@@ -1503,7 +1565,7 @@ TaskXrlItem::execute_done(const XrlError& err, XrlArgs* xrl_args)
 		success = false;
 		errmsg = err.str();
 	}
-	task().item_done(success, fatal, errmsg);
+	task().item_done(this, success, fatal, errmsg);
 }
 
 
@@ -1686,13 +1748,15 @@ TaskProgramItem::execute_done(bool success)
 				task().do_exec());
 	}
 
-	task().item_done(success, fatal, _command_stderr);
+	task().item_done(this, success, fatal, _command_stderr);
 }
 
 
 // ----------------------------------------------------------------------------
 // Task implementation
 
+const size_t	Task::MAX_ITEMS_IN_FLIGHT = 32;
+
 	Task::Task(const string& name, TaskManager& taskmgr)
 : _name(name),
 	_taskmgr(taskmgr),
@@ -1704,6 +1768,9 @@ TaskProgramItem::execute_done(bool success)
 	_shutdown_validation(NULL),
 	_startup_method(NULL),
 	_shutdown_method(NULL),
+	_is_executing_items(false),
+	_item_failed(false),
+	_item_fatal(false),
 	_config_done(false),
 	_exec_id(taskmgr.exec_id()),
 	_verbose(taskmgr.verbose())
@@ -1726,6 +1793,7 @@ Task::~Task()
 		delete _shutdown_method;
 
 	delete_pointers_list(_task_items);
+	delete_pointers_list(_running_items);
 }
 
 	void
@@ -1789,6 +1857,8 @@ Task::run(CallBack cb)
 	debug_msg("Task::run (%s)\n", _module_name.c_str());
 
 	_task_complete_cb = cb;
+	TimerList::system_gettimeofday(&_start_time);
+	_phase_start = _start_time;
 	step1_start();
 }
 
@@ -1813,6 +1883,7 @@ Task::step1_done(bool success)
 {
 	debug_msg("step1_done (%s)\n", _module_name.c_str());
 
+	phase_done("start");
 	if (success)
 		step2_wait();
 	else
@@ -1839,6 +1910,7 @@ Task::step2_done(bool success)
 {
 	debug_msg("step2_done (%s)\n", _module_name.c_str());
 
+	phase_done("startup-validation");
 	if (success)
 		step2_2_wait();
 	else
@@ -1865,6 +1937,7 @@ Task::step2_2_done(bool success)
 {
 	debug_msg("step2_2_done (%s)\n", _module_name.c_str());
 
+	phase_done("startup");
 	if (success)
 		step2_3_wait();
 	else
@@ -1891,6 +1964,7 @@ Task::step2_3_done(bool success)
 {
 	debug_msg("step2_3_done (%s)\n", _module_name.c_str());
 
+	phase_done("config-validation");
 	if (success)
 		step3_config();
 	else
@@ -1903,59 +1977,137 @@ Task::step3_config()
 {
 	debug_msg("step3 (%s)\n", _module_name.c_str());
 
-	if (_task_items.empty()) 
+	if (_stop_module && (! _task_items.empty())) 
 	{
-		step4_wait();
-	} else 
-	{
-		if (_stop_module) 
-		{
-			//
-			// We don't call any task items on a module if we are going to
-			// shut it down immediately afterwards, but we do need to
-			// unschedule the task items.
-			//
-			while (! _task_items.empty()) 
-			{
-				TaskBaseItem* task_base_item = _task_items.front();
-				task_base_item->unschedule();
-				delete task_base_item;
-				_task_items.pop_front();
-			}
-			// Skip step4 and go directly to stopping the process
-			step5_stop();
-		} else 
+		//
+		// We don't call any task items on a module if we are going to
+		// shut it down immediately afterwards, but we do need to
+		// unschedule the task items.
+		//
+		while (! _task_items.empty()) 
 		{
-			string errmsg;
-			debug_msg("step3: execute\n");
+			TaskBaseItem* task_base_item = _task_items.front();
+			task_base_item->unschedule();
+			delete task_base_item;
+			_task_items.pop_front();
+		}
+		// Skip step4 and go directly to stopping the process
+		step5_stop();
+		return;
+	}
 
-			if (_task_items.front()->execute(errmsg) == false) 
-			{
-				XLOG_WARNING("Failed to execute task item: %s",
-						errmsg.c_str());
-				task_fail(errmsg, false);
-				return;
-			}
+	//
+	// XXX: an item may be done before it returns from execute(), in
+	// which case the loop below carries on with the next items.
+	//
+	if (_is_executing_items)
+		return;
+
+	_is_executing_items = true;
+	while ((! _task_items.empty()) && (! _item_failed)
+			&& may_execute_item(_task_items.front())) 
+	{
+		string errmsg;
+		debug_msg("step3: execute\n");
+
+		TaskBaseItem* task_base_item = _task_items.front();
+		_task_items.pop_front();
+		_running_items.push_back(task_base_item);
+		if (task_base_item->execute(errmsg) == false) 
+		{
+			XLOG_WARNING("Failed to execute task item: %s",
+					errmsg.c_str());
+			_running_items.remove(task_base_item);
+			delete task_base_item;
+			_item_failed = true;
+			_item_errmsg = errmsg;
 		}
 	}
+	_is_executing_items = false;
+
+	// Wait for the items in progress
+	if (! _running_items.empty())
+		return;
+
+	if (_item_failed) 
+	{
+		task_fail(_item_errmsg, _item_fatal);
+		return;
+	}
+
+	if (_task_items.empty()) 
+	{
+		if (_config_done)
+			phase_done("config");
+		step4_wait();
+	}
+}
+
+//
+// The items are executed in order. The first item is executed on its
+// own, so that the module is known to respond before the next items
+// are sent. Then the items that may be pipelined are sent without
+// waiting for the earlier ones to be done, up to a limit, as long as
+// all the items in progress are pipelined too.
+//
+	bool
+Task::may_execute_item(const TaskBaseItem* item) const
+{
+	if (_running_items.empty())
+		return (true);
+
+	if ((! do_exec()) || (! _config_done))
+		return (false);
+	if (_running_items.size() >= MAX_ITEMS_IN_FLIGHT)
+		return (false);
+
+	// An item that isn't pipelined is always executed on its own
+	list<TaskBaseItem *>::const_iterator iter;
+	for (iter = _running_items.begin(); iter != _running_items.end(); ++iter) 
+	{
+		if (! (*iter)->is_pipelined())
+			return (false);
+	}
+	if (! item->is_pipelined())
+		return (false);
+
+	return (true);
+}
+
+	bool
+Task::is_only_running_item(const TaskBaseItem* item) const
+{
+	return ((_running_items.size() == 1) && (_running_items.front() == item));
 }
 
 	void
-Task::item_done(bool success, bool fatal, const string& errmsg)
+Task::item_done(TaskBaseItem* item, bool success, bool fatal,
+		const string& errmsg)
 {
 	debug_msg("item_done (%s)\n", _module_name.c_str());
 
+	_running_items.remove(item);
+	delete item;
+
+	// An item that waits for the other items to be done may proceed
+	if (_running_items.size() == 1)
+		_running_items.front()->items_drained();
+
 	if (success) 
 	{
-		TaskBaseItem* task_base_item = _task_items.front();
-		_task_items.pop_front();
-		delete task_base_item;
 		_config_done = true;
-		step3_config();
 	} else 
 	{
-		task_fail(errmsg, fatal);
+		//
+		// Keep the first error, and report it once the items that are
+		// still in progress are done.
+		//
+		if (! _item_failed)
+			_item_errmsg = errmsg;
+		_item_failed = true;
+		_item_fatal = _item_fatal || fatal;
 	}
+	step3_config();
 }
 
 	void
@@ -1978,6 +2130,7 @@ Task::step4_done(bool success)
 {
 	debug_msg("step4_done (%s)\n", _module_name.c_str());
 
+	phase_done("ready-validation");
 	if (success) 
 	{
 		step5_stop();
@@ -2079,6 +2232,17 @@ Task::step8_report()
 
 	debug_msg("Task done\n");
 
+	if (_stop_module)
+		phase_done("shutdown");
+	if (do_exec()) 
+	{
+		TimeVal now;
+		TimerList::system_gettimeofday(&now);
+		XLOG_TRACE(_verbose, "Task %s done in %s seconds:%s\n",
+				_name.c_str(), (now - _start_time).str().c_str(),
+				_phase_times.c_str());
+	}
+
 	_task_complete_cb->dispatch(true, "");
 }
 
@@ -2114,6 +2278,17 @@ Task::xorp_client() const
 	return _taskmgr.xorp_client();
 }
 
+	void
+Task::phase_done(const string& phase)
+{
+	TimeVal now;
+
+	TimerList::system_gettimeofday(&now);
+	_phase_times += c_format(" %s %s", phase.c_str(),
+			(now - _phase_start).str().c_str());
+	_phase_start = now;
+}
+
 
 
 
@@ -2128,7 +2303,10 @@ TaskManager::TaskManager(MasterConfigTree& config_tree, ModuleManager& mmgr,
 	_xorp_client(xclient),
 	_global_do_exec(global_do_exec),
 	_is_verification(false),
-	_verbose(verbose)
+	_verbose(verbose),
+	_is_starting_tasks(false),
+	_task_failed(false),
+	_max_running_tasks(0)
 {
 }
 
@@ -2154,6 +2332,12 @@ TaskManager::reset()
 	}
 	_shutdown_order.clear();
 	_tasklist.clear();
+	_task_depends.clear();
+	_running_tasks.clear();
+	_done_tasks.clear();
+	_task_failed = false;
+	_task_errmsg = "";
+	_max_running_tasks = 0;
 	_exec_id.reset();
 }
 
@@ -2285,7 +2469,10 @@ TaskManager::run(CallBack cb)
 		debug_msg("%s", debug_output.c_str());
 	}
 
+	find_task_depends();
+
 	_completion_cb = cb;
+	TimerList::system_gettimeofday(&_run_start);
 	run_task();
 }
 
@@ -2325,35 +2512,140 @@ TaskManager::reorder_tasks()
 	}
 }
 
+//
+// Find the tasks that each task must wait for. A task waits for the
+// earlier tasks of the modules its module depends on, as declared in
+// the templates, hence the tasks of independent modules are run at the
+// same time. The process shutdowns are run one at a time after all
+// other tasks. If nothing is executed, the tasks are run one at a
+// time, because XorpClient fakes only one XRL reply at a time.
+//
 	void
-TaskManager::run_task()
+TaskManager::find_task_depends()
 {
-	debug_msg("TaskManager::run_task()\n");
+	list<Task*>::const_iterator iter, prev_iter;
 
-	if (_tasklist.empty()) 
+	_task_depends.clear();
+	for (iter = _tasklist.begin(); iter != _tasklist.end(); ++iter) 
 	{
-		if (! is_verification())
-			XLOG_INFO("No more tasks to run\n");
-		_completion_cb->dispatch(true, "");
-		return;
+		Task* task = *iter;
+		set<Task*>& depends = _task_depends[task];
+		bool has_module_info = (_module_commands.find(task->name())
+				!= _module_commands.end());
+
+		for (prev_iter = _tasklist.begin(); prev_iter != iter; ++prev_iter) 
+		{
+			Task* prev_task = *prev_iter;
+			if ((! do_exec())
+					|| task->will_shutdown_module()
+					|| prev_task->will_shutdown_module()
+					|| (! has_module_info)
+					|| _config_tree.module_depends_on(task->name(),
+						prev_task->name())) 
+			{
+				debug_msg("task %s waits for task %s\n",
+						task->name().c_str(), prev_task->name().c_str());
+				depends.insert(prev_task);
+			}
+		}
+	}
+}
+
+	bool
+TaskManager::task_is_ready(Task* task) const
+{
+	map<Task*, set<Task*> >::const_iterator depends_iter;
+	set<Task*>::const_iterator iter;
+
+	depends_iter = _task_depends.find(task);
+	if (depends_iter == _task_depends.end())
+		return (true);
+
+	for (iter = depends_iter->second.begin();
+			iter != depends_iter->second.end();
+			++iter) 
+	{
+		if (_done_tasks.find(*iter) == _done_tasks.end())
+			return (false);
 	}
-	_tasklist.front()->run(callback(this, &TaskManager::task_done));
+	return (true);
 }
 
 	void
-TaskManager::task_done(bool success, const string& errmsg)
+TaskManager::run_task()
 {
-	assert_not_deleted();
-	debug_msg("TaskManager::task_done, success: %i errmsg: %s\n", (int)(success), errmsg.c_str());
+	debug_msg("TaskManager::run_task()\n");
 
-	if (! success) 
+	//
+	// XXX: a task may be done before it returns from run(), in which
+	// case the loop below carries on with the next tasks.
+	//
+	if (_is_starting_tasks)
+		return;
+
+	//
+	// Start all tasks that don't wait for other tasks. No new task is
+	// started after a task failed.
+	//
+	_is_starting_tasks = true;
+	list<Task*>::iterator iter = _tasklist.begin();
+	while ((iter != _tasklist.end()) && (! _task_failed)) 
+	{
+		Task* task = *iter;
+		if (! task_is_ready(task)) 
+		{
+			++iter;
+			continue;
+		}
+		_tasklist.erase(iter);
+		_running_tasks.insert(task);
+		if (_running_tasks.size() > _max_running_tasks)
+			_max_running_tasks = _running_tasks.size();
+		task->run(callback(this, &TaskManager::task_done, task));
+		// Start again, because the task may be done already
+		iter = _tasklist.begin();
+	}
+	_is_starting_tasks = false;
+
+	// Wait for the tasks in progress
+	if (! _running_tasks.empty())
+		return;
+
+	if (_task_failed) 
 	{
 		debug_msg("task failed\n");
+		string errmsg = _task_errmsg;
 		_completion_cb->dispatch(false, errmsg);
 		reset();
 		return;
 	}
-	if (_tasklist.empty()) 
+
+	if (! _tasklist.empty()) 
+	{
+		// A task can only wait for the tasks before it
+		XLOG_UNREACHABLE();
+	}
+
+	if (! is_verification()) 
+	{
+		TimeVal now;
+		TimerList::system_gettimeofday(&now);
+		XLOG_TRACE(_verbose, "Tasks done in %s seconds, up to %u tasks "
+				"at the same time\n",
+				(now - _run_start).str().c_str(),
+				XORP_UINT_CAST(_max_running_tasks));
+		XLOG_INFO("No more tasks to run\n");
+	}
+	_completion_cb->dispatch(true, "");
+}
+
+	void
+TaskManager::task_done(bool success, const string& errmsg, Task* task)
+{
+	assert_not_deleted();
+	debug_msg("TaskManager::task_done, success: %i errmsg: %s\n", (int)(success), errmsg.c_str());
+
+	if (_running_tasks.erase(task) == 0) 
 	{
 		/** This indicates we are badly out of sync.  We got some callback we
 		 * weren't expecting, basically.  That this happens with the scenario below
@@ -2365,13 +2657,20 @@ TaskManager::task_done(bool success, const string& errmsg)
 		 * 4. use cli command "delete protocol static" to stop static. both xorp_static_routes
 		 *    were terminated. depended process like fea, rib and policy were also terminated. rtrmgr crash.
 		 *
-		 * With this check for empty task list, it at least doesn't crash, but the logic is still busted somewhere.
+		 * With this check for a task that isn't running, it at least doesn't crash, but the logic is still busted somewhere.
 		 */
-		XLOG_ERROR("ERROR:  _tasklist empty in TaskManager::task_done.");
+		XLOG_ERROR("ERROR:  task %s isn't running in TaskManager::task_done.",
+				task->name().c_str());
+		return;
 	}
-	else 
+	_done_tasks.insert(task);
+	debug_msg("task %s done\n", task->name().c_str());
+
+	if ((! success) && (! _task_failed)) 
 	{
-		_tasklist.pop_front();
+		// Keep the first error, and report it once all tasks are done
+		_task_failed = true;
+		_task_errmsg = errmsg;
 	}
 	run_task();
 }
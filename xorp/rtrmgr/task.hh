@@ -361,7 +361,22 @@ class TaskBaseItem
 		virtual bool execute(string& errmsg) = 0;
 		virtual void unschedule() = 0;
 
-		Task& task() { return (_task); }
+		/**
+		 * Test whether the item may be executed while other items
+		 * of the same task are still in progress.
+		 *
+		 * @return true if the item may be pipelined with other items.
+		 */
+		virtual bool is_pipelined() const { return false; }
+
+		/**
+		 * Method invoked when the other items of the same task that
+		 * were in progress are done, and the item is the only item in
+		 * progress.
+		 */
+		virtual void items_drained() {}
+
+		Task& task() const { return (_task); }
 
 	private:
 		Task&	_task;
@@ -380,6 +395,8 @@ class TaskXrlItem : public TaskBaseItem
 		void execute_done(const XrlError& err, XrlArgs* xrl_args);
 		void resend();
 		void unschedule();
+		bool is_pipelined() const;
+		void items_drained();
 
 	private:
 		static const uint32_t	DEFAULT_RESEND_COUNT;
@@ -391,6 +408,9 @@ class TaskXrlItem : public TaskBaseItem
 		uint32_t			_xrl_resend_count;
 		int				_xrl_resend_delay_ms;
 		XorpTimer			_xrl_resend_timer;
+		bool			_is_sent;   // True if the XRL was sent
+		bool			_is_pipelined; // True if sent pipelined
+		bool			_is_resend_pending; // True if waiting to resend
 		bool			_verbose;   // Set to true if output is verbose
 };
 
@@ -443,8 +463,10 @@ class Task
 		Validation* ready_validation() const { return _ready_validation; }
 		bool will_shutdown_module() const { return _stop_module; }
 		void run(CallBack cb);
-		void item_done(bool success, bool fatal, const string& errmsg); 
+		void item_done(TaskBaseItem* item, bool success, bool fatal,
+				const string& errmsg);
 		bool do_exec() const;
+		bool is_only_running_item(const TaskBaseItem* item) const;
 		bool is_verification() const;
 		XorpClient& xorp_client() const;
 
@@ -498,7 +520,15 @@ class Task
 		void step8_report();
 		void task_fail(const string& errmsg, bool fatal);
 
+		bool may_execute_item(const TaskBaseItem* item) const;
+		void phase_done(const string& phase);
+
 	private:
+		//
+		// The maximum number of task items in progress at the same time.
+		//
+		static const size_t	MAX_ITEMS_IN_FLIGHT;
+
 		string	_name;		// The name of the task
 		TaskManager& _taskmgr;
 		string	_module_name;	// The name of the module to start and stop
@@ -515,10 +545,18 @@ class Task
 		Startup*	_startup_method;
 		Shutdown*	_shutdown_method;
 		list<TaskBaseItem *> _task_items;
+		list<TaskBaseItem *> _running_items; // The items in progress
+		bool	_is_executing_items; // True while the items are executed
+		bool	_item_failed;	// True if one of the items failed
+		bool	_item_fatal;	// True if the failure was fatal
+		string	_item_errmsg;	// The error message of the failure
 		bool	_config_done;	// True if we changed the module's config
 		CallBack	_task_complete_cb; // The task completion callback
 		XorpTimer	_wait_timer;
 		RunShellCommand::ExecId _exec_id;
+		TimeVal	_start_time;	// When the task was started
+		TimeVal	_phase_start;	// When the current phase was started
+		string	_phase_times;	// The time taken by each phase
 		bool	_verbose;	 // Set to true if output is verbose
 };
 
@@ -580,8 +618,10 @@ class TaskManager : public BugCatcher
 
 	private:
 	void reorder_tasks();
+	void find_task_depends();
+	bool task_is_ready(Task* task) const;
 	void run_task();
-	void task_done(bool success, const string& errmsg);
+	void task_done(bool success, const string& errmsg, Task* task);
 	void fail_tasklist_initialization(const string& errmsg);
 	Task& find_task(const string& module_name);
 	void null_callback();
@@ -600,9 +640,22 @@ class TaskManager : public BugCatcher
 	// _tasks provides fast access to a Task by name
 	map<string, Task*> _tasks;
 
-	// _tasklist maintains the execution order
+	// _tasklist maintains the execution order of the tasks not started yet
 	list<Task*> _tasklist;
 
+	// _task_depends maps a task to the tasks that must be done before it
+	map<Task*, set<Task*> > _task_depends;
+
+	// _running_tasks and _done_tasks are the tasks started and done
+	set<Task*> _running_tasks;
+	set<Task*> _done_tasks;
+
+	bool	_is_starting_tasks;	// True while the tasks are started
+	bool	_task_failed;		// True if one of the tasks failed
+	string	_task_errmsg;		// The error message of the failure
+	size_t	_max_running_tasks;	// The most tasks run at the same time
+	TimeVal	_run_start;		// When the tasks were started
+
 	// _shutdown_order maintains the shutdown ordering
 	list<Task*> _shutdown_order;
 
@@ -10,6 +10,7 @@
 
 #include "template_tree_node.hh"
 #include "template_tree.hh"
+#include "parse_cache.hh"
 extern void add_cmd_adaptor(char *cmd, TemplateTree* tt) throw (ParseError);
 extern void add_cmd_action_adaptor(const string& cmd,
 				   const list<string>& action,
@@ -39,6 +40,19 @@ static int tplt_type;
 static char *tplt_initializer = NULL;
 static string current_cmd;
 static list<string> cmd_list;
+static ParseCache* tplt_cache = NULL;
+
+/**
+ * The parser actions recorded in the template cache
+ */
+enum {
+    TPLT_CACHE_FILE = 0,
+    TPLT_CACHE_EXTEND_PATH,
+    TPLT_CACHE_PUSH_PATH,
+    TPLT_CACHE_POP_PATH,
+    TPLT_CACHE_ADD_CMD,
+    TPLT_CACHE_ADD_CMD_ACTION
+};
 
 /**
  * Function declarations
@@ -80,6 +94,12 @@ complete_template_parser();
 void
 parse_template() throw (ParseError);
 
+void
+set_template_parser_cache(ParseCache* cache);
+
+void
+replay_template_parser(ParseCache& cache, TemplateTree *c) throw (ParseError);
+
 %}
 
 %token UPLEVEL
@@ -372,6 +392,12 @@ extend_path(char *segment, bool is_tag)
 
     string segname;
     segname = segment;
+    if (tplt_cache != NULL) {
+	vector<string> args;
+	args.push_back(segname);
+	args.push_back(is_tag ? "1" : "0");
+	tplt_cache->record(TPLT_CACHE_EXTEND_PATH, tplt_linenum, args);
+    }
     tt->extend_path(segname, is_tag);
     free(segment);
 }
@@ -379,6 +405,14 @@ extend_path(char *segment, bool is_tag)
 void
 push_path()
 {
+    if (tplt_cache != NULL) {
+	// XXX: the initializer is the optional second argument
+	vector<string> args;
+	args.push_back(c_format("%d", tplt_type));
+	if (tplt_initializer != NULL)
+	    args.push_back(tplt_initializer);
+	tplt_cache->record(TPLT_CACHE_PUSH_PATH, tplt_linenum, args);
+    }
     tt->push_path(tplt_type, tplt_initializer);
     tplt_type = NODE_VOID;
     if (tplt_initializer != NULL) {
@@ -390,6 +424,8 @@ push_path()
 void
 pop_path()
 {
+    if (tplt_cache != NULL)
+	tplt_cache->record(TPLT_CACHE_POP_PATH, tplt_linenum);
     tt->pop_path();
     tplt_type = NODE_VOID;
     if (tplt_initializer != NULL) {
@@ -411,6 +447,8 @@ add_cmd(char *cmd)
 {
     lastsymbol = cmd;
 
+    if (tplt_cache != NULL)
+	tplt_cache->record(TPLT_CACHE_ADD_CMD, tplt_linenum, string(cmd));
     add_cmd_adaptor(cmd, tt);
     current_cmd = cmd;
     free(cmd);
@@ -438,6 +476,13 @@ prepend_cmd(char *s)
 void
 end_cmd()
 {
+    if (tplt_cache != NULL) {
+	// XXX: the command is the first argument, the action follows it
+	vector<string> args;
+	args.push_back(current_cmd);
+	args.insert(args.end(), cmd_list.begin(), cmd_list.end());
+	tplt_cache->record(TPLT_CACHE_ADD_CMD_ACTION, tplt_linenum, args);
+    }
     add_cmd_action_adaptor(current_cmd, cmd_list, tt);
     cmd_list.clear();
 }
@@ -467,6 +512,8 @@ init_template_parser(const char *filename, TemplateTree *c)
     tplt_type = NODE_VOID;
     tplt_initializer = NULL;
     tplt_filename = filename;
+    if (tplt_cache != NULL)
+	tplt_cache->record(TPLT_CACHE_FILE, tplt_linenum, tplt_filename);
     return 0;
 }
 
@@ -483,3 +530,84 @@ parse_template() throw (ParseError)
     if (tpltparse() != 0)
 	tplterror("unknown error");
 }
+
+void
+set_template_parser_cache(ParseCache* cache)
+{
+    tplt_cache = cache;
+}
+
+//
+// Replay the parser actions from a template cache, instead of parsing
+// the template files.
+//
+void
+replay_template_parser(ParseCache& cache, TemplateTree *c) throw (ParseError)
+{
+    ParseCache::Entry entry;
+
+    tt = c;
+    tplt_filename = cache.cache_filename();
+    tplt_linenum = 0;
+    lastsymbol = "";
+
+    while (cache.next_entry(entry)) {
+	const vector<string>& args = entry.args;
+
+	tplt_linenum = entry.line;
+	switch (entry.op) {
+	case TPLT_CACHE_FILE:
+	    if (args.size() != 1)
+		break;
+	    tplt_filename = args[0];
+	    continue;
+	case TPLT_CACHE_EXTEND_PATH:
+	    if (args.size() != 2)
+		break;
+	    lastsymbol = args[0];
+	    tt->extend_path(args[0], args[1] == "1");
+	    continue;
+	case TPLT_CACHE_PUSH_PATH:
+	{
+	    if ((args.size() != 1) && (args.size() != 2))
+		break;
+	    vector<char> initializer;
+	    if (args.size() == 2) {
+		initializer.assign(args[1].begin(), args[1].end());
+		initializer.push_back('\0');
+	    }
+	    tt->push_path(atoi(args[0].c_str()),
+			  initializer.empty() ? NULL : &initializer[0]);
+	    continue;
+	}
+	case TPLT_CACHE_POP_PATH:
+	    if (args.size() != 0)
+		break;
+	    tt->pop_path();
+	    continue;
+	case TPLT_CACHE_ADD_CMD:
+	{
+	    if (args.size() != 1)
+		break;
+	    lastsymbol = args[0];
+	    vector<char> cmd(args[0].begin(), args[0].end());
+	    cmd.push_back('\0');
+	    add_cmd_adaptor(&cmd[0], tt);
+	    continue;
+	}
+	case TPLT_CACHE_ADD_CMD_ACTION:
+	{
+	    if (args.size() < 1)
+		break;
+	    list<string> action(args.begin() + 1, args.end());
+	    add_cmd_action_adaptor(args[0], action, tt);
+	    continue;
+	}
+	default:
+	    break;
+	}
+	tplterror(c_format("bad action %u in cache file %s",
+			   XORP_UINT_CAST(entry.op),
+			   cache.cache_filename().c_str()).c_str());
+    }
+}
@@ -24,12 +24,15 @@
 #include "libxorp/xorp.h"
 #include "libxorp/xlog.h"
 #include "libxorp/debug.h"
+#include "libxorp/timer.hh"
 #include "libxorp/utils.hh"
 
 #include <glob.h>
 
 #include "conf_tree.hh"
 #include "conf_tree_node.hh"
+#include "module_command.hh"
+#include "parse_cache.hh"
 #include "template_commands.hh"
 #include "template_tree.hh"
 #include "template_tree_node.hh"
@@ -50,6 +53,9 @@
 extern int init_template_parser(const char* filename, TemplateTree* c);
 extern void complete_template_parser();
 extern void parse_template() throw (ParseError);
+extern void set_template_parser_cache(ParseCache* cache);
+extern void replay_template_parser(ParseCache& cache, TemplateTree* c)
+	throw (ParseError);
 
 TemplateTree::TemplateTree(const string& xorp_root_dir,
 		bool verbose) throw (InitError)
@@ -69,7 +75,7 @@ TemplateTree::~TemplateTree()
 
 	bool
 TemplateTree::load_template_tree(const string& config_template_dir,
-		string& error_msg)
+		const string& cache_dir, string& error_msg)
 {
 	list<string> files;
 
@@ -110,18 +116,71 @@ TemplateTree::load_template_tree(const string& config_template_dir,
 		return false;
 	}
 
-	for (size_t i = 0; i < (size_t)pglob.gl_pathc; i++) 
+	for (size_t i = 0; i < (size_t)pglob.gl_pathc; i++)
+		files.push_back(string(pglob.gl_pathv[i]));
+	globfree(&pglob);
+
+	TimeVal start_time, end_time;
+	TimerList::system_gettimeofday(&start_time);
+
+	//
+	// Replay the template cache if it is up to date, otherwise parse
+	// the template files and record a new cache. An empty cache
+	// directory disables the cache.
+	//
+	ParseCache cache(cache_dir + "/" + ParseCache::TEMPLATE_CACHE_FILENAME,
+			"template");
+	string cache_error_msg = "no cache directory";
+	bool has_digest = false;
+	if (! cache_dir.empty())
+		has_digest = cache.compute_digest(files, cache_error_msg);
+	bool is_cached = false;
+
+	if (has_digest && cache.load(cache_error_msg)) 
 	{
-		debug_msg("Loading template file %s\n", pglob.gl_pathv[i]);
-		if (! parse_file(string(pglob.gl_pathv[i]),
-					config_template_dir, error_msg)) 
+		try 
+		{
+			replay_template_parser(cache, this);
+		} catch (const ParseError& pe) 
 		{
-			globfree(&pglob);
+			error_msg = pe.why();
 			return false;
 		}
+		is_cached = true;
+	} else 
+	{
+		XLOG_TRACE(_verbose, "Not using the template cache: %s",
+				cache_error_msg.c_str());
+		if (has_digest)
+			set_template_parser_cache(&cache);
+
+		list<string>::const_iterator iter;
+		for (iter = files.begin(); iter != files.end(); ++iter) 
+		{
+			debug_msg("Loading template file %s\n", iter->c_str());
+			if (! parse_file(*iter, config_template_dir, error_msg)) 
+			{
+				set_template_parser_cache(NULL);
+				return false;
+			}
+		}
+		set_template_parser_cache(NULL);
+
+		if (has_digest && (! cache.save(cache_error_msg))) 
+		{
+			XLOG_TRACE(_verbose, "Cannot save the template cache: %s",
+					cache_error_msg.c_str());
+		}
 	}
 
-	globfree(&pglob);
+	TimerList::system_gettimeofday(&end_time);
+	XLOG_TRACE(_verbose, "Loaded %u template files (%u actions) %s in %s "
+			"seconds",
+			XORP_UINT_CAST(files.size()),
+			XORP_UINT_CAST(cache.entries_n()),
+			is_cached ? "from the cache" : "by parsing them",
+			(end_time - start_time).str().c_str());
+	UNUSED(is_cached);		// XXX: if the trace logs are disabled
 
 	// Expand and verify the template tree
 	if (expand_template_tree(error_msg) != true)
@@ -330,31 +389,25 @@ TemplateTree::push_path(int type, char* cinit)
 throw (ParseError)
 {
 	TemplateTreeNode* found = NULL;
+	list<TemplateTreeNode*> matches;
 
-	list<TemplateTreeNode*>::const_iterator iter;
-	iter = _current_node->children().begin();
-	while (iter != _current_node->children().end()) 
+	_current_node->get_children_with_name(matches, segment);
+	if (matches.size() > 1) 
 	{
-		if ((*iter)->segname() == segment) 
-		{
-			if (found != NULL) 
-			{
-				//
-				// If there are two nodes with the same segment name,
-				// we can only distinguish between them by type.
-				// extend_path doesn't have the type information
-				// available because it wasn't at the relevant point
-				// in the template file, so this is an error.  The
-				// correct way to step past such a node would be
-				// through a call to add_node .
-				//
-				string err = "Need to qualify type of " + segment + "\n";
-				xorp_throw(ParseError, err);
-			}
-			found = *iter;
-		}
-		++iter;
+		//
+		// If there are two nodes with the same segment name,
+		// we can only distinguish between them by type.
+		// extend_path doesn't have the type information
+		// available because it wasn't at the relevant point
+		// in the template file, so this is an error.  The
+		// correct way to step past such a node would be
+		// through a call to add_node .
+		//
+		string err = "Need to qualify type of " + segment + "\n";
+		xorp_throw(ParseError, err);
 	}
+	if (! matches.empty())
+		found = matches.front();
 	if (found != NULL) 
 	{
 		_current_node = found;
@@ -398,24 +451,21 @@ TemplateTree::add_node(const string& segment, int type, char* cinit)
 		initializer = cinit;
 
 	TemplateTreeNode* found = NULL;
+	list<TemplateTreeNode*> matches;
 	list<TemplateTreeNode*>::const_iterator iter;
-	for (iter = _current_node->children().begin();
-			iter != _current_node->children().end();
-			++iter) 
+	_current_node->get_children_with_name(matches, segment);
+	for (iter = matches.begin(); iter != matches.end(); ++iter) 
 	{
 		TemplateTreeNode* ttn = *iter;
-		if (ttn->segname() == segment) 
+		if ((ttn->type() == type)
+				|| (type == NODE_VOID) || (ttn->type() == NODE_VOID)) 
 		{
-			if ((ttn->type() == type)
-					|| (type == NODE_VOID) || (ttn->type() == NODE_VOID)) 
+			if (found != NULL) 
 			{
-				if (found != NULL) 
-				{
-					// I don't think this can happen
-					XLOG_UNREACHABLE();
-				}
-				found = ttn;
+				// I don't think this can happen
+				XLOG_UNREACHABLE();
 			}
+			found = ttn;
 		}
 	}
 	if (found != NULL) 
@@ -441,13 +491,7 @@ TemplateTree::find_node(const list<string>& path_segments) const
 		list<TemplateTreeNode*>::const_iterator ti;
 
 		// First look for an exact name match
-		for (ti = ttn->children().begin(); ti != ttn->children().end(); ++ti) 
-		{
-			if ((*ti)->segname() == segname) 
-			{
-				matches.push_back(*ti);
-			}
-		}
+		ttn->get_children_with_name(matches, segname);
 		if (matches.size() == 1) 
 		{
 			ttn = matches.front();
@@ -529,13 +573,7 @@ TemplateTree::find_node_by_type(const list<ConfPathSegment>& path_segments)
 		list<TemplateTreeNode*>::const_iterator ti;
 
 		// First look for an exact name match
-		for (ti = ttn->children().begin(); ti != ttn->children().end(); ++ti) 
-		{
-			if ((*ti)->segname() == segname) 
-			{
-				matches.push_back(*ti);
-			}
-		}
+		ttn->get_children_with_name(matches, segname);
 		if (matches.size() == 1) 
 		{
 			ttn = matches.front();
@@ -632,6 +670,29 @@ TemplateTree::find_module(const string& name)
 		return rpair->second;
 }
 
+//
+// Find a module by the name it provides, or else by its default target
+// name, which some templates use in their dependencies (e.g., "fea" for
+// the "interfaces" module).
+//
+	ModuleCommand*
+TemplateTree::find_module_by_target_name(const string& name)
+{
+	ModuleCommand* mc = find_module(name);
+	if (mc != NULL)
+		return mc;
+
+	map<string, ModuleCommand*>::const_iterator rpair;
+	for (rpair = _registered_modules.begin();
+			rpair != _registered_modules.end();
+			++rpair) 
+	{
+		if (rpair->second->default_target_name() == name)
+			return rpair->second;
+	}
+	return NULL;
+}
+
 bool
 TemplateTree::check_variable_name(const string& s) const
 {
@@ -44,7 +44,7 @@ class TemplateTree
 		virtual ~TemplateTree();
 
 		bool load_template_tree(const string& config_template_dir,
-				string& error_msg);
+				const string& cache_dir, string& error_msg);
 		bool parse_file(const string& filename, 
 				const string& config_template_dir, string& error_msg);
 
@@ -63,6 +63,7 @@ class TemplateTree
 		string tree_str() const;
 		void register_module(const string& name, ModuleCommand* mc);
 		ModuleCommand* find_module(const string& name);
+		ModuleCommand* find_module_by_target_name(const string& name);
 		bool check_variable_name(const string& s) const;
 		TemplateTreeNode* root_node() const { return _root_node; }
 		const string& xorp_root_dir() const { return _xorp_root_dir; }
@@ -79,6 +79,7 @@ TemplateTreeNode::~TemplateTreeNode()
 		delete _children.front();
 		_children.pop_front();
 	}
+	_children_by_segname.clear();
 
 	map<string, BaseCommand *>::iterator iter1, iter2;
 	iter1 = _cmd_map.begin();
@@ -403,6 +404,22 @@ TemplateTreeNode::check_template_tree(string& error_msg) const
 TemplateTreeNode::add_child(TemplateTreeNode* child)
 {
 	_children.push_back(child);
+	_children_by_segname.insert(make_pair(child->segname(), child));
+}
+
+	void
+TemplateTreeNode::get_children_with_name(list<TemplateTreeNode*>& children_ret,
+		const string& segname) const
+{
+	multimap<string, TemplateTreeNode*>::const_iterator iter;
+
+	children_ret.clear();
+	for (iter = _children_by_segname.lower_bound(segname);
+			(iter != _children_by_segname.end()) && (iter->first == segname);
+			++iter) 
+	{
+		children_ret.push_back(iter->second);
+	}
 }
 
 	void
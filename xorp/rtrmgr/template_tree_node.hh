@@ -106,6 +106,8 @@ class TemplateTreeNode
 		string subtree_str() const;
 		TemplateTreeNode* parent() const { return _parent; }
 		const list<TemplateTreeNode*>& children() const { return _children; }
+		void get_children_with_name(list<TemplateTreeNode*>& children_ret,
+				const string& segname) const;
 		const string& module_name() const { return _module_name; }
 		const string& default_target_name() const { return _default_target_name; }
 		void set_subtree_module_name(const string& module_name);
@@ -194,6 +196,7 @@ class TemplateTreeNode
 		map<string, BaseCommand *> _cmd_map;
 		TemplateTreeNode*	_parent;
 		list<TemplateTreeNode*> _children;
+		multimap<string, TemplateTreeNode*> _children_by_segname;
 
 	private:
 		bool split_up_varname(const string& varname,
@@ -38,6 +38,9 @@ class XorpClient
 				const string& expected_response, bool do_exec);
 		void fake_send_done(string xrl_return_spec, XrlRouter::XrlCallback cb);
 		XrlArgs fake_return_args(const string& xrl_return_spec);
+		bool is_resolved(const Xrl& xrl) const {
+			return (_xrl_router.is_resolved(xrl));
+		}
 
 	private:
 		XrlRouter&	_xrl_router;
@@ -124,6 +124,7 @@ add_cmd_action_adaptor(const string& cmd, const list<string>& action,
 XorpShell::XorpShell( const string& IPCname,
 		const string& xorp_root_dir,
 		const string& config_template_dir,
+		const string& cache_dir,
 		bool verbose) throw (InitError)
 : XrlStdRouter( IPCname.c_str()),
 	_xrl_router(*this),
@@ -152,12 +153,14 @@ XorpShell::XorpShell( const string& IPCname,
 			xorp_root_dir.c_str());
 	XLOG_TRACE(_verbose, "Templates directory        := %s\n",
 			config_template_dir.c_str());
+	XLOG_TRACE(_verbose, "Parse cache directory      := %s\n",
+			cache_dir.c_str());
 	XLOG_TRACE(_verbose, "Print verbose information  := %s\n",
 			bool_c_str(_verbose));
 
 	// Read the router config template files
 	_tt = new TemplateTree(xorp_root_dir, _verbose);
-	if (!_tt->load_template_tree(config_template_dir, error_msg)) 
+	if (!_tt->load_template_tree(config_template_dir, cache_dir, error_msg)) 
 	{
 		xorp_throw(InitError, error_msg);
 	}
@@ -167,7 +170,8 @@ XorpShell::XorpShell( const string& IPCname,
 	// Read the router operational template files
 	try 
 	{
-		_ocl = new OpCommandList(config_template_dir.c_str(), _tt, _mmgr);
+		_ocl = new OpCommandList(config_template_dir.c_str(), cache_dir,
+				_tt, _mmgr);
 	} catch (const InitError& e) 
 	{
 		xorp_throw(InitError, e.why());
@@ -775,6 +779,7 @@ usage(const char *argv0)
 	fprintf(stderr, "  -h        Display this information\n");
 	fprintf(stderr, "  -v        Print verbose information\n");
 	fprintf(stderr, "  -t <dir>  Specify templates directory\n");
+	fprintf(stderr, "  -T <dir>  Specify parse cache directory\n");
 }
 
 	static void
@@ -783,6 +788,8 @@ display_defaults()
 	fprintf(stderr, "Defaults:\n");
 	fprintf(stderr, "  Templates directory        := %s\n",
 			xorp_template_dir().c_str());
+	fprintf(stderr, "  Parse cache directory      := %s\n",
+			"the templates directory");
 	fprintf(stderr, "  Print verbose information  := %s\n",
 			bool_c_str(default_verbose));
 }
@@ -818,8 +825,9 @@ main(int argc, char *argv[])
 	//
 	xorp_path_init(argv[0]);
 	string template_dir		= xorp_template_dir();
+	string cache_dir;		// The templates directory if empty
 
-	static const char optstring[] = "c:et:vh";
+	static const char optstring[] = "c:eT:t:vh";
 
 	int c;
 	while ((c = getopt(argc, argv, optstring)) != EOF) 
@@ -837,6 +845,9 @@ main(int argc, char *argv[])
 			case 't':
 				template_dir = optarg;
 				break;
+			case 'T':
+				cache_dir = optarg;
+				break;
 			case 'v':
 				verbose = true;
 				break;
@@ -849,6 +860,9 @@ main(int argc, char *argv[])
 		}
 	}
 
+	if (cache_dir.empty())
+		cache_dir = template_dir;
+
 	//
 	// Initialize the IPC mechanism.
 	// As there can be multiple xorpsh instances, we need to generate a
@@ -866,7 +880,7 @@ main(int argc, char *argv[])
 		string xname = "xorpsh" + c_format("-%d-%s", XORP_INT_CAST(getpid()),
 				hostname);
 		XorpShell xorpsh( xname, xorp_binary_root_dir(),
-				template_dir, verbose);
+				template_dir, cache_dir, verbose);
 		xorpsh.run(commands, exit_on_error);
 	} catch (const InitError& e) 
 	{
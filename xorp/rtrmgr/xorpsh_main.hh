@@ -48,6 +48,7 @@ class XorpShell : public XorpShellBase, XrlStdRouter
 		XorpShell( const string& IPCname, 
 				const string& xorp_root_dir,
 				const string& config_template_dir, 
+				const string& cache_dir, 
 				bool verbose) throw (InitError);
 		~XorpShell();
 
@@ -141,6 +141,7 @@ def DoAllConfig(env, conf, host_os):
     has_syslog = conf.CheckFunc('syslog')
     has_uname = conf.CheckFunc('uname')
     has_writev = conf.CheckFunc('writev')
+    has_mkfifo = conf.CheckFunc('mkfifo')
 
     # may be in -lxnet on opensolaris
     has_libxnet = conf.CheckLib('xnet')
@@ -150,6 +151,7 @@ def DoAllConfig(env, conf, host_os):
     # may be in -lrt
     has_librt = conf.CheckLib('rt')
     has_clock_gettime = conf.CheckFunc('clock_gettime')
+    has_shm_open = conf.CheckFunc('shm_open')
     has_clock_monotonic = conf.CheckDeclaration('CLOCK_MONOTONIC', '#include <time.h>')
     if has_clock_monotonic:
         conf.Define('HAVE_CLOCK_MONOTONIC') # autoconf compat
@@ -187,6 +189,7 @@ def DoAllConfig(env, conf, host_os):
     has_sys_time_h = conf.CheckHeader('sys/time.h')
     has_sys_uio_h = conf.CheckHeader('sys/uio.h')
     has_sys_ioctl_h = conf.CheckHeader('sys/ioctl.h')
+    has_sys_mman_h = conf.CheckHeader('sys/mman.h')
     has_sys_select_h = conf.CheckHeader('sys/select.h')
     has_sys_socket_h = conf.CheckHeader('sys/socket.h')
     has_sys_sockio_h = conf.CheckHeader('sys/sockio.h')